@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file BenchBatch.cpp
+//!
+//! Compares the structure-of-arrays batch operations against looping over
+//! arrays of the existing Vector3, Quaternion and DCM classes.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "../src/DCMBatch.hpp"
+
+template<class T>
+T random()
+{
+    return static_cast<T>(rand()) / RAND_MAX - T(0.5);
+}
+
+template<class T>
+void run(const char *typeName, size_t n)
+{
+    using namespace matrix;
+    // Keep the total work per case roughly constant
+    const size_t iterations = 20000000 / n + 1;
+
+    std::vector<Vector3<T>> a(n), b(n), vOut(n);
+    std::vector<Quaternion<T>> p(n), q(n), qOut(n);
+    std::vector<DCM<T>> dcms(n);
+    std::vector<T> dots(n);
+    for(size_t i = 0; i < n; ++i)
+    {
+        a[i] = Vector3<T>(random<T>(), random<T>(), random<T>());
+        b[i] = Vector3<T>(random<T>(), random<T>(), random<T>());
+        p[i] = Quaternion<T>(random<T>(), random<T>(), random<T>(), random<T>());
+        q[i] = Quaternion<T>(random<T>(), random<T>(), random<T>(), random<T>());
+        dcms[i] = DCM<T>(p[i]);
+    }
+
+    Vector3Batch<T> batchA(a.data(), n), batchB(b.data(), n), batchVOut(n);
+    QuaternionBatch<T> batchP(p.data(), n), batchQ(q.data(), n), batchQOut(n);
+    DCMBatch<T> batchDcm(dcms.data(), n);
+
+    char name[64];
+    auto compare = [&](const char *op, auto aos, auto soa)
+    {
+        double aosNs = bench::timeNs(aos, iterations);
+        double soaNs = bench::timeNs(soa, iterations);
+        snprintf(name, sizeof(name), "%s N=%zu %s", typeName, n, op);
+        bench::report(name, aosNs, soaNs);
+    };
+
+    compare("dot",
+        [&]() { for(size_t i = 0; i < n; ++i) { dots[i] = a[i].dot(b[i]); } bench::doNotOptimize(dots); },
+        [&]() { batchA.dot(batchB, dots.data()); bench::doNotOptimize(dots); });
+    compare("cross",
+        [&]() { for(size_t i = 0; i < n; ++i) { vOut[i] = a[i].cross(b[i]); } bench::doNotOptimize(vOut); },
+        [&]() { batchA.cross(batchB, batchVOut); bench::doNotOptimize(batchVOut); });
+    compare("normalize",
+        [&]() { for(size_t i = 0; i < n; ++i) { vOut[i] = a[i]; vOut[i].normalize(); } bench::doNotOptimize(vOut); },
+        [&]() { batchVOut = batchA; batchVOut.normalize(); bench::doNotOptimize(batchVOut); });
+    compare("quaternion *",
+        [&]() { for(size_t i = 0; i < n; ++i) { qOut[i] = p[i]*q[i]; } bench::doNotOptimize(qOut); },
+        [&]() { batchP.multiply(batchQ, batchQOut); bench::doNotOptimize(batchQOut); });
+    compare("quaternion to DCM",
+        [&]() { for(size_t i = 0; i < n; ++i) { dcms[i] = DCM<T>(p[i]); } bench::doNotOptimize(dcms); },
+        [&]() { batchDcm.load(batchP); bench::doNotOptimize(batchDcm); });
+    compare("DCM rotation",
+        [&]() { for(size_t i = 0; i < n; ++i) { vOut[i] = Vector3<T>(dcms[i]*a[i]); } bench::doNotOptimize(vOut); },
+        [&]() { batchDcm.rotate(batchA, batchVOut); bench::doNotOptimize(batchVOut); });
+}
+
+int main()
+{
+    bench::header("Looping over AoS objects vs SoA batches");
+    for(size_t n : {size_t(1000), size_t(10000), size_t(100000), size_t(1000000)})
+    {
+        run<float>("float", n);
+        run<double>("double", n);
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file BenchCholesky.cpp
+//!
+//! Compares refactoring a covariance after a rank-1 change (O(M^3)) against
+//! the O(M^2) update and downdate of an existing LLT or LDLT factorization.
+//! Each case applies A + v v^T and then A - v v^T, returning to the original
+//! matrix so every iteration does the same work.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "Benchmark.hpp"
+#include "../src/Cholesky.hpp"
+
+template<class Factorization, size_t M>
+void run(const char *typeName, size_t iterations)
+{
+    matrix::SquareMatrix<double, M> B;
+    matrix::Vector<double, M> v;
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < M; ++j)
+        {
+            B(i,j) = static_cast<double>(rand()) / RAND_MAX - 0.5;
+        }
+        v(i) = static_cast<double>(rand()) / RAND_MAX - 0.5;
+    }
+    matrix::SquareMatrix<double, M> P = B*B.transpose();
+    matrix::SquareMatrix<double, M> updated = P;
+    for(size_t i = 0; i < M; ++i)
+    {
+        P(i,i) += 1.0;
+        for(size_t j = 0; j < M; ++j)
+        {
+            updated(i,j) = P(i,j) + v(i)*v(j);
+        }
+    }
+
+    Factorization factor(P);
+    double refactorNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(P);
+        factor.compute(updated);
+        bench::doNotOptimize(factor);
+        factor.compute(P);
+        bench::doNotOptimize(factor);
+    }, iterations);
+
+    double updateNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(v);
+        factor.update(v);
+        bench::doNotOptimize(factor);
+        factor.downdate(v);
+        bench::doNotOptimize(factor);
+    }, iterations);
+
+    char name[64];
+    snprintf(name, sizeof(name), "%s %zux%zu", typeName, M, M);
+    bench::report(name, refactorNs, updateNs);
+}
+
+int main()
+{
+    bench::header("Rank-1 update + downdate: refactor vs O(M^2) update");
+    run<matrix::LLT<double, 6>, 6>("LLT", 2000000);
+    run<matrix::LLT<double, 15>, 15>("LLT", 200000);
+    run<matrix::LLT<double, 30>, 30>("LLT", 30000);
+    run<matrix::LDLT<double, 6>, 6>("LDLT", 2000000);
+    run<matrix::LDLT<double, 15>, 15>("LDLT", 200000);
+    run<matrix::LDLT<double, 30>, 30>("LDLT", 30000);
+    return 0;
+}
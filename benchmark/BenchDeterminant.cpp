@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file BenchDeterminant.cpp
+//!
+//! Compares the recursive cofactor expansion that determinant() used for
+//! M > 3 (O(M!) time, one minor copy per term) against the closed-form 4x4
+//! and the O(M^3) elimination that replace it.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "Benchmark.hpp"
+#include "../src/SquareMatrix.hpp"
+
+//! The previous generic determinant: cofactor expansion along the first row
+template<class T, size_t M>
+T cofactorDeterminant(const matrix::SquareMatrix<T, M> &A)
+{
+    if constexpr(M <= 3)
+    {
+        return matrix::determinant<T>(A);
+    }
+    else
+    {
+        T det = 0;
+        for(size_t i = 0; i < M; ++i)
+        {
+            matrix::SquareMatrix<T, M-1> minor = A.minor(0,i);
+            det += std::pow(-1.0, i)*A(0, i)*cofactorDeterminant<T>(minor);
+        }
+        return det;
+    }
+}
+
+template<size_t M>
+void run(size_t cofactorIterations, size_t iterations)
+{
+    matrix::SquareMatrix<double, M> A;
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < M; ++j)
+        {
+            A(i,j) = static_cast<double>(rand()) / RAND_MAX - 0.5;
+        }
+    }
+
+    double det = 0.0;
+    double cofactorNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        det = cofactorDeterminant<double>(A);
+        bench::doNotOptimize(det);
+    }, cofactorIterations);
+
+    double newNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        det = matrix::determinant<double>(A);
+        bench::doNotOptimize(det);
+    }, iterations);
+
+    char name[64];
+    snprintf(name, sizeof(name), "%zux%zu determinant", M, M);
+    bench::report(name, cofactorNs, newNs);
+}
+
+int main()
+{
+    bench::header("Determinant: cofactor expansion vs closed form / elimination");
+    run<4>(2000000, 10000000);
+    run<5>(500000, 5000000);
+    run<6>(50000, 2000000);
+    run<7>(5000, 1000000);
+    run<8>(500, 1000000);
+    run<9>(50, 500000);
+    run<10>(5, 500000);
+    return 0;
+}
@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file BenchDiscretization.cpp
+//!
+//! Continuous-to-discrete conversion: Phi, Gamma and Qd from three separate
+//! exponentials (e^(A dt), the [A B; 0 0] block for Gamma and the Van Loan
+//! block for Qd) against the single (2N+P) block exponential of c2d, and
+//! against a Discretization object called again with an unchanged system.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "Benchmark.hpp"
+#include "../src/Discretization.hpp"
+
+template<size_t M, size_t N>
+void fill(matrix::Matrix<double, M, N> &m, double scale)
+{
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < N; ++j)
+        {
+            m(i,j) = scale*(static_cast<double>(rand()) / RAND_MAX - 0.5);
+        }
+    }
+}
+
+template<size_t N, size_t P>
+void run(size_t iterations)
+{
+    matrix::SquareMatrix<double, N> A;
+    matrix::Matrix<double, N, P> B;
+    matrix::SquareMatrix<double, N> G;
+    fill(A, 2.0);
+    fill(B, 1.0);
+    fill(G, 1.0);
+    const matrix::SquareMatrix<double, N> Q = G*G.transpose();
+    const double dt = 0.02;
+
+    matrix::SquareMatrix<double, N> Phi;
+    matrix::Matrix<double, N, P> Gamma;
+    matrix::SquareMatrix<double, N> Qd;
+    double separateNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        Phi = matrix::expm(matrix::SquareMatrix<double, N>(A*dt));
+
+        matrix::SquareMatrix<double, N+P> AB;
+        matrix::SquareMatrix<double, 2*N> vanLoan;
+        for(size_t i = 0; i < N; ++i)
+        {
+            for(size_t j = 0; j < N; ++j)
+            {
+                AB(i,j) = A(i,j)*dt;
+                vanLoan(i,j) = -A(i,j)*dt;
+                vanLoan(i,N+j) = Q(i,j)*dt;
+                vanLoan(N+i,N+j) = A(j,i)*dt;
+            }
+            for(size_t k = 0; k < P; ++k)
+            {
+                AB(i,N+k) = B(i,k)*dt;
+            }
+        }
+        matrix::SquareMatrix<double, N+P> eAB = matrix::expm(AB);
+        matrix::SquareMatrix<double, 2*N> eVanLoan = matrix::expm(vanLoan);
+        matrix::SquareMatrix<double, N> PhiInvQd;
+        for(size_t i = 0; i < N; ++i)
+        {
+            for(size_t k = 0; k < P; ++k)
+            {
+                Gamma(i,k) = eAB(i,N+k);
+            }
+            for(size_t j = 0; j < N; ++j)
+            {
+                PhiInvQd(i,j) = eVanLoan(i,N+j);
+            }
+        }
+        Qd = Phi*PhiInvQd;
+        bench::doNotOptimize(Phi);
+        bench::doNotOptimize(Gamma);
+        bench::doNotOptimize(Qd);
+    }, iterations);
+
+    double singleNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        matrix::Discretization<double, N, P> d = matrix::c2d(A, B, Q, dt);
+        bench::doNotOptimize(d);
+    }, iterations);
+
+    matrix::Discretization<double, N, P> reused;
+    double reusedNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        reused.compute(A, B, Q, dt);
+        bench::doNotOptimize(reused);
+    }, iterations);
+
+    char name[64];
+    snprintf(name, sizeof(name), "N=%zu P=%zu, c2d", N, P);
+    bench::report(name, separateNs, singleNs);
+    snprintf(name, sizeof(name), "N=%zu P=%zu, unchanged system", N, P);
+    bench::report(name, separateNs, reusedNs);
+}
+
+int main()
+{
+    bench::header("Separate exponentials vs one Van Loan block exponential");
+    run<4, 2>(50000);
+    run<6, 3>(20000);
+    run<9, 4>(10000);
+    run<12, 4>(5000);
+    return 0;
+}
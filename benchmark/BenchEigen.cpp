@@ -0,0 +1,57 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file BenchEigen.cpp
+//!
+//! Symmetric 3x3 eigen-decomposition benchmarks: cyclic Jacobi against the
+//! closed form, for a random matrix and for an inertia tensor that is already
+//! nearly diagonal (where Jacobi needs the fewest sweeps).
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "Benchmark.hpp"
+#include "../src/SymmetricEigen.hpp"
+
+void run(const char *name, const matrix::SquareMatrix<double, 3> &A, size_t iterations)
+{
+    matrix::SymmetricEigen3<double> eig;
+
+    double jacobiNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        eig.computeJacobi(A);
+        bench::doNotOptimize(eig);
+    }, iterations);
+
+    double closedNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        eig.compute(A);
+        bench::doNotOptimize(eig);
+    }, iterations);
+
+    bench::report(name, jacobiNs, closedNs);
+}
+
+int main()
+{
+    matrix::SquareMatrix<double, 3> random;
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = i; j < 3; ++j)
+        {
+            random(i,j) = static_cast<double>(rand()) / RAND_MAX - 0.5;
+            random(j,i) = random(i,j);
+        }
+    }
+
+    matrix::SquareMatrix<double, 3> inertia = {{1.2, 0.01, -0.02}, {0.01, 2.5, 0.03}, {-0.02, 0.03, 3.1}};
+
+    bench::header("Symmetric 3x3 eigen-decomposition: Jacobi vs closed form");
+    run("random 3x3", random, 2000000);
+    run("near-diagonal 3x3", inertia, 2000000);
+    return 0;
+}
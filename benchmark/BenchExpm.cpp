@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file BenchExpm.cpp
+//!
+//! Matrix exponential benchmarks: a hand-summed 20-term Taylor series against
+//! expm, the Pade path against the closed forms for 3x3 skew and 4x4
+//! quaternion rate matrices, and expm(A)*v against expmv(A, v).
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "Benchmark.hpp"
+#include "../src/MatrixExponential.hpp"
+
+template<size_t M>
+void fill(matrix::SquareMatrix<double, M> &m, double scale)
+{
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < M; ++j)
+        {
+            m(i,j) = scale*(static_cast<double>(rand()) / RAND_MAX - 0.5);
+        }
+    }
+}
+
+template<size_t M>
+void runTaylor(double scale, size_t iterations)
+{
+    matrix::SquareMatrix<double, M> A;
+    fill(A, scale);
+    matrix::SquareMatrix<double, M> E;
+
+    double taylorNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        matrix::SquareMatrix<double, M> term;
+        term.identity();
+        E = term;
+        for(size_t k = 1; k <= 20; ++k)
+        {
+            term = term*A;
+            term /= static_cast<double>(k);
+            E += term;
+        }
+        bench::doNotOptimize(E);
+    }, iterations);
+
+    double expmNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        E = matrix::expm(A);
+        bench::doNotOptimize(E);
+    }, iterations);
+
+    char name[64];
+    snprintf(name, sizeof(name), "%zux%zu, |A| ~ %.1f", M, M, scale*M/4.0);
+    bench::report(name, taylorNs, expmNs);
+}
+
+template<size_t M>
+void runClosedForm(const char *name, const matrix::SquareMatrix<double, M> &A, size_t iterations)
+{
+    matrix::SquareMatrix<double, M> E;
+    double padeNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        E = matrix::detail::expmPade(A);
+        bench::doNotOptimize(E);
+    }, iterations);
+
+    double closedNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        E = matrix::expm(A);
+        bench::doNotOptimize(E);
+    }, iterations);
+    bench::report(name, padeNs, closedNs);
+}
+
+template<size_t M>
+void runExpmv(double scale, size_t iterations)
+{
+    matrix::SquareMatrix<double, M> A;
+    fill(A, scale);
+    matrix::Vector<double, M> v;
+    for(size_t i = 0; i < M; ++i)
+    {
+        v(i) = 1.0;
+    }
+    matrix::Vector<double, M> x;
+
+    double expmNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        x = matrix::expm(A)*v;
+        bench::doNotOptimize(x);
+    }, iterations);
+
+    double expmvNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        x = matrix::expmv(A, v);
+        bench::doNotOptimize(x);
+    }, iterations);
+
+    char name[64];
+    snprintf(name, sizeof(name), "%zux%zu, |A| ~ %.1f", M, M, scale*M/4.0);
+    bench::report(name, expmNs, expmvNs);
+}
+
+int main()
+{
+    bench::header("20-term Taylor series vs expm");
+    runTaylor<4>(0.5, 200000);
+    runTaylor<6>(0.5, 100000);
+    runTaylor<12>(0.5, 20000);
+    runTaylor<12>(2.0, 20000);
+
+    matrix::Vector3<double> w(0.3, -1.2, 0.8);
+    matrix::SquareMatrix<double, 4> Omega = {{0.0, -0.2, -0.05, -0.35},
+                                            {0.2, 0.0, 0.35, -0.05},
+                                            {0.05, -0.35, 0.0, 0.2},
+                                            {0.35, 0.05, -0.2, 0.0}};
+    bench::header("Pade vs closed form");
+    runClosedForm<3>("3x3 skew (Rodrigues)", w.tilde(), 1000000);
+    runClosedForm<4>("4x4 quaternion rate", Omega, 1000000);
+
+    bench::header("expm(A)*v vs expmv(A, v)");
+    runExpmv<12>(0.5, 20000);
+    runExpmv<40>(0.2, 2000);
+    runExpmv<40>(1.0, 2000);
+    return 0;
+}
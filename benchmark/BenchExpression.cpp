@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file BenchExpression.cpp
+//!
+//! Compares fused expression evaluation of A + B*c - C against evaluating it
+//! one operator at a time with a materialized temporary per operator (the
+//! behavior of the original eager operators).
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+
+#include "Benchmark.hpp"
+#include "../src/Matrix.hpp"
+
+template<size_t M>
+void fill(matrix::Matrix<double, M, M> &m)
+{
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < M; ++j)
+        {
+            m(i,j) = static_cast<double>(rand()) / RAND_MAX - 0.5;
+        }
+    }
+}
+
+template<size_t M>
+void run(const char *name, size_t iterations)
+{
+    using Mat = matrix::Matrix<double, M, M>;
+    Mat A, B, C, out;
+    fill(A);
+    fill(B);
+    fill(C);
+    double c = 0.25;
+
+    double eagerNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        // Each intermediate is zero-initialized and then filled, as the eager operators did
+        Mat t1;
+        t1 = B * c;
+        Mat t2;
+        t2 = A + t1;
+        Mat t3;
+        t3 = t2 - C;
+        out = t3;
+        bench::doNotOptimize(out);
+    }, iterations);
+
+    double fusedNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        out = A + B*c - C;
+        bench::doNotOptimize(out);
+    }, iterations);
+
+    bench::report(name, eagerNs, fusedNs);
+}
+
+int main()
+{
+    bench::header("A + B*c - C: eager temporaries vs fused expression");
+    run<3>("3x3", 5000000);
+    run<6>("6x6", 2000000);
+    run<12>("12x12", 500000);
+    return 0;
+}
@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file BenchInverse.cpp
+//!
+//! Compares inverse() against inverting through a pivoted LU factorization,
+//! and the rigid-transform inverse against the general 4x4 inverse.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "Benchmark.hpp"
+#include "../src/LUFactorization.hpp"
+
+template<size_t M>
+void runInverse(size_t iterations)
+{
+    matrix::SquareMatrix<double, M> A;
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < M; ++j)
+        {
+            A(i,j) = static_cast<double>(rand()) / RAND_MAX - 0.5;
+        }
+        A(i,i) += 2.0;
+    }
+
+    matrix::SquareMatrix<double, M> Ainv;
+    double luNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        Ainv = matrix::LUFactorization<double, M>(A).inverse();
+        bench::doNotOptimize(Ainv);
+    }, iterations);
+
+    double inverseNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        Ainv = matrix::inverse<double>(A);
+        bench::doNotOptimize(Ainv);
+    }, iterations);
+
+    char name[64];
+    snprintf(name, sizeof(name), "%zux%zu inverse", M, M);
+    bench::report(name, luNs, inverseNs);
+}
+
+void runRigid(size_t iterations)
+{
+    const double c = std::cos(0.3), s = std::sin(0.3);
+    matrix::SquareMatrix<double, 4> T = {{c, -s, 0.0, 1.0}, {s, c, 0.0, -2.0}, {0.0, 0.0, 1.0, 3.0}, {0.0, 0.0, 0.0, 1.0}};
+    matrix::SquareMatrix<double, 4> Tinv;
+
+    double generalNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(T);
+        Tinv = matrix::inverse<double>(T);
+        bench::doNotOptimize(Tinv);
+    }, iterations);
+
+    double rigidNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(T);
+        Tinv = matrix::rigidInverse(T);
+        bench::doNotOptimize(Tinv);
+    }, iterations);
+
+    bench::report("4x4 rigid transform", generalNs, rigidNs);
+}
+
+int main()
+{
+    bench::header("LUFactorization inverse vs inverse()");
+    runInverse<4>(5000000);
+    runInverse<6>(1000000);
+    runInverse<12>(200000);
+    runInverse<32>(10000);
+
+    bench::header("General 4x4 inverse vs rigidInverse");
+    runRigid(10000000);
+    return 0;
+}
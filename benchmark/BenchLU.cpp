@@ -0,0 +1,120 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file BenchLU.cpp
+//!
+//! Compares the unpivoted SquareMatrix::LU_decomposition against the pivoted,
+//! in-place LUFactorization, and refactoring for every right-hand side against
+//! factoring once and reusing the factorization (e.g. an implicit integrator
+//! that solves with the same Jacobian several times per step).
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "Benchmark.hpp"
+#include "../src/LUFactorization.hpp"
+
+template<size_t M, size_t N>
+void fill(matrix::Matrix<double, M, N> &m)
+{
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < N; ++j)
+        {
+            m(i,j) = static_cast<double>(rand()) / RAND_MAX - 0.5;
+        }
+    }
+}
+
+template<size_t M>
+void runFactor(size_t iterations)
+{
+    // Diagonally dominant, so the unpivoted decomposition is well defined
+    matrix::SquareMatrix<double, M> A;
+    fill<M,M>(A);
+    for(size_t i = 0; i < M; ++i)
+    {
+        A(i,i) += static_cast<double>(M);
+    }
+
+    matrix::SquareMatrix<double, M> L, U;
+    double unpivotedNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        A.LU_decomposition(L, U);
+        bench::doNotOptimize(L);
+        bench::doNotOptimize(U);
+    }, iterations);
+
+    matrix::LUFactorization<double, M> lu;
+    double pivotedNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        lu.compute(A);
+        bench::doNotOptimize(lu);
+    }, iterations);
+
+    char name[64];
+    snprintf(name, sizeof(name), "%zux%zu factor", M, M);
+    bench::report(name, unpivotedNs, pivotedNs);
+}
+
+template<size_t M>
+void runSolve(size_t iterations)
+{
+    const size_t rhsCount = 8;
+    matrix::SquareMatrix<double, M> A;
+    fill<M,M>(A);
+    matrix::Vector<double, M> b[rhsCount];
+    for(size_t n = 0; n < rhsCount; ++n)
+    {
+        fill<M,1>(b[n]);
+    }
+    matrix::Vector<double, M> x;
+
+    double refactorNs = bench::timeNs([&]()
+    {
+        for(size_t n = 0; n < rhsCount; ++n)
+        {
+            bench::doNotOptimize(A);
+            x = matrix::LUFactorization<double, M>(A).solve(b[n]);
+            bench::doNotOptimize(x);
+        }
+    }, iterations);
+
+    matrix::LUFactorization<double, M> lu;
+    double reuseNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        lu.compute(A);
+        for(size_t n = 0; n < rhsCount; ++n)
+        {
+            x = lu.solve(b[n]);
+            bench::doNotOptimize(x);
+        }
+    }, iterations);
+
+    char name[64];
+    snprintf(name, sizeof(name), "%zux%zu 8 solves", M, M);
+    bench::report(name, refactorNs, reuseNs);
+}
+
+int main()
+{
+    bench::header("Factor: unpivoted LU_decomposition vs LUFactorization");
+    runFactor<4>(2000000);
+    runFactor<8>(500000);
+    runFactor<16>(100000);
+    runFactor<32>(10000);
+    runFactor<64>(2000);
+
+    bench::header("Eight right-hand sides: refactor each vs factor once");
+    runSolve<4>(500000);
+    runSolve<8>(100000);
+    runSolve<16>(20000);
+    runSolve<32>(2000);
+    runSolve<64>(300);
+    return 0;
+}
@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file BenchLargeMultiply.cpp
+//!
+//! Compares the cache-blocked product kernel, alone and split across the
+//! default thread pool, against the generic i-j-k loop for large square
+//! matrices.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+#include "Benchmark.hpp"
+#include "../src/Matrix.hpp"
+
+template<class T, size_t M>
+void fill(matrix::Matrix<T, M, M> &m)
+{
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < M; ++j)
+        {
+            m(i,j) = static_cast<T>(rand()) / RAND_MAX - T(0.5);
+        }
+    }
+}
+
+template<class T, size_t M>
+void run(const char *typeName)
+{
+    // Large matrices live on the heap to keep the stack small
+    auto A = std::make_unique<matrix::Matrix<T, M, M>>();
+    auto B = std::make_unique<matrix::Matrix<T, M, M>>();
+    auto out = std::make_unique<matrix::Matrix<T, M, M>>();
+    fill(*A);
+    fill(*B);
+    const T *a = &(*A)(0,0);
+    const T *b = &(*B)(0,0);
+    T *c = &(*out)(0,0);
+    const size_t iterations = 200000000 / (M*M*M) + 1;
+
+    double genericNs = bench::timeNs([&]()
+    {
+        matrix::detail::GenericMultiplyKernel<T, M, M, M>::apply(a, b, c);
+        bench::doNotOptimize(c);
+    }, iterations);
+
+    double blockedNs = bench::timeNs([&]()
+    {
+        matrix::detail::BlockedMultiplyKernel<T, M, M, M>::apply(a, b, c);
+        bench::doNotOptimize(c);
+    }, iterations);
+
+    double threadedNs = bench::timeNs([&]()
+    {
+        matrix::detail::BlockedMultiplyKernel<T, M, M, M>::apply(a, b, c, matrix::defaultThreadPool());
+        bench::doNotOptimize(c);
+    }, iterations);
+
+    char name[64];
+    snprintf(name, sizeof(name), "%s %zux%zu blocked", typeName, M, M);
+    bench::report(name, genericNs, blockedNs);
+    snprintf(name, sizeof(name), "%s %zux%zu blocked, %zu threads", typeName, M, M, matrix::defaultThreadPool().concurrency());
+    bench::report(name, genericNs, threadedNs);
+}
+
+int main()
+{
+    bench::header("A * B: generic loop vs cache-blocked kernel");
+    run<double, 32>("double");
+    run<double, 64>("double");
+    run<double, 128>("double");
+    run<double, 256>("double");
+    run<float, 32>("float");
+    run<float, 64>("float");
+    run<float, 128>("float");
+    run<float, 256>("float");
+    return 0;
+}
@@ -0,0 +1,99 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file BenchLayout.cpp
+//!
+//! Compares products of column-major operands (e.g. matrices shared with a
+//! column-major library) converted to row-major at the boundary against the
+//! same products computed directly in the operands' own layouts.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+
+#include "Benchmark.hpp"
+#include "../src/Matrix.hpp"
+
+template<size_t M, size_t N>
+using ColMatrix = matrix::Matrix<double, M, N, matrix::DefaultBounds, matrix::ColumnMajor>;
+
+template<class Mat>
+void fill(Mat &m)
+{
+    for(size_t i = 0; i < Mat::rows; ++i)
+    {
+        for(size_t j = 0; j < Mat::cols; ++j)
+        {
+            m(i,j) = static_cast<double>(rand()) / RAND_MAX - 0.5;
+        }
+    }
+}
+
+template<size_t M, size_t N, size_t P>
+void runColumnProduct(const char *name, size_t iterations)
+{
+    ColMatrix<M, N> A;
+    ColMatrix<N, P> B;
+    ColMatrix<M, P> out;
+    fill(A);
+    fill(B);
+
+    // Convert both operands to row-major, multiply and convert the result back
+    double convertNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        out = matrix::Matrix<double, M, N>(A) * matrix::Matrix<double, N, P>(B);
+        bench::doNotOptimize(out);
+    }, iterations);
+
+    double directNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        out = A * B;
+        bench::doNotOptimize(out);
+    }, iterations);
+
+    bench::report(name, convertNs, directNs);
+}
+
+template<size_t M, size_t N, size_t P>
+void runMixedProduct(const char *name, size_t iterations)
+{
+    matrix::Matrix<double, M, N> A;
+    ColMatrix<N, P> B;
+    matrix::Matrix<double, M, P> out;
+    fill(A);
+    fill(B);
+
+    double convertNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        out = A * matrix::Matrix<double, N, P>(B);
+        bench::doNotOptimize(out);
+    }, iterations);
+
+    double directNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        out = A * B;
+        bench::doNotOptimize(out);
+    }, iterations);
+
+    bench::report(name, convertNs, directNs);
+}
+
+int main()
+{
+    bench::header("ColumnMajor * ColumnMajor: convert to row-major vs direct");
+    runColumnProduct<3, 3, 3>("3x3 * 3x3", 10000000);
+    runColumnProduct<6, 6, 6>("6x6 * 6x6", 2000000);
+    runColumnProduct<12, 12, 12>("12x12 * 12x12", 500000);
+    runColumnProduct<64, 64, 64>("64x64 * 64x64", 5000);
+
+    bench::header("RowMajor * ColumnMajor: convert B vs direct");
+    runMixedProduct<3, 3, 3>("3x3 * 3x3", 10000000);
+    runMixedProduct<6, 6, 6>("6x6 * 6x6", 2000000);
+    runMixedProduct<12, 12, 12>("12x12 * 12x12", 500000);
+    runMixedProduct<64, 64, 64>("64x64 * 64x64", 5000);
+    return 0;
+}
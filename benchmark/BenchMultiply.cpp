@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file BenchMultiply.cpp
+//!
+//! Compares the specialized, fully unrolled product kernels used by
+//! Matrix::operator* against the loop operator* used before them, which
+//! accumulated into the result through the bounds-checked operator().
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+
+#include "Benchmark.hpp"
+#include "../src/Matrix.hpp"
+
+template<size_t M, size_t N>
+void fill(matrix::Matrix<double, M, N> &m)
+{
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < N; ++j)
+        {
+            m(i,j) = static_cast<double>(rand()) / RAND_MAX - 0.5;
+        }
+    }
+}
+
+//! The original Matrix::operator*, copied here as the baseline
+template<size_t M, size_t N, size_t P>
+matrix::Matrix<double, M, P> baselineMultiply(const matrix::Matrix<double, M, N> &self, const matrix::Matrix<double, N, P> &other)
+{
+    matrix::Matrix<double, M, P> result;
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < P; ++j)
+        {
+            for(size_t k = 0; k < N; ++k)
+            {
+                result(i,j) += self(i,k) * other(k,j);
+            }
+        }
+    }
+    return result;
+}
+
+template<size_t M, size_t N, size_t P>
+void run(const char *name, size_t iterations)
+{
+    matrix::Matrix<double, M, N> A;
+    matrix::Matrix<double, N, P> B;
+    matrix::Matrix<double, M, P> out;
+    fill(A);
+    fill(B);
+
+    double baselineNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        out = baselineMultiply(A, B);
+        bench::doNotOptimize(out);
+    }, iterations);
+
+    double kernelNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        out = A * B;
+        bench::doNotOptimize(out);
+    }, iterations);
+
+    bench::report(name, baselineNs, kernelNs);
+}
+
+int main()
+{
+    bench::header("A * B: original checked loop vs specialized kernel");
+    run<3, 3, 3>("3x3 * 3x3", 10000000);
+    run<3, 3, 1>("3x3 * 3x1", 10000000);
+    run<4, 4, 1>("4x4 * 4x1", 10000000);
+    run<6, 6, 6>("6x6 * 6x6", 2000000);
+    run<6, 6, 1>("6x6 * 6x1", 10000000);
+    return 0;
+}
@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file BenchOrthonormalize.cpp
+//!
+//! Cost and residual of DCM re-orthonormalization. The baseline is the round
+//! trip through Quaternion; each DCM::orthonormalize() mode is timed against
+//! it for a small and a large drift. Each line also gives the residual
+//! max |R^T R - I| after one call and how far the result moved from the
+//! drifted input (smallest for polar, which finds the closest rotation).
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "Benchmark.hpp"
+#include "../src/DCM.hpp"
+
+namespace
+{
+
+//! Largest element of |R^T R - I|
+double residual(const matrix::DCM<double> &R)
+{
+    matrix::SquareMatrix<double, 3> I;
+    I.identity();
+    matrix::SquareMatrix<double, 3> E = R.transpose()*R - I;
+    double largest = 0.0;
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < 3; ++j)
+        {
+            largest = std::max(largest, std::fabs(E(i,j)));
+        }
+    }
+    return largest;
+}
+
+//! Frobenius norm of a - b
+double distance(const matrix::DCM<double> &a, const matrix::DCM<double> &b)
+{
+    double sum = 0.0;
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < 3; ++j)
+        {
+            sum += (a(i,j) - b(i,j))*(a(i,j) - b(i,j));
+        }
+    }
+    return std::sqrt(sum);
+}
+
+//! A rotation with every element perturbed by up to +/- drift
+matrix::DCM<double> drifted(double drift)
+{
+    matrix::DCM<double> R(matrix::Quaternion<double>(0.7, 0.1, -0.5, 0.3));
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < 3; ++j)
+        {
+            R(i,j) += drift*(2.0*rand()/RAND_MAX - 1.0);
+        }
+    }
+    return R;
+}
+
+} // namespace
+
+void run(double drift, size_t iterations)
+{
+    const matrix::DCM<double> start = drifted(drift);
+    matrix::DCM<double> R;
+
+    double quaternionNs = bench::timeNs([&]()
+    {
+        R = start;
+        bench::doNotOptimize(R);
+        R = matrix::DCM<double>(matrix::Quaternion<double>(R));
+        bench::doNotOptimize(R);
+    }, iterations);
+    printf("drift %.0e: quaternion round trip residual %.1e, moved %.3e\n", drift, residual(R), distance(R, start));
+
+    const char *names[3] = {"polar", "first order", "Gram-Schmidt"};
+    const matrix::Orthonormalization methods[3] = {matrix::Orthonormalization::Polar,
+                                                   matrix::Orthonormalization::FirstOrder,
+                                                   matrix::Orthonormalization::GramSchmidt};
+    for(size_t m = 0; m < 3; ++m)
+    {
+        double ns = bench::timeNs([&]()
+        {
+            R = start;
+            bench::doNotOptimize(R);
+            R.orthonormalize(methods[m]);
+            bench::doNotOptimize(R);
+        }, iterations);
+
+        bench::report(names[m], quaternionNs, ns);
+        printf("    residual %.1e, moved %.3e\n", residual(R), distance(R, start));
+    }
+}
+
+int main()
+{
+    bench::header("DCM orthonormalize vs Quaternion round trip");
+    run(1.0e-6, 2000000);
+    run(1.0e-3, 2000000);
+    return 0;
+}
@@ -0,0 +1,119 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file BenchPadded.cpp
+//!
+//! Compares packed 3-vectors and 3x3 matrices (three elements per vector or
+//! row) against the padded, aligned layout of PaddedVector3 and PaddedMatrix3
+//! (four lanes per vector or row), both through the kernel tables on batches
+//! and one object at a time through the types.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#define MTL_ENABLE_SIMD
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "../src/DCM.hpp"
+#include "../src/MatrixStorage.hpp"
+#include "../src/PaddedMatrix3.hpp"
+
+template<class T>
+T randomValue()
+{
+    return static_cast<T>(rand()) / RAND_MAX - T(0.5);
+}
+
+template<class T>
+void runKernels(const char *typeName)
+{
+    using namespace matrix::simd;
+    const size_t count = 1024;
+    const size_t iterations = 20000;
+
+    // Packed arrays hold 3 (or 9) elements per object, padded ones 4 (or 12) with zero padding
+    std::vector<T> a(9*count), b(9*count), out(9*count);
+    std::vector<T, matrix::AlignedAllocator<T>> pa(12*count), pb(12*count), pout(12*count);
+    for(size_t i = 0; i < 12*count; ++i)
+    {
+        pa[i] = i % 4 == 3 ? T(0) : randomValue<T>();
+        pb[i] = i % 4 == 3 ? T(0) : randomValue<T>();
+    }
+    for(size_t i = 0; i < 9*count; ++i)
+    {
+        a[i] = pa[i + i/3];
+        b[i] = pb[i + i/3];
+    }
+
+    const Kernels<T> &k = kernels<T>();
+    char name[64];
+    auto compare = [&](const char *op, auto packed, auto padded)
+    {
+        double packedNs = bench::timeNs([&]() { packed(); bench::doNotOptimize(out); }, iterations);
+        double paddedNs = bench::timeNs([&]() { padded(); bench::doNotOptimize(pout); }, iterations);
+        snprintf(name, sizeof(name), "%s %s %s", typeName, isaName(detectIsa()), op);
+        bench::report(name, packedNs, paddedNs);
+    };
+
+    compare("cross",
+        [&]() { k.cross(a.data(), b.data(), out.data(), 3*count); },
+        [&]() { k.crossPadded(pa.data(), pb.data(), pout.data(), 3*count); });
+    compare("3x3 *",
+        [&]() { k.multiply3x3(a.data(), b.data(), out.data(), count); },
+        [&]() { k.multiply3x3Padded(pa.data(), pb.data(), pout.data(), count); });
+    compare("DCM rotation",
+        [&]() { k.rotate3(a.data(), b.data(), out.data(), 3*count); },
+        [&]() { k.rotate3Padded(pa.data(), pb.data(), pout.data(), 3*count); });
+}
+
+template<class T>
+void runTypes(const char *typeName)
+{
+    const size_t iterations = 10000000;
+    const matrix::DCM<T> dcm(matrix::Quaternion<T>(T(0.9), T(0.1), T(-0.3), T(0.2)).unit());
+    const matrix::Vector3<T> u(randomValue<T>(), randomValue<T>(), randomValue<T>());
+    matrix::Vector3<T> v(randomValue<T>(), randomValue<T>(), randomValue<T>());
+    matrix::SquareMatrix<T, 3> m(dcm);
+
+    const matrix::PaddedMatrix3<T> pdcm(dcm);
+    const matrix::PaddedVector3<T> pu(u);
+    matrix::PaddedVector3<T> pv(v);
+    matrix::PaddedMatrix3<T> pm(m);
+
+    char name[64];
+    auto compare = [&](const char *op, auto packed, auto padded)
+    {
+        double packedNs = bench::timeNs(packed, iterations);
+        double paddedNs = bench::timeNs(padded, iterations);
+        snprintf(name, sizeof(name), "%s %s", typeName, op);
+        bench::report(name, packedNs, paddedNs);
+    };
+
+    compare("v += u*s",
+        [&]() { bench::doNotOptimize(v); v += u*T(0.5); bench::doNotOptimize(v); },
+        [&]() { bench::doNotOptimize(pv); pv += pu*T(0.5); bench::doNotOptimize(pv); });
+    compare("v.cross(u)",
+        [&]() { bench::doNotOptimize(v); v = v.cross(u); bench::doNotOptimize(v); },
+        [&]() { bench::doNotOptimize(pv); pv = pv.cross(pu); bench::doNotOptimize(pv); });
+    compare("DCM * v",
+        [&]() { bench::doNotOptimize(v); v = dcm*v; bench::doNotOptimize(v); },
+        [&]() { bench::doNotOptimize(pv); pv = pdcm*pv; bench::doNotOptimize(pv); });
+    compare("M *= DCM",
+        [&]() { bench::doNotOptimize(m); m *= dcm; bench::doNotOptimize(m); },
+        [&]() { bench::doNotOptimize(pm); pm *= pdcm; bench::doNotOptimize(pm); });
+}
+
+int main()
+{
+    bench::header("1024-object batches: packed vs padded kernels");
+    runKernels<float>("float");
+    runKernels<double>("double");
+
+    bench::header("One object at a time: packed vs padded types");
+    runTypes<float>("float");
+    runTypes<double>("double");
+    return 0;
+}
@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file BenchQR.cpp
+//!
+//! Least-squares benchmarks for HouseholderQR: normal equations against a QR
+//! solve, the unblocked against the compact WY factorization of tall
+//! matrices, and refactoring against appending one new observation.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "Benchmark.hpp"
+#include "../src/HouseholderQR.hpp"
+
+template<size_t M, size_t N>
+void fill(matrix::Matrix<double, M, N> &m)
+{
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < N; ++j)
+        {
+            m(i,j) = static_cast<double>(rand()) / RAND_MAX - 0.5;
+        }
+    }
+}
+
+template<size_t M, size_t N>
+void runNormalEquations(size_t iterations)
+{
+    matrix::Matrix<double, M, N> A;
+    matrix::Vector<double, M> b;
+    fill(A);
+    fill(b);
+
+    matrix::Matrix<double, N, 1> x;
+    double normalNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        matrix::Matrix<double, N, M> At = A.transpose();
+        matrix::SquareMatrix<double, N> AtA = At*A;
+        x = matrix::inverse<double>(AtA)*(At*b);
+        bench::doNotOptimize(x);
+    }, iterations);
+
+    double qrNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        x = matrix::HouseholderQR<double, M, N>(A).solve(b);
+        bench::doNotOptimize(x);
+    }, iterations);
+
+    char name[64];
+    snprintf(name, sizeof(name), "%zux%zu least squares", M, N);
+    bench::report(name, normalNs, qrNs);
+}
+
+template<size_t M, size_t N>
+void runBlocked(size_t iterations)
+{
+    matrix::Matrix<double, M, N> A;
+    fill(A);
+    matrix::HouseholderQR<double, M, N> qr;
+
+    double unblockedNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        qr.compute(A);
+        bench::doNotOptimize(qr);
+    }, iterations);
+
+    double blockedNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        qr.computeBlocked(A);
+        bench::doNotOptimize(qr);
+    }, iterations);
+
+    char name[64];
+    snprintf(name, sizeof(name), "%zux%zu factor", M, N);
+    bench::report(name, unblockedNs, blockedNs);
+}
+
+template<size_t M, size_t N>
+void runAppend(size_t iterations)
+{
+    matrix::Matrix<double, M, N> A;
+    matrix::Vector<double, M> b;
+    matrix::Matrix<double, 1, N> row;
+    fill(A);
+    fill(b);
+    fill(row);
+    matrix::HouseholderQR<double, M, N> qr;
+    matrix::Vector<double, N> x;
+
+    // A new sample arrives: refactor every row, or rotate the sample into R
+    double refactorNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        qr.compute(A, b);
+        x = qr.solve();
+        bench::doNotOptimize(x);
+    }, iterations);
+
+    qr.compute(A, b);
+    double appendNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(row);
+        qr.appendRow(row, 0.1);
+        x = qr.solve();
+        bench::doNotOptimize(x);
+    }, iterations);
+
+    char name[64];
+    snprintf(name, sizeof(name), "%zux%zu new sample", M, N);
+    bench::report(name, refactorNs, appendNs);
+}
+
+int main()
+{
+    bench::header("Normal equations vs HouseholderQR solve");
+    runNormalEquations<100, 9>(100000);
+    runNormalEquations<200, 12>(30000);
+
+    bench::header("Unblocked vs compact WY factorization");
+    runBlocked<500, 32>(2000);
+    runBlocked<2000, 32>(300);
+    runBlocked<1000, 64>(100);
+
+    bench::header("Refactor vs appendRow for one new sample");
+    runAppend<100, 9>(100000);
+    runAppend<400, 12>(10000);
+    return 0;
+}
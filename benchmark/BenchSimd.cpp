@@ -0,0 +1,163 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file BenchSimd.cpp
+//!
+//! Compares each SIMD kernel table supported by the host against the scalar
+//! kernels on batches of contiguous objects, and a call through the kernel
+//! table per object against the inline scalar code for single objects.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "../src/MatrixStorage.hpp"
+#include "../src/MultiplyKernel.hpp"
+#include "../src/SimdKernel.hpp"
+
+template<class T>
+void run(const char *typeName, matrix::simd::Isa isa)
+{
+    using namespace matrix::simd;
+    const size_t count = 1024;
+    const size_t iterations = 20000;
+    std::vector<T> a(16*count), b(16*count), out(16*count);
+    for(size_t i = 0; i < a.size(); ++i)
+    {
+        a[i] = static_cast<T>(rand()) / RAND_MAX - T(0.5);
+        b[i] = static_cast<T>(rand()) / RAND_MAX - T(0.5);
+    }
+
+    const Kernels<T> &ref = kernels<T>(Isa::Scalar);
+    const Kernels<T> &k = kernels<T>(isa);
+    char name[64];
+    T sink = 0;
+
+    auto compare = [&](const char *op, auto call)
+    {
+        double scalarNs = bench::timeNs([&]() { call(ref); bench::doNotOptimize(out); }, iterations);
+        double simdNs = bench::timeNs([&]() { call(k); bench::doNotOptimize(out); }, iterations);
+        snprintf(name, sizeof(name), "%s %s %s", typeName, isaName(isa), op);
+        bench::report(name, scalarNs, simdNs);
+    };
+
+    compare("add", [&](const Kernels<T> &t) { t.add(a.data(), b.data(), out.data(), 4*count); });
+    compare("scale", [&](const Kernels<T> &t) { t.scale(a.data(), T(0.5), out.data(), 4*count); });
+    compare("dot", [&](const Kernels<T> &t) { sink += t.dot(a.data(), b.data(), 4*count); });
+    compare("cross", [&](const Kernels<T> &t) { t.cross(a.data(), b.data(), out.data(), count); });
+    compare("quaternion *", [&](const Kernels<T> &t) { t.quaternionMultiply(a.data(), b.data(), out.data(), count); });
+    compare("3x3 *", [&](const Kernels<T> &t) { t.multiply3x3(a.data(), b.data(), out.data(), count); });
+    compare("4x4 *", [&](const Kernels<T> &t) { t.multiply4x4(a.data(), b.data(), out.data(), count); });
+    compare("DCM rotation", [&](const Kernels<T> &t) { t.rotate3(a.data(), b.data(), out.data(), count); });
+    bench::doNotOptimize(sink);
+}
+
+//! One object per call, as Vector3, Quaternion and the 3x3/4x4 products would make
+template<class T>
+void runSingle(const char *typeName)
+{
+    using namespace matrix::simd;
+    const size_t count = 1024;
+    const size_t iterations = 20000;
+    std::vector<T, matrix::AlignedAllocator<T>> a(16*count), b(16*count), out(16*count);
+    for(size_t i = 0; i < a.size(); ++i)
+    {
+        a[i] = static_cast<T>(rand()) / RAND_MAX - T(0.5);
+        b[i] = static_cast<T>(rand()) / RAND_MAX - T(0.5);
+    }
+    for(size_t i = 3; i < a.size(); i += 4)
+    {
+        a[i] = T(0);
+        b[i] = T(0);
+    }
+
+    const Kernels<T> &k = kernels<T>();
+    char name[64];
+
+    // Each object sits 16 elements from the last, so every call stays a single object
+    auto compare = [&](const char *op, auto inlineCall, auto tableCall)
+    {
+        double inlineNs = bench::timeNs([&]()
+        {
+            for(size_t i = 0; i < count; ++i)
+            {
+                inlineCall(a.data() + 16*i, b.data() + 16*i, out.data() + 16*i);
+            }
+            bench::doNotOptimize(out);
+        }, iterations);
+        double tableNs = bench::timeNs([&]()
+        {
+            for(size_t i = 0; i < count; ++i)
+            {
+                tableCall(k, a.data() + 16*i, b.data() + 16*i, out.data() + 16*i);
+            }
+            bench::doNotOptimize(out);
+        }, iterations);
+        snprintf(name, sizeof(name), "%s %s single %s", typeName, isaName(detectIsa()), op);
+        bench::report(name, inlineNs, tableNs);
+    };
+
+    compare("3-vector dot",
+        [](const T *x, const T *y, T *z) { z[0] = Scalar::dot(x, y, 3); },
+        [](const Kernels<T> &t, const T *x, const T *y, T *z) { z[0] = t.dot(x, y, 3); });
+    compare("16-vector dot",
+        [](const T *x, const T *y, T *z) { z[0] = Scalar::dot(x, y, 16); },
+        [](const Kernels<T> &t, const T *x, const T *y, T *z) { z[0] = t.dot(x, y, 16); });
+    compare("cross",
+        [](const T *x, const T *y, T *z) { Scalar::cross(x, y, z, 1); },
+        [](const Kernels<T> &t, const T *x, const T *y, T *z) { t.cross(x, y, z, 1); });
+    compare("quaternion *",
+        [](const T *x, const T *y, T *z) { Scalar::quaternionMultiply(x, y, z, 1); },
+        [](const Kernels<T> &t, const T *x, const T *y, T *z) { t.quaternionMultiply(x, y, z, 1); });
+    compare("3x3 *",
+        [](const T *x, const T *y, T *z) { matrix::detail::MultiplyKernel<T, 3, 3, 3>::apply(x, y, z); },
+        [](const Kernels<T> &t, const T *x, const T *y, T *z) { t.multiply3x3(x, y, z, 1); });
+    compare("4x4 *",
+        [](const T *x, const T *y, T *z) { matrix::detail::MultiplyKernel<T, 4, 4, 4>::apply(x, y, z); },
+        [](const Kernels<T> &t, const T *x, const T *y, T *z) { t.multiply4x4(x, y, z, 1); });
+    compare("DCM rotation",
+        [](const T *x, const T *y, T *z) { matrix::detail::MultiplyKernel<T, 3, 3, 1>::apply(x, y, z); },
+        [](const Kernels<T> &t, const T *x, const T *y, T *z) { t.rotate3(x, y, z, 1); });
+    compare("padded cross",
+        [](const T *x, const T *y, T *z) { Scalar::crossPadded(x, y, z, 1); },
+        [](const Kernels<T> &t, const T *x, const T *y, T *z) { t.crossPadded(x, y, z, 1); });
+    compare("padded 3x3 *",
+        [](const T *x, const T *y, T *z)
+        {
+            // The inline loop of PaddedMatrix3::operator*
+            for(size_t i = 0; i < 3; ++i)
+            {
+                for(size_t j = 0; j < 3; ++j)
+                {
+                    z[4*i+j] = T(0) + x[4*i]*y[j] + x[4*i+1]*y[4+j] + x[4*i+2]*y[8+j];
+                }
+                z[4*i+3] = T(0);
+            }
+        },
+        [](const Kernels<T> &t, const T *x, const T *y, T *z) { t.multiply3x3Padded(x, y, z, 1); });
+    compare("padded rotation",
+        [](const T *x, const T *y, T *z) { Scalar::rotate3Padded(x, y, z, 1); },
+        [](const Kernels<T> &t, const T *x, const T *y, T *z) { t.rotate3Padded(x, y, z, 1); });
+}
+
+int main()
+{
+    using matrix::simd::Isa;
+    bench::header("1024-object batches: scalar vs SIMD kernels");
+    for(Isa isa : {Isa::SSE2, Isa::AVX2, Isa::AVX512})
+    {
+        if(matrix::simd::isSupported(isa))
+        {
+            run<float>("float", isa);
+            run<double>("double", isa);
+        }
+    }
+
+    bench::header("Single objects: inline scalar code vs one kernel table call each");
+    runSingle<float>("float");
+    runSingle<double>("double");
+    return 0;
+}
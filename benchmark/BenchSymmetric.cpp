@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file BenchSymmetric.cpp
+//!
+//! Covariance kernels on a packed SymmetricMatrix against the same work on
+//! SquareMatrix: the propagation F P F^T + Q (dense: both halves, then a
+//! re-symmetrizing pass) and the rank-K downdate P - K S K^T written as
+//! P - (K L)(K L)^T (dense: the full outer product).
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "Benchmark.hpp"
+#include "../src/SymmetricMatrix.hpp"
+
+template<size_t M, size_t N>
+void fill(matrix::Matrix<double, M, N> &m)
+{
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < N; ++j)
+        {
+            m(i,j) = static_cast<double>(rand()) / RAND_MAX - 0.5;
+        }
+    }
+}
+
+template<size_t M, size_t K>
+void run(size_t iterations)
+{
+    matrix::SquareMatrix<double, M> F;
+    matrix::SquareMatrix<double, M> G;
+    matrix::Matrix<double, M, K> W;
+    fill(F);
+    fill(G);
+    fill(W);
+    const matrix::SquareMatrix<double, M> P = G*G.transpose();
+    matrix::SquareMatrix<double, M> Q;
+    Q.identity();
+    const matrix::SymmetricMatrix<double, M> Ps(P);
+    const matrix::SymmetricMatrix<double, M> Qs(Q);
+
+    char name[64];
+    snprintf(name, sizeof(name), "%zux%zu, memory [bytes] %zu vs", M, M, sizeof(P));
+    printf("%s %zu\n", name, sizeof(Ps));
+
+    matrix::SquareMatrix<double, M> dense;
+    double denseNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(F);
+        dense = F*P*F.transpose() + Q;
+        for(size_t i = 0; i < M; ++i)
+        {
+            for(size_t j = i + 1; j < M; ++j)
+            {
+                dense(i,j) = dense(j,i) = (dense(i,j) + dense(j,i)) / 2;
+            }
+        }
+        bench::doNotOptimize(dense);
+    }, iterations);
+    matrix::SymmetricMatrix<double, M> packed;
+    double packedNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(F);
+        packed = matrix::congruence(F, Ps) + Qs;
+        bench::doNotOptimize(packed);
+    }, iterations);
+    snprintf(name, sizeof(name), "%zux%zu, F P F^T + Q", M, M);
+    bench::report(name, denseNs, packedNs);
+
+    denseNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(W);
+        dense = P - W*W.transpose();
+        bench::doNotOptimize(dense);
+    }, iterations);
+    packedNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(W);
+        packed = Ps;
+        packed.rankUpdate(W, -1.0);
+        bench::doNotOptimize(packed);
+    }, iterations);
+    snprintf(name, sizeof(name), "%zux%zu, P - W W^T, rank %zu", M, M, K);
+    bench::report(name, denseNs, packedNs);
+}
+
+int main()
+{
+    bench::header("Packed SymmetricMatrix vs dense SquareMatrix covariance kernels");
+    run<6, 3>(2000000);
+    run<15, 6>(200000);
+    run<30, 6>(30000);
+    return 0;
+}
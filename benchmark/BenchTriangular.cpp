@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file BenchTriangular.cpp
+//!
+//! Packed LowerTriangular against the same factor held in a SquareMatrix:
+//! triangle times dense and dense times triangle against the dense product,
+//! and a multi-column forward substitution against LUFactorization of the
+//! dense factor (the usual way to solve with it before).
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "Benchmark.hpp"
+#include "../src/LUFactorization.hpp"
+#include "../src/TriangularMatrix.hpp"
+
+template<size_t M, size_t N>
+void fill(matrix::Matrix<double, M, N> &m)
+{
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < N; ++j)
+        {
+            m(i,j) = static_cast<double>(rand()) / RAND_MAX - 0.5;
+        }
+    }
+}
+
+template<size_t M>
+void run(size_t iterations)
+{
+    matrix::SquareMatrix<double, M> A;
+    matrix::SquareMatrix<double, M> B;
+    fill(A);
+    fill(B);
+    for(size_t i = 0; i < M; ++i)
+    {
+        A(i,i) += 2.0;
+    }
+    const matrix::LowerTriangular<double, M> L(A);
+    const matrix::SquareMatrix<double, M> dense = L.toSquareMatrix();
+    matrix::Matrix<double, M, M> C;
+
+    char name[64];
+    snprintf(name, sizeof(name), "%zux%zu, memory [bytes] %zu vs", M, M, sizeof(dense));
+    printf("%s %zu\n", name, sizeof(L));
+
+    double denseNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(B);
+        C = dense*B;
+        bench::doNotOptimize(C);
+    }, iterations);
+    double packedNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(B);
+        C = L*B;
+        bench::doNotOptimize(C);
+    }, iterations);
+    snprintf(name, sizeof(name), "%zux%zu, L*B", M, M);
+    bench::report(name, denseNs, packedNs);
+
+    denseNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(B);
+        C = B*dense;
+        bench::doNotOptimize(C);
+    }, iterations);
+    packedNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(B);
+        C = B*L;
+        bench::doNotOptimize(C);
+    }, iterations);
+    snprintf(name, sizeof(name), "%zux%zu, B*L", M, M);
+    bench::report(name, denseNs, packedNs);
+
+    denseNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(B);
+        C = matrix::LUFactorization<double, M>(dense).solve(B);
+        bench::doNotOptimize(C);
+    }, iterations);
+    packedNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(B);
+        C = L.solve(B);
+        bench::doNotOptimize(C);
+    }, iterations);
+    snprintf(name, sizeof(name), "%zux%zu, solve L X = B", M, M);
+    bench::report(name, denseNs, packedNs);
+}
+
+int main()
+{
+    bench::header("Packed LowerTriangular vs dense SquareMatrix");
+    run<6>(2000000);
+    run<15>(200000);
+    run<30>(30000);
+    return 0;
+}
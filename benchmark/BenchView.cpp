@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file BenchView.cpp
+//!
+//! Compares products and updates that go through copies (transpose(),
+//! submatrix()) against the same work done in place through views.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+
+#include "Benchmark.hpp"
+#include "../src/Matrix.hpp"
+
+template<size_t M, size_t N>
+void fill(matrix::Matrix<double, M, N> &m)
+{
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < N; ++j)
+        {
+            m(i,j) = static_cast<double>(rand()) / RAND_MAX - 0.5;
+        }
+    }
+}
+
+template<size_t M, size_t N, size_t P>
+void runTransposeProduct(const char *name, size_t iterations)
+{
+    matrix::Matrix<double, N, M> A;
+    matrix::Matrix<double, N, P> B;
+    matrix::Matrix<double, M, P> out;
+    fill(A);
+    fill(B);
+
+    double copyNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        out = A.transpose() * B;
+        bench::doNotOptimize(out);
+    }, iterations);
+
+    double viewNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(A);
+        out = A.transposed() * B;
+        bench::doNotOptimize(out);
+    }, iterations);
+
+    bench::report(name, copyNs, viewNs);
+}
+
+template<size_t S, size_t B>
+void runBlockUpdate(const char *name, size_t iterations)
+{
+    matrix::Matrix<double, S, S> P;
+    matrix::Matrix<double, B, B> F;
+    matrix::Matrix<double, B, B> Q;
+    fill(P);
+    fill(F);
+    fill(Q);
+
+    // Copy the block out, update it and write it back element by element
+    double copyNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(P);
+        matrix::Matrix<double, B, B> block;
+        for(size_t i = 0; i < B; ++i)
+        {
+            for(size_t j = 0; j < B; ++j)
+            {
+                block(i,j) = P(S-B+i, S-B+j);
+            }
+        }
+        block += F * Q;
+        for(size_t i = 0; i < B; ++i)
+        {
+            for(size_t j = 0; j < B; ++j)
+            {
+                P(S-B+i, S-B+j) = block(i,j);
+            }
+        }
+        bench::doNotOptimize(P);
+    }, iterations);
+
+    double viewNs = bench::timeNs([&]()
+    {
+        bench::doNotOptimize(P);
+        P.template block<B, B>(S-B, S-B) += F * Q;
+        bench::doNotOptimize(P);
+    }, iterations);
+
+    bench::report(name, copyNs, viewNs);
+}
+
+int main()
+{
+    bench::header("A^T * B: transpose() copy vs transposed() view");
+    runTransposeProduct<3, 3, 3>("3x3^T * 3x3", 10000000);
+    runTransposeProduct<6, 6, 6>("6x6^T * 6x6", 2000000);
+    runTransposeProduct<12, 12, 12>("12x12^T * 12x12", 500000);
+    runTransposeProduct<64, 64, 64>("64x64^T * 64x64", 5000);
+
+    bench::header("P.block += F * Q: copy out and back vs block view");
+    runBlockUpdate<6, 3>("6x6, 3x3 block", 10000000);
+    runBlockUpdate<12, 3>("12x12, 3x3 block", 10000000);
+    runBlockUpdate<12, 6>("12x12, 6x6 block", 2000000);
+    return 0;
+}
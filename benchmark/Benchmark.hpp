@@ -0,0 +1,60 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file Benchmark.hpp
+//!
+//! Minimal timing helpers shared by the benchmark executables
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _BENCHMARK_HPP__
+#define _BENCHMARK_HPP__
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+namespace bench
+{
+
+//! Keep the optimizer from discarding or hoisting a value
+template<class T>
+inline void doNotOptimize(T &value)
+{
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+//! Return the average time of one call to fn in nanoseconds
+template<class Fn>
+double timeNs(Fn &&fn, size_t iterations)
+{
+    // Warm up caches and branch predictors before timing
+    for(size_t i = 0; i < iterations / 10 + 1; ++i)
+    {
+        fn();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < iterations; ++i)
+    {
+        fn();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(iterations);
+}
+
+//! Print the table header
+inline void header(const char *title)
+{
+    printf("\n%s\n", title);
+    printf("%-32s %14s %14s %10s\n", "case", "baseline [ns]", "new [ns]", "speedup");
+}
+
+//! Print one baseline/new comparison
+inline void report(const char *name, double baselineNs, double newNs)
+{
+    printf("%-32s %14.2f %14.2f %9.2fx\n", name, baselineNs, newNs, baselineNs / newNs);
+}
+
+} // namespace bench
+
+#endif // _BENCHMARK_HPP__
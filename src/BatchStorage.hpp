@@ -0,0 +1,158 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file BatchStorage.hpp
+//!
+//! Structure-of-arrays storage shared by the batch types. Each of the K
+//! components of every element lives in its own contiguous array, so the
+//! same component of neighboring elements fills a SIMD register directly.
+//!
+//! Every component array is padded with zeros to a whole number of blocks and
+//! the batch operations always process whole blocks. Each block is a loop of
+//! fixed length with no dependence between lanes, which the compiler
+//! vectorizes at -O2 without a scalar remainder loop. The padding lanes are
+//! computed along with the rest but never read back. Every operation keeps
+//! them zero: products of zeros are zero, and normalizing divides the padding
+//! by a norm of one instead of its zero norm.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _BATCH_STORAGE_HPP__
+#define _BATCH_STORAGE_HPP__
+
+#include <cstddef>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+#include "BoundsPolicy.hpp"
+
+//! Lanes of a batch block never depend on each other
+#if defined(__GNUC__) && !defined(__clang__)
+#define MTL_BATCH_IVDEP _Pragma("GCC ivdep")
+#else
+#define MTL_BATCH_IVDEP
+#endif
+
+namespace matrix
+{
+
+namespace detail
+{
+
+//! Report batches whose sizes do not match for an element-wise operation
+[[noreturn]] inline void throwBatchSizeMismatch(const char *operation, size_t sizeA, size_t sizeB)
+{
+    char message[128];
+    snprintf(message, 128, "ERROR: Batch sizes do not agree for %s. Left %lu, Right %lu\n",
+        operation, sizeA, sizeB);
+    throw std::domain_error(message);
+}
+
+} // namespace detail
+
+template<class T, size_t K>
+class BatchStorage
+{
+public:
+    //! Component arrays are padded to a multiple of this many elements
+    static constexpr size_t block = 16;
+
+    //! Default constructor (empty batch)
+    BatchStorage();
+
+    //! Construct a batch of n zero elements
+    explicit BatchStorage(size_t n);
+
+    //! Number of elements
+    inline size_t size() const { return count; }
+
+    //! Number of elements including the padding of the last block
+    inline size_t paddedSize() const { return padded; }
+
+    //! Change the number of elements (existing elements are kept, new ones are zero)
+    void resize(size_t n);
+
+    //! Contiguous array of component k for every element
+    inline T *component(size_t k) { return data.data() + k*padded; }
+    inline const T *component(size_t k) const { return data.data() + k*padded; }
+
+protected:
+    //! Check an element index against the batch size
+    inline void checkIndex(size_t i) const { DefaultBounds::check(i, 0, count, 1); }
+
+    //! Check that another batch has as many elements as this one
+    inline void checkSize(const char *operation, size_t n) const
+    {
+        if(n != count)
+        {
+            detail::throwBatchSizeMismatch(operation, count, n);
+        }
+    }
+
+    //! Give the padding lanes among the m norms starting at element c a norm of one
+    inline void unitPaddingNorms(T *norm, size_t c, size_t m) const
+    {
+        for(size_t i = count > c ? count - c : 0; i < m; ++i)
+        {
+            norm[i] = T(1);
+        }
+    }
+
+    size_t count;
+    size_t padded;
+    std::vector<T> data;
+};
+
+//! Default constructor (empty batch)
+template<class T, size_t K>
+BatchStorage<T,K>::BatchStorage():
+    count(0),
+    padded(0)
+{
+}
+
+//! Construct a batch of n zero elements
+template<class T, size_t K>
+BatchStorage<T,K>::BatchStorage(size_t n):
+    count(n),
+    padded((n + block - 1) / block * block),
+    data(K*padded, T(0))
+{
+}
+
+//! Change the number of elements (existing elements are kept, new ones are zero)
+template<class T, size_t K>
+void BatchStorage<T,K>::resize(size_t n)
+{
+    const size_t newPadded = (n + block - 1) / block * block;
+    if(newPadded != padded)
+    {
+        std::vector<T> resized(K*newPadded, T(0));
+        const size_t kept = n < count ? n : count;
+        for(size_t k = 0; k < K; ++k)
+        {
+            for(size_t i = 0; i < kept; ++i)
+            {
+                resized[k*newPadded + i] = data[k*padded + i];
+            }
+        }
+        data.swap(resized);
+        padded = newPadded;
+    }
+    else
+    {
+        // Padding lanes may hold results of earlier operations
+        for(size_t k = 0; k < K; ++k)
+        {
+            for(size_t i = count; i < n; ++i)
+            {
+                data[k*padded + i] = T(0);
+            }
+        }
+    }
+    count = n;
+}
+
+} // namespace matrix
+
+#endif // _BATCH_STORAGE_HPP__
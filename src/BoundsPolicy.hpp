@@ -0,0 +1,100 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file BoundsPolicy.hpp
+//!
+//! Element access bounds-check policies for Matrix. The policy only governs
+//! the user-facing element accessors; the library's own kernels index the
+//! underlying storage directly and never pay for the check.
+//!
+//! CheckedBounds   - always check and throw std::domain_error (default)
+//! DebugBounds     - check unless NDEBUG is defined (checks vanish in release)
+//! UncheckedBounds - never check
+//!
+//! Each policy's enabled constant tells whether it checks in this build.
+//!
+//! The policy used by SquareMatrix, Vector, Vector3, Quaternion and DCM can be
+//! changed for a whole build by defining MTL_DEFAULT_BOUNDS_POLICY, e.g.
+//! -DMTL_DEFAULT_BOUNDS_POLICY=matrix::DebugBounds
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _BOUNDS_POLICY_HPP__
+#define _BOUNDS_POLICY_HPP__
+
+#include <cstddef>
+#include <cstdio>
+#include <stdexcept>
+
+namespace matrix
+{
+
+namespace detail
+{
+
+//! Report an out of range element access (kept out of the accessors' fast path)
+[[noreturn]] inline void throwIndexOutOfRange(size_t i, size_t j, size_t M, size_t N)
+{
+    char message[110];
+    snprintf(message, 110,
+        "ERROR: Matrix index access out of range. Size [%ld, %ld], Received [%ld, %ld]\n", M, N, i, j);
+    throw std::domain_error(message);
+}
+
+} // namespace detail
+
+//! Always check element indices
+struct CheckedBounds
+{
+    //! Whether out of range indices throw
+    static constexpr bool enabled = true;
+
+    static constexpr void check(size_t i, size_t j, size_t M, size_t N)
+    {
+        if(i >= M || j >= N)
+        {
+            detail::throwIndexOutOfRange(i, j, M, N);
+        }
+    }
+};
+
+//! Check element indices in debug builds only
+struct DebugBounds
+{
+    //! Whether out of range indices throw
+#ifndef NDEBUG
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+
+    static constexpr void check(size_t i, size_t j, size_t M, size_t N)
+    {
+#ifndef NDEBUG
+        CheckedBounds::check(i, j, M, N);
+#else
+        (void)i; (void)j; (void)M; (void)N;
+#endif
+    }
+};
+
+//! Never check element indices
+struct UncheckedBounds
+{
+    //! Whether out of range indices throw
+    static constexpr bool enabled = false;
+
+    static constexpr void check(size_t, size_t, size_t, size_t)
+    {
+    }
+};
+
+#ifndef MTL_DEFAULT_BOUNDS_POLICY
+#define MTL_DEFAULT_BOUNDS_POLICY CheckedBounds
+#endif
+
+//! Policy used when a Matrix does not name one explicitly
+using DefaultBounds = MTL_DEFAULT_BOUNDS_POLICY;
+
+} // namespace matrix
+
+#endif // _BOUNDS_POLICY_HPP__
@@ -0,0 +1,543 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file Cholesky.hpp
+//!
+//! Cholesky factorizations of symmetric matrices, kept as solver objects like
+//! LUFactorization:
+//!
+//!   LLT<T, M>   A = L L^T, L lower triangular (A positive definite)
+//!   LDLT<T, M>  A = L D L^T, L unit lower triangular and D diagonal, without
+//!               square roots (no pivoting, so A must not need any)
+//!
+//! Only the lower triangle of A is read. Both factorizations solve for vectors
+//! or several right-hand-side columns and give the determinant. update(v) and
+//! downdate(v) turn the factorization of A into that of A + v v^T or A - v v^T
+//! in O(M^2) rather than the O(M^3) of compute(), e.g. a covariance
+//! measurement update in a square-root filter.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _CHOLESKY_HPP__
+#define _CHOLESKY_HPP__
+
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+#include "Matrix.hpp"
+#include "SquareMatrix.hpp"
+#include "Vector.hpp"
+
+namespace matrix
+{
+
+namespace detail
+{
+
+//! Report a factorization that cannot be used to solve
+[[noreturn]] inline void throwNotFactored(const char *factorization, const char *reason)
+{
+    char message[100];
+    snprintf(message, 100, "ERROR: %s factorization failed, matrix is %s. Cannot solve.\n", factorization, reason);
+    throw std::runtime_error(message);
+}
+
+//! Overwrite the rows of X (ldx apart, P columns) with the solution of L X = X.
+//! L is lower triangular with unit diagonal when unitDiagonal is set.
+template<class T, size_t M>
+void forwardSubstitute(const T *L, T *x, size_t ldx, size_t P, bool unitDiagonal)
+{
+    for(size_t i = 0; i < M; ++i)
+    {
+        T *xi = x + i*ldx;
+        for(size_t k = 0; k < i; ++k)
+        {
+            const T l = L[i*M+k];
+            const T *xk = x + k*ldx;
+            for(size_t j = 0; j < P; ++j)
+            {
+                xi[j] -= l*xk[j];
+            }
+        }
+        if(!unitDiagonal)
+        {
+            for(size_t j = 0; j < P; ++j)
+            {
+                xi[j] /= L[i*M+i];
+            }
+        }
+    }
+}
+
+//! Overwrite the rows of X (ldx apart, P columns) with the solution of L^T X = X.
+//! L is lower triangular with unit diagonal when unitDiagonal is set.
+template<class T, size_t M>
+void backSubstituteTransposed(const T *L, T *x, size_t ldx, size_t P, bool unitDiagonal)
+{
+    // Column-oriented: once x_i is known, remove it from every earlier row using row i of L
+    for(size_t i = M; i-- > 0;)
+    {
+        T *xi = x + i*ldx;
+        if(!unitDiagonal)
+        {
+            for(size_t j = 0; j < P; ++j)
+            {
+                xi[j] /= L[i*M+i];
+            }
+        }
+        for(size_t k = 0; k < i; ++k)
+        {
+            const T l = L[i*M+k];
+            T *xk = x + k*ldx;
+            for(size_t j = 0; j < P; ++j)
+            {
+                xk[j] -= l*xi[j];
+            }
+        }
+    }
+}
+
+} // namespace detail
+
+template<class T, size_t M>
+class LLT
+{
+public:
+    //! Default constructor (no factorization)
+    LLT();
+
+    //! Factor A (only the lower triangle is read)
+    explicit LLT(const Matrix<T, M, M> &A);
+
+    //! Factor A, replacing the current factorization
+    void compute(const Matrix<T, M, M> &A);
+
+    //! True when A is positive definite (the factorization is usable)
+    inline bool isPositiveDefinite() const { return positiveDefinite; }
+
+    //! Solve A x = b
+    Vector<T, M> solve(const Matrix<T, M, 1> &b) const;
+
+    //! Solve A X = B for every column of B
+    template<size_t P>
+    Matrix<T, M, P> solve(const Matrix<T, M, P> &B) const;
+
+    //! Determinant of A
+    T determinant() const;
+
+    //! Lower triangular factor L
+    inline const SquareMatrix<T, M> &matrixL() const { return L; }
+
+    //! Factor A + v v^T in place of A
+    void update(const Matrix<T, M, 1> &v);
+
+    //! Factor A - v v^T in place of A. Returns false, and the factorization is no
+    //! longer usable, if A - v v^T is not positive definite.
+    bool downdate(const Matrix<T, M, 1> &v);
+
+private:
+    SquareMatrix<T, M> L;
+    bool positiveDefinite;
+};
+
+template<class T, size_t M>
+class LDLT
+{
+public:
+    //! Default constructor (no factorization)
+    LDLT();
+
+    //! Factor A (only the lower triangle is read)
+    explicit LDLT(const Matrix<T, M, M> &A);
+
+    //! Factor A, replacing the current factorization
+    void compute(const Matrix<T, M, M> &A);
+
+    //! True when an element of D is zero (A is singular or needs pivoting)
+    inline bool isSingular() const { return singular; }
+
+    //! True when every element of D is positive
+    bool isPositiveDefinite() const;
+
+    //! Solve A x = b
+    Vector<T, M> solve(const Matrix<T, M, 1> &b) const;
+
+    //! Solve A X = B for every column of B
+    template<size_t P>
+    Matrix<T, M, P> solve(const Matrix<T, M, P> &B) const;
+
+    //! Determinant of A
+    T determinant() const;
+
+    //! Unit lower triangular factor L
+    SquareMatrix<T, M> matrixL() const;
+
+    //! Diagonal of D
+    Vector<T, M> vectorD() const;
+
+    //! Factor A + v v^T in place of A
+    void update(const Matrix<T, M, 1> &v);
+
+    //! Factor A - v v^T in place of A. Returns false if A - v v^T is not
+    //! positive definite (the factorization is no longer usable if it is singular).
+    bool downdate(const Matrix<T, M, 1> &v);
+
+private:
+    //! Factor A + sigma v v^T in place of A
+    void rankUpdate(const Matrix<T, M, 1> &v, T sigma);
+
+    // Unit lower triangle of L below the diagonal, D on the diagonal
+    SquareMatrix<T, M> LD;
+    bool singular;
+};
+
+//! Default constructor (no factorization)
+template<class T, size_t M>
+LLT<T,M>::LLT():
+    L(),
+    positiveDefinite(false)
+{
+}
+
+//! Factor A (only the lower triangle is read)
+template<class T, size_t M>
+LLT<T,M>::LLT(const Matrix<T, M, M> &A)
+{
+    compute(A);
+}
+
+//! Factor A, replacing the current factorization
+template<class T, size_t M>
+void LLT<T,M>::compute(const Matrix<T, M, M> &A)
+{
+    L = A;
+    positiveDefinite = true;
+    T *l = &L(0,0);
+    for(size_t j = 0; j < M; ++j)
+    {
+        // Row j of L against itself and every later row, left of column j
+        T d = l[j*M+j];
+        for(size_t k = 0; k < j; ++k)
+        {
+            d -= l[j*M+k]*l[j*M+k];
+        }
+        if(!(d > T(0)))
+        {
+            positiveDefinite = false;
+            return;
+        }
+        d = std::sqrt(d);
+        l[j*M+j] = d;
+        for(size_t i = j+1; i < M; ++i)
+        {
+            T s = l[i*M+j];
+            for(size_t k = 0; k < j; ++k)
+            {
+                s -= l[i*M+k]*l[j*M+k];
+            }
+            l[i*M+j] = s / d;
+        }
+        for(size_t k = j+1; k < M; ++k)
+        {
+            l[j*M+k] = T(0);
+        }
+    }
+}
+
+//! Solve A x = b
+template<class T, size_t M>
+Vector<T, M> LLT<T,M>::solve(const Matrix<T, M, 1> &b) const
+{
+    if(!positiveDefinite)
+    {
+        detail::throwNotFactored("LLT", "not positive definite");
+    }
+    Vector<T, M> x(b);
+    detail::forwardSubstitute<T, M>(&L(0,0), &x(0), 1, 1, false);
+    detail::backSubstituteTransposed<T, M>(&L(0,0), &x(0), 1, 1, false);
+    return x;
+}
+
+//! Solve A X = B for every column of B
+template<class T, size_t M>
+template<size_t P>
+Matrix<T, M, P> LLT<T,M>::solve(const Matrix<T, M, P> &B) const
+{
+    if(!positiveDefinite)
+    {
+        detail::throwNotFactored("LLT", "not positive definite");
+    }
+    Matrix<T, M, P> X(B);
+    detail::forwardSubstitute<T, M>(&L(0,0), &X(0,0), P, P, false);
+    detail::backSubstituteTransposed<T, M>(&L(0,0), &X(0,0), P, P, false);
+    return X;
+}
+
+//! Determinant of A
+template<class T, size_t M>
+T LLT<T,M>::determinant() const
+{
+    T det = 1;
+    for(size_t i = 0; i < M; ++i)
+    {
+        det *= L(i,i);
+    }
+    return det*det;
+}
+
+//! Factor A + v v^T in place of A
+template<class T, size_t M>
+void LLT<T,M>::update(const Matrix<T, M, 1> &v)
+{
+    // Apply one Givens rotation per column to fold v into L
+    Vector<T, M> work(v);
+    T *w = &work(0);
+    T *l = &L(0,0);
+    for(size_t k = 0; k < M; ++k)
+    {
+        const T lkk = l[k*M+k];
+        const T r = std::sqrt(lkk*lkk + w[k]*w[k]);
+        const T c = r / lkk;
+        const T cinv = lkk / r;
+        const T s = w[k] / lkk;
+        l[k*M+k] = r;
+        for(size_t i = k+1; i < M; ++i)
+        {
+            l[i*M+k] = (l[i*M+k] + s*w[i])*cinv;
+            w[i] = c*w[i] - s*l[i*M+k];
+        }
+    }
+}
+
+//! Factor A - v v^T in place of A. Returns false, and the factorization is no
+//! longer usable, if A - v v^T is not positive definite.
+template<class T, size_t M>
+bool LLT<T,M>::downdate(const Matrix<T, M, 1> &v)
+{
+    // Hyperbolic rotations; a non-positive r^2 means the result is not positive definite
+    Vector<T, M> work(v);
+    T *w = &work(0);
+    T *l = &L(0,0);
+    for(size_t k = 0; k < M; ++k)
+    {
+        const T lkk = l[k*M+k];
+        const T r2 = lkk*lkk - w[k]*w[k];
+        if(!(r2 > T(0)))
+        {
+            positiveDefinite = false;
+            return false;
+        }
+        const T r = std::sqrt(r2);
+        const T c = r / lkk;
+        const T cinv = lkk / r;
+        const T s = w[k] / lkk;
+        l[k*M+k] = r;
+        for(size_t i = k+1; i < M; ++i)
+        {
+            l[i*M+k] = (l[i*M+k] - s*w[i])*cinv;
+            w[i] = c*w[i] - s*l[i*M+k];
+        }
+    }
+    return true;
+}
+
+//! Default constructor (no factorization)
+template<class T, size_t M>
+LDLT<T,M>::LDLT():
+    LD(),
+    singular(true)
+{
+}
+
+//! Factor A (only the lower triangle is read)
+template<class T, size_t M>
+LDLT<T,M>::LDLT(const Matrix<T, M, M> &A)
+{
+    compute(A);
+}
+
+//! Factor A, replacing the current factorization
+template<class T, size_t M>
+void LDLT<T,M>::compute(const Matrix<T, M, M> &A)
+{
+    LD = A;
+    singular = false;
+    T *a = &LD(0,0);
+    for(size_t j = 0; j < M; ++j)
+    {
+        // The upper triangle holds L(j,k)*D(k) for row j while it is being formed
+        T d = a[j*M+j];
+        for(size_t k = 0; k < j; ++k)
+        {
+            const T ldk = a[j*M+k]*a[k*M+k];
+            a[k*M+j] = ldk;
+            d -= ldk*a[j*M+k];
+        }
+        a[j*M+j] = d;
+        if(d == T(0))
+        {
+            singular = true;
+            return;
+        }
+        for(size_t i = j+1; i < M; ++i)
+        {
+            T s = a[i*M+j];
+            for(size_t k = 0; k < j; ++k)
+            {
+                s -= a[i*M+k]*a[k*M+j];
+            }
+            a[i*M+j] = s / d;
+        }
+    }
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = i+1; j < M; ++j)
+        {
+            a[i*M+j] = T(0);
+        }
+    }
+}
+
+//! True when every element of D is positive
+template<class T, size_t M>
+bool LDLT<T,M>::isPositiveDefinite() const
+{
+    if(singular)
+    {
+        return false;
+    }
+    for(size_t i = 0; i < M; ++i)
+    {
+        if(!(LD(i,i) > T(0)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! Solve A x = b
+template<class T, size_t M>
+Vector<T, M> LDLT<T,M>::solve(const Matrix<T, M, 1> &b) const
+{
+    if(singular)
+    {
+        detail::throwNotFactored("LDLT", "singular");
+    }
+    Vector<T, M> x(b);
+    detail::forwardSubstitute<T, M>(&LD(0,0), &x(0), 1, 1, true);
+    for(size_t i = 0; i < M; ++i)
+    {
+        x(i) /= LD(i,i);
+    }
+    detail::backSubstituteTransposed<T, M>(&LD(0,0), &x(0), 1, 1, true);
+    return x;
+}
+
+//! Solve A X = B for every column of B
+template<class T, size_t M>
+template<size_t P>
+Matrix<T, M, P> LDLT<T,M>::solve(const Matrix<T, M, P> &B) const
+{
+    if(singular)
+    {
+        detail::throwNotFactored("LDLT", "singular");
+    }
+    Matrix<T, M, P> X(B);
+    detail::forwardSubstitute<T, M>(&LD(0,0), &X(0,0), P, P, true);
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < P; ++j)
+        {
+            X(i,j) /= LD(i,i);
+        }
+    }
+    detail::backSubstituteTransposed<T, M>(&LD(0,0), &X(0,0), P, P, true);
+    return X;
+}
+
+//! Determinant of A
+template<class T, size_t M>
+T LDLT<T,M>::determinant() const
+{
+    T det = 1;
+    for(size_t i = 0; i < M; ++i)
+    {
+        det *= LD(i,i);
+    }
+    return det;
+}
+
+//! Unit lower triangular factor L
+template<class T, size_t M>
+SquareMatrix<T, M> LDLT<T,M>::matrixL() const
+{
+    SquareMatrix<T, M> L = LD;
+    for(size_t i = 0; i < M; ++i)
+    {
+        L(i,i) = T(1);
+    }
+    return L;
+}
+
+//! Diagonal of D
+template<class T, size_t M>
+Vector<T, M> LDLT<T,M>::vectorD() const
+{
+    Vector<T, M> d;
+    for(size_t i = 0; i < M; ++i)
+    {
+        d(i) = LD(i,i);
+    }
+    return d;
+}
+
+//! Factor A + v v^T in place of A
+template<class T, size_t M>
+void LDLT<T,M>::update(const Matrix<T, M, 1> &v)
+{
+    rankUpdate(v, T(1));
+}
+
+//! Factor A - v v^T in place of A. Returns false if A - v v^T is not
+//! positive definite (the factorization is no longer usable if it is singular).
+template<class T, size_t M>
+bool LDLT<T,M>::downdate(const Matrix<T, M, 1> &v)
+{
+    rankUpdate(v, T(-1));
+    return isPositiveDefinite();
+}
+
+//! Factor A + sigma v v^T in place of A
+template<class T, size_t M>
+void LDLT<T,M>::rankUpdate(const Matrix<T, M, 1> &v, T sigma)
+{
+    // Gill, Golub, Murray and Saunders (1974), method C1
+    Vector<T, M> work(v);
+    T *w = &work(0);
+    T *a = &LD(0,0);
+    T alpha = sigma;
+    for(size_t j = 0; j < M; ++j)
+    {
+        const T p = w[j];
+        const T dj = a[j*M+j];
+        const T d = dj + alpha*p*p;
+        if(d == T(0))
+        {
+            singular = true;
+            return;
+        }
+        const T beta = p*alpha / d;
+        alpha = dj*alpha / d;
+        a[j*M+j] = d;
+        for(size_t i = j+1; i < M; ++i)
+        {
+            w[i] -= p*a[i*M+j];
+            a[i*M+j] += beta*w[i];
+        }
+    }
+}
+
+} // namespace matrix
+
+#endif // _CHOLESKY_HPP__
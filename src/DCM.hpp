@@ -14,10 +14,22 @@
 #include "Quaternion.hpp"
 #include "Euler.hpp"
 #include "RotationSequence.hpp"
+#include "SVD3.hpp"
 
 namespace matrix
 {
 
+template<class T>
+class PolarDecomposition3;
+
+//! How DCM::orthonormalize() pulls a drifted DCM back to a rotation
+enum class Orthonormalization
+{
+    Polar,        // Closest rotation, from the polar decomposition
+    FirstOrder,   // R - 0.5 R (R^T R - I), error squared per call
+    GramSchmidt   // Columns in order; the first keeps its direction
+};
+
 // template<class T>
 // class Quaternion;
 
@@ -29,76 +41,106 @@ class DCM: public SquareMatrix<T, 3>
 {
 public:
     //! Default constructor
-    DCM();
+    constexpr DCM();
 
     //! Construct from a 2d array of data
-    explicit DCM(const T values[3][3]);
+    explicit constexpr DCM(const T values[3][3]);
 
     //! Construct from a flat array of data
-    explicit DCM(const T values[9]);
+    explicit constexpr DCM(const T values[9]);
+
+    //! Construct using initializer list
+    constexpr DCM(std::initializer_list<std::initializer_list<T>> list);
 
     //! Copy constructor from Matrix<T, 3, 3> type
-    DCM(const Matrix<T, 3, 3> &other);
+    constexpr DCM(const Matrix<T, 3, 3> &other);
 
     //! Copy constructor from SquareMatrix<T, 3> type
-    DCM(const SquareMatrix<T, 3> &other);
+    constexpr DCM(const SquareMatrix<T, 3> &other);
+
+    //! Construct by evaluating a matrix expression
+    template<class E, typename = std::enable_if_t<detail::IsExpressionOfShape<E, T, 3, 3>::value>>
+    constexpr DCM(const MatrixExpression<E> &expr);
 
     //! Constructor from Quaternion (Equation 1.8-18, Stevens and Lewis)
     DCM(const Quaternion<T> &q);
 
     //! Constructor from Euler Angles
     DCM(const Euler<T> &e);
+
+    //! Restore orthonormality after numerical drift
+    void orthonormalize(Orthonormalization method = Orthonormalization::Polar);
 }; // class DCM
 
+static_assert(sizeof(DCM<double>) == 9*sizeof(double), "DCM must not carry anything beyond its elements");
+static_assert(std::is_standard_layout<DCM<double>>::value, "DCM must be standard-layout");
+static_assert(std::is_trivially_copyable<DCM<double>>::value, "DCM must be trivially copyable");
+
 //! Default constructor
 template<class T>
-DCM<T>::DCM():
+constexpr DCM<T>::DCM():
     SquareMatrix<T, 3>(identity<T, 3>())
 {
 }
 
 //! Construct from a 2d array of data
 template<class T>
-DCM<T>::DCM(const T values[3][3]):
+constexpr DCM<T>::DCM(const T values[3][3]):
     SquareMatrix<T, 3>(values)
 {
 }
 
 //! Construct from a flat array of data
 template<class T>
-DCM<T>::DCM(const T values[9]):
+constexpr DCM<T>::DCM(const T values[9]):
     SquareMatrix<T, 3>(values)
 {
 }
 
+//! Construct using initializer list
+template<class T>
+constexpr DCM<T>::DCM(std::initializer_list<std::initializer_list<T>> list):
+    SquareMatrix<T, 3>(list)
+{
+}
+
 //! Copy constructor from Matrix<T, 3, 3>
 template<class T>
-DCM<T>::DCM(const Matrix<T, 3, 3> &other):
+constexpr DCM<T>::DCM(const Matrix<T, 3, 3> &other):
     SquareMatrix<T, 3>(other)
 {
 }
 
 //! Copy constructor from SquareMatrix<T, 3> type
 template<class T>
-DCM<T>::DCM(const SquareMatrix<T, 3> &other):
+constexpr DCM<T>::DCM(const SquareMatrix<T, 3> &other):
     SquareMatrix<T, 3>(other)
 {
 }
 
+//! Construct by evaluating a matrix expression
+template<class T>
+template<class E, typename>
+constexpr DCM<T>::DCM(const MatrixExpression<E> &expr):
+    SquareMatrix<T, 3>(expr)
+{
+}
+
 //! Constructor from Quaternion
 template<class T>
 DCM<T>::DCM(const Quaternion<T> &q)
 {
-    Quaternion<T> p = q.unit();
-    this->data[0] = p(0)*p(0) + p(1)*p(1) - p(2)*p(2) - p(3)*p(3);
-    this->data[1] = static_cast<T>(2)*(p(1)*p(2) - p(0)*p(3));
-    this->data[2] = static_cast<T>(2)*(p(1)*p(3) + p(0)*p(2));
-    this->data[3] = static_cast<T>(2)*(p(1)*p(2) + p(0)*p(3));
-    this->data[4] = p(0)*p(0) - p(1)*p(1) + p(2)*p(2) - p(3)*p(3);
-    this->data[5] = static_cast<T>(2)*(p(2)*p(3) - p(0)*p(1));
-    this->data[6] = static_cast<T>(2)*(p(1)*p(3) - p(0)*p(2));
-    this->data[7] = static_cast<T>(2)*(p(2)*p(3) + p(0)*p(1));
-    this->data[8] = p(0)*p(0) - p(1)*p(1) - p(2)*p(2) + p(3)*p(3);
+    const Quaternion<T> unit = q.unit();
+    const T p[4] = {unit.coeff(0), unit.coeff(1), unit.coeff(2), unit.coeff(3)};
+    this->data[0] = p[0]*p[0] + p[1]*p[1] - p[2]*p[2] - p[3]*p[3];
+    this->data[1] = static_cast<T>(2)*(p[1]*p[2] - p[0]*p[3]);
+    this->data[2] = static_cast<T>(2)*(p[1]*p[3] + p[0]*p[2]);
+    this->data[3] = static_cast<T>(2)*(p[1]*p[2] + p[0]*p[3]);
+    this->data[4] = p[0]*p[0] - p[1]*p[1] + p[2]*p[2] - p[3]*p[3];
+    this->data[5] = static_cast<T>(2)*(p[2]*p[3] - p[0]*p[1]);
+    this->data[6] = static_cast<T>(2)*(p[1]*p[3] - p[0]*p[2]);
+    this->data[7] = static_cast<T>(2)*(p[2]*p[3] + p[0]*p[1]);
+    this->data[8] = p[0]*p[0] - p[1]*p[1] - p[2]*p[2] + p[3]*p[3];
 }
 
 //! Constructor from Euler Angles
@@ -276,6 +318,74 @@ DCM<T>::DCM(const Euler<T> &e)
     }
 }
 
+//! Restore orthonormality after numerical drift
+template<class T>
+void DCM<T>::orthonormalize(Orthonormalization method)
+{
+    T *r = this->data;
+    switch(method)
+    {
+        case Orthonormalization::Polar:
+        {
+            *this = PolarDecomposition3<T>(*this).rotation();
+        } break;
+
+        case Orthonormalization::FirstOrder:
+        {
+            // E = R^T R - I is symmetric, then R <- R - 0.5 R E
+            T E[9];
+            for(size_t i = 0; i < 3; ++i)
+            {
+                for(size_t j = i; j < 3; ++j)
+                {
+                    E[i*3+j] = r[i]*r[j] + r[3+i]*r[3+j] + r[6+i]*r[6+j] - (i == j ? T(1) : T(0));
+                    E[j*3+i] = E[i*3+j];
+                }
+            }
+            T corrected[9];
+            for(size_t i = 0; i < 3; ++i)
+            {
+                for(size_t j = 0; j < 3; ++j)
+                {
+                    corrected[i*3+j] = r[i*3+j] - T(0.5)*(r[i*3]*E[j] + r[i*3+1]*E[3+j] + r[i*3+2]*E[6+j]);
+                }
+            }
+            for(size_t k = 0; k < 9; ++k)
+            {
+                r[k] = corrected[k];
+            }
+        } break;
+
+        case Orthonormalization::GramSchmidt:
+        {
+            T x[3] = {r[0], r[3], r[6]};
+            T y[3] = {r[1], r[4], r[7]};
+            const T xScale = T(1) / std::sqrt(x[0]*x[0] + x[1]*x[1] + x[2]*x[2]);
+            for(size_t i = 0; i < 3; ++i)
+            {
+                x[i] *= xScale;
+            }
+            const T xy = x[0]*y[0] + x[1]*y[1] + x[2]*y[2];
+            for(size_t i = 0; i < 3; ++i)
+            {
+                y[i] -= xy*x[i];
+            }
+            const T yScale = T(1) / std::sqrt(y[0]*y[0] + y[1]*y[1] + y[2]*y[2]);
+            for(size_t i = 0; i < 3; ++i)
+            {
+                y[i] *= yScale;
+            }
+
+            // The third column is fixed by the first two for a right-handed frame
+            r[0] = x[0]; r[3] = x[1]; r[6] = x[2];
+            r[1] = y[0]; r[4] = y[1]; r[7] = y[2];
+            r[2] = x[1]*y[2] - x[2]*y[1];
+            r[5] = x[2]*y[0] - x[0]*y[2];
+            r[8] = x[0]*y[1] - x[1]*y[0];
+        } break;
+    }
+}
+
 } // namespace matrix
 
 #endif // _DCM_HPP__
\ No newline at end of file
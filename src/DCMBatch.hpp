@@ -0,0 +1,222 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file DCMBatch.hpp
+//!
+//! Structure-of-arrays batch of direction cosine matrices (each of the nine
+//! elements in its own array). Results match DCM element for element.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _DCM_BATCH_HPP__
+#define _DCM_BATCH_HPP__
+
+#include "BatchStorage.hpp"
+#include "DCM.hpp"
+#include "QuaternionBatch.hpp"
+#include "SimdKernel.hpp"
+#include "Vector3Batch.hpp"
+
+namespace matrix
+{
+
+template<class T>
+class DCMBatch : public BatchStorage<T, 9>
+{
+public:
+    //! Default constructor (empty batch)
+    DCMBatch();
+
+    //! Construct a batch of n zero matrices
+    explicit DCMBatch(size_t n);
+
+    //! Construct from an array of n DCMs
+    DCMBatch(const DCM<T> *dcms, size_t n);
+
+    //! Construct from a batch of quaternions (Equation 1.8-18, Stevens and Lewis)
+    explicit DCMBatch(const QuaternionBatch<T> &q);
+
+    //! Replace the contents with an array of n DCMs
+    void load(const DCM<T> *dcms, size_t n);
+
+    //! Replace the contents with the DCMs of a batch of quaternions
+    void load(const QuaternionBatch<T> &q);
+
+    //! Copy every DCM out to an array of size() DCMs
+    void store(DCM<T> *dcms) const;
+
+    //! Get DCM i
+    DCM<T> operator()(size_t i) const;
+
+    //! Set DCM i
+    void set(size_t i, const DCM<T> &dcm);
+
+    //! Array holding element (row, col) of every DCM
+    inline T *element(size_t row, size_t col) { return this->component(row*3 + col); }
+    inline const T *element(size_t row, size_t col) const { return this->component(row*3 + col); }
+
+    //! Rotate every vector of v by the matching DCM (out may be v)
+    void rotate(const Vector3Batch<T> &v, Vector3Batch<T> &out) const;
+};
+
+//! Default constructor (empty batch)
+template<class T>
+DCMBatch<T>::DCMBatch():
+    BatchStorage<T, 9>()
+{
+}
+
+//! Construct a batch of n zero matrices
+template<class T>
+DCMBatch<T>::DCMBatch(size_t n):
+    BatchStorage<T, 9>(n)
+{
+}
+
+//! Construct from an array of n DCMs
+template<class T>
+DCMBatch<T>::DCMBatch(const DCM<T> *dcms, size_t n):
+    BatchStorage<T, 9>(n)
+{
+    load(dcms, n);
+}
+
+//! Construct from a batch of quaternions
+template<class T>
+DCMBatch<T>::DCMBatch(const QuaternionBatch<T> &q):
+    BatchStorage<T, 9>(q.size())
+{
+    load(q);
+}
+
+//! Replace the contents with an array of n DCMs
+template<class T>
+void DCMBatch<T>::load(const DCM<T> *dcms, size_t n)
+{
+    this->resize(n);
+    for(size_t e = 0; e < 9; ++e)
+    {
+        T *pe = this->component(e);
+        for(size_t i = 0; i < n; ++i)
+        {
+            pe[i] = dcms[i].coeff(e);
+        }
+    }
+}
+
+//! Replace the contents with the DCMs of a batch of quaternions
+template<class T>
+void DCMBatch<T>::load(const QuaternionBatch<T> &q)
+{
+    this->resize(q.size());
+    const T *qw = q.w(), *qx = q.x(), *qy = q.y(), *qz = q.z();
+    T *d[9];
+    for(size_t e = 0; e < 9; ++e)
+    {
+        d[e] = this->component(e);
+    }
+
+    // Like DCM(const Quaternion&), normalize each quaternion first
+    constexpr size_t chunk = 16*DCMBatch<T>::block;
+    T norm[chunk];
+    const size_t n = this->padded;
+    for(size_t c = 0; c < n; c += chunk)
+    {
+        const size_t m = n - c < chunk ? n - c : chunk;
+        for(size_t k = 0; k < m; k += this->block)
+        {
+            MTL_BATCH_IVDEP
+            for(size_t l = 0; l < this->block; ++l)
+            {
+                const size_t i = c + k + l;
+                norm[k+l] = T(0) + qw[i]*qw[i] + qx[i]*qx[i] + qy[i]*qy[i] + qz[i]*qz[i];
+            }
+        }
+        simd::kernels<T>().sqrt(norm, norm, m);
+        this->unitPaddingNorms(norm, c, m);
+        for(size_t k = 0; k < m; k += this->block)
+        {
+            MTL_BATCH_IVDEP
+            for(size_t l = 0; l < this->block; ++l)
+            {
+                const size_t i = c + k + l;
+                const T p0 = qw[i] / norm[k+l];
+                const T p1 = qx[i] / norm[k+l];
+                const T p2 = qy[i] / norm[k+l];
+                const T p3 = qz[i] / norm[k+l];
+                d[0][i] = p0*p0 + p1*p1 - p2*p2 - p3*p3;
+                d[1][i] = static_cast<T>(2)*(p1*p2 - p0*p3);
+                d[2][i] = static_cast<T>(2)*(p1*p3 + p0*p2);
+                d[3][i] = static_cast<T>(2)*(p1*p2 + p0*p3);
+                d[4][i] = p0*p0 - p1*p1 + p2*p2 - p3*p3;
+                d[5][i] = static_cast<T>(2)*(p2*p3 - p0*p1);
+                d[6][i] = static_cast<T>(2)*(p1*p3 - p0*p2);
+                d[7][i] = static_cast<T>(2)*(p2*p3 + p0*p1);
+                d[8][i] = p0*p0 - p1*p1 - p2*p2 + p3*p3;
+            }
+        }
+    }
+}
+
+//! Copy every DCM out to an array of size() DCMs
+template<class T>
+void DCMBatch<T>::store(DCM<T> *dcms) const
+{
+    for(size_t i = 0; i < this->count; ++i)
+    {
+        dcms[i] = (*this)(i);
+    }
+}
+
+//! Get DCM i
+template<class T>
+DCM<T> DCMBatch<T>::operator()(size_t i) const
+{
+    this->checkIndex(i);
+    T values[9];
+    for(size_t e = 0; e < 9; ++e)
+    {
+        values[e] = this->component(e)[i];
+    }
+    return DCM<T>(values);
+}
+
+//! Set DCM i
+template<class T>
+void DCMBatch<T>::set(size_t i, const DCM<T> &dcm)
+{
+    this->checkIndex(i);
+    for(size_t e = 0; e < 9; ++e)
+    {
+        this->component(e)[i] = dcm.coeff(e);
+    }
+}
+
+//! Rotate every vector of v by the matching DCM (out may be v)
+template<class T>
+void DCMBatch<T>::rotate(const Vector3Batch<T> &v, Vector3Batch<T> &out) const
+{
+    this->checkSize("rotate", v.size());
+    out.resize(this->count);
+    const T *d0 = this->component(0), *d1 = this->component(1), *d2 = this->component(2);
+    const T *d3 = this->component(3), *d4 = this->component(4), *d5 = this->component(5);
+    const T *d6 = this->component(6), *d7 = this->component(7), *d8 = this->component(8);
+    const T *vx = v.x(), *vy = v.y(), *vz = v.z();
+    T *ox = out.x(), *oy = out.y(), *oz = out.z();
+    const size_t n = this->padded;
+    for(size_t k = 0; k < n; k += this->block)
+    {
+        MTL_BATCH_IVDEP
+        for(size_t l = 0; l < this->block; ++l)
+        {
+            const size_t i = k + l;
+            const T x = vx[i], y = vy[i], z = vz[i];
+            ox[i] = T(0) + d0[i]*x + d1[i]*y + d2[i]*z;
+            oy[i] = T(0) + d3[i]*x + d4[i]*y + d5[i]*z;
+            oz[i] = T(0) + d6[i]*x + d7[i]*y + d8[i]*z;
+        }
+    }
+}
+
+} // namespace matrix
+
+#endif // _DCM_BATCH_HPP__
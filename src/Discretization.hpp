@@ -0,0 +1,330 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file Discretization.hpp
+//!
+//! Continuous-to-discrete conversion of the linear system
+//!
+//!   x' = A x + B u + w,  E[w w^T] = Q delta(t)
+//!
+//! held constant over a step dt, giving x+ = Phi x + Gamma u + w+ with
+//!
+//!   Phi = e^(A dt),  Gamma = int_0^dt e^(A s) ds B,
+//!   Qd = E[w+ w+^T] = int_0^dt e^(A s) Q e^(A^T s) ds
+//!
+//! All three come from one exponential (Van Loan 1978) of the
+//! (2N+P) x (2N+P) block matrix
+//!
+//!         [ -A  Q    0 ]          [ e^(-A dt)  Phi^-1 Qd  0 ]
+//!   C  =  [  0  A^T  0 ] dt,  e^C = [ 0          Phi^T      0 ]
+//!         [  0  B^T  0 ]          [ 0          Gamma^T    I ]
+//!
+//! The exponential runs on the four nonzero blocks only (every polynomial in
+//! C keeps this pattern), so each product costs about 3 N^3 + P N^2 rather
+//! than (2N+P)^3, and the Pade denominator is solved through two N x N LU
+//! factorizations.
+//!
+//! Discretization is a solver object like LUFactorization: compute() keeps
+//! the system and step it was given and skips the exponential when called
+//! again with the same ones, so a filter can call it every cycle and pay
+//! only when the flight condition or step changes.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _DISCRETIZATION_HPP__
+#define _DISCRETIZATION_HPP__
+
+#include <cmath>
+
+#include "Matrix.hpp"
+#include "SquareMatrix.hpp"
+#include "LUFactorization.hpp"
+#include "MatrixExponential.hpp"
+
+namespace matrix
+{
+
+namespace detail
+{
+
+//! [x11 x12 0; 0 x22 0; 0 x32 x33 I], the block pattern of the Van Loan
+//! matrix and of every polynomial in it, for detail::expmPade
+template<class T, size_t N, size_t P>
+struct VanLoanMatrix
+{
+    using value_type = T;
+
+    VanLoanMatrix():
+        x33(0)
+    {
+    }
+
+    void identity()
+    {
+        x11.identity();
+        x12 = SquareMatrix<T, N>();
+        x22.identity();
+        x32 = Matrix<T, P, N>();
+        x33 = 1;
+    }
+
+    void operator*=(T value)
+    {
+        x11 *= value;
+        x12 *= value;
+        x22 *= value;
+        x32 *= value;
+        x33 *= value;
+    }
+
+    SquareMatrix<T, N> x11;
+    SquareMatrix<T, N> x12;
+    SquareMatrix<T, N> x22;
+    Matrix<T, P, N> x32;
+    T x33;
+};
+
+//! Product of two Van Loan pattern matrices, skipping the zero blocks
+template<class T, size_t N, size_t P>
+VanLoanMatrix<T, N, P> operator*(const VanLoanMatrix<T, N, P> &X, const VanLoanMatrix<T, N, P> &Y)
+{
+    VanLoanMatrix<T, N, P> Z;
+    Z.x11 = X.x11*Y.x11;
+    Z.x12 = X.x11*Y.x12 + X.x12*Y.x22;
+    Z.x22 = X.x22*Y.x22;
+    Z.x32 = X.x32*Y.x22 + Y.x32*X.x33;
+    Z.x33 = X.x33*Y.x33;
+    return Z;
+}
+
+//! Largest column sum of |X|
+template<class T, size_t N, size_t P>
+T normOne(const VanLoanMatrix<T, N, P> &X)
+{
+    T largest = std::fabs(X.x33);
+    for(size_t j = 0; j < N; ++j)
+    {
+        T first = 0;
+        T second = 0;
+        for(size_t i = 0; i < N; ++i)
+        {
+            first += std::fabs(X.x11(i,j));
+            second += std::fabs(X.x12(i,j)) + std::fabs(X.x22(i,j));
+        }
+        for(size_t i = 0; i < P; ++i)
+        {
+            second += std::fabs(X.x32(i,j));
+        }
+        largest = first > largest ? first : largest;
+        largest = second > largest ? second : largest;
+    }
+    return largest;
+}
+
+//! Set C = sum of c[k] X[k] over n matrices, block by block
+template<class T, size_t N, size_t P>
+void combine(VanLoanMatrix<T, N, P> &C, const T *c, const VanLoanMatrix<T, N, P> *const *X, size_t n)
+{
+    C = VanLoanMatrix<T, N, P>();
+    for(size_t k = 0; k < n; ++k)
+    {
+        for(size_t i = 0; i < N; ++i)
+        {
+            for(size_t j = 0; j < N; ++j)
+            {
+                C.x11(i,j) += c[k]*X[k]->x11(i,j);
+                C.x12(i,j) += c[k]*X[k]->x12(i,j);
+                C.x22(i,j) += c[k]*X[k]->x22(i,j);
+            }
+        }
+        for(size_t i = 0; i < P; ++i)
+        {
+            for(size_t j = 0; j < N; ++j)
+            {
+                C.x32(i,j) += c[k]*X[k]->x32(i,j);
+            }
+        }
+        C.x33 += c[k]*X[k]->x33;
+    }
+}
+
+//! Solve (V - U) E = V + U by block substitution, two N x N factorizations
+template<class T, size_t N, size_t P>
+VanLoanMatrix<T, N, P> padeQuotient(const VanLoanMatrix<T, N, P> &V, const VanLoanMatrix<T, N, P> &U)
+{
+    const SquareMatrix<T, N> q11 = V.x11 - U.x11;
+    const SquareMatrix<T, N> q12 = V.x12 - U.x12;
+    const SquareMatrix<T, N> q22 = V.x22 - U.x22;
+    const Matrix<T, P, N> q32 = V.x32 - U.x32;
+    const T q33 = V.x33 - U.x33;
+
+    VanLoanMatrix<T, N, P> E;
+    const LUFactorization<T, N> lu11(q11);
+    E.x22 = LUFactorization<T, N>(q22).solve(Matrix<T, N, N>(V.x22 + U.x22));
+    E.x11 = lu11.solve(Matrix<T, N, N>(V.x11 + U.x11));
+    E.x12 = lu11.solve(Matrix<T, N, N>(V.x12 + U.x12 - q12*E.x22));
+    E.x32 = (V.x32 + U.x32 - q32*E.x22) / q33;
+    E.x33 = (V.x33 + U.x33) / q33;
+    return E;
+}
+
+} // namespace detail
+
+template<class T, size_t N, size_t P>
+class Discretization
+{
+public:
+    //! Default constructor (nothing discretized: Phi = I, Gamma = 0, Qd = 0)
+    Discretization();
+
+    //! Discretize x' = A x + B u + w, E[w w^T] = Q delta(t), over dt
+    Discretization(const Matrix<T, N, N> &A, const Matrix<T, N, P> &B, const Matrix<T, N, N> &Q, T dt);
+
+    //! Discretize over dt, unless the system and dt are those of the last call
+    void compute(const Matrix<T, N, N> &A, const Matrix<T, N, P> &B, const Matrix<T, N, N> &Q, T dt);
+
+    //! State transition matrix e^(A dt)
+    inline const SquareMatrix<T, N> &phi() const { return Phi; }
+
+    //! Input matrix int_0^dt e^(A s) ds B
+    inline const Matrix<T, N, P> &gamma() const { return Gamma; }
+
+    //! Discrete process noise covariance int_0^dt e^(A s) Q e^(A^T s) ds
+    inline const SquareMatrix<T, N> &processNoise() const { return Qd; }
+
+private:
+    //! True when A, B, Q and dt are those of the last discretization
+    bool isCurrent(const Matrix<T, N, N> &A, const Matrix<T, N, P> &B, const Matrix<T, N, N> &Q, T dt) const;
+
+    SquareMatrix<T, N> Phi;
+    Matrix<T, N, P> Gamma;
+    SquareMatrix<T, N> Qd;
+
+    // System and step of the last discretization
+    SquareMatrix<T, N> lastA;
+    Matrix<T, N, P> lastB;
+    SquareMatrix<T, N> lastQ;
+    T lastDt;
+    bool computed;
+};
+
+//! Discretize x' = A x + B u + w, E[w w^T] = Q delta(t), over dt
+template<class T, size_t N, size_t P>
+Discretization<T, N, P> c2d(const Matrix<T, N, N> &A, const Matrix<T, N, P> &B, const Matrix<T, N, N> &Q, T dt)
+{
+    return Discretization<T, N, P>(A, B, Q, dt);
+}
+
+//! Default constructor (nothing discretized: Phi = I, Gamma = 0, Qd = 0)
+template<class T, size_t N, size_t P>
+Discretization<T,N,P>::Discretization():
+    lastDt(0),
+    computed(false)
+{
+    Phi.identity();
+}
+
+//! Discretize x' = A x + B u + w, E[w w^T] = Q delta(t), over dt
+template<class T, size_t N, size_t P>
+Discretization<T,N,P>::Discretization(const Matrix<T, N, N> &A, const Matrix<T, N, P> &B, const Matrix<T, N, N> &Q, T dt):
+    lastDt(0),
+    computed(false)
+{
+    compute(A, B, Q, dt);
+}
+
+//! Discretize over dt, unless the system and dt are those of the last call
+template<class T, size_t N, size_t P>
+void Discretization<T,N,P>::compute(const Matrix<T, N, N> &A, const Matrix<T, N, P> &B, const Matrix<T, N, N> &Q, T dt)
+{
+    if(isCurrent(A, B, Q, dt))
+    {
+        return;
+    }
+
+    detail::VanLoanMatrix<T, N, P> C;
+    for(size_t i = 0; i < N; ++i)
+    {
+        for(size_t j = 0; j < N; ++j)
+        {
+            C.x11(i,j) = -A(i,j)*dt;
+            C.x12(i,j) = Q(i,j)*dt;
+            C.x22(i,j) = A(j,i)*dt;
+        }
+        for(size_t k = 0; k < P; ++k)
+        {
+            C.x32(k,i) = B(i,k)*dt;
+        }
+    }
+    const detail::VanLoanMatrix<T, N, P> E = detail::expmPade(C);
+
+    for(size_t i = 0; i < N; ++i)
+    {
+        for(size_t j = 0; j < N; ++j)
+        {
+            Phi(i,j) = E.x22(j,i);
+        }
+        for(size_t k = 0; k < P; ++k)
+        {
+            Gamma(i,k) = E.x32(k,i);
+        }
+    }
+
+    // Qd = Phi (Phi^-1 Qd), made exactly symmetric
+    for(size_t i = 0; i < N; ++i)
+    {
+        for(size_t j = 0; j < N; ++j)
+        {
+            T sum = 0;
+            for(size_t k = 0; k < N; ++k)
+            {
+                sum += Phi(i,k)*E.x12(k,j);
+            }
+            Qd(i,j) = sum;
+        }
+    }
+    for(size_t i = 0; i < N; ++i)
+    {
+        for(size_t j = i + 1; j < N; ++j)
+        {
+            Qd(i,j) = Qd(j,i) = (Qd(i,j) + Qd(j,i)) / 2;
+        }
+    }
+
+    lastA = A;
+    lastB = B;
+    lastQ = Q;
+    lastDt = dt;
+    computed = true;
+}
+
+//! True when A, B, Q and dt are those of the last discretization
+template<class T, size_t N, size_t P>
+bool Discretization<T,N,P>::isCurrent(const Matrix<T, N, N> &A, const Matrix<T, N, P> &B, const Matrix<T, N, N> &Q, T dt) const
+{
+    if(!computed || dt != lastDt)
+    {
+        return false;
+    }
+    for(size_t i = 0; i < N; ++i)
+    {
+        for(size_t j = 0; j < N; ++j)
+        {
+            if(A(i,j) != lastA(i,j) || Q(i,j) != lastQ(i,j))
+            {
+                return false;
+            }
+        }
+        for(size_t k = 0; k < P; ++k)
+        {
+            if(B(i,k) != lastB(i,k))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace matrix
+
+#endif // _DISCRETIZATION_HPP__
@@ -0,0 +1,703 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file DynamicMatrix.hpp
+//!
+//! Matrix whose dimensions are set at runtime. Elements are stored row-major
+//! in one contiguous buffer from Allocator (aligned by default), the same
+//! layout as the fixed-size Matrix, so products run the fixed-size kernels
+//! directly on the buffers whenever the runtime shape has one, and fixed-size
+//! operands are read in place without converting them first.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _DYNAMIC_MATRIX_HPP__
+#define _DYNAMIC_MATRIX_HPP__
+
+#include <cmath>
+#include <cstdio>
+#include <initializer_list>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "BoundsPolicy.hpp"
+#include "Matrix.hpp"
+#include "MatrixStorage.hpp"
+#include "MatrixView.hpp"
+#include "MultiplyKernel.hpp"
+
+namespace matrix
+{
+
+namespace detail
+{
+
+//! Report operands whose runtime shapes do not fit an operation
+[[noreturn]] inline void throwShapeMismatch(const char *operation, size_t rowsA, size_t colsA, size_t rowsB, size_t colsB)
+{
+    char message[160];
+    snprintf(message, 160, "ERROR: Matrix dimensions do not agree for %s. Left [%lu, %lu], Right [%lu, %lu]\n",
+        operation, rowsA, colsA, rowsB, colsB);
+    throw std::domain_error(message);
+}
+
+} // namespace detail
+
+template<class T, class Allocator = AlignedAllocator<T>>
+class DynamicMatrix
+{
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+
+    //! Default constructor (0x0 matrix)
+    DynamicMatrix();
+
+    //! Construct an empty matrix with an allocator
+    explicit DynamicMatrix(const Allocator &allocator);
+
+    //! Construct a rows x cols zero matrix
+    DynamicMatrix(size_t rows, size_t cols, const Allocator &allocator = Allocator());
+
+    //! Construct from a flat (row-major) array of rows*cols values
+    DynamicMatrix(size_t rows, size_t cols, const T *values, const Allocator &allocator = Allocator());
+
+    //! Construct using initializer list
+    DynamicMatrix(std::initializer_list<std::initializer_list<T>> list, const Allocator &allocator = Allocator());
+
+    //! Construct by evaluating a fixed-size matrix or matrix expression
+    template<class E, typename = std::enable_if_t<std::is_same<typename E::value_type, T>::value>>
+    DynamicMatrix(const MatrixExpression<E> &expr, const Allocator &allocator = Allocator());
+
+    //! Copy constructor
+    DynamicMatrix(const DynamicMatrix &other) = default;
+
+    //! Move constructor
+    DynamicMatrix(DynamicMatrix &&other) = default;
+
+    //! Copy assignment
+    DynamicMatrix &operator=(const DynamicMatrix &other) = default;
+
+    //! Move assignment
+    DynamicMatrix &operator=(DynamicMatrix &&other) = default;
+
+    //! Assign by evaluating a fixed-size matrix or matrix expression (takes its shape)
+    template<class E, typename = std::enable_if_t<std::is_same<typename E::value_type, T>::value>>
+    DynamicMatrix &operator=(const MatrixExpression<E> &expr);
+
+    //! Number of rows
+    inline size_t rows() const { return numRows; }
+
+    //! Number of columns
+    inline size_t cols() const { return numCols; }
+
+    //! Number of elements
+    inline size_t size() const { return numRows*numCols; }
+
+    //! Contiguous row-major elements
+    inline T *data() { return elements.data(); }
+    inline const T *data() const { return elements.data(); }
+
+    //! Allocator used for the elements
+    inline Allocator get_allocator() const { return elements.get_allocator(); }
+
+    //! Change the shape (every element is reset to zero)
+    void resize(size_t rows, size_t cols);
+
+    //! Element access operator
+    const T &operator()(size_t i, size_t j) const;
+
+    //! Element assignment operator
+    T &operator()(size_t i, size_t j);
+
+    //! Element access by flat (row-major) index
+    inline T coeff(size_t i) const { return elements[i]; }
+
+    //! Copy into a fixed-size matrix of the same shape
+    template<size_t M, size_t N, class Bounds = DefaultBounds>
+    Matrix<T, M, N, Bounds> toMatrix() const;
+
+    //! Element-wise addition
+    DynamicMatrix operator+(const DynamicMatrix &other) const;
+
+    //! Element-wise subtraction
+    DynamicMatrix operator-(const DynamicMatrix &other) const;
+
+    //! Unary minus
+    DynamicMatrix operator-() const;
+
+    //! Matrix multiply
+    DynamicMatrix operator*(const DynamicMatrix &other) const;
+
+    //! Element-wise scalar addition
+    DynamicMatrix operator+(T value) const;
+
+    //! Matrix-scalar subtraction
+    DynamicMatrix operator-(T value) const;
+
+    //! Scalar multiplication
+    DynamicMatrix operator*(T value) const;
+
+    //! Matrix element-wise scalar division
+    DynamicMatrix operator/(T value) const;
+
+    //! Compound addition operator
+    void operator+=(const DynamicMatrix &other);
+
+    //! Compound addition of a fixed-size matrix or matrix expression
+    template<class E>
+    void operator+=(const MatrixExpression<E> &other);
+
+    //! Compound subtraction operator
+    void operator-=(const DynamicMatrix &other);
+
+    //! Compound subtraction of a fixed-size matrix or matrix expression
+    template<class E>
+    void operator-=(const MatrixExpression<E> &other);
+
+    //! Compound matrix multiplication
+    void operator*=(const DynamicMatrix &other);
+
+    //! Compound scalar addition
+    void operator+=(T value);
+
+    //! Compound matrix-scalar subtraction
+    void operator-=(T value);
+
+    //! Compound rhs scalar multiplication
+    void operator*=(T value);
+
+    //! Compound matrix element-wise scalar division
+    void operator/=(T value);
+
+    //! Test equality (shape and elements)
+    bool operator==(const DynamicMatrix &other) const;
+
+    //! Test non-equality
+    bool operator!=(const DynamicMatrix &other) const;
+
+    //! Matrix transpose
+    DynamicMatrix transpose() const;
+
+    //! Swap rows
+    void swapRows(size_t rowA, size_t rowB);
+
+    //! Swap columns
+    void swapCols(size_t colA, size_t colB);
+
+    //! Set all elements to value
+    void setValue(T value);
+
+    //! Return absolute value of matrix elements
+    DynamicMatrix abs() const;
+
+    //! View of the fixed-size PxQ block whose top-left element is (i, j)
+    template<size_t P, size_t Q>
+    MatrixView<T, P, Q> block(size_t i, size_t j);
+
+    //! Read-only view of the fixed-size PxQ block whose top-left element is (i, j)
+    template<size_t P, size_t Q>
+    MatrixView<const T, P, Q> block(size_t i, size_t j) const;
+
+protected:
+    //! Throw unless the other operand is rows x cols like this matrix
+    void checkSameShape(const char *operation, size_t rows, size_t cols) const;
+
+    size_t numRows;
+    size_t numCols;
+    std::vector<T, Allocator> elements;
+};
+
+//! Default constructor (0x0 matrix)
+template<class T, class Allocator>
+DynamicMatrix<T,Allocator>::DynamicMatrix():
+    numRows(0),
+    numCols(0),
+    elements()
+{
+}
+
+//! Construct an empty matrix with an allocator
+template<class T, class Allocator>
+DynamicMatrix<T,Allocator>::DynamicMatrix(const Allocator &allocator):
+    numRows(0),
+    numCols(0),
+    elements(allocator)
+{
+}
+
+//! Construct a rows x cols zero matrix
+template<class T, class Allocator>
+DynamicMatrix<T,Allocator>::DynamicMatrix(size_t rows, size_t cols, const Allocator &allocator):
+    numRows(rows),
+    numCols(cols),
+    elements(rows*cols, T(0), allocator)
+{
+}
+
+//! Construct from a flat (row-major) array of rows*cols values
+template<class T, class Allocator>
+DynamicMatrix<T,Allocator>::DynamicMatrix(size_t rows, size_t cols, const T *values, const Allocator &allocator):
+    numRows(rows),
+    numCols(cols),
+    elements(values, values + rows*cols, allocator)
+{
+}
+
+//! Construct using initializer list
+template<class T, class Allocator>
+DynamicMatrix<T,Allocator>::DynamicMatrix(std::initializer_list<std::initializer_list<T>> list, const Allocator &allocator):
+    numRows(list.size()),
+    numCols(list.size() > 0 ? list.begin()->size() : 0),
+    elements(allocator)
+{
+    elements.reserve(numRows*numCols);
+    for(const std::initializer_list<T> &row : list)
+    {
+        if(row.size() != numCols)
+        {
+            detail::throwInvalidArgumentCount(numRows, numCols, numRows, row.size());
+        }
+        elements.insert(elements.end(), row.begin(), row.end());
+    }
+}
+
+//! Construct by evaluating a fixed-size matrix or matrix expression
+template<class T, class Allocator>
+template<class E, typename>
+DynamicMatrix<T,Allocator>::DynamicMatrix(const MatrixExpression<E> &expr, const Allocator &allocator):
+    numRows(E::rows),
+    numCols(E::cols),
+    elements(E::rows*E::cols, T(0), allocator)
+{
+    const E &e = expr.derived();
+    for(size_t i = 0; i < E::rows*E::cols; ++i)
+    {
+        elements[i] = e.coeff(i);
+    }
+}
+
+//! Assign by evaluating a fixed-size matrix or matrix expression (takes its shape)
+template<class T, class Allocator>
+template<class E, typename>
+DynamicMatrix<T,Allocator> &DynamicMatrix<T,Allocator>::operator=(const MatrixExpression<E> &expr)
+{
+    const E &e = expr.derived();
+    numRows = E::rows;
+    numCols = E::cols;
+    elements.resize(E::rows*E::cols);
+    for(size_t i = 0; i < E::rows*E::cols; ++i)
+    {
+        elements[i] = e.coeff(i);
+    }
+    return *this;
+}
+
+//! Change the shape (every element is reset to zero)
+template<class T, class Allocator>
+void DynamicMatrix<T,Allocator>::resize(size_t rows, size_t cols)
+{
+    numRows = rows;
+    numCols = cols;
+    elements.assign(rows*cols, T(0));
+}
+
+//! Element access operator
+template<class T, class Allocator>
+const T &DynamicMatrix<T,Allocator>::operator()(size_t i, size_t j) const
+{
+    DefaultBounds::check(i, j, numRows, numCols);
+    return elements[i*numCols+j];
+}
+
+//! Element assignment operator
+template<class T, class Allocator>
+T &DynamicMatrix<T,Allocator>::operator()(size_t i, size_t j)
+{
+    DefaultBounds::check(i, j, numRows, numCols);
+    return elements[i*numCols+j];
+}
+
+//! Copy into a fixed-size matrix of the same shape
+template<class T, class Allocator>
+template<size_t M, size_t N, class Bounds>
+Matrix<T, M, N, Bounds> DynamicMatrix<T,Allocator>::toMatrix() const
+{
+    checkSameShape("conversion to a fixed-size matrix", M, N);
+    return Matrix<T, M, N, Bounds>(elements.data());
+}
+
+//! Element-wise addition
+template<class T, class Allocator>
+DynamicMatrix<T, Allocator> DynamicMatrix<T,Allocator>::operator+(const DynamicMatrix &other) const
+{
+    DynamicMatrix result(*this);
+    result += other;
+    return result;
+}
+
+//! Element-wise subtraction
+template<class T, class Allocator>
+DynamicMatrix<T, Allocator> DynamicMatrix<T,Allocator>::operator-(const DynamicMatrix &other) const
+{
+    DynamicMatrix result(*this);
+    result -= other;
+    return result;
+}
+
+//! Unary minus
+template<class T, class Allocator>
+DynamicMatrix<T, Allocator> DynamicMatrix<T,Allocator>::operator-() const
+{
+    DynamicMatrix result(numRows, numCols, get_allocator());
+    for(size_t i = 0; i < size(); ++i)
+    {
+        result.elements[i] = -elements[i];
+    }
+    return result;
+}
+
+//! Matrix multiply
+template<class T, class Allocator>
+DynamicMatrix<T, Allocator> DynamicMatrix<T,Allocator>::operator*(const DynamicMatrix &other) const
+{
+    if(numCols != other.numRows)
+    {
+        detail::throwShapeMismatch("multiplication", numRows, numCols, other.numRows, other.numCols);
+    }
+    DynamicMatrix result(numRows, other.numCols, get_allocator());
+    detail::DynamicMultiplyKernel<T>::apply(data(), other.data(), result.data(), numRows, numCols, other.numCols);
+    return result;
+}
+
+//! Element-wise scalar addition
+template<class T, class Allocator>
+DynamicMatrix<T, Allocator> DynamicMatrix<T,Allocator>::operator+(T value) const
+{
+    DynamicMatrix result(*this);
+    result += value;
+    return result;
+}
+
+//! Matrix-scalar subtraction
+template<class T, class Allocator>
+DynamicMatrix<T, Allocator> DynamicMatrix<T,Allocator>::operator-(T value) const
+{
+    DynamicMatrix result(*this);
+    result -= value;
+    return result;
+}
+
+//! Scalar multiplication
+template<class T, class Allocator>
+DynamicMatrix<T, Allocator> DynamicMatrix<T,Allocator>::operator*(T value) const
+{
+    DynamicMatrix result(*this);
+    result *= value;
+    return result;
+}
+
+//! Matrix element-wise scalar division
+template<class T, class Allocator>
+DynamicMatrix<T, Allocator> DynamicMatrix<T,Allocator>::operator/(T value) const
+{
+    DynamicMatrix result(*this);
+    result /= value;
+    return result;
+}
+
+//! Compound addition operator
+template<class T, class Allocator>
+void DynamicMatrix<T,Allocator>::operator+=(const DynamicMatrix &other)
+{
+    checkSameShape("addition", other.numRows, other.numCols);
+    for(size_t i = 0; i < size(); ++i)
+    {
+        elements[i] += other.elements[i];
+    }
+}
+
+//! Compound addition of a fixed-size matrix or matrix expression
+template<class T, class Allocator>
+template<class E>
+void DynamicMatrix<T,Allocator>::operator+=(const MatrixExpression<E> &other)
+{
+    checkSameShape("addition", E::rows, E::cols);
+    const E &e = other.derived();
+    for(size_t i = 0; i < size(); ++i)
+    {
+        elements[i] += e.coeff(i);
+    }
+}
+
+//! Compound subtraction operator
+template<class T, class Allocator>
+void DynamicMatrix<T,Allocator>::operator-=(const DynamicMatrix &other)
+{
+    checkSameShape("subtraction", other.numRows, other.numCols);
+    for(size_t i = 0; i < size(); ++i)
+    {
+        elements[i] -= other.elements[i];
+    }
+}
+
+//! Compound subtraction of a fixed-size matrix or matrix expression
+template<class T, class Allocator>
+template<class E>
+void DynamicMatrix<T,Allocator>::operator-=(const MatrixExpression<E> &other)
+{
+    checkSameShape("subtraction", E::rows, E::cols);
+    const E &e = other.derived();
+    for(size_t i = 0; i < size(); ++i)
+    {
+        elements[i] -= e.coeff(i);
+    }
+}
+
+//! Compound matrix multiplication
+template<class T, class Allocator>
+void DynamicMatrix<T,Allocator>::operator*=(const DynamicMatrix &other)
+{
+    (*this) = (*this) * other;
+}
+
+//! Compound scalar addition
+template<class T, class Allocator>
+void DynamicMatrix<T,Allocator>::operator+=(T value)
+{
+    for(size_t i = 0; i < size(); ++i)
+    {
+        elements[i] += value;
+    }
+}
+
+//! Compound matrix-scalar subtraction
+template<class T, class Allocator>
+void DynamicMatrix<T,Allocator>::operator-=(T value)
+{
+    for(size_t i = 0; i < size(); ++i)
+    {
+        elements[i] -= value;
+    }
+}
+
+//! Compound rhs scalar multiplication
+template<class T, class Allocator>
+void DynamicMatrix<T,Allocator>::operator*=(T value)
+{
+    for(size_t i = 0; i < size(); ++i)
+    {
+        elements[i] *= value;
+    }
+}
+
+//! Compound matrix element-wise scalar division
+template<class T, class Allocator>
+void DynamicMatrix<T,Allocator>::operator/=(T value)
+{
+    for(size_t i = 0; i < size(); ++i)
+    {
+        elements[i] = (T)(elements[i] / value);
+    }
+}
+
+//! Test equality (shape and elements)
+template<class T, class Allocator>
+bool DynamicMatrix<T,Allocator>::operator==(const DynamicMatrix &other) const
+{
+    return numRows == other.numRows && numCols == other.numCols && elements == other.elements;
+}
+
+//! Test non-equality
+template<class T, class Allocator>
+bool DynamicMatrix<T,Allocator>::operator!=(const DynamicMatrix &other) const
+{
+    return !(*this == other);
+}
+
+//! Matrix transpose
+template<class T, class Allocator>
+DynamicMatrix<T, Allocator> DynamicMatrix<T,Allocator>::transpose() const
+{
+    DynamicMatrix result(numCols, numRows, get_allocator());
+    for(size_t i = 0; i < numRows; ++i)
+    {
+        for(size_t j = 0; j < numCols; ++j)
+        {
+            result.elements[j*numRows+i] = elements[i*numCols+j];
+        }
+    }
+    return result;
+}
+
+//! Swap rows
+template<class T, class Allocator>
+void DynamicMatrix<T,Allocator>::swapRows(size_t rowA, size_t rowB)
+{
+    if(rowA >= numRows || rowB >= numRows)
+    {
+        char message[110];
+        snprintf(message, 110,
+            "ERROR: Matrix row index access out of range. Max row index [%ld], Received [%ld, %ld]\n", numRows, rowA, rowB);
+        throw std::domain_error(message);
+    }
+
+    for(size_t i = 0; i < numCols; ++i)
+    {
+        std::swap(elements[rowA*numCols+i], elements[rowB*numCols+i]);
+    }
+}
+
+//! Swap columns
+template<class T, class Allocator>
+void DynamicMatrix<T,Allocator>::swapCols(size_t colA, size_t colB)
+{
+    if(colA >= numCols || colB >= numCols)
+    {
+        char message[110];
+        snprintf(message, 110,
+            "ERROR: Matrix column index access out of range. Max column index [%ld], Received [%ld, %ld]\n", numCols, colA, colB);
+        throw std::domain_error(message);
+    }
+
+    for(size_t i = 0; i < numRows; ++i)
+    {
+        std::swap(elements[i*numCols+colA], elements[i*numCols+colB]);
+    }
+}
+
+//! Set all elements to value
+template<class T, class Allocator>
+void DynamicMatrix<T,Allocator>::setValue(T value)
+{
+    elements.assign(size(), value);
+}
+
+//! Return absolute value of matrix elements
+template<class T, class Allocator>
+DynamicMatrix<T, Allocator> DynamicMatrix<T,Allocator>::abs() const
+{
+    DynamicMatrix result(numRows, numCols, get_allocator());
+    for(size_t i = 0; i < size(); ++i)
+    {
+        result.elements[i] = (T)std::fabs(elements[i]);
+    }
+    return result;
+}
+
+//! View of the fixed-size PxQ block whose top-left element is (i, j)
+template<class T, class Allocator>
+template<size_t P, size_t Q>
+MatrixView<T, P, Q> DynamicMatrix<T,Allocator>::block(size_t i, size_t j)
+{
+    DefaultBounds::check(i + P - 1, j + Q - 1, numRows, numCols);
+    return MatrixView<T, P, Q>(elements.data() + i*numCols + j, numCols, 1);
+}
+
+//! Read-only view of the fixed-size PxQ block whose top-left element is (i, j)
+template<class T, class Allocator>
+template<size_t P, size_t Q>
+MatrixView<const T, P, Q> DynamicMatrix<T,Allocator>::block(size_t i, size_t j) const
+{
+    DefaultBounds::check(i + P - 1, j + Q - 1, numRows, numCols);
+    return MatrixView<const T, P, Q>(elements.data() + i*numCols + j, numCols, 1);
+}
+
+//! Throw unless the other operand is rows x cols like this matrix
+template<class T, class Allocator>
+void DynamicMatrix<T,Allocator>::checkSameShape(const char *operation, size_t rows, size_t cols) const
+{
+    if(rows != numRows || cols != numCols)
+    {
+        detail::throwShapeMismatch(operation, numRows, numCols, rows, cols);
+    }
+}
+
+//! Scalar multiplication with the scalar on the left
+template<class T, class Allocator>
+DynamicMatrix<T, Allocator> operator*(T value, const DynamicMatrix<T, Allocator> &mat)
+{
+    return mat * value;
+}
+
+//! Product of a dynamic and a fixed-size matrix, read in place
+template<class T, class Allocator, size_t N, size_t P, class Bounds>
+DynamicMatrix<T, Allocator> operator*(const DynamicMatrix<T, Allocator> &lhs, const Matrix<T, N, P, Bounds> &rhs)
+{
+    if(lhs.cols() != N)
+    {
+        detail::throwShapeMismatch("multiplication", lhs.rows(), lhs.cols(), N, P);
+    }
+    DynamicMatrix<T, Allocator> result(lhs.rows(), P, lhs.get_allocator());
+    detail::DynamicMultiplyKernel<T>::apply(lhs.data(), &rhs(0,0), result.data(), lhs.rows(), N, P);
+    return result;
+}
+
+//! Product of a fixed-size and a dynamic matrix, read in place
+template<class T, class Allocator, size_t M, size_t N, class Bounds>
+DynamicMatrix<T, Allocator> operator*(const Matrix<T, M, N, Bounds> &lhs, const DynamicMatrix<T, Allocator> &rhs)
+{
+    if(rhs.rows() != N)
+    {
+        detail::throwShapeMismatch("multiplication", M, N, rhs.rows(), rhs.cols());
+    }
+    DynamicMatrix<T, Allocator> result(M, rhs.cols(), rhs.get_allocator());
+    detail::DynamicMultiplyKernel<T>::apply(&lhs(0,0), rhs.data(), result.data(), M, N, rhs.cols());
+    return result;
+}
+
+//! Sum of a dynamic matrix and a fixed-size matrix or matrix expression
+template<class T, class Allocator, class E>
+DynamicMatrix<T, Allocator> operator+(const DynamicMatrix<T, Allocator> &lhs, const MatrixExpression<E> &rhs)
+{
+    DynamicMatrix<T, Allocator> result(lhs);
+    result += rhs;
+    return result;
+}
+
+//! Sum of a fixed-size matrix or matrix expression and a dynamic matrix
+template<class T, class Allocator, class E>
+DynamicMatrix<T, Allocator> operator+(const MatrixExpression<E> &lhs, const DynamicMatrix<T, Allocator> &rhs)
+{
+    DynamicMatrix<T, Allocator> result(lhs, rhs.get_allocator());
+    result += rhs;
+    return result;
+}
+
+//! Difference of a dynamic matrix and a fixed-size matrix or matrix expression
+template<class T, class Allocator, class E>
+DynamicMatrix<T, Allocator> operator-(const DynamicMatrix<T, Allocator> &lhs, const MatrixExpression<E> &rhs)
+{
+    DynamicMatrix<T, Allocator> result(lhs);
+    result -= rhs;
+    return result;
+}
+
+//! Difference of a fixed-size matrix or matrix expression and a dynamic matrix
+template<class T, class Allocator, class E>
+DynamicMatrix<T, Allocator> operator-(const MatrixExpression<E> &lhs, const DynamicMatrix<T, Allocator> &rhs)
+{
+    DynamicMatrix<T, Allocator> result(lhs, rhs.get_allocator());
+    result -= rhs;
+    return result;
+}
+
+template<class T, class Allocator>
+std::ostream& operator<<(std::ostream &os, const DynamicMatrix<T, Allocator> &mat)
+{
+    for(size_t i = 0; i < mat.rows(); ++i)
+    {
+        for(size_t j = 0; j < mat.cols(); ++j)
+        {
+            os << mat(i,j) << "\t";
+        }
+        os << "\n";
+    }
+    return os;
+}
+
+} // namespace matrix
+
+#endif // _DYNAMIC_MATRIX_HPP__
@@ -0,0 +1,255 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file DynamicVector.hpp
+//!
+//! Column vector whose length is set at runtime
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _DYNAMIC_VECTOR_HPP__
+#define _DYNAMIC_VECTOR_HPP__
+
+#include <cmath>
+#include <initializer_list>
+
+#include "DynamicMatrix.hpp"
+#include "SimdKernel.hpp"
+#include "Vector.hpp"
+
+namespace matrix
+{
+
+template<class T, class Allocator = AlignedAllocator<T>>
+class DynamicVector : public DynamicMatrix<T, Allocator>
+{
+public:
+    //! Default constructor (empty vector)
+    DynamicVector();
+
+    //! Construct an empty vector with an allocator
+    explicit DynamicVector(const Allocator &allocator);
+
+    //! Construct a zero vector of length size
+    explicit DynamicVector(size_t size, const Allocator &allocator = Allocator());
+
+    //! Constructor with array of initial values
+    DynamicVector(size_t size, const T *values, const Allocator &allocator = Allocator());
+
+    //! Constructor with initializer list
+    DynamicVector(std::initializer_list<T> list, const Allocator &allocator = Allocator());
+
+    //! Construct with a single-column matrix
+    DynamicVector(const DynamicMatrix<T, Allocator> &other);
+
+    //! Construct by taking the elements of a single-column matrix
+    DynamicVector(DynamicMatrix<T, Allocator> &&other);
+
+    //! Construct by evaluating a fixed-size vector or column expression
+    template<class E, typename = std::enable_if_t<std::is_same<typename E::value_type, T>::value && E::cols == 1>>
+    DynamicVector(const MatrixExpression<E> &expr, const Allocator &allocator = Allocator());
+
+    //! Access vector elements
+    const T &operator()(size_t i) const;
+
+    //! Assign vector elements
+    T &operator()(size_t i);
+
+    //! Change the length (every element is reset to zero)
+    void resize(size_t size);
+
+    //! Copy into a fixed-size vector of the same length
+    template<size_t M>
+    Vector<T, M> toVector() const;
+
+    //! Dot product of this vector with b
+    T dot(const DynamicVector &b) const;
+
+    //! Dot product with operator*
+    T operator*(const DynamicVector &b) const;
+
+    //! Multiply with scalar
+    DynamicVector operator*(T value) const;
+
+    //! Compute the norm of a vector
+    T norm() const;
+
+    //! Normalize this vector
+    void normalize();
+
+    //! Get the length of the vector (same as norm)
+    T length() const;
+
+    //! Return unit vector
+    DynamicVector unit() const;
+
+private:
+    //! Throw unless the matrix has a single column
+    static void checkColumn(const DynamicMatrix<T, Allocator> &other);
+};
+
+//! Default constructor (empty vector)
+template<class T, class Allocator>
+DynamicVector<T,Allocator>::DynamicVector():
+    DynamicMatrix<T, Allocator>(0, 1)
+{
+}
+
+//! Construct an empty vector with an allocator
+template<class T, class Allocator>
+DynamicVector<T,Allocator>::DynamicVector(const Allocator &allocator):
+    DynamicMatrix<T, Allocator>(0, 1, allocator)
+{
+}
+
+//! Construct a zero vector of length size
+template<class T, class Allocator>
+DynamicVector<T,Allocator>::DynamicVector(size_t size, const Allocator &allocator):
+    DynamicMatrix<T, Allocator>(size, 1, allocator)
+{
+}
+
+//! Constructor with array of initial values
+template<class T, class Allocator>
+DynamicVector<T,Allocator>::DynamicVector(size_t size, const T *values, const Allocator &allocator):
+    DynamicMatrix<T, Allocator>(size, 1, values, allocator)
+{
+}
+
+//! Constructor with initializer list
+template<class T, class Allocator>
+DynamicVector<T,Allocator>::DynamicVector(std::initializer_list<T> list, const Allocator &allocator):
+    DynamicMatrix<T, Allocator>(list.size(), 1, list.begin(), allocator)
+{
+}
+
+//! Construct with a single-column matrix
+template<class T, class Allocator>
+DynamicVector<T,Allocator>::DynamicVector(const DynamicMatrix<T, Allocator> &other):
+    DynamicMatrix<T, Allocator>(other)
+{
+    checkColumn(other);
+}
+
+//! Construct by taking the elements of a single-column matrix
+template<class T, class Allocator>
+DynamicVector<T,Allocator>::DynamicVector(DynamicMatrix<T, Allocator> &&other):
+    DynamicMatrix<T, Allocator>((checkColumn(other), std::move(other)))
+{
+}
+
+//! Construct by evaluating a fixed-size vector or column expression
+template<class T, class Allocator>
+template<class E, typename>
+DynamicVector<T,Allocator>::DynamicVector(const MatrixExpression<E> &expr, const Allocator &allocator):
+    DynamicMatrix<T, Allocator>(expr, allocator)
+{
+}
+
+//! Access vector elements
+template<class T, class Allocator>
+const T &DynamicVector<T,Allocator>::operator()(size_t i) const
+{
+    DefaultBounds::check(i, 0, this->numRows, 1);
+    return this->elements[i];
+}
+
+//! Assign vector elements
+template<class T, class Allocator>
+T &DynamicVector<T,Allocator>::operator()(size_t i)
+{
+    DefaultBounds::check(i, 0, this->numRows, 1);
+    return this->elements[i];
+}
+
+//! Change the length (every element is reset to zero)
+template<class T, class Allocator>
+void DynamicVector<T,Allocator>::resize(size_t size)
+{
+    DynamicMatrix<T, Allocator>::resize(size, 1);
+}
+
+//! Copy into a fixed-size vector of the same length
+template<class T, class Allocator>
+template<size_t M>
+Vector<T, M> DynamicVector<T,Allocator>::toVector() const
+{
+    this->checkSameShape("conversion to a fixed-size vector", M, 1);
+    return Vector<T, M>(this->elements.data());
+}
+
+//! Dot product of this vector with b
+template<class T, class Allocator>
+T DynamicVector<T,Allocator>::dot(const DynamicVector &b) const
+{
+    this->checkSameShape("dot product", b.numRows, b.numCols);
+    if(simd::useRuntimeKernels<T>())
+    {
+        return simd::kernels<T>().dot(this->data(), b.data(), this->numRows);
+    }
+    T value = 0;
+    for(size_t i = 0; i < this->numRows; ++i)
+    {
+        value += this->elements[i] * b.elements[i];
+    }
+    return value;
+}
+
+//! Dot product with operator*
+template<class T, class Allocator>
+T DynamicVector<T,Allocator>::operator*(const DynamicVector &b) const
+{
+    return dot(b);
+}
+
+//! Multiply with scalar
+template<class T, class Allocator>
+DynamicVector<T, Allocator> DynamicVector<T,Allocator>::operator*(T value) const
+{
+    DynamicVector result(*this);
+    result *= value;
+    return result;
+}
+
+//! Compute the norm of a vector
+template<class T, class Allocator>
+T DynamicVector<T,Allocator>::norm() const
+{
+    return T(std::sqrt(dot(*this)));
+}
+
+//! Normalize this vector
+template<class T, class Allocator>
+void DynamicVector<T,Allocator>::normalize()
+{
+    (*this) /= norm();
+}
+
+//! Get the length of the vector (same as norm)
+template<class T, class Allocator>
+T DynamicVector<T,Allocator>::length() const
+{
+    return norm();
+}
+
+//! Return unit vector
+template<class T, class Allocator>
+DynamicVector<T, Allocator> DynamicVector<T,Allocator>::unit() const
+{
+    DynamicVector result(*this);
+    result.normalize();
+    return result;
+}
+
+//! Throw unless the matrix has a single column
+template<class T, class Allocator>
+void DynamicVector<T,Allocator>::checkColumn(const DynamicMatrix<T, Allocator> &other)
+{
+    if(other.cols() != 1)
+    {
+        detail::throwShapeMismatch("conversion to a vector", other.rows(), other.cols(), other.rows(), 1);
+    }
+}
+
+} // namespace matrix
+
+#endif // _DYNAMIC_VECTOR_HPP__
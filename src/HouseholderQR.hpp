@@ -0,0 +1,599 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file HouseholderQR.hpp
+//!
+//! Householder QR factorization A = QR of a tall M x N matrix (M >= N), kept as
+//! a least-squares solver object. solve(b) minimizes |A x - b| without forming
+//! A^T A, so the condition number is not squared as with the normal equations.
+//!
+//! R is stored in the upper triangle and the Householder vectors (with an
+//! implicit leading one) below it, as in LAPACK. computeBlocked() gives the
+//! same factorization but applies each panel of blockColumns reflectors to the
+//! rest of the matrix at once in compact WY form (I - V T V^T), which streams
+//! a tall matrix through the cache N / blockColumns times instead of N times.
+//!
+//! appendRow(a, b) adds one observation a x = b to the problem with Givens
+//! rotations of R in O(N^2), so streaming problems (e.g. a calibration that
+//! gains a sample at a time) never refactor. Start a stream from a batch with
+//! compute(A, b), or from nothing with the default constructor, and solve the
+//! accumulated problem with solve(). compute(A) and computeBlocked(A) do not
+//! keep Q^T b, so appendRow, solve() and residualNorm() throw after them.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _HOUSEHOLDER_QR_HPP__
+#define _HOUSEHOLDER_QR_HPP__
+
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+#include "Matrix.hpp"
+#include "SquareMatrix.hpp"
+#include "Vector.hpp"
+
+namespace matrix
+{
+
+template<class T, size_t M, size_t N>
+class HouseholderQR
+{
+public:
+    static_assert(M >= N, "HouseholderQR needs at least as many rows as columns");
+
+    //! Reflectors per panel in computeBlocked()
+    static constexpr size_t blockColumns = 8;
+
+    //! Default constructor (empty problem for appendRow)
+    HouseholderQR();
+
+    //! Factor A
+    explicit HouseholderQR(const Matrix<T, M, N> &A);
+
+    //! Factor A, replacing the current factorization
+    void compute(const Matrix<T, M, N> &A);
+
+    //! Factor A and keep Q^T b, so rows can be appended to the problem A x = b
+    void compute(const Matrix<T, M, N> &A, const Matrix<T, M, 1> &b);
+
+    //! Factor A in compact WY panels of blockColumns reflectors (same result as compute)
+    void computeBlocked(const Matrix<T, M, N> &A);
+
+    //! Least-squares solution of A x = b
+    Vector<T, N> solve(const Matrix<T, M, 1> &b) const;
+
+    //! Least-squares solution of A X = B for every column of B
+    template<size_t P>
+    Matrix<T, N, P> solve(const Matrix<T, M, P> &B) const;
+
+    //! Add the observation a x = b to the problem
+    void appendRow(const Matrix<T, 1, N> &a, T b);
+
+    //! Least-squares solution of the problem from compute(A, b) and appendRow
+    Vector<T, N> solve() const;
+
+    //! Norm of the least-squares residual of the problem from compute(A, b) and appendRow
+    inline T residualNorm() const { checkRightHandSide("residualNorm"); return std::sqrt(residualSquared); }
+
+    //! True when R has a zero on its diagonal (A does not have full column rank)
+    bool isRankDeficient() const;
+
+    //! Upper triangular factor R
+    SquareMatrix<T, N> matrixR() const;
+
+    //! First N columns of Q (not available after appendRow)
+    Matrix<T, M, N> thinQ() const;
+
+private:
+    //! Form reflector k from column k of the rows x ld matrix a and apply it to columns k+1 to end-1
+    static void reflectColumn(T *a, size_t ld, size_t rows, size_t k, size_t end, T &tauk);
+
+    //! Overwrite the rows of Y (P columns) with Q^T Y
+    void applyQTranspose(T *y, size_t P) const;
+
+    //! Solve R X = Y for the first N rows of Y (P columns) into X
+    void backSubstitute(const T *y, T *x, size_t P) const;
+
+    //! Throw unless the reflectors are usable for an operation
+    void checkReflectors(const char *operation) const;
+
+    //! Throw unless Q^T b is known for an operation on the accumulated problem
+    void checkRightHandSide(const char *operation) const;
+
+    //! Throw if R is singular
+    void checkRank() const;
+
+    Matrix<T, M, N> qr;
+    T tau[N];
+    Vector<T, N> qtb;
+    T residualSquared;
+    bool rowsAppended;
+    bool rightHandSide;
+};
+
+//! Default constructor (empty problem for appendRow)
+template<class T, size_t M, size_t N>
+HouseholderQR<T,M,N>::HouseholderQR():
+    qr(),
+    tau{},
+    qtb(),
+    residualSquared(0),
+    rowsAppended(true),
+    rightHandSide(true)
+{
+}
+
+//! Factor A
+template<class T, size_t M, size_t N>
+HouseholderQR<T,M,N>::HouseholderQR(const Matrix<T, M, N> &A)
+{
+    compute(A);
+}
+
+//! Factor A, replacing the current factorization
+template<class T, size_t M, size_t N>
+void HouseholderQR<T,M,N>::compute(const Matrix<T, M, N> &A)
+{
+    qr = A;
+    qtb = Vector<T, N>();
+    residualSquared = T(0);
+    rowsAppended = false;
+    rightHandSide = false;
+    T *a = &qr(0,0);
+    for(size_t k = 0; k < N; ++k)
+    {
+        reflectColumn(a, N, M, k, N, tau[k]);
+    }
+}
+
+//! Factor A and keep Q^T b, so rows can be appended to the problem A x = b
+template<class T, size_t M, size_t N>
+void HouseholderQR<T,M,N>::compute(const Matrix<T, M, N> &A, const Matrix<T, M, 1> &b)
+{
+    compute(A);
+    rightHandSide = true;
+    Vector<T, M> y(b);
+    applyQTranspose(&y(0), 1);
+    for(size_t i = 0; i < N; ++i)
+    {
+        qtb(i) = y(i);
+    }
+    for(size_t i = N; i < M; ++i)
+    {
+        residualSquared += y(i)*y(i);
+    }
+}
+
+//! Factor A in compact WY panels of blockColumns reflectors (same result as compute)
+template<class T, size_t M, size_t N>
+void HouseholderQR<T,M,N>::computeBlocked(const Matrix<T, M, N> &A)
+{
+    qr = A;
+    qtb = Vector<T, N>();
+    residualSquared = T(0);
+    rowsAppended = false;
+    rightHandSide = false;
+
+    // Each panel is factored in a contiguous copy (rows of blockColumns elements), which
+    // stays in cache while its reflectors are formed
+    T *a = &qr(0,0);
+    Matrix<T, M, blockColumns> panel;
+    Matrix<T, blockColumns, N> W;
+    T *V = &panel(0,0);
+    T *w = &W(0,0);
+    T Tf[blockColumns][blockColumns];
+    for(size_t k0 = 0; k0 < N; k0 += blockColumns)
+    {
+        const size_t nb = (N - k0 < blockColumns) ? N - k0 : blockColumns;
+        const size_t end = k0 + nb;
+        const size_t rows = M - k0;
+
+        // Row r of the panel is row k0+r of the panel columns
+        for(size_t r = 0; r < rows; ++r)
+        {
+            for(size_t p = 0; p < nb; ++p)
+            {
+                V[r*blockColumns+p] = a[(k0+r)*N+k0+p];
+            }
+        }
+        for(size_t p = 0; p < nb; ++p)
+        {
+            reflectColumn(V, blockColumns, rows, p, nb, tau[k0+p]);
+        }
+        for(size_t r = 0; r < rows; ++r)
+        {
+            for(size_t p = 0; p < nb; ++p)
+            {
+                a[(k0+r)*N+k0+p] = V[r*blockColumns+p];
+            }
+        }
+        if(end == N)
+        {
+            break;
+        }
+
+        // Triangular factor T with H(k0) ... H(end-1) = I - V T V^T (LAPACK larft)
+        for(size_t p = 0; p < nb; ++p)
+        {
+            for(size_t q = 0; q < p; ++q)
+            {
+                // (V^T v_p)(q), using the implicit ones on the diagonal of V
+                T dot = V[p*blockColumns+q];
+                for(size_t r = p+1; r < rows; ++r)
+                {
+                    dot += V[r*blockColumns+q]*V[r*blockColumns+p];
+                }
+                Tf[q][p] = dot;
+            }
+            for(size_t q = 0; q < p; ++q)
+            {
+                T s = 0;
+                for(size_t r = q; r < p; ++r)
+                {
+                    s += Tf[q][r]*Tf[r][p];
+                }
+                Tf[q][p] = s;
+            }
+            for(size_t q = 0; q < p; ++q)
+            {
+                Tf[q][p] *= -tau[k0+p];
+            }
+            Tf[p][p] = tau[k0+p];
+        }
+
+        // C = (I - V T^T V^T) C for the trailing columns: W = V^T C, W = T^T W, C -= V W.
+        // Each product sweeps the rows of C once, where the unblocked form sweeps them
+        // twice per reflector.
+        const size_t cols = N - end;
+        for(size_t p = 0; p < nb; ++p)
+        {
+            const T *ck = a + (k0+p)*N + end;
+            T *wp = w + p*N;
+            for(size_t j = 0; j < cols; ++j)
+            {
+                wp[j] = ck[j];
+            }
+        }
+        for(size_t r = 1; r < rows; ++r)
+        {
+            const T *cr = a + (k0+r)*N + end;
+            const size_t pEnd = (r < nb) ? r : nb;
+            for(size_t p = 0; p < pEnd; ++p)
+            {
+                const T v = V[r*blockColumns+p];
+                T *wp = w + p*N;
+                for(size_t j = 0; j < cols; ++j)
+                {
+                    wp[j] += v*cr[j];
+                }
+            }
+        }
+        for(size_t p = nb; p-- > 0;)
+        {
+            T *wp = w + p*N;
+            for(size_t j = 0; j < cols; ++j)
+            {
+                wp[j] *= Tf[p][p];
+            }
+            for(size_t q = 0; q < p; ++q)
+            {
+                const T t = Tf[q][p];
+                const T *wq = w + q*N;
+                for(size_t j = 0; j < cols; ++j)
+                {
+                    wp[j] += t*wq[j];
+                }
+            }
+        }
+        for(size_t r = 0; r < rows; ++r)
+        {
+            T *cr = a + (k0+r)*N + end;
+            const size_t pEnd = (r+1 < nb) ? r+1 : nb;
+            T v[blockColumns];
+            for(size_t p = 0; p < pEnd; ++p)
+            {
+                v[p] = (r == p) ? T(1) : V[r*blockColumns+p];
+            }
+            // Accumulate the whole panel's correction before storing the element
+            for(size_t j = 0; j < cols; ++j)
+            {
+                T c = cr[j];
+                for(size_t p = 0; p < pEnd; ++p)
+                {
+                    c -= v[p]*w[p*N+j];
+                }
+                cr[j] = c;
+            }
+        }
+    }
+}
+
+//! Least-squares solution of A x = b
+template<class T, size_t M, size_t N>
+Vector<T, N> HouseholderQR<T,M,N>::solve(const Matrix<T, M, 1> &b) const
+{
+    checkReflectors("solve(b)");
+    checkRank();
+    Vector<T, M> y(b);
+    applyQTranspose(&y(0), 1);
+    Vector<T, N> x;
+    backSubstitute(&y(0), &x(0), 1);
+    return x;
+}
+
+//! Least-squares solution of A X = B for every column of B
+template<class T, size_t M, size_t N>
+template<size_t P>
+Matrix<T, N, P> HouseholderQR<T,M,N>::solve(const Matrix<T, M, P> &B) const
+{
+    checkReflectors("solve(B)");
+    checkRank();
+    Matrix<T, M, P> Y(B);
+    applyQTranspose(&Y(0,0), P);
+    Matrix<T, N, P> X;
+    backSubstitute(&Y(0,0), &X(0,0), P);
+    return X;
+}
+
+//! Add the observation a x = b to the problem
+template<class T, size_t M, size_t N>
+void HouseholderQR<T,M,N>::appendRow(const Matrix<T, 1, N> &a, T b)
+{
+    checkRightHandSide("appendRow");
+    // Rotate the new row into R one column at a time; the reflectors no longer describe Q
+    rowsAppended = true;
+    Matrix<T, 1, N> row(a);
+    T *x = &row(0,0);
+    T *r = &qr(0,0);
+    for(size_t k = 0; k < N; ++k)
+    {
+        if(x[k] == T(0))
+        {
+            continue;
+        }
+        const T rkk = r[k*N+k];
+        const T h = std::hypot(rkk, x[k]);
+        const T c = rkk / h;
+        const T s = x[k] / h;
+        r[k*N+k] = h;
+        for(size_t j = k+1; j < N; ++j)
+        {
+            const T t = r[k*N+j];
+            r[k*N+j] = c*t + s*x[j];
+            x[j] = c*x[j] - s*t;
+        }
+        const T t = qtb(k);
+        qtb(k) = c*t + s*b;
+        b = c*b - s*t;
+    }
+    residualSquared += b*b;
+}
+
+//! Least-squares solution of the problem from compute(A, b) and appendRow
+template<class T, size_t M, size_t N>
+Vector<T, N> HouseholderQR<T,M,N>::solve() const
+{
+    checkRightHandSide("solve()");
+    checkRank();
+    Vector<T, N> x;
+    backSubstitute(&qtb(0), &x(0), 1);
+    return x;
+}
+
+//! True when R has a zero on its diagonal (A does not have full column rank)
+template<class T, size_t M, size_t N>
+bool HouseholderQR<T,M,N>::isRankDeficient() const
+{
+    for(size_t k = 0; k < N; ++k)
+    {
+        if(qr(k,k) == T(0))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//! Upper triangular factor R
+template<class T, size_t M, size_t N>
+SquareMatrix<T, N> HouseholderQR<T,M,N>::matrixR() const
+{
+    SquareMatrix<T, N> R;
+    for(size_t i = 0; i < N; ++i)
+    {
+        for(size_t j = i; j < N; ++j)
+        {
+            R(i,j) = qr(i,j);
+        }
+    }
+    return R;
+}
+
+//! First N columns of Q (not available after appendRow)
+template<class T, size_t M, size_t N>
+Matrix<T, M, N> HouseholderQR<T,M,N>::thinQ() const
+{
+    checkReflectors("thinQ");
+    // Q [I; 0] = H(0) ... H(N-1) [I; 0], applied from the last reflector back
+    Matrix<T, M, N> Q;
+    for(size_t i = 0; i < N; ++i)
+    {
+        Q(i,i) = T(1);
+    }
+    const T *v = &qr(0,0);
+    T *q = &Q(0,0);
+    Vector<T, N> w;
+    for(size_t k = N; k-- > 0;)
+    {
+        for(size_t j = 0; j < N; ++j)
+        {
+            w(j) = q[k*N+j];
+        }
+        for(size_t i = k+1; i < M; ++i)
+        {
+            for(size_t j = 0; j < N; ++j)
+            {
+                w(j) += v[i*N+k]*q[i*N+j];
+            }
+        }
+        for(size_t j = 0; j < N; ++j)
+        {
+            w(j) *= tau[k];
+            q[k*N+j] -= w(j);
+        }
+        for(size_t i = k+1; i < M; ++i)
+        {
+            for(size_t j = 0; j < N; ++j)
+            {
+                q[i*N+j] -= v[i*N+k]*w(j);
+            }
+        }
+    }
+    return Q;
+}
+
+//! Form reflector k from column k of the rows x ld matrix a and apply it to columns k+1 to end-1
+template<class T, size_t M, size_t N>
+void HouseholderQR<T,M,N>::reflectColumn(T *a, size_t ld, size_t rows, size_t k, size_t end, T &tauk)
+{
+    // H = I - tau v v^T with v(k) = 1 maps column k below the diagonal to beta e_k (LAPACK larfg)
+    T sigma = 0;
+    for(size_t i = k+1; i < rows; ++i)
+    {
+        sigma += a[i*ld+k]*a[i*ld+k];
+    }
+    const T alpha = a[k*ld+k];
+    if(sigma == T(0))
+    {
+        tauk = T(0);
+        return;
+    }
+    T beta = std::sqrt(alpha*alpha + sigma);
+    if(alpha > T(0))
+    {
+        beta = -beta;
+    }
+    tauk = (beta - alpha) / beta;
+    const T scale = T(1) / (alpha - beta);
+    a[k*ld+k] = beta;
+
+    // Scale v and accumulate w = v^T C in one sweep of the rows, then C -= tau v w
+    T w[N];
+    for(size_t j = k+1; j < end; ++j)
+    {
+        w[j] = a[k*ld+j];
+    }
+    for(size_t i = k+1; i < rows; ++i)
+    {
+        const T v = a[i*ld+k]*scale;
+        a[i*ld+k] = v;
+        for(size_t j = k+1; j < end; ++j)
+        {
+            w[j] += v*a[i*ld+j];
+        }
+    }
+    if(k+1 == end)
+    {
+        return;
+    }
+    for(size_t j = k+1; j < end; ++j)
+    {
+        w[j] *= tauk;
+        a[k*ld+j] -= w[j];
+    }
+    for(size_t i = k+1; i < rows; ++i)
+    {
+        const T v = a[i*ld+k];
+        for(size_t j = k+1; j < end; ++j)
+        {
+            a[i*ld+j] -= v*w[j];
+        }
+    }
+}
+
+//! Overwrite the rows of Y (P columns) with Q^T Y
+template<class T, size_t M, size_t N>
+void HouseholderQR<T,M,N>::applyQTranspose(T *y, size_t P) const
+{
+    const T *a = &qr(0,0);
+    for(size_t k = 0; k < N; ++k)
+    {
+        if(tau[k] == T(0))
+        {
+            continue;
+        }
+        for(size_t j = 0; j < P; ++j)
+        {
+            T s = y[k*P+j];
+            for(size_t i = k+1; i < M; ++i)
+            {
+                s += a[i*N+k]*y[i*P+j];
+            }
+            s *= tau[k];
+            y[k*P+j] -= s;
+            for(size_t i = k+1; i < M; ++i)
+            {
+                y[i*P+j] -= a[i*N+k]*s;
+            }
+        }
+    }
+}
+
+//! Solve R X = Y for the first N rows of Y (P columns) into X
+template<class T, size_t M, size_t N>
+void HouseholderQR<T,M,N>::backSubstitute(const T *y, T *x, size_t P) const
+{
+    const T *r = &qr(0,0);
+    for(size_t i = N; i-- > 0;)
+    {
+        for(size_t j = 0; j < P; ++j)
+        {
+            T s = y[i*P+j];
+            for(size_t k = i+1; k < N; ++k)
+            {
+                s -= r[i*N+k]*x[k*P+j];
+            }
+            x[i*P+j] = s / r[i*N+i];
+        }
+    }
+}
+
+//! Throw unless the reflectors are usable for an operation
+template<class T, size_t M, size_t N>
+void HouseholderQR<T,M,N>::checkReflectors(const char *operation) const
+{
+    if(rowsAppended)
+    {
+        char message[100];
+        snprintf(message, 100, "ERROR: Q is not stored after appendRow. Cannot %s; use solve().\n", operation);
+        throw std::runtime_error(message);
+    }
+}
+
+//! Throw unless Q^T b is known for an operation on the accumulated problem
+template<class T, size_t M, size_t N>
+void HouseholderQR<T,M,N>::checkRightHandSide(const char *operation) const
+{
+    if(!rightHandSide)
+    {
+        char message[100];
+        snprintf(message, 100, "ERROR: Q^T b is not stored; factor with compute(A, b). Cannot %s.\n", operation);
+        throw std::runtime_error(message);
+    }
+}
+
+//! Throw if R is singular
+template<class T, size_t M, size_t N>
+void HouseholderQR<T,M,N>::checkRank() const
+{
+    if(isRankDeficient())
+    {
+        char message[100];
+        snprintf(message, 100, "ERROR: Matrix does not have full column rank. Cannot solve.\n");
+        throw std::runtime_error(message);
+    }
+}
+
+} // namespace matrix
+
+#endif // _HOUSEHOLDER_QR_HPP__
@@ -0,0 +1,311 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file LUFactorization.hpp
+//!
+//! LU factorization with partial pivoting, PA = LU, kept as a solver object:
+//! factor a matrix once, then solve for any number of right-hand sides, or
+//! take its determinant or inverse, without factoring again.
+//!
+//! L (unit diagonal, not stored) and U share one matrix, and the row
+//! permutation P is kept as an index array. compute() refactors in place, so
+//! one object can follow a changing matrix (e.g. the Jacobian of an implicit
+//! integrator) without allocating. A matrix is singular when a pivot is zero;
+//! solve() and inverse() then throw std::runtime_error.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _LU_FACTORIZATION_HPP__
+#define _LU_FACTORIZATION_HPP__
+
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <utility>
+
+#include "Matrix.hpp"
+#include "SquareMatrix.hpp"
+#include "Vector.hpp"
+
+namespace matrix
+{
+
+template<class T, size_t M>
+class LUFactorization
+{
+public:
+    //! Default constructor (factorization of the zero matrix)
+    LUFactorization();
+
+    //! Factor A
+    explicit LUFactorization(const Matrix<T, M, M> &A);
+
+    //! Factor A, replacing the current factorization
+    void compute(const Matrix<T, M, M> &A);
+
+    //! True when a pivot is zero (A is singular)
+    inline bool isSingular() const { return singular; }
+
+    //! Solve A x = b
+    Vector<T, M> solve(const Matrix<T, M, 1> &b) const;
+
+    //! Solve A X = B for every column of B
+    template<size_t P>
+    Matrix<T, M, P> solve(const Matrix<T, M, P> &B) const;
+
+    //! Determinant of A
+    T determinant() const;
+
+    //! Inverse of A
+    SquareMatrix<T, M> inverse() const;
+
+    //! Unit lower triangular factor L
+    SquareMatrix<T, M> lower() const;
+
+    //! Upper triangular factor U
+    SquareMatrix<T, M> upper() const;
+
+    //! Row i of PA is row permutation(i) of A
+    inline size_t permutation(size_t i) const { return perm[i]; }
+
+    //! L below the diagonal and U on and above it
+    inline const SquareMatrix<T, M> &matrixLU() const { return lu; }
+
+private:
+    //! Throw if A is singular
+    void checkInvertible(const char *operation) const;
+
+    //! Overwrite the rows of X (ldx apart, P columns) with the solution of L U X = X
+    void substitute(T *x, size_t ldx, size_t P) const;
+
+    //! y -= alpha*x over n contiguous elements (y and x are distinct rows)
+    static void subtractScaled(T *y, const T *x, T alpha, size_t n);
+
+    SquareMatrix<T, M> lu;
+    size_t perm[M];
+    T sign;
+    bool singular;
+};
+
+//! Default constructor (factorization of the zero matrix)
+template<class T, size_t M>
+LUFactorization<T,M>::LUFactorization():
+    lu(),
+    sign(1),
+    singular(true)
+{
+    for(size_t i = 0; i < M; ++i)
+    {
+        perm[i] = i;
+    }
+}
+
+//! Factor A
+template<class T, size_t M>
+LUFactorization<T,M>::LUFactorization(const Matrix<T, M, M> &A)
+{
+    compute(A);
+}
+
+//! Factor A, replacing the current factorization
+template<class T, size_t M>
+void LUFactorization<T,M>::compute(const Matrix<T, M, M> &A)
+{
+    lu = A;
+    sign = T(1);
+    singular = false;
+    for(size_t i = 0; i < M; ++i)
+    {
+        perm[i] = i;
+    }
+
+    T *a = &lu(0,0);
+    for(size_t k = 0; k < M; ++k)
+    {
+        // Partial pivoting: bring the largest remaining element of column k to the diagonal
+        size_t p = k;
+        T largest = std::fabs(a[k*M+k]);
+        for(size_t i = k+1; i < M; ++i)
+        {
+            const T candidate = std::fabs(a[i*M+k]);
+            if(candidate > largest)
+            {
+                largest = candidate;
+                p = i;
+            }
+        }
+        if(p != k)
+        {
+            for(size_t j = 0; j < M; ++j)
+            {
+                std::swap(a[k*M+j], a[p*M+j]);
+            }
+            std::swap(perm[k], perm[p]);
+            sign = -sign;
+        }
+
+        const T pivot = a[k*M+k];
+        if(pivot == T(0))
+        {
+            // The rest of the column is zero too; nothing to eliminate
+            singular = true;
+            continue;
+        }
+
+        const T *rowK = a + k*M;
+        for(size_t i = k+1; i < M; ++i)
+        {
+            T *rowI = a + i*M;
+            const T l = rowI[k] / pivot;
+            rowI[k] = l;
+            subtractScaled(rowI+k+1, rowK+k+1, l, M-k-1);
+        }
+    }
+}
+
+//! Solve A x = b
+template<class T, size_t M>
+Vector<T, M> LUFactorization<T,M>::solve(const Matrix<T, M, 1> &b) const
+{
+    checkInvertible("solve");
+    Vector<T, M> x;
+    for(size_t i = 0; i < M; ++i)
+    {
+        x(i) = b(perm[i], 0);
+    }
+    substitute(&x(0), 1, 1);
+    return x;
+}
+
+//! Solve A X = B for every column of B
+template<class T, size_t M>
+template<size_t P>
+Matrix<T, M, P> LUFactorization<T,M>::solve(const Matrix<T, M, P> &B) const
+{
+    checkInvertible("solve");
+    Matrix<T, M, P> X;
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < P; ++j)
+        {
+            X(i,j) = B(perm[i], j);
+        }
+    }
+    substitute(&X(0,0), P, P);
+    return X;
+}
+
+//! Determinant of A
+template<class T, size_t M>
+T LUFactorization<T,M>::determinant() const
+{
+    T det = sign;
+    for(size_t i = 0; i < M; ++i)
+    {
+        det *= lu(i,i);
+    }
+    return det;
+}
+
+//! Inverse of A
+template<class T, size_t M>
+SquareMatrix<T, M> LUFactorization<T,M>::inverse() const
+{
+    checkInvertible("inverse");
+    // Solve A X = I; the permuted identity has a single one in each row
+    SquareMatrix<T, M> X;
+    for(size_t i = 0; i < M; ++i)
+    {
+        X(i, perm[i]) = T(1);
+    }
+    substitute(&X(0,0), M, M);
+    return X;
+}
+
+//! Unit lower triangular factor L
+template<class T, size_t M>
+SquareMatrix<T, M> LUFactorization<T,M>::lower() const
+{
+    SquareMatrix<T, M> L;
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < i; ++j)
+        {
+            L(i,j) = lu(i,j);
+        }
+        L(i,i) = T(1);
+    }
+    return L;
+}
+
+//! Upper triangular factor U
+template<class T, size_t M>
+SquareMatrix<T, M> LUFactorization<T,M>::upper() const
+{
+    SquareMatrix<T, M> U;
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = i; j < M; ++j)
+        {
+            U(i,j) = lu(i,j);
+        }
+    }
+    return U;
+}
+
+//! Throw if A is singular
+template<class T, size_t M>
+void LUFactorization<T,M>::checkInvertible(const char *operation) const
+{
+    if(singular)
+    {
+        char message[100];
+        snprintf(message, 100, "ERROR: Matrix is singular (zero pivot in LU factorization). Cannot %s.\n", operation);
+        throw std::runtime_error(message);
+    }
+}
+
+//! Overwrite the rows of X (ldx apart, P columns) with the solution of L U X = X
+template<class T, size_t M>
+void LUFactorization<T,M>::substitute(T *x, size_t ldx, size_t P) const
+{
+    const T *a = &lu(0,0);
+
+    // Forward substitution with the unit lower triangle, whole rows of X at a time
+    for(size_t i = 1; i < M; ++i)
+    {
+        T *xi = x + i*ldx;
+        for(size_t k = 0; k < i; ++k)
+        {
+            subtractScaled(xi, x + k*ldx, a[i*M+k], P);
+        }
+    }
+
+    // Back substitution with the upper triangle
+    for(size_t i = M; i-- > 0;)
+    {
+        T *xi = x + i*ldx;
+        for(size_t k = i+1; k < M; ++k)
+        {
+            subtractScaled(xi, x + k*ldx, a[i*M+k], P);
+        }
+        const T pivot = a[i*M+i];
+        for(size_t j = 0; j < P; ++j)
+        {
+            xi[j] /= pivot;
+        }
+    }
+}
+
+//! y -= alpha*x over n contiguous elements (y and x are distinct rows)
+template<class T, size_t M>
+inline void LUFactorization<T,M>::subtractScaled(T *y, const T *x, T alpha, size_t n)
+{
+    for(size_t j = 0; j < n; ++j)
+    {
+        y[j] -= alpha*x[j];
+    }
+}
+
+} // namespace matrix
+
+#endif // _LU_FACTORIZATION_HPP__
@@ -2,7 +2,9 @@
 //!
 //! @file Matrix.hpp
 //!
-//! Template matrix header
+//! Template matrix header. Layout (RowMajor by default, or ColumnMajor) sets
+//! the order of the elements in storage; every operation gives the same
+//! result for either layout.
 //!
 //! @author David Wallace <jdavidwallace1@gmail.com>
 ///////////////////////////////////////////////////////////////////////////////
@@ -12,30 +14,72 @@
 #include <cmath>
 #include <cstdio>
 #include <cstring>
+#include <initializer_list>
+#include <ostream>
 #include <stdexcept>
+#include <type_traits>
+
+#include "BoundsPolicy.hpp"
+#include "MatrixExpression.hpp"
+#include "MatrixLayout.hpp"
+#include "MatrixStorage.hpp"
+#include "MatrixView.hpp"
+#include "MultiplyKernel.hpp"
 
 
 namespace matrix
 {
 
-template<typename T, size_t M, size_t N>
-class Matrix
+namespace detail
+{
+
+//! Report an initializer list that does not match the matrix shape
+[[noreturn]] inline void throwInvalidArgumentCount(size_t M, size_t N, size_t rows, size_t cols)
+{
+    char message[120];
+    snprintf(message, 120, "ERROR: Invalid number of arguments supplied. Expected [%lu, %lu], Received [%lu, %lu]\n", M, N, rows, cols);
+    throw std::invalid_argument(message);
+}
+
+//! Report an initializer list that does not match the vector length
+[[noreturn]] inline void throwInvalidArgumentCount(size_t M, size_t size)
+{
+    char message[120];
+    snprintf(message, 120, "ERROR: Invalid number of arguments supplied. Expected [%lu], Received [%lu]\n", M, size);
+    throw std::invalid_argument(message);
+}
+
+} // namespace detail
+
+template<typename T, size_t M, size_t N, class Bounds, class Layout>
+class Matrix : public MatrixExpression<Matrix<T, M, N, Bounds, Layout>>
 {
 public:
+    using value_type = T;
+    using plain_type = Matrix<T, M, N, Bounds, Layout>;
+    using bounds_policy = Bounds;
+    using layout = Layout;
+    static constexpr size_t rows = M;
+    static constexpr size_t cols = N;
+
     //! Default constructor
-    Matrix();
+    constexpr Matrix();
 
-    //! Destructor
-    virtual ~Matrix() = default;
+    //! Destructor (non-virtual so matrices stay trivially copyable and carry no vptr)
+    ~Matrix() = default;
 
     //! Constructor initializing with 2-d array of data
-    explicit Matrix(const T values[M][N]);
+    explicit constexpr Matrix(const T values[M][N]);
 
-    //! Constructor initializing with flat array of data
-    explicit Matrix(const T values[M*N]);
+    //! Constructor initializing with flat array of data in storage order (row-major unless Layout is ColumnMajor)
+    explicit constexpr Matrix(const T values[M*N]);
 
     //! Construct using initializer list
-    Matrix(std::initializer_list<std::initializer_list<T>> list);
+    constexpr Matrix(std::initializer_list<std::initializer_list<T>> list);
+
+    //! Construct by evaluating a matrix expression
+    template<class E, typename = std::enable_if_t<detail::IsExpressionOfShape<E, T, M, N>::value>>
+    constexpr Matrix(const MatrixExpression<E> &expr);
 
     //! Copy constructor
     Matrix(const Matrix &other) = default;
@@ -49,71 +93,62 @@ public:
     //! Move assignment
     Matrix& operator=(Matrix&& other) = default;
 
+    //! Assign by evaluating a matrix expression
+    template<class E, typename = std::enable_if_t<detail::IsExpressionOfShape<E, T, M, N>::value>>
+    constexpr Matrix& operator=(const MatrixExpression<E> &expr);
+
     //! Element access operator
-    const T &operator()(size_t i, size_t j) const;
+    constexpr const T &operator()(size_t i, size_t j) const;
 
     //! Element assignment operator
-    T &operator()(size_t i, size_t j);
+    constexpr T &operator()(size_t i, size_t j);
+
+    //! Element access by flat (row-major) index, used by expression evaluation
+    constexpr T coeff(size_t i) const { return data[storageIndex(i)]; }
+
+    //! Element access by index into storage, used by expression evaluation
+    constexpr T storageCoeff(size_t i) const { return data[i]; }
 
     //! Resize method (create new matrix)
     // template<size_t P, size_t Q>
     // Matrix<T, P, Q> resize();
 
-    //! Add two matrices
-    Matrix<T, M, N> operator+(const Matrix<T, M, N> &other) const;
-
-    //! Element-wise matrix subtraction
-    Matrix<T, M, N> operator-(const Matrix<T, M, N> &other) const;
-
     //! Matrix multiply
-    template<size_t P>
-    Matrix<T, M, P> operator*(const Matrix<T, N, P> &other) const;
+    template<size_t P, class B, class L>
+    constexpr Matrix<T, M, P, Bounds, Layout> operator*(const Matrix<T, N, P, B, L> &other) const;
 
     //! Compound addition operator
-    void operator+=(const Matrix<T, M, N> &other);
+    template<class E>
+    constexpr void operator+=(const MatrixExpression<E> &other);
 
     //! Compound subtraction operator
-    void operator-=(const Matrix<T, M, N> &other);
+    template<class E>
+    constexpr void operator-=(const MatrixExpression<E> &other);
 
     //! Compound matrix multiplication
-    template<size_t P>
-    void operator*=(const Matrix<T, N, P> &other);
-
-    //! Unary minus operator
-    Matrix<T, M, N> operator-() const;
-
-    //! Element-wise scalar addition
-    Matrix<T, M, N> operator+(T value) const;
-
-    //! Matrix-scalar subtraction
-    Matrix<T, M, N> operator-(T value) const;
-
-    //! Scalar multiplication
-    Matrix<T, M, N> operator*(T value) const;
-
-    //! Matrix element-wise scalar division
-    Matrix<T, M, N> operator/(T value) const;
+    template<size_t P, class B, class L>
+    constexpr void operator*=(const Matrix<T, N, P, B, L> &other);
 
     //! Compound scalar addition
-    void operator+=(T value);
+    constexpr void operator+=(T value);
 
     //! Compound matrix-scalar subtraction
-    void operator-=(T value);
+    constexpr void operator-=(T value);
 
     //! Compound rhs scalar multiplication
-    void operator*=(T value);
+    constexpr void operator*=(T value);
 
     //! Compound matrix element-wise scalar division
-    void operator/=(T value);
+    constexpr void operator/=(T value);
 
     //! Test equality
-    bool operator==(const Matrix<T, M, N> &other) const;
+    constexpr bool operator==(const Matrix &other) const;
 
     //! Test non-equality
-    bool operator!=(const Matrix<T, M, N> &other) const;
+    constexpr bool operator!=(const Matrix &other) const;
 
     //! Matrix transpose
-    Matrix<T, N, M> transpose() const;
+    constexpr Matrix<T, N, M, Bounds, Layout> transpose() const;
 
     //! Swap rows
     void swapRows(size_t rowA, size_t rowB);
@@ -122,47 +157,111 @@ public:
     void swapCols(size_t colA, size_t colB);
 
     //! Set all elements to value
-    void setValue(T value);
+    constexpr void setValue(T value);
 
     //! Return absolute value of matrix elements
-    Matrix<T, M, N> abs() const;
+    Matrix abs() const;
 
     //! Return submatrix of parent
     template<size_t P, size_t Q>
-    Matrix<T, P, Q> submatrix(size_t rowA, size_t colA, size_t rowB, size_t colB) const;
+    Matrix<T, P, Q, Bounds, Layout> submatrix(size_t rowA, size_t colA, size_t rowB, size_t colB) const;
+
+    //! View of the PxQ block whose top-left element is (i, j)
+    template<size_t P, size_t Q>
+    MatrixView<T, P, Q, Bounds> block(size_t i, size_t j);
+
+    //! Read-only view of the PxQ block whose top-left element is (i, j)
+    template<size_t P, size_t Q>
+    MatrixView<const T, P, Q, Bounds> block(size_t i, size_t j) const;
+
+    //! View of row i
+    MatrixView<T, 1, N, Bounds> row(size_t i);
+
+    //! Read-only view of row i
+    MatrixView<const T, 1, N, Bounds> row(size_t i) const;
+
+    //! View of column j
+    MatrixView<T, M, 1, Bounds> col(size_t j);
+
+    //! Read-only view of column j
+    MatrixView<const T, M, 1, Bounds> col(size_t j) const;
+
+    //! View of the main diagonal as a column
+    MatrixView<T, (M < N ? M : N), 1, Bounds> diagonal();
+
+    //! Read-only view of the main diagonal as a column
+    MatrixView<const T, (M < N ? M : N), 1, Bounds> diagonal() const;
+
+    //! View of the transpose (no elements are copied, unlike transpose())
+    MatrixView<T, N, M, Bounds> transposed();
+
+    //! Read-only view of the transpose (no elements are copied, unlike transpose())
+    MatrixView<const T, N, M, Bounds> transposed() const;
 
 protected:
-    T data[M*N];
+    //! Inline array, or an aligned heap buffer above MTL_HEAP_STORAGE_THRESHOLD bytes
+    detail::MatrixStorage<T, M*N> data;
+
+    // Kernels read and write the storage of differently sized matrices directly
+    template<class, size_t, size_t, class, class>
+    friend class Matrix;
 
 private:
+    //! Index into storage of the element at flat (row-major) index i
+    static constexpr size_t storageIndex(size_t i)
+    {
+        if constexpr(std::is_same<Layout, RowMajor>::value)
+        {
+            return i;
+        }
+        else
+        {
+            return Layout::index(i/N, i%N, M, N);
+        }
+    }
+
+    //! Apply op(element, value) to every element with the value of the same element of e
+    template<class E, class Op>
+    constexpr void assignExpression(const E &e, Op op);
 }; // class Matrix
 
+// Matrices are plain arrays of T: no vptr, no padding, and safe to memcpy
+static_assert(sizeof(Matrix<float, 3, 3>) == 9*sizeof(float), "Matrix must not carry anything beyond its elements");
+static_assert(std::is_standard_layout<Matrix<double, 3, 3>>::value, "Matrix must be standard-layout");
+static_assert(std::is_trivially_copyable<Matrix<double, 3, 3>>::value, "Matrix must be trivially copyable");
+
+// Column-major matrices are the same plain arrays in a different order
+static_assert(sizeof(Matrix<float, 3, 3, DefaultBounds, ColumnMajor>) == 9*sizeof(float), "Layout must not add anything to a Matrix");
+
+// Large matrices hold only a pointer to their elements and move without copying them
+static_assert(sizeof(Matrix<double, 100, 100>) == sizeof(double *), "Large matrices must keep their elements on the heap");
+static_assert(std::is_nothrow_move_constructible<Matrix<double, 100, 100>>::value, "Large matrices must move without allocating");
+
 //! Default constructor
-template<class T, size_t M, size_t N>
-Matrix<T,M,N>::Matrix()
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+constexpr Matrix<T,M,N,Bounds,Layout>::Matrix():
+    data{}
 {
-    for(size_t i = 0; i < M*N; ++i)
-    {
-        data[i] = (T)0;
-    }
 }
 
 //! Constructor initializing with 2-d array of data
-template<class T, size_t M, size_t N>
-Matrix<T,M,N>::Matrix(const T values[M][N])
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+constexpr Matrix<T,M,N,Bounds,Layout>::Matrix(const T values[M][N]):
+    data{}
 {
     for(size_t i = 0; i < M; ++i)
     {
         for(size_t j = 0; j < N; ++j)
         {
-            data[i*N+j] = values[i][j];
+            data[Layout::index(i,j,M,N)] = values[i][j];
         }
     }
 }
 
 //! Constructor initializing with flat array of data
-template<class T, size_t M, size_t N>
-Matrix<T,M,N>::Matrix(const T values[M*N])
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+constexpr Matrix<T,M,N,Bounds,Layout>::Matrix(const T values[M*N]):
+    data{}
 {
     for(size_t i = 0; i < M*N; ++i)
     {
@@ -171,16 +270,15 @@ Matrix<T,M,N>::Matrix(const T values[M*N])
 }
 
 //! Construct using initializer list
-template<class T, size_t M, size_t N>
-Matrix<T,M,N>::Matrix(std::initializer_list<std::initializer_list<T>> list)
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+constexpr Matrix<T,M,N,Bounds,Layout>::Matrix(std::initializer_list<std::initializer_list<T>> list):
+    data{}
 {
     size_t listcols = static_cast<size_t>(list.begin()->size());
     size_t listrows = static_cast<size_t>(list.size());
     if(listrows != M || listcols != N)
     {
-        char message[120];
-        snprintf(message, 120, "ERROR: Invalid number of arguments supplied. Expected [%lu, %lu], Received [%lu, %lu]\n", M, N, listrows, listcols);
-        throw std::invalid_argument(message);
+        detail::throwInvalidArgumentCount(M, N, listrows, listcols);
     }
 
     auto outeriter = list.begin();
@@ -192,175 +290,102 @@ Matrix<T,M,N>::Matrix(std::initializer_list<std::initializer_list<T>> list)
             // Keep for posterity
             // data[i*N+j] = ((list.begin()+i)->begin())[j];
             // data[i*N+j] = ((iter+i)->begin())[j];
-            data[i*N+j] = inneriter[j];
+            data[Layout::index(i,j,M,N)] = inneriter[j];
         }
     }
 }
 
-//! Element access operator
-template<class T, size_t M, size_t N>
-const T &Matrix<T,M,N>::operator()(size_t i, size_t j) const
+//! Construct by evaluating a matrix expression
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+template<class E, typename>
+constexpr Matrix<T,M,N,Bounds,Layout>::Matrix(const MatrixExpression<E> &expr):
+    data{}
 {
-    if(i >= M || j >= N)
-    {
-        char message[110];
-        snprintf(message, 110, 
-            "ERROR: Matrix index access out of range. Size [%ld, %ld], Received [%ld, %ld]\n", M, N, i, j);
-        throw std::domain_error(message);
-    }
-    return data[i*N+j];
+    assignExpression(expr.derived(), [](T &element, T value) { element = value; });
 }
 
-//! Element assignment operator
-template<class T, size_t M, size_t N>
-T &Matrix<T,M,N>::operator()(size_t i, size_t j)
+//! Assign by evaluating a matrix expression
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+template<class E, typename>
+constexpr Matrix<T,M,N,Bounds,Layout> &Matrix<T,M,N,Bounds,Layout>::operator=(const MatrixExpression<E> &expr)
 {
-    if(i >= M || j >= N)
-    {
-        char message[110];
-        snprintf(message, 110, 
-            "ERROR: Matrix index access out of range. Size [%ld, %ld], Received [%ld, %ld]\n", M, N, i, j);
-        throw std::domain_error(message);
-    }
-    return data[i*N+j];
+    assignExpression(expr.derived(), [](T &element, T value) { element = value; });
+    return *this;
 }
 
-//! Add two matrices
-template<class T, size_t M, size_t N>
-Matrix<T,M,N> Matrix<T,M,N>::operator+(const Matrix<T, M, N> &other) const
+//! Element access operator
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+constexpr const T &Matrix<T,M,N,Bounds,Layout>::operator()(size_t i, size_t j) const
 {
-    Matrix<T, M, N> result;
-    for(size_t i = 0; i < M*N; ++i)
-    {
-        result.data[i] = data[i] + other.data[i];
-    }
-    return result;
+    Bounds::check(i, j, M, N);
+    return data[Layout::index(i,j,M,N)];
 }
 
-//! Subtract other from this
-template<class T, size_t M, size_t N>
-Matrix<T,M,N> Matrix<T,M,N>::operator-(const Matrix<T, M, N> &other) const
+//! Element assignment operator
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+constexpr T &Matrix<T,M,N,Bounds,Layout>::operator()(size_t i, size_t j)
 {
-    Matrix<T, M, N> result;
-    for(size_t i = 0; i < M*N; ++i)
-    {
-        result.data[i] = data[i] - other.data[i];
-    }
-    return result;
+    Bounds::check(i, j, M, N);
+    return data[Layout::index(i,j,M,N)];
 }
 
 //! Matrix multiplication
-template<class T, size_t M, size_t N>
-template<size_t P>
-Matrix<T,M,P> Matrix<T,M,N>::operator*(const Matrix<T, N, P> &other) const
-{
-    const Matrix<T, M, N> &self = *this;
-    Matrix<T, M, P> result;
-    for(size_t i = 0; i < M; ++i)
-    {
-        for(size_t j = 0; j < P; ++j)
-        {
-            for(size_t k = 0; k < N; ++k)
-            {
-                result(i,j) += self(i,k) * other(k,j);
-            }
-        }
-    }
-    return result;
-}
-
-//! Compound addition operator
-template<class T, size_t M, size_t  N>
-void Matrix<T,M,N>::operator+=(const Matrix<T, M, N> &other)
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+template<size_t P, class B, class L>
+constexpr Matrix<T, M, P, Bounds, Layout> Matrix<T,M,N,Bounds,Layout>::operator*(const Matrix<T, N, P, B, L> &other) const
 {
-    for(size_t i = 0; i < M*N; ++i)
+    Matrix<T, M, P, Bounds, Layout> result;
+    if constexpr(std::is_same<Layout, RowMajor>::value && std::is_same<L, RowMajor>::value)
     {
-        data[i] += other.data[i];
+        detail::MultiplyKernel<T, M, N, P>::apply(data, other.data, result.data);
     }
-}
-
-//! Compound subtraction operator
-template<class T, size_t M, size_t N>
-void Matrix<T,M,N>::operator-=(const Matrix<T, M, N> &other)
-{
-    for(size_t i = 0; i < M*N; ++i)
+    else if constexpr(std::is_same<Layout, ColumnMajor>::value && std::is_same<L, ColumnMajor>::value)
     {
-        data[i] -= other.data[i];
+        // Column-major storage of C = A*B is row-major storage of C^T = B^T * A^T
+        detail::MultiplyKernel<T, P, N, M>::apply(other.data, data, result.data);
     }
-}
-
-//! Compound matrix multiplication
-template<class T, size_t M, size_t N>
-template<size_t P>
-void Matrix<T,M,N>::operator*=(const Matrix<T, N, P> &other)
-{
-    (*this) = (*this) * other;
-}
-
-//! Unary minus operator
-template<class T, size_t M, size_t N>
-Matrix<T,M,N> Matrix<T,M,N>::operator-() const
-{
-    Matrix<T, M, N> result;
-    for(size_t i = 0; i < M*N; ++i)
+    else if constexpr(std::is_same<Layout, RowMajor>::value)
     {
-        result.data[i] = -data[i];
+        detail::StridedMultiplyKernel<T, M, N, P>::apply(data, Layout::rowStride(M, N), Layout::colStride(M, N),
+            other.data, L::rowStride(N, P), L::colStride(N, P), result.data);
     }
-    return result;
-}
-
-//! Element-wise scalar addition
-template<class T, size_t M, size_t N>
-Matrix<T, M, N> Matrix<T,M,N>::operator+(T value) const
-{
-    Matrix<T, M, N> result;
-    for(size_t i = 0; i < M*N; ++i)
+    else
     {
-        result.data[i] = data[i] + value;
+        detail::StridedMultiplyKernel<T, P, N, M>::apply(other.data, L::colStride(N, P), L::rowStride(N, P),
+            data, Layout::colStride(M, N), Layout::rowStride(M, N), result.data);
     }
     return result;
 }
 
-//! Matrix-scalar subtraction
-template<class T, size_t M, size_t N>
-Matrix<T, M, N> Matrix<T,M,N>::operator-(T value) const
+//! Compound addition operator
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+template<class E>
+constexpr void Matrix<T,M,N,Bounds,Layout>::operator+=(const MatrixExpression<E> &other)
 {
-    Matrix<T, M, N> result;
-    for(size_t i = 0; i < M*N; ++i)
-    {
-        result.data[i] = data[i] - value;
-    }
-    return result;
+    static_assert(detail::IsExpressionOfShape<E, T, M, N>::value, "Compound addition requires operands of the same type and shape");
+    assignExpression(other.derived(), [](T &element, T value) { element += value; });
 }
 
-//! Scalar multiplication
-template<class T, size_t M, size_t N>
-Matrix<T, M, N> Matrix<T,M,N>::operator*(T value) const
+//! Compound subtraction operator
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+template<class E>
+constexpr void Matrix<T,M,N,Bounds,Layout>::operator-=(const MatrixExpression<E> &other)
 {
-    // const Matrix<T, M, N> &self = *this;
-    Matrix<T, M, N> result;
-    for(size_t i = 0; i < M*N; ++i)
-    {
-        result.data[i] = data[i] * value;
-    }
-    return result;
+    static_assert(detail::IsExpressionOfShape<E, T, M, N>::value, "Compound subtraction requires operands of the same type and shape");
+    assignExpression(other.derived(), [](T &element, T value) { element -= value; });
 }
 
-//! Matrix element-wise scalar division
-template<class T, size_t M, size_t N>
-Matrix<T, M, N> Matrix<T,M,N>::operator/(T value) const
+//! Compound matrix multiplication
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+template<size_t P, class B, class L>
+constexpr void Matrix<T,M,N,Bounds,Layout>::operator*=(const Matrix<T, N, P, B, L> &other)
 {
-    Matrix<T, M, N> result;
-    for(size_t i = 0; i < M*N; ++i)
-    {
-        result.data[i] = (T)(data[i] / value);
-    }
-    return result;
+    (*this) = (*this) * other;
 }
 
 //! Compound scalar addition
-template<class T, size_t M, size_t N>
-void Matrix<T,M,N>::operator+=(T value)
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+constexpr void Matrix<T,M,N,Bounds,Layout>::operator+=(T value)
 {
     for(size_t i = 0; i < M*N; ++i)
     {
@@ -369,8 +394,8 @@ void Matrix<T,M,N>::operator+=(T value)
 }
 
 //! Compound matrix-scalar subtraction
-template<class T, size_t M, size_t N>
-void Matrix<T,M,N>::operator-=(T value)
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+constexpr void Matrix<T,M,N,Bounds,Layout>::operator-=(T value)
 {
     for(size_t i = 0; i < M*N; ++i)
     {
@@ -379,8 +404,8 @@ void Matrix<T,M,N>::operator-=(T value)
 }
 
 //! Compound rhs scalar multiplication
-template<class T, size_t M, size_t N>
-void Matrix<T,M,N>::operator*=(T value)
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+constexpr void Matrix<T,M,N,Bounds,Layout>::operator*=(T value)
 {
     for(size_t i = 0; i < M*N; ++i)
     {
@@ -389,8 +414,8 @@ void Matrix<T,M,N>::operator*=(T value)
 }
 
 //! Compound matrix element-wise scalar division
-template<class T, size_t M, size_t N>
-void Matrix<T,M,N>::operator/=(T value)
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+constexpr void Matrix<T,M,N,Bounds,Layout>::operator/=(T value)
 {
     for(size_t i = 0; i < M*N; ++i)
     {
@@ -399,8 +424,8 @@ void Matrix<T,M,N>::operator/=(T value)
 }
 
 //! Test equality
-template<class T, size_t M, size_t N>
-bool Matrix<T,M,N>::operator==(const Matrix<T, M, N> &other) const
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+constexpr bool Matrix<T,M,N,Bounds,Layout>::operator==(const Matrix &other) const
 {
     for(size_t i = 0; i < M*N; ++i)
     {
@@ -413,31 +438,30 @@ bool Matrix<T,M,N>::operator==(const Matrix<T, M, N> &other) const
 }
 
 //! Test non-equality
-template<class T, size_t M, size_t N>
-bool Matrix<T,M,N>::operator!=(const Matrix<T, M, N> &other) const
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+constexpr bool Matrix<T,M,N,Bounds,Layout>::operator!=(const Matrix &other) const
 {
     return !(*this == other);
 }
 
 //! Matrix transpose
-template<class T, size_t M, size_t N>
-Matrix<T, N, M> Matrix<T,M,N>::transpose() const
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+constexpr Matrix<T, N, M, Bounds, Layout> Matrix<T,M,N,Bounds,Layout>::transpose() const
 {
-    Matrix<T, N, M> result;
-    const Matrix<T, M, N> &self = *this;
+    Matrix<T, N, M, Bounds, Layout> result;
     for(size_t i = 0; i < M; ++i)
     {
         for(size_t j = 0; j < N; ++j)
         {
-            result(j,i) = self(i,j);
+            result.data[Layout::index(j,i,N,M)] = data[Layout::index(i,j,M,N)];
         }
     }
     return result;
 }
 
 //! Swap rows
-template<class T, size_t M, size_t N>
-void Matrix<T,M,N>::swapRows(size_t rowA, size_t rowB)
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+void Matrix<T,M,N,Bounds,Layout>::swapRows(size_t rowA, size_t rowB)
 {
     if(rowA >= M || rowB >= M)
     {
@@ -447,18 +471,17 @@ void Matrix<T,M,N>::swapRows(size_t rowA, size_t rowB)
         throw std::domain_error(message);
     }
 
-    Matrix<T, M, N> &self = *this;
     for(size_t i = 0; i < N; ++i)
     {
-        T temp = self(rowA, i);
-        self(rowA, i) = self(rowB, i);
-        self(rowB, i) = temp;
+        T temp = data[Layout::index(rowA,i,M,N)];
+        data[Layout::index(rowA,i,M,N)] = data[Layout::index(rowB,i,M,N)];
+        data[Layout::index(rowB,i,M,N)] = temp;
     }
 }
 
 //! Swap columns
-template<class T, size_t M, size_t N>
-void Matrix<T,M,N>::swapCols(size_t colA, size_t colB)
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+void Matrix<T,M,N,Bounds,Layout>::swapCols(size_t colA, size_t colB)
 {
     if(colA >= N || colB >= N)
     {
@@ -468,35 +491,29 @@ void Matrix<T,M,N>::swapCols(size_t colA, size_t colB)
             throw std::domain_error(message);
     }
 
-    Matrix<T, M, N> &self = *this;
     for(size_t i = 0; i < M; ++i)
     {
-        T temp = self(i, colA);
-        self(i, colA) = self(i, colB);
-        self(i, colB) = temp;
+        T temp = data[Layout::index(i,colA,M,N)];
+        data[Layout::index(i,colA,M,N)] = data[Layout::index(i,colB,M,N)];
+        data[Layout::index(i,colB,M,N)] = temp;
     }
 }
 
 //! Set all elements to value
-template<class T, size_t M, size_t N>
-void Matrix<T,M,N>::setValue(T value)
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+constexpr void Matrix<T,M,N,Bounds,Layout>::setValue(T value)
 {
-    Matrix<T, M, N> &self = *this;
-    for(size_t i = 0; i < M; ++i)
+    for(size_t i = 0; i < M*N; ++i)
     {
-        for(size_t j = 0; j < N; ++j)
-        {
-            self(i,j) = value;
-        }
+        data[i] = value;
     }
 }
 
 //! Return absolute value of matrix elements
-template<class T, size_t M, size_t N>
-Matrix<T, M, N> Matrix<T,M,N>::abs() const
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+Matrix<T, M, N, Bounds, Layout> Matrix<T,M,N,Bounds,Layout>::abs() const
 {
-    const Matrix<T, M, N> &self = *this;
-    Matrix<T, M, N> result;
+    Matrix<T, M, N, Bounds, Layout> result;
     for(size_t i = 0; i < M*N; ++i)
     {
         result.data[i] = (T)std::fabs(data[i]);
@@ -505,9 +522,9 @@ Matrix<T, M, N> Matrix<T,M,N>::abs() const
 }
 
 //! Return submatrix of parent
-template<class T, size_t M, size_t N>
+template<class T, size_t M, size_t N, class Bounds, class Layout>
 template<size_t P, size_t Q>
-Matrix<T, P, Q> Matrix<T,M,N>::submatrix(size_t rowA, size_t colA, size_t rowB, size_t colB) const
+Matrix<T, P, Q, Bounds, Layout> Matrix<T,M,N,Bounds,Layout>::submatrix(size_t rowA, size_t colA, size_t rowB, size_t colB) const
 {
     if(P >= M || Q >= N)
     {
@@ -524,27 +541,142 @@ Matrix<T, P, Q> Matrix<T,M,N>::submatrix(size_t rowA, size_t colA, size_t rowB,
         throw std::domain_error(message);
     }
 
-    Matrix<T, P, Q> res;
-    const Matrix<T, M, N> &self = *this;
+    Matrix<T, P, Q, Bounds, Layout> res;
     for(size_t i = rowA; i < rowB; ++i)
     {
         for(size_t j = colA; j < colB; ++j)
         {
-            res(i-rowA, j-colA) = self(i,j);
+            res.data[Layout::index(i-rowA,j-colA,P,Q)] = data[Layout::index(i,j,M,N)];
         }
     }
     return res;
 }
 
-template<class T, size_t M, size_t N>
-Matrix<T, M, N> operator*(T value, const Matrix<T, M, N> &other)
+//! Apply op(element, value) to every element with the value of the same element of e
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+template<class E, class Op>
+constexpr void Matrix<T,M,N,Bounds,Layout>::assignExpression(const E &e, Op op)
 {
-    return other * value;
+    if constexpr(std::is_same<typename detail::ExpressionLayout<E>::type, Layout>::value)
+    {
+        // Every matrix in e is stored like this one: walk the storage in order
+        for(size_t i = 0; i < M*N; ++i)
+        {
+            op(data[i], e.storageCoeff(i));
+        }
+    }
+    else
+    {
+        for(size_t i = 0; i < M*N; ++i)
+        {
+            op(data[storageIndex(i)], e.coeff(i));
+        }
+    }
+}
+
+//! View of the PxQ block whose top-left element is (i, j)
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+template<size_t P, size_t Q>
+MatrixView<T, P, Q, Bounds> Matrix<T,M,N,Bounds,Layout>::block(size_t i, size_t j)
+{
+    static_assert(P <= M && Q <= N, "Block must fit inside the matrix");
+    Bounds::check(i + P - 1, j + Q - 1, M, N);
+    return MatrixView<T, P, Q, Bounds>(data + Layout::index(i,j,M,N), Layout::rowStride(M, N), Layout::colStride(M, N));
+}
+
+//! Read-only view of the PxQ block whose top-left element is (i, j)
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+template<size_t P, size_t Q>
+MatrixView<const T, P, Q, Bounds> Matrix<T,M,N,Bounds,Layout>::block(size_t i, size_t j) const
+{
+    static_assert(P <= M && Q <= N, "Block must fit inside the matrix");
+    Bounds::check(i + P - 1, j + Q - 1, M, N);
+    return MatrixView<const T, P, Q, Bounds>(data + Layout::index(i,j,M,N), Layout::rowStride(M, N), Layout::colStride(M, N));
+}
+
+//! View of row i
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+MatrixView<T, 1, N, Bounds> Matrix<T,M,N,Bounds,Layout>::row(size_t i)
+{
+    return block<1, N>(i, 0);
+}
+
+//! Read-only view of row i
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+MatrixView<const T, 1, N, Bounds> Matrix<T,M,N,Bounds,Layout>::row(size_t i) const
+{
+    return block<1, N>(i, 0);
+}
+
+//! View of column j
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+MatrixView<T, M, 1, Bounds> Matrix<T,M,N,Bounds,Layout>::col(size_t j)
+{
+    return block<M, 1>(0, j);
+}
+
+//! Read-only view of column j
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+MatrixView<const T, M, 1, Bounds> Matrix<T,M,N,Bounds,Layout>::col(size_t j) const
+{
+    return block<M, 1>(0, j);
+}
+
+//! View of the main diagonal as a column
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+MatrixView<T, (M < N ? M : N), 1, Bounds> Matrix<T,M,N,Bounds,Layout>::diagonal()
+{
+    return MatrixView<T, (M < N ? M : N), 1, Bounds>(data, Layout::rowStride(M, N) + Layout::colStride(M, N), 1);
+}
+
+//! Read-only view of the main diagonal as a column
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+MatrixView<const T, (M < N ? M : N), 1, Bounds> Matrix<T,M,N,Bounds,Layout>::diagonal() const
+{
+    return MatrixView<const T, (M < N ? M : N), 1, Bounds>(data, Layout::rowStride(M, N) + Layout::colStride(M, N), 1);
+}
+
+//! View of the transpose (no elements are copied, unlike transpose())
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+MatrixView<T, N, M, Bounds> Matrix<T,M,N,Bounds,Layout>::transposed()
+{
+    return MatrixView<T, N, M, Bounds>(data, Layout::colStride(M, N), Layout::rowStride(M, N));
+}
+
+//! Read-only view of the transpose (no elements are copied, unlike transpose())
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+MatrixView<const T, N, M, Bounds> Matrix<T,M,N,Bounds,Layout>::transposed() const
+{
+    return MatrixView<const T, N, M, Bounds>(data, Layout::colStride(M, N), Layout::rowStride(M, N));
+}
+
+//! Matrix multiply where at least one operand is an unevaluated expression or a view
+template<class L, class R, typename = std::enable_if_t<
+    (!std::is_same<L, typename L::plain_type>::value || !std::is_same<R, typename R::plain_type>::value)
+    && std::is_same<typename L::value_type, typename R::value_type>::value && L::cols == R::rows>>
+constexpr Matrix<typename L::value_type, L::rows, R::cols> operator*(const MatrixExpression<L> &lhs, const MatrixExpression<R> &rhs)
+{
+    // Evaluate expression operands once; matrices and views are read in place
+    const auto &a = detail::evaluateOperand(lhs.derived());
+    const auto &b = detail::evaluateOperand(rhs.derived());
+    using A = detail::StridedOperand<std::decay_t<decltype(a)>>;
+    using B = detail::StridedOperand<std::decay_t<decltype(b)>>;
+    if constexpr(!A::view && !B::view)
+    {
+        return a * b;
+    }
+    else
+    {
+        Matrix<typename L::value_type, L::rows, R::cols> result;
+        detail::StridedMultiplyKernel<typename L::value_type, L::rows, L::cols, R::cols>::apply(
+            A::pointer(a), A::rowStride(a), A::colStride(a), B::pointer(b), B::rowStride(b), B::colStride(b), &result(0,0));
+        return result;
+    }
 }
 
 //! TODO: move this method into non-flight utilities module?
-template<class T, size_t M, size_t N>
-std::ostream& operator<<(std::ostream &os, const matrix::Matrix<T, M, N> &mat)
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+std::ostream& operator<<(std::ostream &os, const matrix::Matrix<T, M, N, Bounds, Layout> &mat)
 {
     for(size_t i = 0; i < M; ++i)
     {
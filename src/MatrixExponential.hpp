@@ -0,0 +1,382 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file MatrixExponential.hpp
+//!
+//! Matrix exponential e^A, e.g. the state transition matrix of continuous
+//! linear dynamics:
+//!
+//!   expm(A)      scaling and squaring with a [m/m] Pade approximant, the
+//!                degree m in {3, 5, 7, 9, 13} and the number of squarings
+//!                chosen from the 1-norm of A (Higham 2005). 3x3 skew
+//!                matrices (Rodrigues) and 4x4 quaternion rate matrices,
+//!                whose square is -theta^2 I, are recognized and take a
+//!                closed form.
+//!   expmv(A, v)  e^A v from a truncated Taylor series in A/s applied s
+//!                times (Al-Mohy and Higham 2011). It needs only products
+//!                A x, never e^A itself.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _MATRIX_EXPONENTIAL_HPP__
+#define _MATRIX_EXPONENTIAL_HPP__
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include "Matrix.hpp"
+#include "SquareMatrix.hpp"
+#include "Vector.hpp"
+#include "Vector3.hpp"
+#include "LUFactorization.hpp"
+
+namespace matrix
+{
+
+namespace detail
+{
+
+//! Largest column sum of |A|
+template<class T, size_t M>
+T normOne(const SquareMatrix<T, M> &A)
+{
+    T largest = 0;
+    for(size_t j = 0; j < M; ++j)
+    {
+        T sum = 0;
+        for(size_t i = 0; i < M; ++i)
+        {
+            sum += std::fabs(A(i,j));
+        }
+        largest = sum > largest ? sum : largest;
+    }
+    return largest;
+}
+
+//! Largest |x_i|
+template<class T, size_t M>
+T normInf(const Matrix<T, M, 1> &x)
+{
+    T largest = 0;
+    for(size_t i = 0; i < M; ++i)
+    {
+        const T a = std::fabs(x(i,0));
+        largest = a > largest ? a : largest;
+    }
+    return largest;
+}
+
+//! Set C = sum of c[k] P[k] over n matrices
+template<class T, size_t M>
+void combine(SquareMatrix<T, M> &C, const T *c, const SquareMatrix<T, M> *const *P, size_t n)
+{
+    T *out = &C(0,0);
+    for(size_t e = 0; e < M*M; ++e)
+    {
+        T sum = 0;
+        for(size_t k = 0; k < n; ++k)
+        {
+            sum += c[k]*(&(*P[k])(0,0))[e];
+        }
+        out[e] = sum;
+    }
+}
+
+//! e^A by Rodrigues' formula when A is skew-symmetric; false otherwise
+template<class T>
+bool expmSkew(const SquareMatrix<T, 3> &A, SquareMatrix<T, 3> &E)
+{
+    if(A(0,0) != 0 || A(1,1) != 0 || A(2,2) != 0 ||
+       A(1,0) != -A(0,1) || A(2,0) != -A(0,2) || A(2,1) != -A(1,2))
+    {
+        return false;
+    }
+
+    // e^A = I + sin(theta)/theta A + (1 - cos(theta))/theta^2 A^2, A = w~
+    const Vector3<T> w(A(2,1), A(0,2), A(1,0));
+    const T theta = w.norm();
+    E.identity();
+    if(theta == 0)
+    {
+        return true;
+    }
+    const T half = std::sin(theta / 2) / theta;
+    const T a = std::sin(theta) / theta;
+    const T b = 2*half*half;
+    const SquareMatrix<T, 3> W = w.tilde();
+    const SquareMatrix<T, 3> W2 = W*W;
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < 3; ++j)
+        {
+            E(i,j) += a*W(i,j) + b*W2(i,j);
+        }
+    }
+    return true;
+}
+
+//! e^A in closed form when A is a quaternion rate matrix, the matrix of
+//! q -> 0.5 q * (0, w) or q -> 0.5 (0, w) * q; false otherwise
+template<class T>
+bool expmQuaternionRate(const SquareMatrix<T, 4> &A, SquareMatrix<T, 4> &E)
+{
+    for(size_t i = 0; i < 4; ++i)
+    {
+        if(A(i,i) != 0)
+        {
+            return false;
+        }
+        for(size_t j = i + 1; j < 4; ++j)
+        {
+            if(A(j,i) != -A(i,j))
+            {
+                return false;
+            }
+        }
+    }
+
+    // Below the first row and column sits +/- the tilde matrix of the first column
+    const T w1 = A(1,0);
+    const T w2 = A(2,0);
+    const T w3 = A(3,0);
+    const bool left = A(2,1) == w3 && A(3,1) == -w2 && A(3,2) == w1;
+    const bool right = A(2,1) == -w3 && A(3,1) == w2 && A(3,2) == -w1;
+    if(!left && !right)
+    {
+        return false;
+    }
+
+    // A^2 = -theta^2 I, so e^A = cos(theta) I + sin(theta)/theta A
+    const T theta = std::sqrt(w1*w1 + w2*w2 + w3*w3);
+    const T c = std::cos(theta);
+    const T s = theta == 0 ? T(1) : std::sin(theta) / theta;
+    for(size_t i = 0; i < 4; ++i)
+    {
+        for(size_t j = 0; j < 4; ++j)
+        {
+            E(i,j) = s*A(i,j) + (i == j ? c : T(0));
+        }
+    }
+    return true;
+}
+
+//! Solve q(A) X = p(A) for the Pade approximant X, with p(A) = V + U and q(A) = V - U
+template<class T, size_t M>
+SquareMatrix<T, M> padeQuotient(const SquareMatrix<T, M> &V, const SquareMatrix<T, M> &U)
+{
+    SquareMatrix<T, M> numerator;
+    SquareMatrix<T, M> denominator;
+    for(size_t e = 0; e < M*M; ++e)
+    {
+        (&numerator(0,0))[e] = (&V(0,0))[e] + (&U(0,0))[e];
+        (&denominator(0,0))[e] = (&V(0,0))[e] - (&U(0,0))[e];
+    }
+    return LUFactorization<T, M>(denominator).solve(numerator);
+}
+
+//! e^A by scaling and squaring with a Pade approximant. X is a SquareMatrix,
+//! or any type closed under multiplication that has identity(), *= and the
+//! normOne, combine and padeQuotient overloads (e.g. a block-structured
+//! matrix whose products skip known zero blocks).
+template<class X>
+X expmPade(const X &A)
+{
+    using T = typename X::value_type;
+
+    // Largest 1-norm for which each degree meets double precision
+    static const T theta[5] = {T(1.495585217958292e-2), T(2.539398330063230e-1), T(9.504178996162932e-1),
+                               T(2.097847961257068e0), T(5.371920351148152e0)};
+    static const T b3[4] = {120, 60, 12, 1};
+    static const T b5[6] = {30240, 15120, 3360, 420, 30, 1};
+    static const T b7[8] = {17297280, 8648640, 1995840, 277200, 25200, 1512, 56, 1};
+    static const T b9[10] = {T(17643225600.0), T(8821612800.0), T(2075673600.0), T(302702400.0), T(30270240.0),
+                             T(2162160.0), T(110880.0), T(3960.0), T(90.0), T(1.0)};
+    static const T b13[14] = {T(64764752532480000.0), T(32382376266240000.0), T(7771770303897600.0),
+                              T(1187353796428800.0), T(129060195264000.0), T(10559470521600.0),
+                              T(670442572800.0), T(33522128640.0), T(1323241920.0), T(40840800.0),
+                              T(960960.0), T(16380.0), T(182.0), T(1.0)};
+
+    X I;
+    I.identity();
+    const T norm = normOne(A);
+
+    // U holds the odd and V the even powers of the numerator p(A) = V + U;
+    // the denominator is q(A) = V - U
+    X U;
+    X V;
+    size_t squarings = 0;
+    const X A2 = A*A;
+    if(norm <= theta[3])
+    {
+        const T *b = b3;
+        size_t m = 3;
+        if(norm > theta[0])
+        {
+            b = norm <= theta[1] ? b5 : (norm <= theta[2] ? b7 : b9);
+            m = norm <= theta[1] ? 5 : (norm <= theta[2] ? 7 : 9);
+        }
+
+        // Powers I, A^2, A^4, ... up to A^(m-1)
+        X powers[5];
+        powers[0] = I;
+        powers[1] = A2;
+        for(size_t k = 2; k <= m/2; ++k)
+        {
+            powers[k] = powers[k-1]*A2;
+        }
+        const X *P[5] = {&powers[0], &powers[1], &powers[2], &powers[3], &powers[4]};
+        T odd[5];
+        T even[5];
+        for(size_t k = 0; k <= m/2; ++k)
+        {
+            odd[k] = b[2*k+1];
+            even[k] = b[2*k];
+        }
+        X W;
+        combine(W, odd, P, m/2 + 1);
+        U = A*W;
+        combine(V, even, P, m/2 + 1);
+    }
+    else
+    {
+        // Scale so that |A / 2^s| <= theta_13, then square s times
+        const T ratio = norm / theta[4];
+        squarings = ratio > 1 ? static_cast<size_t>(std::ceil(std::log2(ratio))) : 0;
+        const T scale = std::ldexp(T(1), -static_cast<int>(squarings));
+        const T scale2 = scale*scale;
+        X As = A;
+        X B2 = A2;
+        As *= scale;
+        B2 *= scale2;
+        const X B4 = B2*B2;
+        const X B6 = B4*B2;
+
+        const X *high[3] = {&B2, &B4, &B6};
+        const T oddHigh[3] = {b13[9], b13[11], b13[13]};
+        const T evenHigh[3] = {b13[8], b13[10], b13[12]};
+        X W;
+        combine(W, oddHigh, high, 3);
+        X Z;
+        combine(Z, evenHigh, high, 3);
+
+        const X W6 = B6*W;
+        const X Z6 = B6*Z;
+        const X *low[5] = {&W6, &I, &B2, &B4, &B6};
+        const T oddLow[5] = {1, b13[1], b13[3], b13[5], b13[7]};
+        const T evenLow[5] = {1, b13[0], b13[2], b13[4], b13[6]};
+        combine(W, oddLow, low, 5);
+        U = As*W;
+        low[0] = &Z6;
+        combine(V, evenLow, low, 5);
+    }
+
+    X E = padeQuotient(V, U);
+    for(size_t k = 0; k < squarings; ++k)
+    {
+        E = E*E;
+    }
+    return E;
+}
+
+} // namespace detail
+
+//! Matrix exponential e^A
+template<class T, size_t M>
+SquareMatrix<T, M> expm(const SquareMatrix<T, M> &A)
+{
+    static_assert(std::is_floating_point<T>::value, "expm needs a floating-point type");
+    if constexpr(M == 1)
+    {
+        SquareMatrix<T, 1> E;
+        E(0,0) = std::exp(A(0,0));
+        return E;
+    }
+    else if constexpr(M == 3)
+    {
+        SquareMatrix<T, 3> E;
+        if(detail::expmSkew(A, E))
+        {
+            return E;
+        }
+    }
+    else if constexpr(M == 4)
+    {
+        SquareMatrix<T, 4> E;
+        if(detail::expmQuaternionRate(A, E))
+        {
+            return E;
+        }
+    }
+    return detail::expmPade(A);
+}
+
+//! e^A v, without forming e^A
+template<class T, size_t M>
+Vector<T, M> expmv(const SquareMatrix<T, M> &A, const Matrix<T, M, 1> &v)
+{
+    static_assert(std::is_floating_point<T>::value, "expmv needs a floating-point type");
+
+    // Largest 1-norm of A/s for which a Taylor series of degree m meets double
+    // precision, m = 1, ..., 30
+    static const T theta[30] = {T(2.29e-16), T(2.58e-8), T(1.39e-5), T(3.40e-4), T(2.40e-3), T(9.07e-3),
+                                T(2.38e-2), T(5.00e-2), T(8.96e-2), T(1.44e-1), T(2.14e-1), T(3.00e-1),
+                                T(4.00e-1), T(5.14e-1), T(6.41e-1), T(7.81e-1), T(9.31e-1), T(1.09),
+                                T(1.26), T(1.44), T(1.62), T(1.82), T(2.01), T(2.22), T(2.43), T(2.64),
+                                T(2.86), T(3.08), T(3.31), T(3.54)};
+
+    // e^A v = e^mu e^(A - mu I) v; the shift by the mean eigenvalue shrinks the norm
+    const T mu = A.trace() / static_cast<T>(M);
+    SquareMatrix<T, M> B = A;
+    for(size_t i = 0; i < M; ++i)
+    {
+        B(i,i) -= mu;
+    }
+    const T norm = detail::normOne(B);
+
+    // Fewest products m s over degrees m with s = ceil(norm / theta_m) steps
+    size_t degree = 0;
+    size_t steps = 1;
+    if(norm > 0)
+    {
+        size_t best = 0;
+        for(size_t m = 1; m <= 30; ++m)
+        {
+            const size_t s = static_cast<size_t>(std::ceil(norm / theta[m-1]));
+            if(best == 0 || m*s < best)
+            {
+                best = m*s;
+                degree = m;
+                steps = s;
+            }
+        }
+    }
+
+    const T eps = std::numeric_limits<T>::epsilon();
+    const T eta = std::exp(mu / static_cast<T>(steps));
+    Vector<T, M> F = v;
+    Vector<T, M> b = v;
+    for(size_t i = 0; i < steps; ++i)
+    {
+        // F <- sum_k (B/s)^k b / k!, stopping once two terms fall below rounding
+        T previous = detail::normInf(b);
+        for(size_t k = 1; k <= degree; ++k)
+        {
+            b = B*b;
+            b /= static_cast<T>(steps*k);
+            F += b;
+            const T current = detail::normInf(b);
+            if(previous + current <= eps*detail::normInf(F))
+            {
+                break;
+            }
+            previous = current;
+        }
+        F *= eta;
+        b = F;
+    }
+    return F;
+}
+
+} // namespace matrix
+
+#endif // _MATRIX_EXPONENTIAL_HPP__
@@ -0,0 +1,497 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file MatrixExpression.hpp
+//!
+//! Lazy expression nodes for element-wise matrix arithmetic. The element-wise
+//! operators return lightweight nodes that refer to their operands instead of
+//! building a full result, so an expression like A + B*c - C is evaluated in a
+//! single loop only when it is assigned to a Matrix (or a derived type).
+//!
+//! Elements are addressed by their row-major flat index (coeff), whatever the
+//! storage layout of the matrices involved. When every matrix in an expression
+//! shares one layout, a destination with that layout evaluates it in storage
+//! order instead (storageCoeff).
+//!
+//! Each node converts every intermediate element back to T, so a fused
+//! expression produces exactly the same values as evaluating it one operator
+//! at a time. Nodes refer to named matrix operands and hold temporary ones
+//! (e.g. the product in A*B + C) by value, so an expression stored in an auto
+//! variable stays valid as long as the named matrices do.
+//!
+//! Every expression also offers eval(), transpose(), abs(), submatrix(), ==,
+//! != and << by evaluating into its plain Matrix type, so code written for the
+//! eager operators (e.g. (A + B).transpose()) keeps compiling.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _MATRIX_EXPRESSION_HPP__
+#define _MATRIX_EXPRESSION_HPP__
+
+#include <cstddef>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+#include "BoundsPolicy.hpp"
+#include "MatrixLayout.hpp"
+
+namespace matrix
+{
+
+//! Forward declaration (default template arguments are declared here)
+template<class T, size_t M, size_t N, class Bounds = DefaultBounds, class Layout = RowMajor>
+class Matrix;
+
+//! Base class of every matrix expression, including Matrix itself (CRTP)
+template<class E>
+class MatrixExpression
+{
+public:
+    //! Access the concrete expression type
+    constexpr const E &derived() const { return static_cast<const E&>(*this); }
+
+    //! Evaluate into the plain Matrix type
+    constexpr auto eval() const { return typename E::plain_type(derived()); }
+
+    //! Transpose of the evaluated expression
+    constexpr auto transpose() const { return eval().transpose(); }
+
+    //! Absolute value of the evaluated expression's elements
+    auto abs() const { return eval().abs(); }
+
+    //! Submatrix of the evaluated expression
+    template<size_t P, size_t Q>
+    auto submatrix(size_t rowA, size_t colA, size_t rowB, size_t colB) const
+    {
+        return eval().template submatrix<P, Q>(rowA, colA, rowB, colB);
+    }
+};
+
+namespace detail
+{
+
+//! Matrices are held by reference inside an expression, nodes are held by value
+template<class E>
+struct ExpressionOperand
+{
+    using type = const E;
+};
+
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+struct ExpressionOperand<Matrix<T, M, N, Bounds, Layout>>
+{
+    using type = const Matrix<T, M, N, Bounds, Layout>&;
+};
+
+//! Storage layout shared by every matrix in an expression (void if they differ or for views)
+template<class E>
+struct ExpressionLayout
+{
+    using type = void;
+};
+
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+struct ExpressionLayout<Matrix<T, M, N, Bounds, Layout>>
+{
+    using type = Layout;
+};
+
+//! True when E is an expression with value type T and shape MxN
+template<class E, class T, size_t M, size_t N>
+struct IsExpressionOfShape
+{
+    static constexpr bool value = std::is_same<typename E::value_type, T>::value && E::rows == M && E::cols == N;
+};
+
+//! True when L and R may be combined element-wise
+template<class L, class R>
+struct IsSameShape
+{
+    static constexpr bool value = IsExpressionOfShape<R, typename L::value_type, L::rows, L::cols>::value;
+};
+
+//! Element-wise operations (results are converted back to T like the eager operators)
+struct AddOp
+{
+    template<class T>
+    static constexpr T apply(T a, T b) { return static_cast<T>(a + b); }
+};
+
+struct SubtractOp
+{
+    template<class T>
+    static constexpr T apply(T a, T b) { return static_cast<T>(a - b); }
+};
+
+struct MultiplyOp
+{
+    template<class T>
+    static constexpr T apply(T a, T b) { return static_cast<T>(a * b); }
+};
+
+struct DivideOp
+{
+    template<class T>
+    static constexpr T apply(T a, T b) { return static_cast<T>(a / b); }
+};
+
+struct NegateOp
+{
+    template<class T>
+    static constexpr T apply(T a) { return static_cast<T>(-a); }
+};
+
+} // namespace detail
+
+//! Element-wise combination of two expressions of the same shape
+template<class L, class R, class Op>
+class MatrixBinaryExpression : public MatrixExpression<MatrixBinaryExpression<L, R, Op>>
+{
+public:
+    using value_type = typename L::value_type;
+    static constexpr size_t rows = L::rows;
+    static constexpr size_t cols = L::cols;
+    using plain_type = Matrix<value_type, rows, cols>;
+
+    template<class A, class B>
+    constexpr MatrixBinaryExpression(A &&lhs, B &&rhs):
+        lhs(std::forward<A>(lhs)),
+        rhs(std::forward<B>(rhs))
+    {
+    }
+
+    //! Evaluate the element at flat (row-major) index i
+    constexpr value_type coeff(size_t i) const { return Op::apply(lhs.coeff(i), rhs.coeff(i)); }
+
+    //! Evaluate the element at storage index i (only when every matrix shares a layout)
+    constexpr value_type storageCoeff(size_t i) const { return Op::apply(lhs.storageCoeff(i), rhs.storageCoeff(i)); }
+
+    //! Evaluate the element at row i, column j
+    constexpr value_type operator()(size_t i, size_t j) const { return coeff(i*cols + j); }
+
+private:
+    typename detail::ExpressionOperand<L>::type lhs;
+    typename detail::ExpressionOperand<R>::type rhs;
+};
+
+//! Element-wise combination of an expression with a scalar on the right
+template<class E, class Op>
+class MatrixScalarExpression : public MatrixExpression<MatrixScalarExpression<E, Op>>
+{
+public:
+    using value_type = typename E::value_type;
+    static constexpr size_t rows = E::rows;
+    static constexpr size_t cols = E::cols;
+    using plain_type = Matrix<value_type, rows, cols>;
+
+    template<class A>
+    constexpr MatrixScalarExpression(A &&expr, value_type value):
+        expr(std::forward<A>(expr)),
+        value(value)
+    {
+    }
+
+    //! Evaluate the element at flat (row-major) index i
+    constexpr value_type coeff(size_t i) const { return Op::apply(expr.coeff(i), value); }
+
+    //! Evaluate the element at storage index i (only when every matrix shares a layout)
+    constexpr value_type storageCoeff(size_t i) const { return Op::apply(expr.storageCoeff(i), value); }
+
+    //! Evaluate the element at row i, column j
+    constexpr value_type operator()(size_t i, size_t j) const { return coeff(i*cols + j); }
+
+private:
+    typename detail::ExpressionOperand<E>::type expr;
+    value_type value;
+};
+
+//! Element-wise unary operation on an expression
+template<class E, class Op>
+class MatrixUnaryExpression : public MatrixExpression<MatrixUnaryExpression<E, Op>>
+{
+public:
+    using value_type = typename E::value_type;
+    static constexpr size_t rows = E::rows;
+    static constexpr size_t cols = E::cols;
+    using plain_type = Matrix<value_type, rows, cols>;
+
+    template<class A, typename = std::enable_if_t<!std::is_same<std::decay_t<A>, MatrixUnaryExpression>::value>>
+    explicit constexpr MatrixUnaryExpression(A &&expr):
+        expr(std::forward<A>(expr))
+    {
+    }
+
+    //! Evaluate the element at flat (row-major) index i
+    constexpr value_type coeff(size_t i) const { return Op::apply(expr.coeff(i)); }
+
+    //! Evaluate the element at storage index i (only when every matrix shares a layout)
+    constexpr value_type storageCoeff(size_t i) const { return Op::apply(expr.storageCoeff(i)); }
+
+    //! Evaluate the element at row i, column j
+    constexpr value_type operator()(size_t i, size_t j) const { return coeff(i*cols + j); }
+
+private:
+    typename detail::ExpressionOperand<E>::type expr;
+};
+
+//! Temporary matrix operand (e.g. a product) held by value inside an expression
+template<class P>
+class MatrixTemporary : public MatrixExpression<MatrixTemporary<P>>
+{
+public:
+    using value_type = typename P::value_type;
+    static constexpr size_t rows = P::rows;
+    static constexpr size_t cols = P::cols;
+    using plain_type = P;
+
+    explicit constexpr MatrixTemporary(P &&matrix):
+        matrix(std::move(matrix))
+    {
+    }
+
+    //! Element at flat (row-major) index i
+    constexpr value_type coeff(size_t i) const { return matrix.coeff(i); }
+
+    //! Element at storage index i
+    constexpr value_type storageCoeff(size_t i) const { return matrix.storageCoeff(i); }
+
+    //! Element at row i, column j
+    constexpr value_type operator()(size_t i, size_t j) const { return matrix(i,j); }
+
+private:
+    P matrix;
+};
+
+namespace detail
+{
+
+//! Type an rvalue operand is held as: temporary matrices by value, nodes moved
+template<class E>
+struct TemporaryOperand
+{
+    using type = E;
+};
+
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+struct TemporaryOperand<Matrix<T, M, N, Bounds, Layout>>
+{
+    using type = MatrixTemporary<Matrix<T, M, N, Bounds, Layout>>;
+};
+
+//! Take an rvalue operand out of the statement that created it
+template<class E>
+constexpr typename TemporaryOperand<E>::type temporary(MatrixExpression<E> &&expr)
+{
+    return typename TemporaryOperand<E>::type(static_cast<E&&>(expr));
+}
+
+template<class P>
+struct ExpressionLayout<MatrixTemporary<P>> : ExpressionLayout<P>
+{
+};
+
+template<class L, class R, class Op>
+struct ExpressionLayout<MatrixBinaryExpression<L, R, Op>>
+{
+    using type = std::conditional_t<std::is_same<typename ExpressionLayout<L>::type, typename ExpressionLayout<R>::type>::value,
+        typename ExpressionLayout<L>::type, void>;
+};
+
+template<class E, class Op>
+struct ExpressionLayout<MatrixScalarExpression<E, Op>> : ExpressionLayout<E>
+{
+};
+
+template<class E, class Op>
+struct ExpressionLayout<MatrixUnaryExpression<E, Op>> : ExpressionLayout<E>
+{
+};
+
+} // namespace detail
+
+//! Element-wise addition
+template<class L, class R, typename = std::enable_if_t<detail::IsSameShape<L, R>::value>>
+constexpr MatrixBinaryExpression<L, R, detail::AddOp> operator+(const MatrixExpression<L> &lhs, const MatrixExpression<R> &rhs)
+{
+    return MatrixBinaryExpression<L, R, detail::AddOp>(lhs.derived(), rhs.derived());
+}
+
+//! Element-wise addition, holding a temporary left operand
+template<class L, class R, typename = std::enable_if_t<detail::IsSameShape<L, R>::value>>
+constexpr auto operator+(MatrixExpression<L> &&lhs, const MatrixExpression<R> &rhs)
+{
+    using A = typename detail::TemporaryOperand<L>::type;
+    return MatrixBinaryExpression<A, R, detail::AddOp>(detail::temporary(std::move(lhs)), rhs.derived());
+}
+
+//! Element-wise addition, holding a temporary right operand
+template<class L, class R, typename = std::enable_if_t<detail::IsSameShape<L, R>::value>>
+constexpr auto operator+(const MatrixExpression<L> &lhs, MatrixExpression<R> &&rhs)
+{
+    using B = typename detail::TemporaryOperand<R>::type;
+    return MatrixBinaryExpression<L, B, detail::AddOp>(lhs.derived(), detail::temporary(std::move(rhs)));
+}
+
+//! Element-wise addition, holding both temporary operands
+template<class L, class R, typename = std::enable_if_t<detail::IsSameShape<L, R>::value>>
+constexpr auto operator+(MatrixExpression<L> &&lhs, MatrixExpression<R> &&rhs)
+{
+    using A = typename detail::TemporaryOperand<L>::type;
+    using B = typename detail::TemporaryOperand<R>::type;
+    return MatrixBinaryExpression<A, B, detail::AddOp>(detail::temporary(std::move(lhs)), detail::temporary(std::move(rhs)));
+}
+
+//! Element-wise subtraction
+template<class L, class R, typename = std::enable_if_t<detail::IsSameShape<L, R>::value>>
+constexpr MatrixBinaryExpression<L, R, detail::SubtractOp> operator-(const MatrixExpression<L> &lhs, const MatrixExpression<R> &rhs)
+{
+    return MatrixBinaryExpression<L, R, detail::SubtractOp>(lhs.derived(), rhs.derived());
+}
+
+//! Element-wise subtraction, holding a temporary left operand
+template<class L, class R, typename = std::enable_if_t<detail::IsSameShape<L, R>::value>>
+constexpr auto operator-(MatrixExpression<L> &&lhs, const MatrixExpression<R> &rhs)
+{
+    using A = typename detail::TemporaryOperand<L>::type;
+    return MatrixBinaryExpression<A, R, detail::SubtractOp>(detail::temporary(std::move(lhs)), rhs.derived());
+}
+
+//! Element-wise subtraction, holding a temporary right operand
+template<class L, class R, typename = std::enable_if_t<detail::IsSameShape<L, R>::value>>
+constexpr auto operator-(const MatrixExpression<L> &lhs, MatrixExpression<R> &&rhs)
+{
+    using B = typename detail::TemporaryOperand<R>::type;
+    return MatrixBinaryExpression<L, B, detail::SubtractOp>(lhs.derived(), detail::temporary(std::move(rhs)));
+}
+
+//! Element-wise subtraction, holding both temporary operands
+template<class L, class R, typename = std::enable_if_t<detail::IsSameShape<L, R>::value>>
+constexpr auto operator-(MatrixExpression<L> &&lhs, MatrixExpression<R> &&rhs)
+{
+    using A = typename detail::TemporaryOperand<L>::type;
+    using B = typename detail::TemporaryOperand<R>::type;
+    return MatrixBinaryExpression<A, B, detail::SubtractOp>(detail::temporary(std::move(lhs)), detail::temporary(std::move(rhs)));
+}
+
+//! Unary minus
+template<class E>
+constexpr MatrixUnaryExpression<E, detail::NegateOp> operator-(const MatrixExpression<E> &expr)
+{
+    return MatrixUnaryExpression<E, detail::NegateOp>(expr.derived());
+}
+
+//! Unary minus of a temporary
+template<class E>
+constexpr auto operator-(MatrixExpression<E> &&expr)
+{
+    using A = typename detail::TemporaryOperand<E>::type;
+    return MatrixUnaryExpression<A, detail::NegateOp>(detail::temporary(std::move(expr)));
+}
+
+//! Element-wise scalar addition
+template<class E>
+constexpr MatrixScalarExpression<E, detail::AddOp> operator+(const MatrixExpression<E> &expr, typename E::value_type value)
+{
+    return MatrixScalarExpression<E, detail::AddOp>(expr.derived(), value);
+}
+
+//! Element-wise scalar addition, holding a temporary
+template<class E>
+constexpr auto operator+(MatrixExpression<E> &&expr, typename E::value_type value)
+{
+    using A = typename detail::TemporaryOperand<E>::type;
+    return MatrixScalarExpression<A, detail::AddOp>(detail::temporary(std::move(expr)), value);
+}
+
+//! Matrix-scalar subtraction
+template<class E>
+constexpr MatrixScalarExpression<E, detail::SubtractOp> operator-(const MatrixExpression<E> &expr, typename E::value_type value)
+{
+    return MatrixScalarExpression<E, detail::SubtractOp>(expr.derived(), value);
+}
+
+//! Matrix-scalar subtraction, holding a temporary
+template<class E>
+constexpr auto operator-(MatrixExpression<E> &&expr, typename E::value_type value)
+{
+    using A = typename detail::TemporaryOperand<E>::type;
+    return MatrixScalarExpression<A, detail::SubtractOp>(detail::temporary(std::move(expr)), value);
+}
+
+//! Scalar multiplication
+template<class E>
+constexpr MatrixScalarExpression<E, detail::MultiplyOp> operator*(const MatrixExpression<E> &expr, typename E::value_type value)
+{
+    return MatrixScalarExpression<E, detail::MultiplyOp>(expr.derived(), value);
+}
+
+//! Scalar multiplication, holding a temporary
+template<class E>
+constexpr auto operator*(MatrixExpression<E> &&expr, typename E::value_type value)
+{
+    using A = typename detail::TemporaryOperand<E>::type;
+    return MatrixScalarExpression<A, detail::MultiplyOp>(detail::temporary(std::move(expr)), value);
+}
+
+//! Scalar multiplication with the scalar on the left
+template<class E>
+constexpr MatrixScalarExpression<E, detail::MultiplyOp> operator*(typename E::value_type value, const MatrixExpression<E> &expr)
+{
+    return MatrixScalarExpression<E, detail::MultiplyOp>(expr.derived(), value);
+}
+
+//! Scalar multiplication with the scalar on the left, holding a temporary
+template<class E>
+constexpr auto operator*(typename E::value_type value, MatrixExpression<E> &&expr)
+{
+    using A = typename detail::TemporaryOperand<E>::type;
+    return MatrixScalarExpression<A, detail::MultiplyOp>(detail::temporary(std::move(expr)), value);
+}
+
+//! Matrix element-wise scalar division
+template<class E>
+constexpr MatrixScalarExpression<E, detail::DivideOp> operator/(const MatrixExpression<E> &expr, typename E::value_type value)
+{
+    return MatrixScalarExpression<E, detail::DivideOp>(expr.derived(), value);
+}
+
+//! Matrix element-wise scalar division, holding a temporary
+template<class E>
+constexpr auto operator/(MatrixExpression<E> &&expr, typename E::value_type value)
+{
+    using A = typename detail::TemporaryOperand<E>::type;
+    return MatrixScalarExpression<A, detail::DivideOp>(detail::temporary(std::move(expr)), value);
+}
+
+//! Test equality of two expressions of the same shape, element by element (a
+//! Matrix on the left uses its own operator==, evaluating the right side)
+template<class L, class R, typename = std::enable_if_t<!std::is_same<L, typename L::plain_type>::value && detail::IsSameShape<L, R>::value>>
+constexpr bool operator==(const MatrixExpression<L> &lhs, const MatrixExpression<R> &rhs)
+{
+    for(size_t i = 0; i < L::rows*L::cols; ++i)
+    {
+        if(lhs.derived().coeff(i) != rhs.derived().coeff(i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! Test non-equality of two expressions of the same shape
+template<class L, class R, typename = std::enable_if_t<!std::is_same<L, typename L::plain_type>::value && detail::IsSameShape<L, R>::value>>
+constexpr bool operator!=(const MatrixExpression<L> &lhs, const MatrixExpression<R> &rhs)
+{
+    return !(lhs == rhs);
+}
+
+//! Print an expression like its evaluated Matrix
+template<class E>
+std::ostream& operator<<(std::ostream &os, const MatrixExpression<E> &expr)
+{
+    return os << expr.eval();
+}
+
+} // namespace matrix
+
+#endif // _MATRIX_EXPRESSION_HPP__
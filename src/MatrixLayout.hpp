@@ -0,0 +1,39 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file MatrixLayout.hpp
+//!
+//! Element layouts of an M x N matrix in memory. Each layout gives the flat
+//! index of element (i,j) and the equivalent row and column strides.
+//!
+//! RowMajor    - element (i,j) at i*N + j (rows are contiguous)
+//! ColumnMajor - element (i,j) at j*M + i (columns are contiguous)
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _MATRIX_LAYOUT_HPP__
+#define _MATRIX_LAYOUT_HPP__
+
+#include <cstddef>
+
+namespace matrix
+{
+
+//! Rows are contiguous
+struct RowMajor
+{
+    static constexpr size_t index(size_t i, size_t j, size_t, size_t N) { return i*N + j; }
+    static constexpr size_t rowStride(size_t, size_t N) { return N; }
+    static constexpr size_t colStride(size_t, size_t) { return 1; }
+};
+
+//! Columns are contiguous
+struct ColumnMajor
+{
+    static constexpr size_t index(size_t i, size_t j, size_t M, size_t) { return j*M + i; }
+    static constexpr size_t rowStride(size_t, size_t) { return 1; }
+    static constexpr size_t colStride(size_t M, size_t) { return M; }
+};
+
+} // namespace matrix
+
+#endif // _MATRIX_LAYOUT_HPP__
@@ -0,0 +1,182 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file MatrixMap.hpp
+//!
+//! Maps that present a caller-owned buffer (a driver's sample array, shared
+//! memory, a memory-mapped log) as a fixed-size matrix or vector without
+//! copying it. A map is a MatrixView whose pointer, strides or layout are
+//! chosen by the caller, so it takes part in expressions, products and the
+//! compound operators exactly like a view, reading and writing the buffer in
+//! place. Map a const T buffer for read-only access. The buffer must outlive
+//! the map.
+//!
+//! Vector3Map and QuaternionMap (in their own headers) add the 3-vector and
+//! quaternion operations.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _MATRIX_MAP_HPP__
+#define _MATRIX_MAP_HPP__
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include "Matrix.hpp"
+#include "MatrixLayout.hpp"
+#include "MatrixView.hpp"
+#include "Vector.hpp"
+
+namespace matrix
+{
+
+template<class T, size_t M, size_t N, class Bounds = DefaultBounds>
+class MatrixMap : public MatrixView<T, M, N, Bounds>
+{
+public:
+    //! Map M*N contiguous row-major elements
+    explicit constexpr MatrixMap(T *values);
+
+    //! Map M*N contiguous elements stored in Layout (RowMajor or ColumnMajor)
+    template<class Layout>
+    constexpr MatrixMap(T *values, Layout);
+
+    //! Map the elements values[i*rowStride + j*colStride]
+    constexpr MatrixMap(T *values, size_t rowStride, size_t colStride);
+
+    //! Assign the mapped elements
+    using MatrixView<T, M, N, Bounds>::operator=;
+};
+
+template<class T, size_t M, class Bounds = DefaultBounds>
+class VectorMap : public MatrixMap<T, M, 1, Bounds>
+{
+public:
+    using value_type = typename MatrixMap<T, M, 1, Bounds>::value_type;
+
+    //! Map M elements stride apart (stride 1 for contiguous elements)
+    explicit constexpr VectorMap(T *values, size_t stride = 1);
+
+    //! Assign the mapped elements
+    using MatrixMap<T, M, 1, Bounds>::operator=;
+
+    //! Element access by row and column
+    using MatrixMap<T, M, 1, Bounds>::operator();
+
+    //! Element access
+    constexpr T &operator()(size_t i) const;
+
+    //! Number of elements
+    static constexpr size_t size() { return M; }
+
+    //! Dot product with a vector or vector expression of the same length
+    template<class E, typename = std::enable_if_t<detail::IsExpressionOfShape<E, value_type, M, 1>::value>>
+    constexpr value_type dot(const MatrixExpression<E> &b) const;
+
+    //! Dot product with operator*
+    template<class E, typename = std::enable_if_t<detail::IsExpressionOfShape<E, value_type, M, 1>::value>>
+    constexpr value_type operator*(const MatrixExpression<E> &b) const;
+
+    //! Compute the norm of the mapped vector
+    value_type norm() const;
+
+    //! Normalize the mapped elements in place
+    void normalize() const;
+
+    //! Get the length of the vector (same as norm)
+    value_type length() const;
+
+    //! Return unit vector
+    Vector<value_type, M> unit() const;
+};
+
+//! Map M*N contiguous row-major elements
+template<class T, size_t M, size_t N, class Bounds>
+constexpr MatrixMap<T,M,N,Bounds>::MatrixMap(T *values):
+    MatrixView<T, M, N, Bounds>(values, N, 1)
+{
+}
+
+//! Map M*N contiguous elements stored in Layout (RowMajor or ColumnMajor)
+template<class T, size_t M, size_t N, class Bounds>
+template<class Layout>
+constexpr MatrixMap<T,M,N,Bounds>::MatrixMap(T *values, Layout):
+    MatrixView<T, M, N, Bounds>(values, Layout::rowStride(M, N), Layout::colStride(M, N))
+{
+}
+
+//! Map the elements values[i*rowStride + j*colStride]
+template<class T, size_t M, size_t N, class Bounds>
+constexpr MatrixMap<T,M,N,Bounds>::MatrixMap(T *values, size_t rowStride, size_t colStride):
+    MatrixView<T, M, N, Bounds>(values, rowStride, colStride)
+{
+}
+
+//! Map M elements stride apart (stride 1 for contiguous elements)
+template<class T, size_t M, class Bounds>
+constexpr VectorMap<T,M,Bounds>::VectorMap(T *values, size_t stride):
+    MatrixMap<T, M, 1, Bounds>(values, stride, 1)
+{
+}
+
+//! Element access
+template<class T, size_t M, class Bounds>
+constexpr T &VectorMap<T,M,Bounds>::operator()(size_t i) const
+{
+    Bounds::check(i, 0, M, 1);
+    return this->data()[i*this->rowStride()];
+}
+
+//! Dot product with a vector or vector expression of the same length
+template<class T, size_t M, class Bounds>
+template<class E, typename>
+constexpr typename VectorMap<T,M,Bounds>::value_type VectorMap<T,M,Bounds>::dot(const MatrixExpression<E> &b) const
+{
+    const E &e = b.derived();
+    value_type value = 0;
+    for(size_t i = 0; i < M; ++i)
+    {
+        value += this->data()[i*this->rowStride()] * e.coeff(i);
+    }
+    return value;
+}
+
+//! Dot product with operator*
+template<class T, size_t M, class Bounds>
+template<class E, typename>
+constexpr typename VectorMap<T,M,Bounds>::value_type VectorMap<T,M,Bounds>::operator*(const MatrixExpression<E> &b) const
+{
+    return dot(b);
+}
+
+//! Compute the norm of the mapped vector
+template<class T, size_t M, class Bounds>
+typename VectorMap<T,M,Bounds>::value_type VectorMap<T,M,Bounds>::norm() const
+{
+    return value_type(std::sqrt(dot(*this)));
+}
+
+//! Normalize the mapped elements in place
+template<class T, size_t M, class Bounds>
+void VectorMap<T,M,Bounds>::normalize() const
+{
+    (*this) /= norm();
+}
+
+//! Get the length of the vector (same as norm)
+template<class T, size_t M, class Bounds>
+typename VectorMap<T,M,Bounds>::value_type VectorMap<T,M,Bounds>::length() const
+{
+    return norm();
+}
+
+//! Return unit vector
+template<class T, size_t M, class Bounds>
+Vector<typename VectorMap<T,M,Bounds>::value_type, M> VectorMap<T,M,Bounds>::unit() const
+{
+    return Vector<value_type, M>((*this) / norm());
+}
+
+} // namespace matrix
+
+#endif // _MATRIX_MAP_HPP__
@@ -0,0 +1,238 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file MatrixStorage.hpp
+//!
+//! Element storage for Matrix. Matrices up to MTL_HEAP_STORAGE_THRESHOLD bytes
+//! keep their elements inline (a plain array, so they stay trivially copyable
+//! and usable in constant expressions). Larger matrices keep them in a heap
+//! buffer aligned to MTL_HEAP_STORAGE_ALIGNMENT bytes, which keeps them off the
+//! stack and makes moving them a pointer swap. A move leaves the source without
+//! a buffer; a moved-from matrix allocates a fresh zeroed one the first time its
+//! elements are accessed, so it keeps its size and stays readable.
+//!
+//! Both storage types convert to a pointer to the first element, so the
+//! matrix code indexes them exactly like an array. AlignedAllocator provides
+//! the same aligned buffers to standard containers and the dynamic types.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _MATRIX_STORAGE_HPP__
+#define _MATRIX_STORAGE_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//! Matrices larger than this many bytes keep their elements on the heap
+#ifndef MTL_HEAP_STORAGE_THRESHOLD
+#define MTL_HEAP_STORAGE_THRESHOLD 16384
+#endif
+
+//! Alignment of heap element buffers in bytes
+#ifndef MTL_HEAP_STORAGE_ALIGNMENT
+#define MTL_HEAP_STORAGE_ALIGNMENT 64
+#endif
+
+namespace matrix
+{
+
+//! Standard allocator returning buffers aligned to Alignment bytes (or alignof(T) if larger)
+template<class T, size_t Alignment = MTL_HEAP_STORAGE_ALIGNMENT>
+class AlignedAllocator
+{
+public:
+    using value_type = T;
+    static constexpr size_t alignment = alignof(T) > Alignment ? alignof(T) : Alignment;
+
+    template<class U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+
+    template<class U>
+    constexpr AlignedAllocator(const AlignedAllocator<U, Alignment> &) {}
+
+    //! Allocate uninitialized storage for n elements
+    T *allocate(size_t n)
+    {
+        return static_cast<T *>(::operator new(n*sizeof(T), std::align_val_t(alignment)));
+    }
+
+    //! Release storage from allocate
+    void deallocate(T *p, size_t)
+    {
+        ::operator delete(p, std::align_val_t(alignment));
+    }
+};
+
+template<class T, class U, size_t Alignment>
+constexpr bool operator==(const AlignedAllocator<T, Alignment> &, const AlignedAllocator<U, Alignment> &)
+{
+    return true;
+}
+
+template<class T, class U, size_t Alignment>
+constexpr bool operator!=(const AlignedAllocator<T, Alignment> &, const AlignedAllocator<U, Alignment> &)
+{
+    return false;
+}
+
+namespace detail
+{
+
+//! Elements held in the object itself
+template<class T, size_t Size>
+class InlineStorage
+{
+public:
+    static constexpr bool onHeap = false;
+
+    constexpr operator T *() { return values; }
+    constexpr operator const T *() const { return values; }
+
+private:
+    T values[Size];
+};
+
+//! Elements held in an aligned heap buffer owned by the object
+template<class T, size_t Size>
+class HeapStorage
+{
+public:
+    static constexpr bool onHeap = true;
+
+    //! Allocate value-initialized elements
+    HeapStorage();
+
+    //! Allocate a copy of other's elements
+    HeapStorage(const HeapStorage &other);
+
+    //! Take other's buffer, leaving other without one
+    HeapStorage(HeapStorage &&other) noexcept;
+
+    //! Copy other's elements (allocating a buffer if this was moved from)
+    HeapStorage &operator=(const HeapStorage &other);
+
+    //! Swap buffers with other
+    HeapStorage &operator=(HeapStorage &&other) noexcept;
+
+    //! Release the buffer
+    ~HeapStorage();
+
+    //! True while the object owns a buffer (false after it was moved from)
+    bool allocated() const { return values != nullptr; }
+
+    operator T *() { return buffer(); }
+    operator const T *() const { return buffer(); }
+
+private:
+    //! Allocate an uninitialized buffer
+    static T *allocate() { return AlignedAllocator<T>().allocate(Size); }
+
+    //! Destroy the elements and release the buffer (null is ignored)
+    static void release(T *buffer);
+
+    //! The elements, allocated value-initialized if this was moved from
+    T *buffer() const;
+
+    mutable T *values;
+};
+
+//! Allocate value-initialized elements
+template<class T, size_t Size>
+HeapStorage<T,Size>::HeapStorage():
+    values(allocate())
+{
+    std::uninitialized_value_construct_n(values, Size);
+}
+
+//! Allocate a copy of other's elements
+template<class T, size_t Size>
+HeapStorage<T,Size>::HeapStorage(const HeapStorage &other):
+    values(allocate())
+{
+    std::uninitialized_copy_n(other.buffer(), Size, values);
+}
+
+//! Take other's buffer, leaving other without one
+template<class T, size_t Size>
+HeapStorage<T,Size>::HeapStorage(HeapStorage &&other) noexcept:
+    values(other.values)
+{
+    other.values = nullptr;
+}
+
+//! Copy other's elements (allocating a buffer if this was moved from)
+template<class T, size_t Size>
+HeapStorage<T,Size> &HeapStorage<T,Size>::operator=(const HeapStorage &other)
+{
+    if(this != &other)
+    {
+        if(values == nullptr)
+        {
+            T *copy = allocate();
+            std::uninitialized_copy_n(other.buffer(), Size, copy);
+            values = copy;
+        }
+        else
+        {
+            std::copy_n(other.buffer(), Size, values);
+        }
+    }
+    return *this;
+}
+
+//! Swap buffers with other
+template<class T, size_t Size>
+HeapStorage<T,Size> &HeapStorage<T,Size>::operator=(HeapStorage &&other) noexcept
+{
+    std::swap(values, other.values);
+    return *this;
+}
+
+//! Release the buffer
+template<class T, size_t Size>
+HeapStorage<T,Size>::~HeapStorage()
+{
+    release(values);
+}
+
+//! Destroy the elements and release the buffer (null is ignored)
+template<class T, size_t Size>
+void HeapStorage<T,Size>::release(T *buffer)
+{
+    if(buffer != nullptr)
+    {
+        std::destroy_n(buffer, Size);
+        AlignedAllocator<T>().deallocate(buffer, Size);
+    }
+}
+
+//! The elements, allocated value-initialized if this was moved from
+template<class T, size_t Size>
+T *HeapStorage<T,Size>::buffer() const
+{
+    if(values == nullptr)
+    {
+        T *fresh = allocate();
+        std::uninitialized_value_construct_n(fresh, Size);
+        values = fresh;
+    }
+    return values;
+}
+
+//! Storage for Size elements, on the heap above the byte threshold
+template<class T, size_t Size>
+using MatrixStorage = std::conditional_t<(Size*sizeof(T) > MTL_HEAP_STORAGE_THRESHOLD), HeapStorage<T, Size>, InlineStorage<T, Size>>;
+
+} // namespace detail
+
+} // namespace matrix
+
+#endif // _MATRIX_STORAGE_HPP__
@@ -0,0 +1,283 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file MatrixView.hpp
+//!
+//! Fixed-size views that refer to the elements of another matrix instead of
+//! copying them: blocks, rows, columns, the diagonal and the transpose. Element
+//! (i,j) of a view is values[i*rowStride + j*colStride], so every kind of view
+//! is the same type with different strides.
+//!
+//! Views read and write the parent's elements, take part in lazy expressions
+//! like any other matrix and multiply through StridedMultiplyKernel without
+//! copying, e.g. P.block<3,3>(3,3) += F*Q or A.transposed()*B. A view is only
+//! valid while its parent is alive. Assigning an expression that reads other
+//! elements of the same parent (e.g. A.transposed() = A) is not alias-safe;
+//! evaluate it into a Matrix first.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _MATRIX_VIEW_HPP__
+#define _MATRIX_VIEW_HPP__
+
+#include <cstddef>
+#include <type_traits>
+
+#include "BoundsPolicy.hpp"
+#include "MatrixExpression.hpp"
+#include "MultiplyKernel.hpp"
+
+namespace matrix
+{
+
+template<class T, size_t M, size_t N, class Bounds = DefaultBounds>
+class MatrixView : public MatrixExpression<MatrixView<T, M, N, Bounds>>
+{
+public:
+    using value_type = std::remove_const_t<T>;
+    using plain_type = Matrix<value_type, M, N, Bounds>;
+    using bounds_policy = Bounds;
+    static constexpr size_t rows = M;
+    static constexpr size_t cols = N;
+
+    //! View the elements values[i*rowStride + j*colStride]
+    constexpr MatrixView(T *values, size_t rowStride, size_t colStride);
+
+    //! Copy constructor (both views refer to the same elements)
+    MatrixView(const MatrixView &other) = default;
+
+    //! Convert a view of mutable elements to a read-only view
+    template<class U, typename = std::enable_if_t<std::is_same<const U, T>::value && !std::is_same<U, T>::value>>
+    constexpr MatrixView(const MatrixView<U, M, N, Bounds> &other);
+
+    //! Copy the elements of other into the viewed elements
+    constexpr MatrixView &operator=(const MatrixView &other);
+
+    //! Assign the viewed elements by evaluating a matrix expression
+    template<class E, typename = std::enable_if_t<detail::IsExpressionOfShape<E, value_type, M, N>::value>>
+    constexpr MatrixView &operator=(const MatrixExpression<E> &expr);
+
+    //! Element access (a const view still refers to mutable elements, like a pointer)
+    constexpr T &operator()(size_t i, size_t j) const;
+
+    //! Element access by flat (row-major) index, used by expression evaluation
+    constexpr value_type coeff(size_t i) const { return values[(i/N)*rowStep + (i%N)*colStep]; }
+
+    //! Pointer to element (0,0)
+    constexpr T *data() const { return values; }
+
+    //! Distance between consecutive rows
+    constexpr size_t rowStride() const { return rowStep; }
+
+    //! Distance between consecutive columns
+    constexpr size_t colStride() const { return colStep; }
+
+    //! Compound addition operator
+    template<class E>
+    constexpr void operator+=(const MatrixExpression<E> &other) const;
+
+    //! Compound subtraction operator
+    template<class E>
+    constexpr void operator-=(const MatrixExpression<E> &other) const;
+
+    //! Compound scalar addition
+    constexpr void operator+=(value_type value) const;
+
+    //! Compound matrix-scalar subtraction
+    constexpr void operator-=(value_type value) const;
+
+    //! Compound rhs scalar multiplication
+    constexpr void operator*=(value_type value) const;
+
+    //! Compound matrix element-wise scalar division
+    constexpr void operator/=(value_type value) const;
+
+    //! Set all viewed elements to value
+    constexpr void setValue(value_type value) const;
+
+    //! View of the transpose of the viewed elements
+    constexpr MatrixView<T, N, M, Bounds> transposed() const;
+
+private:
+    //! Apply fn to a reference to every viewed element, row by row
+    template<class Fn>
+    constexpr void forEach(Fn fn) const;
+
+    T *values;
+    size_t rowStep;
+    size_t colStep;
+};
+
+namespace detail
+{
+
+//! Operands the strided kernel can read in place: element (i,j) at pointer(e)[i*rowStride(e) + j*colStride(e)]
+template<class E>
+struct StridedOperand
+{
+    static constexpr bool value = false;
+    static constexpr bool view = false;
+};
+
+template<class T, size_t M, size_t N, class Bounds, class Layout>
+struct StridedOperand<Matrix<T, M, N, Bounds, Layout>>
+{
+    static constexpr bool value = true;
+    static constexpr bool view = false;
+    static const T *pointer(const Matrix<T, M, N, Bounds, Layout> &m) { return &m(0,0); }
+    static constexpr size_t rowStride(const Matrix<T, M, N, Bounds, Layout> &) { return Layout::rowStride(M, N); }
+    static constexpr size_t colStride(const Matrix<T, M, N, Bounds, Layout> &) { return Layout::colStride(M, N); }
+};
+
+template<class T, size_t M, size_t N, class Bounds>
+struct StridedOperand<MatrixView<T, M, N, Bounds>>
+{
+    static constexpr bool value = true;
+    static constexpr bool view = true;
+    static const T *pointer(const MatrixView<T, M, N, Bounds> &v) { return v.data(); }
+    static size_t rowStride(const MatrixView<T, M, N, Bounds> &v) { return v.rowStride(); }
+    static size_t colStride(const MatrixView<T, M, N, Bounds> &v) { return v.colStride(); }
+};
+
+//! Operand of a product ready to be read in place: matrices and views as they are, expressions evaluated
+template<class E>
+constexpr decltype(auto) evaluateOperand(const E &e)
+{
+    if constexpr(StridedOperand<E>::value)
+    {
+        return (e);
+    }
+    else
+    {
+        return typename E::plain_type(e);
+    }
+}
+
+} // namespace detail
+
+//! View the elements values[i*rowStride + j*colStride]
+template<class T, size_t M, size_t N, class Bounds>
+constexpr MatrixView<T,M,N,Bounds>::MatrixView(T *values, size_t rowStride, size_t colStride):
+    values(values),
+    rowStep(rowStride),
+    colStep(colStride)
+{
+}
+
+//! Convert a view of mutable elements to a read-only view
+template<class T, size_t M, size_t N, class Bounds>
+template<class U, typename>
+constexpr MatrixView<T,M,N,Bounds>::MatrixView(const MatrixView<U, M, N, Bounds> &other):
+    values(other.data()),
+    rowStep(other.rowStride()),
+    colStep(other.colStride())
+{
+}
+
+//! Copy the elements of other into the viewed elements
+template<class T, size_t M, size_t N, class Bounds>
+constexpr MatrixView<T,M,N,Bounds> &MatrixView<T,M,N,Bounds>::operator=(const MatrixView &other)
+{
+    return (*this) = static_cast<const MatrixExpression<MatrixView> &>(other);
+}
+
+//! Assign the viewed elements by evaluating a matrix expression
+template<class T, size_t M, size_t N, class Bounds>
+template<class E, typename>
+constexpr MatrixView<T,M,N,Bounds> &MatrixView<T,M,N,Bounds>::operator=(const MatrixExpression<E> &expr)
+{
+    const E &e = expr.derived();
+    size_t k = 0;
+    forEach([&e, &k](T &element) { element = e.coeff(k++); });
+    return *this;
+}
+
+//! Element access (a const view still refers to mutable elements, like a pointer)
+template<class T, size_t M, size_t N, class Bounds>
+constexpr T &MatrixView<T,M,N,Bounds>::operator()(size_t i, size_t j) const
+{
+    Bounds::check(i, j, M, N);
+    return values[i*rowStep + j*colStep];
+}
+
+//! Compound addition operator
+template<class T, size_t M, size_t N, class Bounds>
+template<class E>
+constexpr void MatrixView<T,M,N,Bounds>::operator+=(const MatrixExpression<E> &other) const
+{
+    static_assert(detail::IsExpressionOfShape<E, value_type, M, N>::value, "Compound addition requires operands of the same type and shape");
+    const E &e = other.derived();
+    size_t k = 0;
+    forEach([&e, &k](T &element) { element += e.coeff(k++); });
+}
+
+//! Compound subtraction operator
+template<class T, size_t M, size_t N, class Bounds>
+template<class E>
+constexpr void MatrixView<T,M,N,Bounds>::operator-=(const MatrixExpression<E> &other) const
+{
+    static_assert(detail::IsExpressionOfShape<E, value_type, M, N>::value, "Compound subtraction requires operands of the same type and shape");
+    const E &e = other.derived();
+    size_t k = 0;
+    forEach([&e, &k](T &element) { element -= e.coeff(k++); });
+}
+
+//! Compound scalar addition
+template<class T, size_t M, size_t N, class Bounds>
+constexpr void MatrixView<T,M,N,Bounds>::operator+=(value_type value) const
+{
+    forEach([value](T &element) { element += value; });
+}
+
+//! Compound matrix-scalar subtraction
+template<class T, size_t M, size_t N, class Bounds>
+constexpr void MatrixView<T,M,N,Bounds>::operator-=(value_type value) const
+{
+    forEach([value](T &element) { element -= value; });
+}
+
+//! Compound rhs scalar multiplication
+template<class T, size_t M, size_t N, class Bounds>
+constexpr void MatrixView<T,M,N,Bounds>::operator*=(value_type value) const
+{
+    forEach([value](T &element) { element *= value; });
+}
+
+//! Compound matrix element-wise scalar division
+template<class T, size_t M, size_t N, class Bounds>
+constexpr void MatrixView<T,M,N,Bounds>::operator/=(value_type value) const
+{
+    forEach([value](T &element) { element = (value_type)(element / value); });
+}
+
+//! Set all viewed elements to value
+template<class T, size_t M, size_t N, class Bounds>
+constexpr void MatrixView<T,M,N,Bounds>::setValue(value_type value) const
+{
+    forEach([value](T &element) { element = value; });
+}
+
+//! View of the transpose of the viewed elements
+template<class T, size_t M, size_t N, class Bounds>
+constexpr MatrixView<T, N, M, Bounds> MatrixView<T,M,N,Bounds>::transposed() const
+{
+    return MatrixView<T, N, M, Bounds>(values, colStep, rowStep);
+}
+
+//! Apply fn to a reference to every viewed element, row by row
+template<class T, size_t M, size_t N, class Bounds>
+template<class Fn>
+constexpr void MatrixView<T,M,N,Bounds>::forEach(Fn fn) const
+{
+    for(size_t i = 0; i < M; ++i)
+    {
+        T *row = values + i*rowStep;
+        for(size_t j = 0; j < N; ++j)
+        {
+            fn(row[j*colStep]);
+        }
+    }
+}
+
+} // namespace matrix
+
+#endif // _MATRIX_VIEW_HPP__
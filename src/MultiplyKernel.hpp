@@ -0,0 +1,540 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file MultiplyKernel.hpp
+//!
+//! Matrix product kernels selected at compile time from the operand shapes.
+//! All kernels compute C(MxP) = A(MxN) * B(NxP) on row-major storage and sum
+//! each element in the same order as the generic loop, so every kernel equals
+//! the fallback up to rounding (the compiler may contract a kernel's multiplies
+//! and adds into FMAs differently, e.g. with -march=native).
+//!
+//! The shapes that dominate attitude and navigation work (3x3 DCMs, 4x4
+//! quaternion matrices and 6x6 state blocks) are fully unrolled with the rows
+//! of A held in locals. With MTL_ENABLE_SIMD the 4x4 product calls the SIMD
+//! kernels at runtime; the unrolled 3x3 products are faster inline.
+//!
+//! Products whose dimensions are all at least MTL_BLOCKED_MULTIPLY_MIN_SIZE use
+//! a cache-blocked kernel: tiles of B are packed into a contiguous buffer and C
+//! is built from small register tiles, so the inner loops never stride down
+//! the columns of B. With MTL_ENABLE_THREADS, products whose dimensions are all
+//! at least MTL_THREADED_MULTIPLY_MIN_SIZE also split their row panels across
+//! defaultThreadPool(). Everything else uses the generic loop.
+//!
+//! StridedMultiplyKernel takes operands through row and column strides, so
+//! views into larger matrices (blocks, transposes) multiply without first
+//! being copied into matrices.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _MULTIPLY_KERNEL_HPP__
+#define _MULTIPLY_KERNEL_HPP__
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "SimdKernel.hpp"
+#include "ThreadPool.hpp"
+
+//! Smallest dimension for which products use the cache-blocked kernel
+#ifndef MTL_BLOCKED_MULTIPLY_MIN_SIZE
+#define MTL_BLOCKED_MULTIPLY_MIN_SIZE 16
+#endif
+
+//! Smallest dimension for which blocked products are split across threads (with MTL_ENABLE_THREADS)
+#ifndef MTL_THREADED_MULTIPLY_MIN_SIZE
+#define MTL_THREADED_MULTIPLY_MIN_SIZE 128
+#endif
+
+namespace matrix
+{
+
+namespace detail
+{
+
+//! Generic i-j-k loop, used for every shape without a specialized kernel
+template<class T, size_t M, size_t N, size_t P>
+struct GenericMultiplyKernel
+{
+    static constexpr void apply(const T *a, const T *b, T *c)
+    {
+        for(size_t i = 0; i < M; ++i)
+        {
+            for(size_t j = 0; j < P; ++j)
+            {
+                T sum = 0;
+                for(size_t k = 0; k < N; ++k)
+                {
+                    sum += a[i*N+k] * b[k*P+j];
+                }
+                c[i*P+j] = sum;
+            }
+        }
+    }
+};
+
+//! Fully unrolled kernel: each row of A is loaded once and every element is a fixed-length sum
+template<class T, size_t M, size_t N, size_t P>
+struct UnrolledMultiplyKernel
+{
+    static constexpr void apply(const T *a, const T *b, T *c)
+    {
+        applyRows(a, b, c, std::make_index_sequence<M>{});
+    }
+
+private:
+    template<size_t... I>
+    static constexpr void applyRows(const T *a, const T *b, T *c, std::index_sequence<I...>)
+    {
+        (applyRow<I>(a, b, c, std::make_index_sequence<N>{}), ...);
+    }
+
+    template<size_t I, size_t... K>
+    static constexpr void applyRow(const T *a, const T *b, T *c, std::index_sequence<K...>)
+    {
+        const T row[N] = {a[I*N+K]...};
+        applyCols(row, b, c + I*P, std::make_index_sequence<P>{});
+    }
+
+    template<size_t... J>
+    static constexpr void applyCols(const T (&row)[N], const T *b, T *c, std::index_sequence<J...>)
+    {
+        ((c[J] = dot<J>(row, b, std::make_index_sequence<N>{})), ...);
+    }
+
+    template<size_t J, size_t... K>
+    static constexpr T dot(const T (&row)[N], const T *b, std::index_sequence<K...>)
+    {
+        return (T(0) + ... + (row[K] * b[K*P+J]));
+    }
+};
+
+//! Cache-blocked kernel for large products with runtime dimensions, computed one panel of rows of C at a time
+template<class T>
+struct DynamicBlockedMultiplyKernel
+{
+    //! Rows of C per panel (the unit of work given to a thread)
+    static constexpr size_t panelRows = 32;
+
+    //! Register tile of C (four rows by 32 bytes)
+    static constexpr size_t microRows = 4;
+    static constexpr size_t microCols = sizeof(T) < 32 ? 32 / sizeof(T) : 1;
+
+    //! Packed tile of B (128 rows by 16 register tiles)
+    static constexpr size_t tileDepth = 128;
+    static constexpr size_t tileWidth = 16*microCols;
+
+    //! Number of row panels of an m-row product
+    static constexpr size_t panels(size_t m) { return (m + panelRows - 1) / panelRows; }
+
+    static void apply(const T *a, const T *b, T *c, size_t m, size_t n, size_t p)
+    {
+        apply(a, n, b, p, c, m, n, p);
+    }
+
+    //! Split the row panels across a thread pool
+    static void apply(const T *a, const T *b, T *c, size_t m, size_t n, size_t p, ThreadPool &pool)
+    {
+        apply(a, n, b, p, c, m, n, p, pool);
+    }
+
+    //! Product of operands whose rows are lda and ldb elements apart (e.g. blocks of larger matrices)
+    static void apply(const T *a, size_t lda, const T *b, size_t ldb, T *c, size_t m, size_t n, size_t p)
+    {
+        for(size_t panel = 0; panel < panels(m); ++panel)
+        {
+            applyPanel(a, lda, b, ldb, c, m, n, p, panel);
+        }
+    }
+
+    //! Split the row panels of a product with leading dimensions across a thread pool
+    static void apply(const T *a, size_t lda, const T *b, size_t ldb, T *c, size_t m, size_t n, size_t p, ThreadPool &pool)
+    {
+        pool.parallelFor(panels(m), [a, lda, b, ldb, c, m, n, p](size_t panel) { applyPanel(a, lda, b, ldb, c, m, n, p, panel); });
+    }
+
+    //! Compute rows [panel*panelRows, (panel+1)*panelRows) of C
+    static void applyPanel(const T *a, size_t lda, const T *b, size_t ldb, T *c, size_t m, size_t n, size_t p, size_t panel)
+    {
+        const size_t rowBegin = panel*panelRows;
+        const size_t rowEnd = rowBegin + panelRows < m ? rowBegin + panelRows : m;
+        for(size_t i = rowBegin; i < rowEnd; ++i)
+        {
+            for(size_t j = 0; j < p; ++j)
+            {
+                c[i*p+j] = T(0);
+            }
+        }
+
+        // Tiles are visited in increasing k so each element is summed in the same order as the generic loop
+        T packed[tileDepth*tileWidth];
+        for(size_t k0 = 0; k0 < n; k0 += tileDepth)
+        {
+            const size_t depth = k0 + tileDepth < n ? tileDepth : n - k0;
+            for(size_t j0 = 0; j0 < p; j0 += tileWidth)
+            {
+                const size_t width = j0 + tileWidth < p ? tileWidth : p - j0;
+                for(size_t k = 0; k < depth; ++k)
+                {
+                    for(size_t j = 0; j < width; ++j)
+                    {
+                        packed[k*tileWidth+j] = b[(k0+k)*ldb + j0 + j];
+                    }
+                }
+
+                size_t i = rowBegin;
+                for(; i + microRows <= rowEnd; i += microRows)
+                {
+                    size_t j = 0;
+                    for(; j + microCols <= width; j += microCols)
+                    {
+                        applyMicroTile(a + i*lda + k0, packed + j, c + i*p + j0 + j, lda, p, depth, std::make_index_sequence<microRows*microCols>{});
+                    }
+                    applyEdge(a + i*lda + k0, packed + j, c + i*p + j0 + j, lda, p, microRows, width - j, depth);
+                }
+                applyEdge(a + i*lda + k0, packed, c + i*p + j0, lda, p, rowEnd - i, width, depth);
+            }
+        }
+    }
+
+private:
+    //! Accumulate one register tile of C over depth rows of a packed tile
+    template<size_t... I>
+    static void applyMicroTile(const T *a, const T *packed, T *c, size_t lda, size_t p, size_t depth, std::index_sequence<I...>)
+    {
+        T acc[microRows*microCols] = {c[(I/microCols)*p + I%microCols]...};
+        for(size_t k = 0; k < depth; ++k)
+        {
+            const T *row = packed + k*tileWidth;
+            ((acc[I] += a[(I/microCols)*lda + k] * row[I%microCols]), ...);
+        }
+        ((c[(I/microCols)*p + I%microCols] = acc[I]), ...);
+    }
+
+    //! Accumulate the rows and columns that do not fill a register tile
+    static void applyEdge(const T *a, const T *packed, T *c, size_t lda, size_t p, size_t rows, size_t cols, size_t depth)
+    {
+        for(size_t i = 0; i < rows; ++i)
+        {
+            for(size_t k = 0; k < depth; ++k)
+            {
+                const T aik = a[i*lda+k];
+                for(size_t j = 0; j < cols; ++j)
+                {
+                    c[i*p+j] += aik * packed[k*tileWidth+j];
+                }
+            }
+        }
+    }
+};
+
+//! Cache-blocked kernel for large fixed-size products
+template<class T, size_t M, size_t N, size_t P>
+struct BlockedMultiplyKernel
+{
+    //! Number of row panels
+    static constexpr size_t panels = DynamicBlockedMultiplyKernel<T>::panels(M);
+
+    static void apply(const T *a, const T *b, T *c)
+    {
+        DynamicBlockedMultiplyKernel<T>::apply(a, b, c, M, N, P);
+    }
+
+    //! Split the row panels across a thread pool
+    static void apply(const T *a, const T *b, T *c, ThreadPool &pool)
+    {
+        DynamicBlockedMultiplyKernel<T>::apply(a, b, c, M, N, P, pool);
+    }
+};
+
+//! Kernel used by Matrix::operator* (generic or blocked loop unless specialized below)
+template<class T, size_t M, size_t N, size_t P>
+struct MultiplyKernel
+{
+    static constexpr bool blocked = M >= MTL_BLOCKED_MULTIPLY_MIN_SIZE && N >= MTL_BLOCKED_MULTIPLY_MIN_SIZE && P >= MTL_BLOCKED_MULTIPLY_MIN_SIZE;
+    static constexpr bool threaded = M >= MTL_THREADED_MULTIPLY_MIN_SIZE && N >= MTL_THREADED_MULTIPLY_MIN_SIZE && P >= MTL_THREADED_MULTIPLY_MIN_SIZE;
+
+    static constexpr void apply(const T *a, const T *b, T *c)
+    {
+        if constexpr(blocked)
+        {
+            if(!__builtin_is_constant_evaluated())
+            {
+#if defined(MTL_ENABLE_THREADS)
+                if constexpr(threaded)
+                {
+                    BlockedMultiplyKernel<T, M, N, P>::apply(a, b, c, defaultThreadPool());
+                    return;
+                }
+#endif
+                BlockedMultiplyKernel<T, M, N, P>::apply(a, b, c);
+                return;
+            }
+        }
+        GenericMultiplyKernel<T, M, N, P>::apply(a, b, c);
+    }
+};
+
+//! 3x3 * 3x3 (DCM composition)
+template<class T>
+struct MultiplyKernel<T, 3, 3, 3>
+{
+    static constexpr void apply(const T *a, const T *b, T *c)
+    {
+        const T b00 = b[0], b01 = b[1], b02 = b[2];
+        const T b10 = b[3], b11 = b[4], b12 = b[5];
+        const T b20 = b[6], b21 = b[7], b22 = b[8];
+        const T a00 = a[0], a01 = a[1], a02 = a[2];
+        const T a10 = a[3], a11 = a[4], a12 = a[5];
+        const T a20 = a[6], a21 = a[7], a22 = a[8];
+        c[0] = T(0) + a00*b00 + a01*b10 + a02*b20;
+        c[1] = T(0) + a00*b01 + a01*b11 + a02*b21;
+        c[2] = T(0) + a00*b02 + a01*b12 + a02*b22;
+        c[3] = T(0) + a10*b00 + a11*b10 + a12*b20;
+        c[4] = T(0) + a10*b01 + a11*b11 + a12*b21;
+        c[5] = T(0) + a10*b02 + a11*b12 + a12*b22;
+        c[6] = T(0) + a20*b00 + a21*b10 + a22*b20;
+        c[7] = T(0) + a20*b01 + a21*b11 + a22*b21;
+        c[8] = T(0) + a20*b02 + a21*b12 + a22*b22;
+    }
+};
+
+//! 3x3 * 3x1 (DCM rotating a vector)
+template<class T>
+struct MultiplyKernel<T, 3, 3, 1>
+{
+    static constexpr void apply(const T *a, const T *b, T *c)
+    {
+        const T x = b[0], y = b[1], z = b[2];
+        c[0] = T(0) + a[0]*x + a[1]*y + a[2]*z;
+        c[1] = T(0) + a[3]*x + a[4]*y + a[5]*z;
+        c[2] = T(0) + a[6]*x + a[7]*y + a[8]*z;
+    }
+};
+
+//! 4x4 * 4x1 (quaternion matrix times a quaternion)
+template<class T>
+struct MultiplyKernel<T, 4, 4, 1>
+{
+    static constexpr void apply(const T *a, const T *b, T *c)
+    {
+        const T q0 = b[0], q1 = b[1], q2 = b[2], q3 = b[3];
+        c[0] = T(0) + a[0]*q0  + a[1]*q1  + a[2]*q2  + a[3]*q3;
+        c[1] = T(0) + a[4]*q0  + a[5]*q1  + a[6]*q2  + a[7]*q3;
+        c[2] = T(0) + a[8]*q0  + a[9]*q1  + a[10]*q2 + a[11]*q3;
+        c[3] = T(0) + a[12]*q0 + a[13]*q1 + a[14]*q2 + a[15]*q3;
+    }
+};
+
+//! 4x4 * 4x4 (quaternion matrix composition)
+template<class T>
+struct MultiplyKernel<T, 4, 4, 4>
+{
+    static constexpr void apply(const T *a, const T *b, T *c)
+    {
+        if(simd::useRuntimeKernels<T>())
+        {
+            simd::kernels<T>().multiply4x4(a, b, c, 1);
+            return;
+        }
+        UnrolledMultiplyKernel<T, 4, 4, 4>::apply(a, b, c);
+    }
+};
+
+//! 6x6 * 6x6 (state transition and covariance blocks)
+template<class T>
+struct MultiplyKernel<T, 6, 6, 6> : UnrolledMultiplyKernel<T, 6, 6, 6>
+{
+};
+
+//! 6x6 * 6x1 (state propagation)
+template<class T>
+struct MultiplyKernel<T, 6, 6, 1> : UnrolledMultiplyKernel<T, 6, 6, 1>
+{
+};
+
+//! Kernel for products whose dimensions are only known at runtime: shapes with a
+//! fixed-size kernel run it directly on the same storage, large products use the
+//! blocked kernel and everything else the generic loop
+template<class T>
+struct DynamicMultiplyKernel
+{
+    static void apply(const T *a, const T *b, T *c, size_t m, size_t n, size_t p)
+    {
+        if(m == 3 && n == 3 && p == 3)
+        {
+            MultiplyKernel<T, 3, 3, 3>::apply(a, b, c);
+        }
+        else if(m == 3 && n == 3 && p == 1)
+        {
+            MultiplyKernel<T, 3, 3, 1>::apply(a, b, c);
+        }
+        else if(m == 4 && n == 4 && p == 1)
+        {
+            MultiplyKernel<T, 4, 4, 1>::apply(a, b, c);
+        }
+        else if(m == 4 && n == 4 && p == 4)
+        {
+            MultiplyKernel<T, 4, 4, 4>::apply(a, b, c);
+        }
+        else if(m == 6 && n == 6 && p == 6)
+        {
+            MultiplyKernel<T, 6, 6, 6>::apply(a, b, c);
+        }
+        else if(m == 6 && n == 6 && p == 1)
+        {
+            MultiplyKernel<T, 6, 6, 1>::apply(a, b, c);
+        }
+        else if(m >= MTL_BLOCKED_MULTIPLY_MIN_SIZE && n >= MTL_BLOCKED_MULTIPLY_MIN_SIZE && p >= MTL_BLOCKED_MULTIPLY_MIN_SIZE)
+        {
+#if defined(MTL_ENABLE_THREADS)
+            if(m >= MTL_THREADED_MULTIPLY_MIN_SIZE && n >= MTL_THREADED_MULTIPLY_MIN_SIZE && p >= MTL_THREADED_MULTIPLY_MIN_SIZE)
+            {
+                DynamicBlockedMultiplyKernel<T>::apply(a, b, c, m, n, p, defaultThreadPool());
+                return;
+            }
+#endif
+            DynamicBlockedMultiplyKernel<T>::apply(a, b, c, m, n, p);
+        }
+        else
+        {
+            for(size_t i = 0; i < m; ++i)
+            {
+                for(size_t j = 0; j < p; ++j)
+                {
+                    T sum = 0;
+                    for(size_t k = 0; k < n; ++k)
+                    {
+                        sum += a[i*n+k] * b[k*p+j];
+                    }
+                    c[i*p+j] = sum;
+                }
+            }
+        }
+    }
+};
+
+//! Product of operands whose element (i,j) is at i*rowStride + j*colStride (views into
+//! larger matrices, transposes), written to row-major C. Operands are never copied
+//! into matrices first: contiguous operands go straight to the fixed-size kernel,
+//! large operands with contiguous rows straight to the blocked kernel (which reads
+//! rows lda/ldb apart), and other operands are packed by the kernel itself, like
+//! the blocked kernel packs tiles of B, into a stack buffer for small products or
+//! a scratch buffer for large ones. Operands too large for the stack but too thin
+//! for the blocked kernel use whichever loop order walks B contiguously.
+template<class T, size_t M, size_t N, size_t P>
+struct StridedMultiplyKernel
+{
+    static constexpr bool blocked = M >= MTL_BLOCKED_MULTIPLY_MIN_SIZE && N >= MTL_BLOCKED_MULTIPLY_MIN_SIZE && P >= MTL_BLOCKED_MULTIPLY_MIN_SIZE;
+
+    //! Largest operand (in bytes) packed on the stack
+    static constexpr size_t maxStackBytes = 4096;
+
+    static void apply(const T *a, size_t aRowStride, size_t aColStride, const T *b, size_t bRowStride, size_t bColStride, T *c)
+    {
+        const bool aContiguous = aRowStride == N && aColStride == 1;
+        const bool bContiguous = bRowStride == P && bColStride == 1;
+        if(aContiguous && bContiguous)
+        {
+            MultiplyKernel<T, M, N, P>::apply(a, b, c);
+        }
+        else if constexpr(blocked)
+        {
+            std::unique_ptr<T[]> aPacked(aColStride == 1 ? nullptr : new T[M*N]);
+            std::unique_ptr<T[]> bPacked(bColStride == 1 ? nullptr : new T[N*P]);
+            if(aPacked)
+            {
+                pack<M, N>(a, aRowStride, aColStride, aPacked.get());
+            }
+            if(bPacked)
+            {
+                pack<N, P>(b, bRowStride, bColStride, bPacked.get());
+            }
+            applyBlocked(aPacked ? aPacked.get() : a, aPacked ? N : aRowStride, bPacked ? bPacked.get() : b, bPacked ? P : bRowStride, c);
+        }
+        else if constexpr(M*N*sizeof(T) <= maxStackBytes && N*P*sizeof(T) <= maxStackBytes)
+        {
+            T aPacked[M*N];
+            T bPacked[N*P];
+            if(!aContiguous)
+            {
+                pack<M, N>(a, aRowStride, aColStride, aPacked);
+            }
+            if(!bContiguous)
+            {
+                pack<N, P>(b, bRowStride, bColStride, bPacked);
+            }
+            MultiplyKernel<T, M, N, P>::apply(aContiguous ? a : aPacked, bContiguous ? b : bPacked, c);
+        }
+        else if(bColStride == 1)
+        {
+            // Rows of B are contiguous: build each row of C from whole rows of B (i-k-j order)
+            for(size_t i = 0; i < M; ++i)
+            {
+                T *ci = c + i*P;
+                for(size_t j = 0; j < P; ++j)
+                {
+                    ci[j] = T(0);
+                }
+                for(size_t k = 0; k < N; ++k)
+                {
+                    const T aik = a[i*aRowStride + k*aColStride];
+                    const T *bk = b + k*bRowStride;
+                    for(size_t j = 0; j < P; ++j)
+                    {
+                        ci[j] += aik * bk[j];
+                    }
+                }
+            }
+        }
+        else
+        {
+            // Columns of B are contiguous (or nothing is): one dot product per element (i-j-k order)
+            for(size_t i = 0; i < M; ++i)
+            {
+                for(size_t j = 0; j < P; ++j)
+                {
+                    T sum = 0;
+                    for(size_t k = 0; k < N; ++k)
+                    {
+                        sum += a[i*aRowStride + k*aColStride] * b[k*bRowStride + j*bColStride];
+                    }
+                    c[i*P+j] = sum;
+                }
+            }
+        }
+    }
+
+private:
+    //! Copy a strided R x C operand into a contiguous row-major buffer
+    template<size_t R, size_t C>
+    static void pack(const T *src, size_t rowStride, size_t colStride, T *dst)
+    {
+        for(size_t i = 0; i < R; ++i)
+        {
+            for(size_t j = 0; j < C; ++j)
+            {
+                dst[i*C+j] = src[i*rowStride + j*colStride];
+            }
+        }
+    }
+
+    //! Blocked product of operands with contiguous rows
+    static void applyBlocked(const T *a, size_t lda, const T *b, size_t ldb, T *c)
+    {
+#if defined(MTL_ENABLE_THREADS)
+        if constexpr(M >= MTL_THREADED_MULTIPLY_MIN_SIZE && N >= MTL_THREADED_MULTIPLY_MIN_SIZE && P >= MTL_THREADED_MULTIPLY_MIN_SIZE)
+        {
+            DynamicBlockedMultiplyKernel<T>::apply(a, lda, b, ldb, c, M, N, P, defaultThreadPool());
+            return;
+        }
+#endif
+        DynamicBlockedMultiplyKernel<T>::apply(a, lda, b, ldb, c, M, N, P);
+    }
+};
+
+} // namespace detail
+
+} // namespace matrix
+
+#endif // _MULTIPLY_KERNEL_HPP__
@@ -0,0 +1,307 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file PaddedMatrix3.hpp
+//!
+//! 3x3 matrix stored as three rows of four lanes (like three PaddedVector3s)
+//! and aligned to four elements, so each row of a product or rotation is a
+//! single aligned SIMD load or store. The padding lanes hold zero and every
+//! operation keeps them zero.
+//!
+//! PaddedMatrix3 is an opt-in storage format for hot loops, e.g. a DCM that
+//! rotates many vectors. Convert from and to SquareMatrix<T, 3> or DCM at the
+//! boundary; results match the packed types element for element, up to
+//! rounding when MTL_ENABLE_SIMD sends products through the SIMD kernels.
+//! A single matrix-vector product stays inline, which is faster than a call
+//! through the kernel table; rotate() takes many vectors in one call.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _PADDED_MATRIX3_HPP__
+#define _PADDED_MATRIX3_HPP__
+
+#include <type_traits>
+
+#include "BoundsPolicy.hpp"
+#include "PaddedVector3.hpp"
+#include "SimdKernel.hpp"
+#include "SquareMatrix.hpp"
+
+namespace matrix
+{
+
+template<class T>
+class alignas(4*sizeof(T)) PaddedMatrix3
+{
+public:
+    //! Default constructor (zero matrix)
+    constexpr PaddedMatrix3();
+
+    //! Construct from a packed 3x3 matrix (including SquareMatrix and DCM)
+    constexpr PaddedMatrix3(const Matrix<T, 3, 3> &other);
+
+    //! Copy into a packed 3x3 matrix
+    constexpr SquareMatrix<T, 3> toSquareMatrix() const;
+
+    //! Element access operator
+    constexpr const T &operator()(size_t i, size_t j) const;
+
+    //! Element assignment operator (the padding lanes are not accessible)
+    constexpr T &operator()(size_t i, size_t j);
+
+    //! Pointer to the twelve lanes (row i starts at data() + 4*i)
+    constexpr const T *data() const { return values; }
+
+    //! Row i as a padded vector
+    constexpr PaddedVector3<T> row(size_t i) const;
+
+    //! Set to the identity matrix
+    constexpr void identity();
+
+    //! Matrix transpose
+    constexpr PaddedMatrix3 transpose() const;
+
+    //! Matrix multiply
+    constexpr PaddedMatrix3 operator*(const PaddedMatrix3 &other) const;
+
+    //! Matrix-vector multiply (e.g. rotate a vector by a DCM)
+    constexpr PaddedVector3<T> operator*(const PaddedVector3<T> &v) const;
+
+    //! Compound matrix multiplication
+    constexpr void operator*=(const PaddedMatrix3 &other);
+
+    //! Matrix addition
+    constexpr PaddedMatrix3 operator+(const PaddedMatrix3 &other) const;
+
+    //! Matrix subtraction
+    constexpr PaddedMatrix3 operator-(const PaddedMatrix3 &other) const;
+
+    //! Scalar multiplication
+    constexpr PaddedMatrix3 operator*(T value) const;
+
+    //! Equality operator
+    constexpr bool operator==(const PaddedMatrix3 &other) const;
+
+    //! Inequality operator
+    constexpr bool operator!=(const PaddedMatrix3 &other) const;
+
+    //! Multiply count vectors by this matrix (out may be in)
+    void rotate(const PaddedVector3<T> *in, PaddedVector3<T> *out, size_t count) const;
+
+private:
+    // Three rows of x, y, z and a padding lane that is always zero
+    T values[12];
+};
+
+static_assert(sizeof(PaddedMatrix3<float>) == 48, "PaddedMatrix3<float> must hold three 128-bit rows");
+static_assert(alignof(PaddedMatrix3<double>) == 32, "PaddedMatrix3<double> must be aligned for 256-bit loads");
+static_assert(std::is_trivially_copyable<PaddedMatrix3<double>>::value, "PaddedMatrix3 must be trivially copyable");
+
+//! Default constructor (zero matrix)
+template<class T>
+constexpr PaddedMatrix3<T>::PaddedMatrix3():
+    values{}
+{
+}
+
+//! Construct from a packed 3x3 matrix (including SquareMatrix and DCM)
+template<class T>
+constexpr PaddedMatrix3<T>::PaddedMatrix3(const Matrix<T, 3, 3> &other):
+    values{}
+{
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < 3; ++j)
+        {
+            values[4*i+j] = other(i,j);
+        }
+    }
+}
+
+//! Copy into a packed 3x3 matrix
+template<class T>
+constexpr SquareMatrix<T, 3> PaddedMatrix3<T>::toSquareMatrix() const
+{
+    SquareMatrix<T, 3> result;
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < 3; ++j)
+        {
+            result(i,j) = values[4*i+j];
+        }
+    }
+    return result;
+}
+
+//! Element access operator
+template<class T>
+constexpr const T &PaddedMatrix3<T>::operator()(size_t i, size_t j) const
+{
+    DefaultBounds::check(i, j, 3, 3);
+    return values[4*i+j];
+}
+
+//! Element assignment operator (the padding lanes are not accessible)
+template<class T>
+constexpr T &PaddedMatrix3<T>::operator()(size_t i, size_t j)
+{
+    DefaultBounds::check(i, j, 3, 3);
+    return values[4*i+j];
+}
+
+//! Row i as a padded vector
+template<class T>
+constexpr PaddedVector3<T> PaddedMatrix3<T>::row(size_t i) const
+{
+    DefaultBounds::check(i, 0, 3, 1);
+    return PaddedVector3<T>(values[4*i], values[4*i+1], values[4*i+2]);
+}
+
+//! Set to the identity matrix
+template<class T>
+constexpr void PaddedMatrix3<T>::identity()
+{
+    for(size_t i = 0; i < 12; ++i)
+    {
+        values[i] = T(0);
+    }
+    values[0] = values[5] = values[10] = T(1);
+}
+
+//! Matrix transpose
+template<class T>
+constexpr PaddedMatrix3<T> PaddedMatrix3<T>::transpose() const
+{
+    PaddedMatrix3<T> result;
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < 3; ++j)
+        {
+            result.values[4*j+i] = values[4*i+j];
+        }
+    }
+    return result;
+}
+
+//! Matrix multiply
+template<class T>
+constexpr PaddedMatrix3<T> PaddedMatrix3<T>::operator*(const PaddedMatrix3<T> &other) const
+{
+    PaddedMatrix3<T> result;
+    if(simd::useRuntimeKernels<T>())
+    {
+        simd::kernels<T>().multiply3x3Padded(values, other.values, result.values, 1);
+        return result;
+    }
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < 3; ++j)
+        {
+            result.values[4*i+j] = T(0) + values[4*i]*other.values[j] + values[4*i+1]*other.values[4+j] + values[4*i+2]*other.values[8+j];
+        }
+    }
+    return result;
+}
+
+//! Matrix-vector multiply (e.g. rotate a vector by a DCM)
+template<class T>
+constexpr PaddedVector3<T> PaddedMatrix3<T>::operator*(const PaddedVector3<T> &v) const
+{
+    const T x = v.values[0], y = v.values[1], z = v.values[2];
+    return PaddedVector3<T>(T(0) + values[0]*x + values[1]*y + values[2]*z,
+                            T(0) + values[4]*x + values[5]*y + values[6]*z,
+                            T(0) + values[8]*x + values[9]*y + values[10]*z);
+}
+
+//! Compound matrix multiplication
+template<class T>
+constexpr void PaddedMatrix3<T>::operator*=(const PaddedMatrix3<T> &other)
+{
+    if(simd::useRuntimeKernels<T>())
+    {
+        // The kernels read a whole row before writing it, so the product can go straight into this
+        simd::kernels<T>().multiply3x3Padded(values, other.values, values, 1);
+        return;
+    }
+    (*this) = (*this) * other;
+}
+
+//! Matrix addition
+template<class T>
+constexpr PaddedMatrix3<T> PaddedMatrix3<T>::operator+(const PaddedMatrix3<T> &other) const
+{
+    PaddedMatrix3<T> result;
+    for(size_t i = 0; i < 12; ++i)
+    {
+        result.values[i] = values[i] + other.values[i];
+    }
+    return result;
+}
+
+//! Matrix subtraction
+template<class T>
+constexpr PaddedMatrix3<T> PaddedMatrix3<T>::operator-(const PaddedMatrix3<T> &other) const
+{
+    PaddedMatrix3<T> result;
+    for(size_t i = 0; i < 12; ++i)
+    {
+        result.values[i] = values[i] - other.values[i];
+    }
+    return result;
+}
+
+//! Scalar multiplication
+template<class T>
+constexpr PaddedMatrix3<T> PaddedMatrix3<T>::operator*(T value) const
+{
+    // The padding lanes are scaled by zero, so they stay zero even for a non-finite value
+    const T scale[4] = {value, value, value, T(0)};
+    PaddedMatrix3<T> result;
+    for(size_t i = 0; i < 12; ++i)
+    {
+        result.values[i] = values[i] * scale[i%4];
+    }
+    return result;
+}
+
+//! Equality operator
+template<class T>
+constexpr bool PaddedMatrix3<T>::operator==(const PaddedMatrix3<T> &other) const
+{
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < 3; ++j)
+        {
+            if(values[4*i+j] != other.values[4*i+j])
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//! Inequality operator
+template<class T>
+constexpr bool PaddedMatrix3<T>::operator!=(const PaddedMatrix3<T> &other) const
+{
+    return !(*this == other);
+}
+
+//! Multiply count vectors by this matrix (out may be in)
+template<class T>
+void PaddedMatrix3<T>::rotate(const PaddedVector3<T> *in, PaddedVector3<T> *out, size_t count) const
+{
+    if(simd::useRuntimeKernels<T>() && count > 0)
+    {
+        simd::kernels<T>().rotate3Padded(values, in[0].values, out[0].values, count);
+        return;
+    }
+    for(size_t n = 0; n < count; ++n)
+    {
+        out[n] = (*this) * in[n];
+    }
+}
+
+} // namespace matrix
+
+#endif // _PADDED_MATRIX3_HPP__
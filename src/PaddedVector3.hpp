@@ -0,0 +1,307 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file PaddedVector3.hpp
+//!
+//! 3-vector stored in four lanes and aligned to four elements (16 bytes for
+//! float, 32 for double), so a single aligned SIMD load or store covers the
+//! whole vector. The fourth lane is padding: every operation keeps it zero, so
+//! it can take part in full-width arithmetic without changing any result.
+//!
+//! PaddedVector3 is an opt-in storage format for hot loops. Convert from and
+//! to Vector3 at the boundary; results match Vector3 element for element.
+//! Prefer the compound operators (v += u*s) in hot loops: they update the
+//! four lanes in place, where v = v + u*s also copies the result.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _PADDED_VECTOR3_HPP__
+#define _PADDED_VECTOR3_HPP__
+
+#include <cmath>
+#include <type_traits>
+
+#include "BoundsPolicy.hpp"
+#include "Vector3.hpp"
+
+namespace matrix
+{
+
+template<class T>
+class alignas(4*sizeof(T)) PaddedVector3
+{
+public:
+    //! Default constructor (zero vector)
+    constexpr PaddedVector3();
+
+    //! Create 3-vector from individual elements
+    constexpr PaddedVector3(T x, T y, T z);
+
+    //! Construct from a packed 3-vector
+    constexpr PaddedVector3(const Vector3<T> &other);
+
+    //! Copy into a packed 3-vector
+    constexpr Vector3<T> toVector3() const;
+
+    //! Access vector elements
+    constexpr const T &operator()(size_t i) const;
+
+    //! Assign vector elements (the padding lane is not accessible)
+    constexpr T &operator()(size_t i);
+
+    //! Pointer to the four lanes
+    constexpr const T *data() const { return values; }
+
+    //! Vector addition
+    constexpr PaddedVector3 operator+(const PaddedVector3 &other) const;
+
+    //! Vector subtraction
+    constexpr PaddedVector3 operator-(const PaddedVector3 &other) const;
+
+    //! Unary minus
+    constexpr PaddedVector3 operator-() const;
+
+    //! Scalar multiplication
+    constexpr PaddedVector3 operator*(T value) const;
+
+    //! Scalar division
+    constexpr PaddedVector3 operator/(T value) const;
+
+    //! Compound vector addition
+    constexpr void operator+=(const PaddedVector3 &other);
+
+    //! Compound vector subtraction
+    constexpr void operator-=(const PaddedVector3 &other);
+
+    //! Compound scalar multiplication
+    constexpr void operator*=(T value);
+
+    //! Equality operator
+    constexpr bool operator==(const PaddedVector3 &other) const;
+
+    //! Inequality operator
+    constexpr bool operator!=(const PaddedVector3 &other) const;
+
+    //! Dot product of this vector with b
+    constexpr T dot(const PaddedVector3 &b) const;
+
+    //! Vector multiplication (dot product)
+    constexpr T operator*(const PaddedVector3 &b) const;
+
+    //! Cross product
+    constexpr PaddedVector3 cross(const PaddedVector3 &other) const;
+
+    //! Compute the norm of a vector
+    T norm() const;
+
+    //! Normalize this vector
+    void normalize();
+
+    //! Return unit vector
+    PaddedVector3 unit() const;
+
+private:
+    // x, y, z and a padding lane that is always zero
+    T values[4];
+
+    template<class>
+    friend class PaddedMatrix3;
+};
+
+static_assert(sizeof(PaddedVector3<float>) == 16, "PaddedVector3<float> must fill one 128-bit register");
+static_assert(alignof(PaddedVector3<double>) == 32, "PaddedVector3<double> must be aligned for 256-bit loads");
+static_assert(std::is_trivially_copyable<PaddedVector3<double>>::value, "PaddedVector3 must be trivially copyable");
+
+//! Default constructor (zero vector)
+template<class T>
+constexpr PaddedVector3<T>::PaddedVector3():
+    values{}
+{
+}
+
+//! Create 3-vector from individual elements
+template<class T>
+constexpr PaddedVector3<T>::PaddedVector3(T x, T y, T z):
+    values{x, y, z, T(0)}
+{
+}
+
+//! Construct from a packed 3-vector
+template<class T>
+constexpr PaddedVector3<T>::PaddedVector3(const Vector3<T> &other):
+    values{other.coeff(0), other.coeff(1), other.coeff(2), T(0)}
+{
+}
+
+//! Copy into a packed 3-vector
+template<class T>
+constexpr Vector3<T> PaddedVector3<T>::toVector3() const
+{
+    return Vector3<T>(values[0], values[1], values[2]);
+}
+
+//! Access vector elements
+template<class T>
+constexpr const T &PaddedVector3<T>::operator()(size_t i) const
+{
+    DefaultBounds::check(i, 0, 3, 1);
+    return values[i];
+}
+
+//! Assign vector elements (the padding lane is not accessible)
+template<class T>
+constexpr T &PaddedVector3<T>::operator()(size_t i)
+{
+    DefaultBounds::check(i, 0, 3, 1);
+    return values[i];
+}
+
+//! Vector addition
+template<class T>
+constexpr PaddedVector3<T> PaddedVector3<T>::operator+(const PaddedVector3<T> &other) const
+{
+    PaddedVector3<T> result;
+    for(size_t i = 0; i < 4; ++i)
+    {
+        result.values[i] = values[i] + other.values[i];
+    }
+    return result;
+}
+
+//! Vector subtraction
+template<class T>
+constexpr PaddedVector3<T> PaddedVector3<T>::operator-(const PaddedVector3<T> &other) const
+{
+    PaddedVector3<T> result;
+    for(size_t i = 0; i < 4; ++i)
+    {
+        result.values[i] = values[i] - other.values[i];
+    }
+    return result;
+}
+
+//! Unary minus
+template<class T>
+constexpr PaddedVector3<T> PaddedVector3<T>::operator-() const
+{
+    return PaddedVector3<T>(-values[0], -values[1], -values[2]);
+}
+
+//! Scalar multiplication
+template<class T>
+constexpr PaddedVector3<T> PaddedVector3<T>::operator*(T value) const
+{
+    // The padding lane is scaled by zero, so it stays zero even for a non-finite value
+    const T scale[4] = {value, value, value, T(0)};
+    PaddedVector3<T> result;
+    for(size_t i = 0; i < 4; ++i)
+    {
+        result.values[i] = values[i] * scale[i];
+    }
+    return result;
+}
+
+//! Scalar division
+template<class T>
+constexpr PaddedVector3<T> PaddedVector3<T>::operator/(T value) const
+{
+    // The padding lane stays zero even for value == 0
+    return PaddedVector3<T>(values[0] / value, values[1] / value, values[2] / value);
+}
+
+//! Compound vector addition
+template<class T>
+constexpr void PaddedVector3<T>::operator+=(const PaddedVector3<T> &other)
+{
+    for(size_t i = 0; i < 4; ++i)
+    {
+        values[i] += other.values[i];
+    }
+}
+
+//! Compound vector subtraction
+template<class T>
+constexpr void PaddedVector3<T>::operator-=(const PaddedVector3<T> &other)
+{
+    for(size_t i = 0; i < 4; ++i)
+    {
+        values[i] -= other.values[i];
+    }
+}
+
+//! Compound scalar multiplication
+template<class T>
+constexpr void PaddedVector3<T>::operator*=(T value)
+{
+    const T scale[4] = {value, value, value, T(0)};
+    for(size_t i = 0; i < 4; ++i)
+    {
+        values[i] *= scale[i];
+    }
+}
+
+//! Equality operator
+template<class T>
+constexpr bool PaddedVector3<T>::operator==(const PaddedVector3<T> &other) const
+{
+    return values[0] == other.values[0] && values[1] == other.values[1] && values[2] == other.values[2];
+}
+
+//! Inequality operator
+template<class T>
+constexpr bool PaddedVector3<T>::operator!=(const PaddedVector3<T> &other) const
+{
+    return !(*this == other);
+}
+
+//! Dot product of this vector with b
+template<class T>
+constexpr T PaddedVector3<T>::dot(const PaddedVector3<T> &b) const
+{
+    T value = 0;
+    for(size_t i = 0; i < 3; ++i)
+    {
+        value += values[i] * b.values[i];
+    }
+    return value;
+}
+
+//! Vector multiplication (dot product)
+template<class T>
+constexpr T PaddedVector3<T>::operator*(const PaddedVector3<T> &b) const
+{
+    return dot(b);
+}
+
+//! Cross product
+template<class T>
+constexpr PaddedVector3<T> PaddedVector3<T>::cross(const PaddedVector3<T> &other) const
+{
+    const T *a = values;
+    const T *b = other.values;
+    return PaddedVector3<T>(a[1]*b[2]-a[2]*b[1], a[2]*b[0]-a[0]*b[2], a[0]*b[1]-a[1]*b[0]);
+}
+
+//! Compute the norm of a vector
+template<class T>
+T PaddedVector3<T>::norm() const
+{
+    return T(std::sqrt(dot(*this)));
+}
+
+//! Normalize this vector
+template<class T>
+void PaddedVector3<T>::normalize()
+{
+    (*this) = (*this) / norm();
+}
+
+//! Return unit vector
+template<class T>
+PaddedVector3<T> PaddedVector3<T>::unit() const
+{
+    return (*this) / norm();
+}
+
+} // namespace matrix
+
+#endif // _PADDED_VECTOR3_HPP__
@@ -39,13 +39,13 @@ public:
     // Constructors
     //-------------------------------------------------------------------------
     //! Default constructor
-    Quaternion();
+    constexpr Quaternion();
 
     //! Constructor from array of values
-    explicit Quaternion(const T values[4]);
+    explicit constexpr Quaternion(const T values[4]);
 
     //! Constructor from individual values
-    Quaternion(T q0, T q1, T q2, T q3);
+    constexpr Quaternion(T q0, T q1, T q2, T q3);
 
     //! Construct from axis and angle
     Quaternion(const Vector3<T> &axis, T angle);
@@ -57,7 +57,11 @@ public:
     Quaternion(const DCM<T> &dcm);
 
     //! Construct quaternion from Vector<T, 4>
-    Quaternion(const Vector<T, 4> &vec);
+    constexpr Quaternion(const Vector<T, 4> &vec);
+
+    //! Construct by evaluating a matrix expression
+    template<class E, typename = std::enable_if_t<detail::IsExpressionOfShape<E, T, 4, 1>::value>>
+    constexpr Quaternion(const MatrixExpression<E> &expr);
 
     //! Construct a quaternion generating the shortest rotation from a to b
     Quaternion(const Vector3<T> &a, const Vector3<T> &b, const T eps = 1.0e-6);
@@ -66,40 +70,40 @@ public:
     // Operators
     //-------------------------------------------------------------------------
     //! Quaternion addition
-    Quaternion operator+(const Quaternion<T> &q) const;
+    constexpr Quaternion operator+(const Quaternion<T> &q) const;
 
     //! Quaternion subtraction
-    Quaternion operator-(const Quaternion<T> &q) const;
+    constexpr Quaternion operator-(const Quaternion<T> &q) const;
 
     //! Quaternion multiplication
-    Quaternion operator*(const Quaternion<T> &q) const;
+    constexpr Quaternion operator*(const Quaternion<T> &q) const;
 
     //! Compound quaternion addition operator
-    void operator+=(const Quaternion<T> &other);
+    constexpr void operator+=(const Quaternion<T> &other);
 
     //! Compound quaternion subtraction operator
-    void operator-=(const Quaternion<T> &other);
+    constexpr void operator-=(const Quaternion<T> &other);
 
     //! Quaternion compound multiplication operator
-    void operator*=(const Quaternion<T> &other);
+    constexpr void operator*=(const Quaternion<T> &other);
 
     //! Add scalar component
-    Quaternion operator+(T value) const;
+    constexpr Quaternion operator+(T value) const;
 
     //! Subtract scalar component
-    Quaternion operator-(T value) const;
+    constexpr Quaternion operator-(T value) const;
 
     //! Quaternion-scalar multiplication
-    Quaternion operator*(T value) const;
+    constexpr Quaternion operator*(T value) const;
 
     //! Compound quaternion-scalar addition
-    void operator+=(T value);
+    constexpr void operator+=(T value);
 
     //! Compound quaternion-scalar subtraction
-    void operator-=(T value);
+    constexpr void operator-=(T value);
 
     //! Quaternion-scalar compound multiplication operator
-    void operator*=(T value);
+    constexpr void operator*=(T value);
 
     //-------------------------------------------------------------------------
     // Class methods
@@ -108,7 +112,7 @@ public:
     T norm() const;
 
     //! Compute quaternion conjugate
-    Quaternion conjugate() const;
+    constexpr Quaternion conjugate() const;
 
     //! Compute the derivative of a quaternion rotation from system a to system b
     Vector<T, 4> derivA2B(const Vector3<T> &w) const;
@@ -120,24 +124,28 @@ public:
     void invert();
 
     //! Get individual elements
-    inline const T x() const { return this->data[1]; }
-    inline const T y() const { return this->data[2]; }
-    inline const T z() const { return this->data[3]; }
-    inline const T w() const { return this->data[0]; }
+    constexpr T x() const { return this->data[1]; }
+    constexpr T y() const { return this->data[2]; }
+    constexpr T z() const { return this->data[3]; }
+    constexpr T w() const { return this->data[0]; }
 
     //! Get the scalar part
-    inline const T scalar() const { return this->data[0]; }
+    constexpr T scalar() const { return this->data[0]; }
 
     //! Get the vector part
-    inline const Vector3<T> vector() const { return Vector3<T>(this->data[1], this->data[2], this->data[3]); }
+    constexpr Vector3<T> vector() const { return Vector3<T>(this->data[1], this->data[2], this->data[3]); }
 
     //! Return as a matrix
     SquareMatrix<T, 4> asMatrix() const;
 };
 
+static_assert(sizeof(Quaternion<float>) == 4*sizeof(float), "Quaternion must not carry anything beyond its elements");
+static_assert(std::is_standard_layout<Quaternion<float>>::value, "Quaternion must be standard-layout");
+static_assert(std::is_trivially_copyable<Quaternion<float>>::value, "Quaternion must be trivially copyable");
+
 //! Default constructor
 template<class T>
-Quaternion<T>::Quaternion()
+constexpr Quaternion<T>::Quaternion()
 {
     this->data[0] = static_cast<T>(1);
     this->data[1] = static_cast<T>(0);
@@ -147,14 +155,14 @@ Quaternion<T>::Quaternion()
 
 //! Constructor from array of values
 template<class T>
-Quaternion<T>::Quaternion(const T values[4]):
+constexpr Quaternion<T>::Quaternion(const T values[4]):
     Vector<T, 4>(values)
 {
 }
 
 //! Constructor from individual values
 template<class T>
-Quaternion<T>::Quaternion(T q0, T q1, T q2, T q3)
+constexpr Quaternion<T>::Quaternion(T q0, T q1, T q2, T q3)
 {
     this->data[0] = q0;
     this->data[1] = q1;
@@ -347,11 +355,19 @@ Quaternion<T>::Quaternion(const DCM<T> &dcm)
 
 //! Construct quaternion from Vector<T, 4>
 template<class T>
-Quaternion<T>::Quaternion(const Vector<T, 4> &vec):
+constexpr Quaternion<T>::Quaternion(const Vector<T, 4> &vec):
     Vector<T, 4>(vec)
 {
 }
 
+//! Construct by evaluating a matrix expression
+template<class T>
+template<class E, typename>
+constexpr Quaternion<T>::Quaternion(const MatrixExpression<E> &expr):
+    Vector<T, 4>(expr)
+{
+}
+
 //! Construct a quaternion that rotates vector a to b
 template<class T>
 Quaternion<T>::Quaternion(const Vector3<T> &a, const Vector3<T> &b, const T eps)
@@ -408,34 +424,34 @@ Quaternion<T>::Quaternion(const Vector3<T> &a, const Vector3<T> &b, const T eps)
 
 //! Quaternion addition
 template<class T>
-Quaternion<T> Quaternion<T>::operator+(const Quaternion<T> &q) const
+constexpr Quaternion<T> Quaternion<T>::operator+(const Quaternion<T> &q) const
 {
     return Quaternion<T>(this->data[0]+q.data[0], this->data[1]+q.data[1], this->data[2]+q.data[2], this->data[3]+q.data[3]);
 }
 
 //! Quaternion subtraction
 template<class T>
-Quaternion<T> Quaternion<T>::operator-(const Quaternion<T> &q) const
+constexpr Quaternion<T> Quaternion<T>::operator-(const Quaternion<T> &q) const
 {
     return Quaternion<T>(this->data[0]-q.data[0], this->data[1]-q.data[1], this->data[2]-q.data[2], this->data[3]-q.data[3]);
 }
 
 //! Quaternion multiplication
 template<class T>
-Quaternion<T> Quaternion<T>::operator*(const Quaternion<T> &q) const
+constexpr Quaternion<T> Quaternion<T>::operator*(const Quaternion<T> &q) const
 {
     // r = p * q
-    const Quaternion &p = *this;
-    Quaternion r = {p(0)*q(0) - p(1)*q(1) - p(2)*q(2) - p(3)*q(3),
-                    p(0)*q(1) + p(1)*q(0) + p(2)*q(3) - p(3)*q(2),
-                    p(0)*q(2) - p(1)*q(3) + p(2)*q(0) + p(3)*q(1),
-                    p(0)*q(3) + p(1)*q(2) - p(2)*q(1) + p(3)*q(0)};
-    return r;
+    const T *p = this->data;
+    const T *s = q.data;
+    return Quaternion(p[0]*s[0] - p[1]*s[1] - p[2]*s[2] - p[3]*s[3],
+                      p[0]*s[1] + p[1]*s[0] + p[2]*s[3] - p[3]*s[2],
+                      p[0]*s[2] - p[1]*s[3] + p[2]*s[0] + p[3]*s[1],
+                      p[0]*s[3] + p[1]*s[2] - p[2]*s[1] + p[3]*s[0]);
 }
 
 //! Compound quaternion addition operator
 template<class T>
-void Quaternion<T>::operator+=(const Quaternion<T> &other)
+constexpr void Quaternion<T>::operator+=(const Quaternion<T> &other)
 {
     this->data[0] += other.data[0];
     this->data[1] += other.data[1];
@@ -445,7 +461,7 @@ void Quaternion<T>::operator+=(const Quaternion<T> &other)
 
 //! Compound quaternion subtraction operator
 template<class T>
-void Quaternion<T>::operator-=(const Quaternion<T> &other)
+constexpr void Quaternion<T>::operator-=(const Quaternion<T> &other)
 {
     this->data[0] -= other.data[0];
     this->data[1] -= other.data[1];
@@ -455,7 +471,7 @@ void Quaternion<T>::operator-=(const Quaternion<T> &other)
 
 //! Quaternion compound multiplication operator
 template<class T>
-void Quaternion<T>::operator*=(const Quaternion<T> &other)
+constexpr void Quaternion<T>::operator*=(const Quaternion<T> &other)
 {
     Quaternion &self = *this;
     self = self * other;
@@ -463,42 +479,42 @@ void Quaternion<T>::operator*=(const Quaternion<T> &other)
 
 //! Add scalar component
 template<class T>
-Quaternion<T> Quaternion<T>::operator+(T value) const
+constexpr Quaternion<T> Quaternion<T>::operator+(T value) const
 {
     return Quaternion<T>(this->data[0]+value, this->data[1], this->data[2], this->data[3]);
 }
 
 //! Subtract scalar component
 template<class T>
-Quaternion<T> Quaternion<T>::operator-(T value) const
+constexpr Quaternion<T> Quaternion<T>::operator-(T value) const
 {
     return Quaternion<T>(this->data[0]-value, this->data[1], this->data[2], this->data[3]);
 }
 
 //! Quaternion-scalar multiplication
 template<class T>
-Quaternion<T> Quaternion<T>::operator*(T value) const
+constexpr Quaternion<T> Quaternion<T>::operator*(T value) const
 {
     return Quaternion<T>(this->data[0]*value, this->data[1]*value, this->data[2]*value, this->data[3]*value);
 }
 
 //! Compound quaternion-scalar addition
 template<class T>
-void Quaternion<T>::operator+=(T value)
+constexpr void Quaternion<T>::operator+=(T value)
 {
     this->data[0] += value;
 }
 
 //! Compound quaternion-scalar subtraction
 template<class T>
-void Quaternion<T>::operator-=(T value)
+constexpr void Quaternion<T>::operator-=(T value)
 {
     this->data[0] -= value;
 }
 
 //! Quaternion-scalar compound multiplication operator
 template<class T>
-void Quaternion<T>::operator*=(T value)
+constexpr void Quaternion<T>::operator*=(T value)
 {
     Quaternion &self = *this;
     self = self * value;
@@ -513,7 +529,7 @@ T Quaternion<T>::norm() const
 
 //! Compute quaternion conjugate
 template<class T>
-Quaternion<T> Quaternion<T>::conjugate() const
+constexpr Quaternion<T> Quaternion<T>::conjugate() const
 {
     return Quaternion(this->data[0], -this->data[1], -this->data[2], -this->data[3]);
 }
@@ -558,7 +574,7 @@ SquareMatrix<T, 4> Quaternion<T>::asMatrix() const
 
 //! Scalar-Quaternion multiplication
 template<class T>
-Quaternion<T> operator*(T value, const Quaternion<T> &q)
+constexpr Quaternion<T> operator*(T value, const Quaternion<T> &q)
 {
     return q * value;
 }
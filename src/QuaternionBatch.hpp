@@ -0,0 +1,197 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file QuaternionBatch.hpp
+//!
+//! Structure-of-arrays batch of scalar-first quaternions (w, x, y and z each in
+//! their own array). Results match Quaternion element for element.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _QUATERNION_BATCH_HPP__
+#define _QUATERNION_BATCH_HPP__
+
+#include "BatchStorage.hpp"
+#include "SimdKernel.hpp"
+#include "Quaternion.hpp"
+
+namespace matrix
+{
+
+template<class T>
+class QuaternionBatch : public BatchStorage<T, 4>
+{
+public:
+    //! Default constructor (empty batch)
+    QuaternionBatch();
+
+    //! Construct a batch of n zero quaternions
+    explicit QuaternionBatch(size_t n);
+
+    //! Construct from an array of n quaternions
+    QuaternionBatch(const Quaternion<T> *quaternions, size_t n);
+
+    //! Replace the contents with an array of n quaternions
+    void load(const Quaternion<T> *quaternions, size_t n);
+
+    //! Copy every quaternion out to an array of size() quaternions
+    void store(Quaternion<T> *quaternions) const;
+
+    //! Get quaternion i
+    Quaternion<T> operator()(size_t i) const;
+
+    //! Set quaternion i
+    void set(size_t i, const Quaternion<T> &q);
+
+    //! Component arrays
+    inline T *w() { return this->component(0); }
+    inline T *x() { return this->component(1); }
+    inline T *y() { return this->component(2); }
+    inline T *z() { return this->component(3); }
+    inline const T *w() const { return this->component(0); }
+    inline const T *x() const { return this->component(1); }
+    inline const T *y() const { return this->component(2); }
+    inline const T *z() const { return this->component(3); }
+
+    //! Quaternion product of every quaternion with the matching one of q (out may be this or q)
+    void multiply(const QuaternionBatch<T> &q, QuaternionBatch<T> &out) const;
+
+    //! Normalize every quaternion
+    void normalize();
+};
+
+//! Default constructor (empty batch)
+template<class T>
+QuaternionBatch<T>::QuaternionBatch():
+    BatchStorage<T, 4>()
+{
+}
+
+//! Construct a batch of n zero quaternions
+template<class T>
+QuaternionBatch<T>::QuaternionBatch(size_t n):
+    BatchStorage<T, 4>(n)
+{
+}
+
+//! Construct from an array of n quaternions
+template<class T>
+QuaternionBatch<T>::QuaternionBatch(const Quaternion<T> *quaternions, size_t n):
+    BatchStorage<T, 4>(n)
+{
+    load(quaternions, n);
+}
+
+//! Replace the contents with an array of n quaternions
+template<class T>
+void QuaternionBatch<T>::load(const Quaternion<T> *quaternions, size_t n)
+{
+    this->resize(n);
+    T *pw = w(), *px = x(), *py = y(), *pz = z();
+    for(size_t i = 0; i < n; ++i)
+    {
+        pw[i] = quaternions[i].coeff(0);
+        px[i] = quaternions[i].coeff(1);
+        py[i] = quaternions[i].coeff(2);
+        pz[i] = quaternions[i].coeff(3);
+    }
+}
+
+//! Copy every quaternion out to an array of size() quaternions
+template<class T>
+void QuaternionBatch<T>::store(Quaternion<T> *quaternions) const
+{
+    const T *pw = w(), *px = x(), *py = y(), *pz = z();
+    for(size_t i = 0; i < this->count; ++i)
+    {
+        quaternions[i] = Quaternion<T>(pw[i], px[i], py[i], pz[i]);
+    }
+}
+
+//! Get quaternion i
+template<class T>
+Quaternion<T> QuaternionBatch<T>::operator()(size_t i) const
+{
+    this->checkIndex(i);
+    return Quaternion<T>(w()[i], x()[i], y()[i], z()[i]);
+}
+
+//! Set quaternion i
+template<class T>
+void QuaternionBatch<T>::set(size_t i, const Quaternion<T> &q)
+{
+    this->checkIndex(i);
+    w()[i] = q.coeff(0);
+    x()[i] = q.coeff(1);
+    y()[i] = q.coeff(2);
+    z()[i] = q.coeff(3);
+}
+
+//! Quaternion product of every quaternion with the matching one of q (out may be this or q)
+template<class T>
+void QuaternionBatch<T>::multiply(const QuaternionBatch<T> &q, QuaternionBatch<T> &out) const
+{
+    this->checkSize("multiply", q.size());
+    out.resize(this->count);
+    const T *p0 = w(), *p1 = x(), *p2 = y(), *p3 = z();
+    const T *s0 = q.w(), *s1 = q.x(), *s2 = q.y(), *s3 = q.z();
+    T *r0 = out.w(), *r1 = out.x(), *r2 = out.y(), *r3 = out.z();
+    const size_t n = this->padded;
+    for(size_t k = 0; k < n; k += this->block)
+    {
+        MTL_BATCH_IVDEP
+        for(size_t l = 0; l < this->block; ++l)
+        {
+            const size_t i = k + l;
+            const T a = p0[i]*s0[i] - p1[i]*s1[i] - p2[i]*s2[i] - p3[i]*s3[i];
+            const T b = p0[i]*s1[i] + p1[i]*s0[i] + p2[i]*s3[i] - p3[i]*s2[i];
+            const T c = p0[i]*s2[i] - p1[i]*s3[i] + p2[i]*s0[i] + p3[i]*s1[i];
+            const T d = p0[i]*s3[i] + p1[i]*s2[i] - p2[i]*s1[i] + p3[i]*s0[i];
+            r0[i] = a;
+            r1[i] = b;
+            r2[i] = c;
+            r3[i] = d;
+        }
+    }
+}
+
+//! Normalize every quaternion
+template<class T>
+void QuaternionBatch<T>::normalize()
+{
+    // Norms are computed a chunk at a time so the square roots can use the SIMD kernels
+    constexpr size_t chunk = 16*QuaternionBatch<T>::block;
+    T norm[chunk];
+    T *pw = w(), *px = x(), *py = y(), *pz = z();
+    const size_t n = this->padded;
+    for(size_t c = 0; c < n; c += chunk)
+    {
+        const size_t m = n - c < chunk ? n - c : chunk;
+        for(size_t k = 0; k < m; k += this->block)
+        {
+            MTL_BATCH_IVDEP
+            for(size_t l = 0; l < this->block; ++l)
+            {
+                const size_t i = c + k + l;
+                norm[k+l] = T(0) + pw[i]*pw[i] + px[i]*px[i] + py[i]*py[i] + pz[i]*pz[i];
+            }
+        }
+        simd::kernels<T>().sqrt(norm, norm, m);
+        this->unitPaddingNorms(norm, c, m);
+        for(size_t k = 0; k < m; k += this->block)
+        {
+            MTL_BATCH_IVDEP
+            for(size_t l = 0; l < this->block; ++l)
+            {
+                const size_t i = c + k + l;
+                pw[i] /= norm[k+l];
+                px[i] /= norm[k+l];
+                py[i] /= norm[k+l];
+                pz[i] /= norm[k+l];
+            }
+        }
+    }
+}
+
+} // namespace matrix
+
+#endif // _QUATERNION_BATCH_HPP__
@@ -0,0 +1,175 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file QuaternionMap.hpp
+//!
+//! Map that presents four elements of a caller-owned buffer (scalar first) as
+//! a Quaternion without copying them (see MatrixMap.hpp). Operators follow
+//! Quaternion: products are quaternion products, and adding or subtracting a
+//! scalar only changes the scalar part. Results that are new quaternions are
+//! returned as Quaternion; compound operators, normalize and invert update the
+//! buffer in place.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _QUATERNION_MAP_HPP__
+#define _QUATERNION_MAP_HPP__
+
+#include "MatrixMap.hpp"
+#include "Quaternion.hpp"
+#include "Vector3.hpp"
+
+namespace matrix
+{
+
+template<class T>
+class QuaternionMap : public VectorMap<T, 4>
+{
+public:
+    using value_type = typename VectorMap<T, 4>::value_type;
+
+    //! Map four elements stride apart (stride 1 for contiguous elements)
+    explicit constexpr QuaternionMap(T *values, size_t stride = 1);
+
+    //! Assign the mapped elements
+    using VectorMap<T, 4>::operator=;
+    using VectorMap<T, 4>::operator+=;
+    using VectorMap<T, 4>::operator-=;
+    using VectorMap<T, 4>::operator*=;
+
+    //! Quaternion multiplication
+    Quaternion<value_type> operator*(const Quaternion<value_type> &q) const;
+
+    //! Quaternion compound multiplication (the mapped elements become this * q)
+    void operator*=(const Quaternion<value_type> &q) const;
+
+    //! Add scalar component
+    constexpr Quaternion<value_type> operator+(value_type value) const;
+
+    //! Subtract scalar component
+    constexpr Quaternion<value_type> operator-(value_type value) const;
+
+    //! Compound quaternion-scalar addition
+    constexpr void operator+=(value_type value) const;
+
+    //! Compound quaternion-scalar subtraction
+    constexpr void operator-=(value_type value) const;
+
+    //! Compute the norm (sum of squares, like Quaternion::norm)
+    value_type norm() const;
+
+    //! Compute quaternion conjugate
+    constexpr Quaternion<value_type> conjugate() const;
+
+    //! Return the inverse of the mapped quaternion
+    Quaternion<value_type> inverse() const;
+
+    //! Invert the mapped quaternion in place
+    void invert() const;
+
+    //! Access individual elements
+    constexpr T &w() const { return this->data()[0]; }
+    constexpr T &x() const { return this->data()[this->rowStride()]; }
+    constexpr T &y() const { return this->data()[2*this->rowStride()]; }
+    constexpr T &z() const { return this->data()[3*this->rowStride()]; }
+
+    //! Get the scalar part
+    constexpr value_type scalar() const { return w(); }
+
+    //! Get the vector part
+    constexpr Vector3<value_type> vector() const { return Vector3<value_type>(x(), y(), z()); }
+
+private:
+    //! Write q to the mapped elements
+    void store(const Quaternion<value_type> &q) const;
+};
+
+//! Map four elements stride apart (stride 1 for contiguous elements)
+template<class T>
+constexpr QuaternionMap<T>::QuaternionMap(T *values, size_t stride):
+    VectorMap<T, 4>(values, stride)
+{
+}
+
+//! Quaternion multiplication
+template<class T>
+Quaternion<typename QuaternionMap<T>::value_type> QuaternionMap<T>::operator*(const Quaternion<value_type> &q) const
+{
+    return Quaternion<value_type>(*this) * q;
+}
+
+//! Quaternion compound multiplication (the mapped elements become this * q)
+template<class T>
+void QuaternionMap<T>::operator*=(const Quaternion<value_type> &q) const
+{
+    store((*this) * q);
+}
+
+//! Add scalar component
+template<class T>
+constexpr Quaternion<typename QuaternionMap<T>::value_type> QuaternionMap<T>::operator+(value_type value) const
+{
+    return Quaternion<value_type>(w()+value, x(), y(), z());
+}
+
+//! Subtract scalar component
+template<class T>
+constexpr Quaternion<typename QuaternionMap<T>::value_type> QuaternionMap<T>::operator-(value_type value) const
+{
+    return Quaternion<value_type>(w()-value, x(), y(), z());
+}
+
+//! Compound quaternion-scalar addition
+template<class T>
+constexpr void QuaternionMap<T>::operator+=(value_type value) const
+{
+    w() += value;
+}
+
+//! Compound quaternion-scalar subtraction
+template<class T>
+constexpr void QuaternionMap<T>::operator-=(value_type value) const
+{
+    w() -= value;
+}
+
+//! Compute the norm (sum of squares, like Quaternion::norm)
+template<class T>
+typename QuaternionMap<T>::value_type QuaternionMap<T>::norm() const
+{
+    return w()*w() + x()*x() + y()*y() + z()*z();
+}
+
+//! Compute quaternion conjugate
+template<class T>
+constexpr Quaternion<typename QuaternionMap<T>::value_type> QuaternionMap<T>::conjugate() const
+{
+    return Quaternion<value_type>(w(), -x(), -y(), -z());
+}
+
+//! Return the inverse of the mapped quaternion
+template<class T>
+Quaternion<typename QuaternionMap<T>::value_type> QuaternionMap<T>::inverse() const
+{
+    return Quaternion<value_type>(*this).inverse();
+}
+
+//! Invert the mapped quaternion in place
+template<class T>
+void QuaternionMap<T>::invert() const
+{
+    store(inverse());
+}
+
+//! Write q to the mapped elements
+template<class T>
+void QuaternionMap<T>::store(const Quaternion<value_type> &q) const
+{
+    w() = q.w();
+    x() = q.x();
+    y() = q.y();
+    z() = q.z();
+}
+
+} // namespace matrix
+
+#endif // _QUATERNION_MAP_HPP__
@@ -0,0 +1,332 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file SVD3.hpp
+//!
+//! Singular value and polar decompositions of 3x3 matrices, kept as solver
+//! objects like LUFactorization:
+//!
+//!   SVD3<T>                 A = U diag(s) V^T
+//!   PolarDecomposition3<T>  A = R S, R the rotation closest to A
+//!
+//! The SVD runs a bounded number of Jacobi sweeps on A^T A for V, then
+//! factors A V = U diag(s) with three Givens rotations. U and V are always
+//! proper rotations, so s(2) carries the sign of det(A) (a "signed" SVD);
+//! s(0) >= s(1) >= |s(2)|. Working from A^T A costs the relative accuracy of
+//! singular values far below s(0), which does not matter for the rotations
+//! these classes exist to produce.
+//!
+//! The polar decomposition iterates R <- (R + R^-T) / 2 (Newton's method, with
+//! Frobenius-norm scaling while far from converged), which needs only a 3x3
+//! cofactor matrix per step and converges quadratically: a DCM drifted by
+//! 1e-6 is exact after two steps. Matrices with det(A) <= 0, whose closest
+//! rotation Newton's method cannot reach, go through the SVD instead.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _SVD3_HPP__
+#define _SVD3_HPP__
+
+#include <cmath>
+#include <limits>
+
+#include "Matrix.hpp"
+#include "SquareMatrix.hpp"
+#include "Vector.hpp"
+#include "SymmetricEigen.hpp"
+
+namespace matrix
+{
+
+namespace detail
+{
+
+// Defined in SymmetricEigen.hpp, whose include of DCM.hpp can bring this header in first
+template<class T, size_t M>
+bool jacobiEigen(T *a, T *v, T *d, size_t maxSweeps);
+
+} // namespace detail
+
+template<class T>
+class SVD3
+{
+public:
+    //! Jacobi sweeps on A^T A; random matrices converge in 4 to 5
+    static constexpr size_t sweeps = 6;
+
+    //! Default constructor (identity factors, zero singular values)
+    SVD3();
+
+    //! Decompose A
+    explicit SVD3(const Matrix<T, 3, 3> &A);
+
+    //! Decompose A, replacing the current decomposition
+    void compute(const Matrix<T, 3, 3> &A);
+
+    //! Left singular vectors, a proper rotation
+    inline const SquareMatrix<T, 3> &matrixU() const { return U; }
+
+    //! Singular values in descending order of magnitude; s(2) < 0 when det(A) < 0
+    inline const Vector<T, 3> &singularValues() const { return s; }
+
+    //! Right singular vectors, a proper rotation
+    inline const SquareMatrix<T, 3> &matrixV() const { return V; }
+
+private:
+    SquareMatrix<T, 3> U;
+    Vector<T, 3> s;
+    SquareMatrix<T, 3> V;
+};
+
+template<class T>
+class PolarDecomposition3
+{
+public:
+    //! Newton steps before falling back to the SVD; scaled iteration needs
+    //! fewer than 10 for any matrix that is not nearly singular
+    static constexpr size_t maxIterations = 16;
+
+    //! Default constructor (identity factors)
+    PolarDecomposition3();
+
+    //! Decompose A
+    explicit PolarDecomposition3(const Matrix<T, 3, 3> &A);
+
+    //! Decompose A, replacing the current decomposition
+    void compute(const Matrix<T, 3, 3> &A);
+
+    //! Rotation closest to A in the Frobenius norm
+    inline const SquareMatrix<T, 3> &rotation() const { return R; }
+
+    //! Symmetric stretch S = R^T A (positive semidefinite when det(A) >= 0)
+    inline const SquareMatrix<T, 3> &stretch() const { return S; }
+
+private:
+    //! R from the SVD, R = U V^T
+    void computeFromSVD(const Matrix<T, 3, 3> &A);
+
+    SquareMatrix<T, 3> R;
+    SquareMatrix<T, 3> S;
+};
+
+//! Default constructor (identity factors, zero singular values)
+template<class T>
+SVD3<T>::SVD3()
+{
+    U.identity();
+    V.identity();
+}
+
+//! Decompose A
+template<class T>
+SVD3<T>::SVD3(const Matrix<T, 3, 3> &A)
+{
+    compute(A);
+}
+
+//! Decompose A, replacing the current decomposition
+template<class T>
+void SVD3<T>::compute(const Matrix<T, 3, 3> &A)
+{
+    // Right singular vectors are the eigenvectors of A^T A
+    SquareMatrix<T, 3> AtA;
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = i; j < 3; ++j)
+        {
+            AtA(i,j) = A(0,i)*A(0,j) + A(1,i)*A(1,j) + A(2,i)*A(2,j);
+        }
+    }
+    SquareMatrix<T, 3> ascending;
+    T eigenvalues[3];
+    detail::jacobiEigen<T, 3>(&AtA(0,0), &ascending(0,0), eigenvalues, sweeps);
+
+    // Largest first; reversing the columns is a reflection, and so is a
+    // negative determinant from the sweeps, so negate a column to keep V proper
+    for(size_t i = 0; i < 3; ++i)
+    {
+        V(i,0) = ascending(i,2);
+        V(i,1) = ascending(i,1);
+        V(i,2) = ascending(i,0);
+    }
+    const T det = V(0,0)*(V(1,1)*V(2,2) - V(1,2)*V(2,1))
+                - V(0,1)*(V(1,0)*V(2,2) - V(1,2)*V(2,0))
+                + V(0,2)*(V(1,0)*V(2,1) - V(1,1)*V(2,0));
+    if(det < 0)
+    {
+        for(size_t i = 0; i < 3; ++i)
+        {
+            V(i,2) = -V(i,2);
+        }
+    }
+
+    // B = A V has orthogonal columns of decreasing length; Givens QR gives
+    // B = U R with R diagonal up to rounding
+    SquareMatrix<T, 3> B = A*V;
+    U.identity();
+    const size_t rows[3][2] = {{0, 1}, {0, 2}, {1, 2}};
+    for(size_t k = 0; k < 3; ++k)
+    {
+        const size_t p = rows[k][0];
+        const size_t q = rows[k][1];
+        const size_t column = k == 2 ? 1 : 0;
+        const T a = B(p,column);
+        const T b = B(q,column);
+        const T r = std::sqrt(a*a + b*b);
+        if(r == T(0))
+        {
+            continue;
+        }
+        const T c = a / r;
+        const T sn = b / r;
+        for(size_t j = 0; j < 3; ++j)
+        {
+            const T bp = B(p,j);
+            const T bq = B(q,j);
+            B(p,j) = c*bp + sn*bq;
+            B(q,j) = c*bq - sn*bp;
+
+            // U accumulates the transposed rotations
+            const T up = U(j,p);
+            const T uq = U(j,q);
+            U(j,p) = c*up + sn*uq;
+            U(j,q) = c*uq - sn*up;
+        }
+    }
+    s(0) = B(0,0);
+    s(1) = B(1,1);
+    s(2) = B(2,2);
+}
+
+//! Default constructor (identity factors)
+template<class T>
+PolarDecomposition3<T>::PolarDecomposition3()
+{
+    R.identity();
+    S.identity();
+}
+
+//! Decompose A
+template<class T>
+PolarDecomposition3<T>::PolarDecomposition3(const Matrix<T, 3, 3> &A)
+{
+    compute(A);
+}
+
+//! Decompose A, replacing the current decomposition
+template<class T>
+void PolarDecomposition3<T>::compute(const Matrix<T, 3, 3> &A)
+{
+    const T eps = std::numeric_limits<T>::epsilon();
+    T x[9];
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < 3; ++j)
+        {
+            x[i*3+j] = A(i,j);
+        }
+    }
+
+    bool converged = false;
+    bool first = true;
+    bool scaled = false;
+    for(size_t k = 0; k < maxIterations && !converged; ++k)
+    {
+        // X^-T = cof(X) / det(X)
+        const T cof[9] = {x[4]*x[8] - x[5]*x[7], x[5]*x[6] - x[3]*x[8], x[3]*x[7] - x[4]*x[6],
+                          x[2]*x[7] - x[1]*x[8], x[0]*x[8] - x[2]*x[6], x[1]*x[6] - x[0]*x[7],
+                          x[1]*x[5] - x[2]*x[4], x[2]*x[3] - x[0]*x[5], x[0]*x[4] - x[1]*x[3]};
+        const T det = x[0]*cof[0] + x[1]*cof[1] + x[2]*cof[2];
+        T normX = 0;
+        for(size_t i = 0; i < 9; ++i)
+        {
+            normX += x[i]*x[i];
+        }
+        if(!(det > 0 && det*det > eps*eps*normX*normX*normX))
+        {
+            break;
+        }
+
+        // gamma = sqrt(|X^-1| / |X|) balances X against X^-T. It is 1 for a
+        // rotation, so a nearly orthogonal start (the usual DCM) skips it.
+        if(first)
+        {
+            scaled = std::fabs(normX - 3) > T(0.01) || std::fabs(det - 1) > T(0.01);
+            first = false;
+        }
+        T gamma = 1;
+        if(scaled)
+        {
+            T normCof = 0;
+            for(size_t i = 0; i < 9; ++i)
+            {
+                normCof += cof[i]*cof[i];
+            }
+            gamma = std::sqrt(std::sqrt(normCof / normX) / det);
+        }
+        const T a = gamma / 2;
+        const T b = 1 / (2*gamma*det);
+        T change = 0;
+        for(size_t i = 0; i < 9; ++i)
+        {
+            const T next = a*x[i] + b*cof[i];
+            change += (next - x[i])*(next - x[i]);
+            x[i] = next;
+        }
+
+        // The next step would change X by about change, below rounding once change < eps
+        converged = change <= eps;
+        scaled = scaled && change > T(1.0e-4);
+    }
+
+    if(!converged)
+    {
+        computeFromSVD(A);
+        return;
+    }
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < 3; ++j)
+        {
+            R(i,j) = x[i*3+j];
+        }
+    }
+
+    // S = R^T A, symmetric up to rounding
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < 3; ++j)
+        {
+            S(i,j) = R(0,i)*A(0,j) + R(1,i)*A(1,j) + R(2,i)*A(2,j);
+        }
+    }
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = i + 1; j < 3; ++j)
+        {
+            S(i,j) = S(j,i) = (S(i,j) + S(j,i)) / 2;
+        }
+    }
+}
+
+//! R from the SVD, R = U V^T
+template<class T>
+void PolarDecomposition3<T>::computeFromSVD(const Matrix<T, 3, 3> &A)
+{
+    // S = V diag(s) V^T
+    const SVD3<T> svd(A);
+    const SquareMatrix<T, 3> &U = svd.matrixU();
+    const SquareMatrix<T, 3> &V = svd.matrixV();
+    const Vector<T, 3> &s = svd.singularValues();
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < 3; ++j)
+        {
+            R(i,j) = U(i,0)*V(j,0) + U(i,1)*V(j,1) + U(i,2)*V(j,2);
+            S(i,j) = V(i,0)*s(0)*V(j,0) + V(i,1)*s(1)*V(j,1) + V(i,2)*s(2)*V(j,2);
+        }
+    }
+}
+
+} // namespace matrix
+
+#endif // _SVD3_HPP__
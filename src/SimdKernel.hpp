@@ -0,0 +1,1205 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file SimdKernel.hpp
+//!
+//! Explicit SSE2, AVX2 and AVX-512 kernels for float and double, selected at
+//! runtime from CPUID. Every kernel works on contiguous arrays (count objects
+//! stored back to back) so a single call can process a whole batch, and each
+//! instruction set shares one table layout with the scalar reference.
+//!
+//! Kernels that work on one small object at a time (cross product, quaternion
+//! product, 3x3 and 4x4 products, DCM rotation) keep one object per register:
+//! floats use 128-bit registers and doubles 256-bit ones, so AVX-512 reuses the
+//! AVX2 versions and SSE2 falls back to scalar code for doubles. Those kernels
+//! evaluate each element in the same order as the scalar code but may differ
+//! from it in the last bits, since the compiler is free to contract the scalar
+//! code into fused multiply-adds. The element-wise kernels are exact, and dot
+//! products reassociate the sum across lanes.
+//!
+//! The padded kernels work on 3-vectors stored in four lanes and 3x3 matrices
+//! stored as three four-lane rows (PaddedVector3, PaddedMatrix3), aligned to
+//! four elements. Each vector or row is then a single aligned load and store
+//! instead of a masked or split one. The padding lanes hold zero and the
+//! kernels keep them zero.
+//!
+//! Define MTL_ENABLE_SIMD to route Vector::dot (16 or more elements), the
+//! 4x4 Matrix product and the padded 3x3 products through the runtime kernels
+//! (constant evaluation always uses the scalar code). Single 3-vectors,
+//! quaternions and 3x3 matrices stay on the inline scalar code, which beats an
+//! indirect call through the kernel table for one object (see BenchSimd).
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _SIMD_KERNEL_HPP__
+#define _SIMD_KERNEL_HPP__
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define MTL_SIMD_X86 1
+#include <immintrin.h>
+#define MTL_SIMD_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace matrix
+{
+
+namespace simd
+{
+
+//! Instruction sets with a kernel table
+enum class Isa
+{
+    Scalar,
+    SSE2,
+    AVX2,
+    AVX512
+};
+
+//! Table of kernels for one instruction set and element type
+template<class T>
+struct Kernels
+{
+    //! out[i] = a[i] + b[i] for n elements
+    void (*add)(const T *a, const T *b, T *out, size_t n);
+
+    //! out[i] = a[i] - b[i] for n elements
+    void (*subtract)(const T *a, const T *b, T *out, size_t n);
+
+    //! out[i] = a[i] * b[i] for n elements
+    void (*multiply)(const T *a, const T *b, T *out, size_t n);
+
+    //! out[i] = a[i] * value for n elements
+    void (*scale)(const T *a, T value, T *out, size_t n);
+
+    //! out[i] = sqrt(a[i]) for n elements
+    void (*sqrt)(const T *a, T *out, size_t n);
+
+    //! Sum of a[i] * b[i] for n elements
+    T (*dot)(const T *a, const T *b, size_t n);
+
+    //! Cross products of count pairs of 3-vectors
+    void (*cross)(const T *a, const T *b, T *out, size_t count);
+
+    //! Products of count pairs of scalar-first quaternions
+    void (*quaternionMultiply)(const T *p, const T *q, T *out, size_t count);
+
+    //! Products of count pairs of row-major 3x3 matrices
+    void (*multiply3x3)(const T *a, const T *b, T *out, size_t count);
+
+    //! Products of count pairs of row-major 4x4 matrices
+    void (*multiply4x4)(const T *a, const T *b, T *out, size_t count);
+
+    //! Rotate count 3-vectors by one row-major 3x3 DCM
+    void (*rotate3)(const T *dcm, const T *v, T *out, size_t count);
+
+    //! Cross products of count pairs of padded 3-vectors
+    void (*crossPadded)(const T *a, const T *b, T *out, size_t count);
+
+    //! Products of count pairs of padded 3x3 matrices
+    void (*multiply3x3Padded)(const T *a, const T *b, T *out, size_t count);
+
+    //! Rotate count padded 3-vectors by one padded 3x3 DCM
+    void (*rotate3Padded)(const T *dcm, const T *v, T *out, size_t count);
+};
+
+//! Portable reference kernels (also the fallback on every platform)
+struct Scalar
+{
+    template<class T>
+    static void add(const T *a, const T *b, T *out, size_t n)
+    {
+        for(size_t i = 0; i < n; ++i)
+        {
+            out[i] = a[i] + b[i];
+        }
+    }
+
+    template<class T>
+    static void subtract(const T *a, const T *b, T *out, size_t n)
+    {
+        for(size_t i = 0; i < n; ++i)
+        {
+            out[i] = a[i] - b[i];
+        }
+    }
+
+    template<class T>
+    static void multiply(const T *a, const T *b, T *out, size_t n)
+    {
+        for(size_t i = 0; i < n; ++i)
+        {
+            out[i] = a[i] * b[i];
+        }
+    }
+
+    template<class T>
+    static void scale(const T *a, T value, T *out, size_t n)
+    {
+        for(size_t i = 0; i < n; ++i)
+        {
+            out[i] = a[i] * value;
+        }
+    }
+
+    template<class T>
+    static void sqrt(const T *a, T *out, size_t n)
+    {
+        for(size_t i = 0; i < n; ++i)
+        {
+            out[i] = static_cast<T>(std::sqrt(a[i]));
+        }
+    }
+
+    template<class T>
+    static T dot(const T *a, const T *b, size_t n)
+    {
+        T sum = 0;
+        for(size_t i = 0; i < n; ++i)
+        {
+            sum += a[i] * b[i];
+        }
+        return sum;
+    }
+
+    template<class T>
+    static void cross(const T *a, const T *b, T *out, size_t count)
+    {
+        for(size_t n = 0; n < count; ++n, a += 3, b += 3, out += 3)
+        {
+            const T x = a[1]*b[2] - a[2]*b[1];
+            const T y = a[2]*b[0] - a[0]*b[2];
+            const T z = a[0]*b[1] - a[1]*b[0];
+            out[0] = x;
+            out[1] = y;
+            out[2] = z;
+        }
+    }
+
+    template<class T>
+    static void quaternionMultiply(const T *p, const T *s, T *out, size_t count)
+    {
+        for(size_t n = 0; n < count; ++n, p += 4, s += 4, out += 4)
+        {
+            const T r0 = p[0]*s[0] - p[1]*s[1] - p[2]*s[2] - p[3]*s[3];
+            const T r1 = p[0]*s[1] + p[1]*s[0] + p[2]*s[3] - p[3]*s[2];
+            const T r2 = p[0]*s[2] - p[1]*s[3] + p[2]*s[0] + p[3]*s[1];
+            const T r3 = p[0]*s[3] + p[1]*s[2] - p[2]*s[1] + p[3]*s[0];
+            out[0] = r0;
+            out[1] = r1;
+            out[2] = r2;
+            out[3] = r3;
+        }
+    }
+
+    template<class T>
+    static void multiply3x3(const T *a, const T *b, T *out, size_t count)
+    {
+        multiplySquare<T, 3>(a, b, out, count);
+    }
+
+    template<class T>
+    static void multiply4x4(const T *a, const T *b, T *out, size_t count)
+    {
+        multiplySquare<T, 4>(a, b, out, count);
+    }
+
+    template<class T>
+    static void rotate3(const T *dcm, const T *v, T *out, size_t count)
+    {
+        for(size_t n = 0; n < count; ++n, v += 3, out += 3)
+        {
+            const T x = v[0], y = v[1], z = v[2];
+            out[0] = T(0) + dcm[0]*x + dcm[1]*y + dcm[2]*z;
+            out[1] = T(0) + dcm[3]*x + dcm[4]*y + dcm[5]*z;
+            out[2] = T(0) + dcm[6]*x + dcm[7]*y + dcm[8]*z;
+        }
+    }
+
+    template<class T>
+    static void crossPadded(const T *a, const T *b, T *out, size_t count)
+    {
+        for(size_t n = 0; n < count; ++n, a += 4, b += 4, out += 4)
+        {
+            cross(a, b, out, 1);
+            out[3] = T(0);
+        }
+    }
+
+    template<class T>
+    static void multiply3x3Padded(const T *a, const T *b, T *out, size_t count)
+    {
+        for(size_t n = 0; n < count; ++n, a += 12, b += 12, out += 12)
+        {
+            // Every lane of a row, padding included, as the vector kernels compute it
+            T c[12];
+            for(size_t i = 0; i < 3; ++i)
+            {
+                for(size_t j = 0; j < 4; ++j)
+                {
+                    c[4*i+j] = T(0) + a[4*i]*b[j] + a[4*i+1]*b[4+j] + a[4*i+2]*b[8+j];
+                }
+            }
+            for(size_t i = 0; i < 12; ++i)
+            {
+                out[i] = c[i];
+            }
+        }
+    }
+
+    template<class T>
+    static void rotate3Padded(const T *dcm, const T *v, T *out, size_t count)
+    {
+        for(size_t n = 0; n < count; ++n, v += 4, out += 4)
+        {
+            const T x = v[0], y = v[1], z = v[2];
+            out[0] = T(0) + dcm[0]*x + dcm[1]*y + dcm[2]*z;
+            out[1] = T(0) + dcm[4]*x + dcm[5]*y + dcm[6]*z;
+            out[2] = T(0) + dcm[8]*x + dcm[9]*y + dcm[10]*z;
+            out[3] = T(0);
+        }
+    }
+
+private:
+    template<class T, size_t M>
+    static void multiplySquare(const T *a, const T *b, T *out, size_t count)
+    {
+        for(size_t n = 0; n < count; ++n, a += M*M, b += M*M, out += M*M)
+        {
+            T c[M*M];
+            for(size_t i = 0; i < M; ++i)
+            {
+                for(size_t j = 0; j < M; ++j)
+                {
+                    T sum = 0;
+                    for(size_t k = 0; k < M; ++k)
+                    {
+                        sum += a[i*M+k] * b[k*M+j];
+                    }
+                    c[i*M+j] = sum;
+                }
+            }
+            for(size_t i = 0; i < M*M; ++i)
+            {
+                out[i] = c[i];
+            }
+        }
+    }
+};
+
+#if defined(MTL_SIMD_X86)
+
+//! 128-bit kernels (baseline on x86-64)
+struct Sse2
+{
+    MTL_SIMD_TARGET("sse2") static void add(const float *a, const float *b, float *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 4 <= n; i += 4)
+        {
+            _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        }
+        Scalar::add(a + i, b + i, out + i, n - i);
+    }
+
+    MTL_SIMD_TARGET("sse2") static void add(const double *a, const double *b, double *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 2 <= n; i += 2)
+        {
+            _mm_storeu_pd(out + i, _mm_add_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+        }
+        Scalar::add(a + i, b + i, out + i, n - i);
+    }
+
+    MTL_SIMD_TARGET("sse2") static void subtract(const float *a, const float *b, float *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 4 <= n; i += 4)
+        {
+            _mm_storeu_ps(out + i, _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        }
+        Scalar::subtract(a + i, b + i, out + i, n - i);
+    }
+
+    MTL_SIMD_TARGET("sse2") static void subtract(const double *a, const double *b, double *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 2 <= n; i += 2)
+        {
+            _mm_storeu_pd(out + i, _mm_sub_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+        }
+        Scalar::subtract(a + i, b + i, out + i, n - i);
+    }
+
+    MTL_SIMD_TARGET("sse2") static void multiply(const float *a, const float *b, float *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 4 <= n; i += 4)
+        {
+            _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        }
+        Scalar::multiply(a + i, b + i, out + i, n - i);
+    }
+
+    MTL_SIMD_TARGET("sse2") static void multiply(const double *a, const double *b, double *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 2 <= n; i += 2)
+        {
+            _mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+        }
+        Scalar::multiply(a + i, b + i, out + i, n - i);
+    }
+
+    MTL_SIMD_TARGET("sse2") static void scale(const float *a, float value, float *out, size_t n)
+    {
+        const __m128 s = _mm_set1_ps(value);
+        size_t i = 0;
+        for(; i + 4 <= n; i += 4)
+        {
+            _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(a + i), s));
+        }
+        Scalar::scale(a + i, value, out + i, n - i);
+    }
+
+    MTL_SIMD_TARGET("sse2") static void scale(const double *a, double value, double *out, size_t n)
+    {
+        const __m128d s = _mm_set1_pd(value);
+        size_t i = 0;
+        for(; i + 2 <= n; i += 2)
+        {
+            _mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(a + i), s));
+        }
+        Scalar::scale(a + i, value, out + i, n - i);
+    }
+
+    MTL_SIMD_TARGET("sse2") static void sqrt(const float *a, float *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 4 <= n; i += 4)
+        {
+            _mm_storeu_ps(out + i, _mm_sqrt_ps(_mm_loadu_ps(a + i)));
+        }
+        Scalar::sqrt(a + i, out + i, n - i);
+    }
+
+    MTL_SIMD_TARGET("sse2") static void sqrt(const double *a, double *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 2 <= n; i += 2)
+        {
+            _mm_storeu_pd(out + i, _mm_sqrt_pd(_mm_loadu_pd(a + i)));
+        }
+        Scalar::sqrt(a + i, out + i, n - i);
+    }
+
+    //! Sum the four lanes of v
+    MTL_SIMD_TARGET("sse2") static float sum(__m128 v)
+    {
+        __m128 t = _mm_add_ps(v, _mm_movehl_ps(v, v));
+        t = _mm_add_ss(t, _mm_shuffle_ps(t, t, 1));
+        return _mm_cvtss_f32(t);
+    }
+
+    //! Sum the two lanes of v
+    MTL_SIMD_TARGET("sse2") static double sum(__m128d v)
+    {
+        return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+    }
+
+    MTL_SIMD_TARGET("sse2") static float dot(const float *a, const float *b, size_t n)
+    {
+        __m128 acc = _mm_setzero_ps();
+        size_t i = 0;
+        for(; i + 4 <= n; i += 4)
+        {
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        }
+        return sum(acc) + Scalar::dot(a + i, b + i, n - i);
+    }
+
+    MTL_SIMD_TARGET("sse2") static double dot(const double *a, const double *b, size_t n)
+    {
+        __m128d acc = _mm_setzero_pd();
+        size_t i = 0;
+        for(; i + 2 <= n; i += 2)
+        {
+            acc = _mm_add_pd(acc, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+        }
+        return sum(acc) + Scalar::dot(a + i, b + i, n - i);
+    }
+
+    //! Load x, y, z into the low three lanes without reading past p[2]
+    MTL_SIMD_TARGET("sse2") static __m128 load3(const float *p)
+    {
+        const __m128 xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(p)));
+        return _mm_movelh_ps(xy, _mm_load_ss(p + 2));
+    }
+
+    //! Store the low three lanes of v
+    MTL_SIMD_TARGET("sse2") static void store3(float *p, __m128 v)
+    {
+        _mm_store_sd(reinterpret_cast<double*>(p), _mm_castps_pd(v));
+        _mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+    }
+
+    MTL_SIMD_TARGET("sse2") static void cross(const float *a, const float *b, float *out, size_t count)
+    {
+        for(size_t n = 0; n < count; ++n, a += 3, b += 3, out += 3)
+        {
+            const __m128 u = load3(a);
+            const __m128 v = load3(b);
+            const __m128 uyzx = _mm_shuffle_ps(u, u, _MM_SHUFFLE(3, 0, 2, 1));
+            const __m128 uzxy = _mm_shuffle_ps(u, u, _MM_SHUFFLE(3, 1, 0, 2));
+            const __m128 vyzx = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1));
+            const __m128 vzxy = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 1, 0, 2));
+            store3(out, _mm_sub_ps(_mm_mul_ps(uyzx, vzxy), _mm_mul_ps(uzxy, vyzx)));
+        }
+    }
+
+    MTL_SIMD_TARGET("sse2") static void quaternionMultiply(const float *p, const float *q, float *out, size_t count)
+    {
+        // r = p0*[s0 s1 s2 s3] + p1*[-s1 s0 -s3 s2] + p2*[-s2 s3 s0 -s1] + p3*[-s3 -s2 s1 s0]
+        const __m128 sign1 = _mm_set_ps(0.0f, -0.0f, 0.0f, -0.0f);
+        const __m128 sign2 = _mm_set_ps(-0.0f, 0.0f, 0.0f, -0.0f);
+        const __m128 sign3 = _mm_set_ps(0.0f, 0.0f, -0.0f, -0.0f);
+        for(size_t n = 0; n < count; ++n, p += 4, q += 4, out += 4)
+        {
+            const __m128 s = _mm_loadu_ps(q);
+            const __m128 s1 = _mm_xor_ps(_mm_shuffle_ps(s, s, _MM_SHUFFLE(2, 3, 0, 1)), sign1);
+            const __m128 s2 = _mm_xor_ps(_mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 0, 3, 2)), sign2);
+            const __m128 s3 = _mm_xor_ps(_mm_shuffle_ps(s, s, _MM_SHUFFLE(0, 1, 2, 3)), sign3);
+            __m128 r = _mm_mul_ps(_mm_set1_ps(p[0]), s);
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(p[1]), s1));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(p[2]), s2));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(p[3]), s3));
+            _mm_storeu_ps(out, r);
+        }
+    }
+
+    MTL_SIMD_TARGET("sse2") static void multiply3x3(const float *a, const float *b, float *out, size_t count)
+    {
+        for(size_t n = 0; n < count; ++n, a += 9, b += 9, out += 9)
+        {
+            const __m128 b0 = load3(b);
+            const __m128 b1 = load3(b + 3);
+            const __m128 b2 = load3(b + 6);
+            __m128 c[3];
+            for(size_t i = 0; i < 3; ++i)
+            {
+                __m128 r = _mm_add_ps(_mm_setzero_ps(), _mm_mul_ps(_mm_set1_ps(a[3*i]), b0));
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[3*i+1]), b1));
+                c[i] = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[3*i+2]), b2));
+            }
+            store3(out, c[0]);
+            store3(out + 3, c[1]);
+            store3(out + 6, c[2]);
+        }
+    }
+
+    MTL_SIMD_TARGET("sse2") static void multiply4x4(const float *a, const float *b, float *out, size_t count)
+    {
+        for(size_t n = 0; n < count; ++n, a += 16, b += 16, out += 16)
+        {
+            const __m128 b0 = _mm_loadu_ps(b);
+            const __m128 b1 = _mm_loadu_ps(b + 4);
+            const __m128 b2 = _mm_loadu_ps(b + 8);
+            const __m128 b3 = _mm_loadu_ps(b + 12);
+            __m128 c[4];
+            for(size_t i = 0; i < 4; ++i)
+            {
+                __m128 r = _mm_add_ps(_mm_setzero_ps(), _mm_mul_ps(_mm_set1_ps(a[4*i]), b0));
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[4*i+1]), b1));
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[4*i+2]), b2));
+                c[i] = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[4*i+3]), b3));
+            }
+            for(size_t i = 0; i < 4; ++i)
+            {
+                _mm_storeu_ps(out + 4*i, c[i]);
+            }
+        }
+    }
+
+    MTL_SIMD_TARGET("sse2") static void rotate3(const float *dcm, const float *v, float *out, size_t count)
+    {
+        const __m128 col0 = _mm_set_ps(0.0f, dcm[6], dcm[3], dcm[0]);
+        const __m128 col1 = _mm_set_ps(0.0f, dcm[7], dcm[4], dcm[1]);
+        const __m128 col2 = _mm_set_ps(0.0f, dcm[8], dcm[5], dcm[2]);
+        for(size_t n = 0; n < count; ++n, v += 3, out += 3)
+        {
+            __m128 r = _mm_add_ps(_mm_setzero_ps(), _mm_mul_ps(col0, _mm_set1_ps(v[0])));
+            r = _mm_add_ps(r, _mm_mul_ps(col1, _mm_set1_ps(v[1])));
+            r = _mm_add_ps(r, _mm_mul_ps(col2, _mm_set1_ps(v[2])));
+            store3(out, r);
+        }
+    }
+
+    MTL_SIMD_TARGET("sse2") static void crossPadded(const float *a, const float *b, float *out, size_t count)
+    {
+        for(size_t n = 0; n < count; ++n, a += 4, b += 4, out += 4)
+        {
+            const __m128 u = _mm_load_ps(a);
+            const __m128 v = _mm_load_ps(b);
+            const __m128 uyzx = _mm_shuffle_ps(u, u, _MM_SHUFFLE(3, 0, 2, 1));
+            const __m128 uzxy = _mm_shuffle_ps(u, u, _MM_SHUFFLE(3, 1, 0, 2));
+            const __m128 vyzx = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1));
+            const __m128 vzxy = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 1, 0, 2));
+            _mm_store_ps(out, _mm_sub_ps(_mm_mul_ps(uyzx, vzxy), _mm_mul_ps(uzxy, vyzx)));
+        }
+    }
+
+    MTL_SIMD_TARGET("sse2") static void multiply3x3Padded(const float *a, const float *b, float *out, size_t count)
+    {
+        for(size_t n = 0; n < count; ++n, a += 12, b += 12, out += 12)
+        {
+            const __m128 b0 = _mm_load_ps(b);
+            const __m128 b1 = _mm_load_ps(b + 4);
+            const __m128 b2 = _mm_load_ps(b + 8);
+            __m128 c[3];
+            for(size_t i = 0; i < 3; ++i)
+            {
+                const __m128 ai = _mm_load_ps(a + 4*i);
+                __m128 r = _mm_add_ps(_mm_setzero_ps(), _mm_mul_ps(_mm_shuffle_ps(ai, ai, _MM_SHUFFLE(0, 0, 0, 0)), b0));
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(ai, ai, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+                c[i] = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(ai, ai, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+            }
+            _mm_store_ps(out, c[0]);
+            _mm_store_ps(out + 4, c[1]);
+            _mm_store_ps(out + 8, c[2]);
+        }
+    }
+
+    MTL_SIMD_TARGET("sse2") static void rotate3Padded(const float *dcm, const float *v, float *out, size_t count)
+    {
+        // Transpose the padded rows once; the zero fourth row makes the padding lanes of the columns zero
+        __m128 col0 = _mm_load_ps(dcm);
+        __m128 col1 = _mm_load_ps(dcm + 4);
+        __m128 col2 = _mm_load_ps(dcm + 8);
+        __m128 col3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(col0, col1, col2, col3);
+        for(size_t n = 0; n < count; ++n, v += 4, out += 4)
+        {
+            const __m128 x = _mm_load_ps(v);
+            __m128 r = _mm_add_ps(_mm_setzero_ps(), _mm_mul_ps(col0, _mm_shuffle_ps(x, x, _MM_SHUFFLE(0, 0, 0, 0))));
+            r = _mm_add_ps(r, _mm_mul_ps(col1, _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 1, 1))));
+            r = _mm_add_ps(r, _mm_mul_ps(col2, _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 2, 2, 2))));
+            _mm_store_ps(out, r);
+        }
+    }
+};
+
+//! 256-bit kernels
+struct Avx2
+{
+    MTL_SIMD_TARGET("avx2") static void add(const float *a, const float *b, float *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 8 <= n; i += 8)
+        {
+            _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+        }
+        Scalar::add(a + i, b + i, out + i, n - i);
+    }
+
+    MTL_SIMD_TARGET("avx2") static void add(const double *a, const double *b, double *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 4 <= n; i += 4)
+        {
+            _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+        }
+        Scalar::add(a + i, b + i, out + i, n - i);
+    }
+
+    MTL_SIMD_TARGET("avx2") static void subtract(const float *a, const float *b, float *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 8 <= n; i += 8)
+        {
+            _mm256_storeu_ps(out + i, _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+        }
+        Scalar::subtract(a + i, b + i, out + i, n - i);
+    }
+
+    MTL_SIMD_TARGET("avx2") static void subtract(const double *a, const double *b, double *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 4 <= n; i += 4)
+        {
+            _mm256_storeu_pd(out + i, _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+        }
+        Scalar::subtract(a + i, b + i, out + i, n - i);
+    }
+
+    MTL_SIMD_TARGET("avx2") static void multiply(const float *a, const float *b, float *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 8 <= n; i += 8)
+        {
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+        }
+        Scalar::multiply(a + i, b + i, out + i, n - i);
+    }
+
+    MTL_SIMD_TARGET("avx2") static void multiply(const double *a, const double *b, double *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 4 <= n; i += 4)
+        {
+            _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+        }
+        Scalar::multiply(a + i, b + i, out + i, n - i);
+    }
+
+    MTL_SIMD_TARGET("avx2") static void scale(const float *a, float value, float *out, size_t n)
+    {
+        const __m256 s = _mm256_set1_ps(value);
+        size_t i = 0;
+        for(; i + 8 <= n; i += 8)
+        {
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_loadu_ps(a + i), s));
+        }
+        Scalar::scale(a + i, value, out + i, n - i);
+    }
+
+    MTL_SIMD_TARGET("avx2") static void scale(const double *a, double value, double *out, size_t n)
+    {
+        const __m256d s = _mm256_set1_pd(value);
+        size_t i = 0;
+        for(; i + 4 <= n; i += 4)
+        {
+            _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(a + i), s));
+        }
+        Scalar::scale(a + i, value, out + i, n - i);
+    }
+
+    MTL_SIMD_TARGET("avx2") static void sqrt(const float *a, float *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 8 <= n; i += 8)
+        {
+            _mm256_storeu_ps(out + i, _mm256_sqrt_ps(_mm256_loadu_ps(a + i)));
+        }
+        Scalar::sqrt(a + i, out + i, n - i);
+    }
+
+    MTL_SIMD_TARGET("avx2") static void sqrt(const double *a, double *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 4 <= n; i += 4)
+        {
+            _mm256_storeu_pd(out + i, _mm256_sqrt_pd(_mm256_loadu_pd(a + i)));
+        }
+        Scalar::sqrt(a + i, out + i, n - i);
+    }
+
+    MTL_SIMD_TARGET("avx2") static float dot(const float *a, const float *b, size_t n)
+    {
+        __m256 acc = _mm256_setzero_ps();
+        size_t i = 0;
+        for(; i + 8 <= n; i += 8)
+        {
+            acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+        }
+        const __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+        return Sse2::sum(half) + Scalar::dot(a + i, b + i, n - i);
+    }
+
+    MTL_SIMD_TARGET("avx2") static double dot(const double *a, const double *b, size_t n)
+    {
+        __m256d acc = _mm256_setzero_pd();
+        size_t i = 0;
+        for(; i + 4 <= n; i += 4)
+        {
+            acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+        }
+        const __m128d half = _mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+        return Sse2::sum(half) + Scalar::dot(a + i, b + i, n - i);
+    }
+
+    //! Mask selecting the low three lanes
+    MTL_SIMD_TARGET("avx2") static __m256i mask3()
+    {
+        return _mm256_set_epi64x(0, -1, -1, -1);
+    }
+
+    MTL_SIMD_TARGET("avx2") static void cross(const double *a, const double *b, double *out, size_t count)
+    {
+        const __m256i mask = mask3();
+        for(size_t n = 0; n < count; ++n, a += 3, b += 3, out += 3)
+        {
+            const __m256d u = _mm256_maskload_pd(a, mask);
+            const __m256d v = _mm256_maskload_pd(b, mask);
+            const __m256d uyzx = _mm256_permute4x64_pd(u, _MM_SHUFFLE(3, 0, 2, 1));
+            const __m256d uzxy = _mm256_permute4x64_pd(u, _MM_SHUFFLE(3, 1, 0, 2));
+            const __m256d vyzx = _mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 0, 2, 1));
+            const __m256d vzxy = _mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 1, 0, 2));
+            _mm256_maskstore_pd(out, mask, _mm256_sub_pd(_mm256_mul_pd(uyzx, vzxy), _mm256_mul_pd(uzxy, vyzx)));
+        }
+    }
+
+    MTL_SIMD_TARGET("avx2") static void quaternionMultiply(const double *p, const double *q, double *out, size_t count)
+    {
+        // Same lane layout as the SSE2 float kernel
+        const __m256d sign1 = _mm256_set_pd(0.0, -0.0, 0.0, -0.0);
+        const __m256d sign2 = _mm256_set_pd(-0.0, 0.0, 0.0, -0.0);
+        const __m256d sign3 = _mm256_set_pd(0.0, 0.0, -0.0, -0.0);
+        for(size_t n = 0; n < count; ++n, p += 4, q += 4, out += 4)
+        {
+            const __m256d s = _mm256_loadu_pd(q);
+            const __m256d s1 = _mm256_xor_pd(_mm256_permute4x64_pd(s, _MM_SHUFFLE(2, 3, 0, 1)), sign1);
+            const __m256d s2 = _mm256_xor_pd(_mm256_permute4x64_pd(s, _MM_SHUFFLE(1, 0, 3, 2)), sign2);
+            const __m256d s3 = _mm256_xor_pd(_mm256_permute4x64_pd(s, _MM_SHUFFLE(0, 1, 2, 3)), sign3);
+            __m256d r = _mm256_mul_pd(_mm256_set1_pd(p[0]), s);
+            r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_set1_pd(p[1]), s1));
+            r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_set1_pd(p[2]), s2));
+            r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_set1_pd(p[3]), s3));
+            _mm256_storeu_pd(out, r);
+        }
+    }
+
+    MTL_SIMD_TARGET("avx2") static void multiply3x3(const double *a, const double *b, double *out, size_t count)
+    {
+        const __m256i mask = mask3();
+        for(size_t n = 0; n < count; ++n, a += 9, b += 9, out += 9)
+        {
+            const __m256d b0 = _mm256_maskload_pd(b, mask);
+            const __m256d b1 = _mm256_maskload_pd(b + 3, mask);
+            const __m256d b2 = _mm256_maskload_pd(b + 6, mask);
+            __m256d c[3];
+            for(size_t i = 0; i < 3; ++i)
+            {
+                __m256d r = _mm256_add_pd(_mm256_setzero_pd(), _mm256_mul_pd(_mm256_set1_pd(a[3*i]), b0));
+                r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_set1_pd(a[3*i+1]), b1));
+                c[i] = _mm256_add_pd(r, _mm256_mul_pd(_mm256_set1_pd(a[3*i+2]), b2));
+            }
+            _mm256_maskstore_pd(out, mask, c[0]);
+            _mm256_maskstore_pd(out + 3, mask, c[1]);
+            _mm256_maskstore_pd(out + 6, mask, c[2]);
+        }
+    }
+
+    MTL_SIMD_TARGET("avx2") static void multiply4x4(const double *a, const double *b, double *out, size_t count)
+    {
+        for(size_t n = 0; n < count; ++n, a += 16, b += 16, out += 16)
+        {
+            const __m256d b0 = _mm256_loadu_pd(b);
+            const __m256d b1 = _mm256_loadu_pd(b + 4);
+            const __m256d b2 = _mm256_loadu_pd(b + 8);
+            const __m256d b3 = _mm256_loadu_pd(b + 12);
+            __m256d c[4];
+            for(size_t i = 0; i < 4; ++i)
+            {
+                __m256d r = _mm256_add_pd(_mm256_setzero_pd(), _mm256_mul_pd(_mm256_set1_pd(a[4*i]), b0));
+                r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_set1_pd(a[4*i+1]), b1));
+                r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_set1_pd(a[4*i+2]), b2));
+                c[i] = _mm256_add_pd(r, _mm256_mul_pd(_mm256_set1_pd(a[4*i+3]), b3));
+            }
+            for(size_t i = 0; i < 4; ++i)
+            {
+                _mm256_storeu_pd(out + 4*i, c[i]);
+            }
+        }
+    }
+
+    MTL_SIMD_TARGET("avx2") static void rotate3(const double *dcm, const double *v, double *out, size_t count)
+    {
+        const __m256i mask = mask3();
+        const __m256d col0 = _mm256_set_pd(0.0, dcm[6], dcm[3], dcm[0]);
+        const __m256d col1 = _mm256_set_pd(0.0, dcm[7], dcm[4], dcm[1]);
+        const __m256d col2 = _mm256_set_pd(0.0, dcm[8], dcm[5], dcm[2]);
+        for(size_t n = 0; n < count; ++n, v += 3, out += 3)
+        {
+            __m256d r = _mm256_add_pd(_mm256_setzero_pd(), _mm256_mul_pd(col0, _mm256_set1_pd(v[0])));
+            r = _mm256_add_pd(r, _mm256_mul_pd(col1, _mm256_set1_pd(v[1])));
+            r = _mm256_add_pd(r, _mm256_mul_pd(col2, _mm256_set1_pd(v[2])));
+            _mm256_maskstore_pd(out, mask, r);
+        }
+    }
+
+    MTL_SIMD_TARGET("avx2") static void crossPadded(const double *a, const double *b, double *out, size_t count)
+    {
+        for(size_t n = 0; n < count; ++n, a += 4, b += 4, out += 4)
+        {
+            const __m256d u = _mm256_load_pd(a);
+            const __m256d v = _mm256_load_pd(b);
+            const __m256d uyzx = _mm256_permute4x64_pd(u, _MM_SHUFFLE(3, 0, 2, 1));
+            const __m256d uzxy = _mm256_permute4x64_pd(u, _MM_SHUFFLE(3, 1, 0, 2));
+            const __m256d vyzx = _mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 0, 2, 1));
+            const __m256d vzxy = _mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 1, 0, 2));
+            _mm256_store_pd(out, _mm256_sub_pd(_mm256_mul_pd(uyzx, vzxy), _mm256_mul_pd(uzxy, vyzx)));
+        }
+    }
+
+    MTL_SIMD_TARGET("avx2") static void multiply3x3Padded(const double *a, const double *b, double *out, size_t count)
+    {
+        for(size_t n = 0; n < count; ++n, a += 12, b += 12, out += 12)
+        {
+            const __m256d b0 = _mm256_load_pd(b);
+            const __m256d b1 = _mm256_load_pd(b + 4);
+            const __m256d b2 = _mm256_load_pd(b + 8);
+            __m256d c[3];
+            for(size_t i = 0; i < 3; ++i)
+            {
+                __m256d r = _mm256_add_pd(_mm256_setzero_pd(), _mm256_mul_pd(_mm256_set1_pd(a[4*i]), b0));
+                r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_set1_pd(a[4*i+1]), b1));
+                c[i] = _mm256_add_pd(r, _mm256_mul_pd(_mm256_set1_pd(a[4*i+2]), b2));
+            }
+            _mm256_store_pd(out, c[0]);
+            _mm256_store_pd(out + 4, c[1]);
+            _mm256_store_pd(out + 8, c[2]);
+        }
+    }
+
+    MTL_SIMD_TARGET("avx2") static void rotate3Padded(const double *dcm, const double *v, double *out, size_t count)
+    {
+        const __m256d col0 = _mm256_set_pd(0.0, dcm[8], dcm[4], dcm[0]);
+        const __m256d col1 = _mm256_set_pd(0.0, dcm[9], dcm[5], dcm[1]);
+        const __m256d col2 = _mm256_set_pd(0.0, dcm[10], dcm[6], dcm[2]);
+        for(size_t n = 0; n < count; ++n, v += 4, out += 4)
+        {
+            const __m256d x = _mm256_load_pd(v);
+            __m256d r = _mm256_add_pd(_mm256_setzero_pd(), _mm256_mul_pd(col0, _mm256_permute4x64_pd(x, _MM_SHUFFLE(0, 0, 0, 0))));
+            r = _mm256_add_pd(r, _mm256_mul_pd(col1, _mm256_permute4x64_pd(x, _MM_SHUFFLE(1, 1, 1, 1))));
+            r = _mm256_add_pd(r, _mm256_mul_pd(col2, _mm256_permute4x64_pd(x, _MM_SHUFFLE(2, 2, 2, 2))));
+            _mm256_store_pd(out, r);
+        }
+    }
+};
+
+//! 512-bit kernels (masked loads and stores handle the tails)
+struct Avx512
+{
+    //! Mask selecting the first n (< 16) lanes
+    static __mmask16 tail(size_t n)
+    {
+        return static_cast<__mmask16>((1u << n) - 1u);
+    }
+
+    // GCC's unmasked sqrt and 256-bit extract intrinsics take their unused
+    // source from _mm512_undefined_*, which -Wall reports as uninitialized in
+    // every caller. The zero-masking forms with a full mask are the same
+    // instructions without the undefined source.
+
+    //! Square roots of all 16 lanes
+    MTL_SIMD_TARGET("avx512f") static __m512 sqrtAll(__m512 x)
+    {
+        return _mm512_maskz_sqrt_ps(static_cast<__mmask16>(0xFFFF), x);
+    }
+
+    //! Square roots of all 8 lanes
+    MTL_SIMD_TARGET("avx512f") static __m512d sqrtAll(__m512d x)
+    {
+        return _mm512_maskz_sqrt_pd(static_cast<__mmask8>(0xFF), x);
+    }
+
+    //! Sum the 16 lanes of v
+    MTL_SIMD_TARGET("avx512f") static float sum(__m512 v)
+    {
+        const __m512d d = _mm512_castps_pd(v);
+        const __m256 half = _mm256_add_ps(_mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xF, d, 0)),
+                                          _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xF, d, 1)));
+        return Sse2::sum(_mm_add_ps(_mm256_castps256_ps128(half), _mm256_extractf128_ps(half, 1)));
+    }
+
+    //! Sum the 8 lanes of v
+    MTL_SIMD_TARGET("avx512f") static double sum(__m512d v)
+    {
+        const __m256d half = _mm256_add_pd(_mm512_maskz_extractf64x4_pd(0xF, v, 0), _mm512_maskz_extractf64x4_pd(0xF, v, 1));
+        return Sse2::sum(_mm_add_pd(_mm256_castpd256_pd128(half), _mm256_extractf128_pd(half, 1)));
+    }
+
+    MTL_SIMD_TARGET("avx512f") static void add(const float *a, const float *b, float *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 16 <= n; i += 16)
+        {
+            _mm512_storeu_ps(out + i, _mm512_add_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+        }
+        const __mmask16 m = tail(n - i);
+        _mm512_mask_storeu_ps(out + i, m, _mm512_add_ps(_mm512_maskz_loadu_ps(m, a + i), _mm512_maskz_loadu_ps(m, b + i)));
+    }
+
+    MTL_SIMD_TARGET("avx512f") static void add(const double *a, const double *b, double *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 8 <= n; i += 8)
+        {
+            _mm512_storeu_pd(out + i, _mm512_add_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+        }
+        const __mmask8 m = static_cast<__mmask8>(tail(n - i));
+        _mm512_mask_storeu_pd(out + i, m, _mm512_add_pd(_mm512_maskz_loadu_pd(m, a + i), _mm512_maskz_loadu_pd(m, b + i)));
+    }
+
+    MTL_SIMD_TARGET("avx512f") static void subtract(const float *a, const float *b, float *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 16 <= n; i += 16)
+        {
+            _mm512_storeu_ps(out + i, _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+        }
+        const __mmask16 m = tail(n - i);
+        _mm512_mask_storeu_ps(out + i, m, _mm512_sub_ps(_mm512_maskz_loadu_ps(m, a + i), _mm512_maskz_loadu_ps(m, b + i)));
+    }
+
+    MTL_SIMD_TARGET("avx512f") static void subtract(const double *a, const double *b, double *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 8 <= n; i += 8)
+        {
+            _mm512_storeu_pd(out + i, _mm512_sub_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+        }
+        const __mmask8 m = static_cast<__mmask8>(tail(n - i));
+        _mm512_mask_storeu_pd(out + i, m, _mm512_sub_pd(_mm512_maskz_loadu_pd(m, a + i), _mm512_maskz_loadu_pd(m, b + i)));
+    }
+
+    MTL_SIMD_TARGET("avx512f") static void multiply(const float *a, const float *b, float *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 16 <= n; i += 16)
+        {
+            _mm512_storeu_ps(out + i, _mm512_mul_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+        }
+        const __mmask16 m = tail(n - i);
+        _mm512_mask_storeu_ps(out + i, m, _mm512_mul_ps(_mm512_maskz_loadu_ps(m, a + i), _mm512_maskz_loadu_ps(m, b + i)));
+    }
+
+    MTL_SIMD_TARGET("avx512f") static void multiply(const double *a, const double *b, double *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 8 <= n; i += 8)
+        {
+            _mm512_storeu_pd(out + i, _mm512_mul_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+        }
+        const __mmask8 m = static_cast<__mmask8>(tail(n - i));
+        _mm512_mask_storeu_pd(out + i, m, _mm512_mul_pd(_mm512_maskz_loadu_pd(m, a + i), _mm512_maskz_loadu_pd(m, b + i)));
+    }
+
+    MTL_SIMD_TARGET("avx512f") static void scale(const float *a, float value, float *out, size_t n)
+    {
+        const __m512 s = _mm512_set1_ps(value);
+        size_t i = 0;
+        for(; i + 16 <= n; i += 16)
+        {
+            _mm512_storeu_ps(out + i, _mm512_mul_ps(_mm512_loadu_ps(a + i), s));
+        }
+        const __mmask16 m = tail(n - i);
+        _mm512_mask_storeu_ps(out + i, m, _mm512_mul_ps(_mm512_maskz_loadu_ps(m, a + i), s));
+    }
+
+    MTL_SIMD_TARGET("avx512f") static void scale(const double *a, double value, double *out, size_t n)
+    {
+        const __m512d s = _mm512_set1_pd(value);
+        size_t i = 0;
+        for(; i + 8 <= n; i += 8)
+        {
+            _mm512_storeu_pd(out + i, _mm512_mul_pd(_mm512_loadu_pd(a + i), s));
+        }
+        const __mmask8 m = static_cast<__mmask8>(tail(n - i));
+        _mm512_mask_storeu_pd(out + i, m, _mm512_mul_pd(_mm512_maskz_loadu_pd(m, a + i), s));
+    }
+
+    MTL_SIMD_TARGET("avx512f") static void sqrt(const float *a, float *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 16 <= n; i += 16)
+        {
+            _mm512_storeu_ps(out + i, sqrtAll(_mm512_loadu_ps(a + i)));
+        }
+        const __mmask16 m = tail(n - i);
+        _mm512_mask_storeu_ps(out + i, m, _mm512_maskz_sqrt_ps(m, _mm512_maskz_loadu_ps(m, a + i)));
+    }
+
+    MTL_SIMD_TARGET("avx512f") static void sqrt(const double *a, double *out, size_t n)
+    {
+        size_t i = 0;
+        for(; i + 8 <= n; i += 8)
+        {
+            _mm512_storeu_pd(out + i, sqrtAll(_mm512_loadu_pd(a + i)));
+        }
+        const __mmask8 m = static_cast<__mmask8>(tail(n - i));
+        _mm512_mask_storeu_pd(out + i, m, _mm512_maskz_sqrt_pd(m, _mm512_maskz_loadu_pd(m, a + i)));
+    }
+
+    MTL_SIMD_TARGET("avx512f") static float dot(const float *a, const float *b, size_t n)
+    {
+        __m512 acc = _mm512_setzero_ps();
+        size_t i = 0;
+        for(; i + 16 <= n; i += 16)
+        {
+            acc = _mm512_add_ps(acc, _mm512_mul_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+        }
+        const __mmask16 m = tail(n - i);
+        acc = _mm512_add_ps(acc, _mm512_mul_ps(_mm512_maskz_loadu_ps(m, a + i), _mm512_maskz_loadu_ps(m, b + i)));
+        return sum(acc);
+    }
+
+    MTL_SIMD_TARGET("avx512f") static double dot(const double *a, const double *b, size_t n)
+    {
+        __m512d acc = _mm512_setzero_pd();
+        size_t i = 0;
+        for(; i + 8 <= n; i += 8)
+        {
+            acc = _mm512_add_pd(acc, _mm512_mul_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+        }
+        const __mmask8 m = static_cast<__mmask8>(tail(n - i));
+        acc = _mm512_add_pd(acc, _mm512_mul_pd(_mm512_maskz_loadu_pd(m, a + i), _mm512_maskz_loadu_pd(m, b + i)));
+        return sum(acc);
+    }
+};
+
+#endif // MTL_SIMD_X86
+
+//! Element types with SIMD kernels
+template<class T>
+struct IsSimdType
+{
+    static constexpr bool value = std::is_same<T, float>::value || std::is_same<T, double>::value;
+};
+
+//! Name of an instruction set
+inline const char *isaName(Isa isa)
+{
+    switch(isa)
+    {
+        case Isa::SSE2: return "SSE2";
+        case Isa::AVX2: return "AVX2";
+        case Isa::AVX512: return "AVX-512";
+        default: return "Scalar";
+    }
+}
+
+//! True when the host CPU (and this build) supports the instruction set
+inline bool isSupported(Isa isa)
+{
+#if defined(MTL_SIMD_X86)
+    switch(isa)
+    {
+        case Isa::Scalar: return true;
+        case Isa::SSE2: return __builtin_cpu_supports("sse2");
+        case Isa::AVX2: return __builtin_cpu_supports("avx2");
+        case Isa::AVX512: return __builtin_cpu_supports("avx512f");
+    }
+    return false;
+#else
+    return isa == Isa::Scalar;
+#endif
+}
+
+//! Widest instruction set supported by the host (queried from CPUID once)
+inline Isa detectIsa()
+{
+    static const Isa best = isSupported(Isa::AVX512) ? Isa::AVX512 :
+                            isSupported(Isa::AVX2) ? Isa::AVX2 :
+                            isSupported(Isa::SSE2) ? Isa::SSE2 : Isa::Scalar;
+    return best;
+}
+
+namespace detail
+{
+
+template<class T>
+const Kernels<T> &scalarKernels()
+{
+    static const Kernels<T> table = {&Scalar::add<T>, &Scalar::subtract<T>, &Scalar::multiply<T>, &Scalar::scale<T>, &Scalar::sqrt<T>,
+                                     &Scalar::dot<T>, &Scalar::cross<T>, &Scalar::quaternionMultiply<T>,
+                                     &Scalar::multiply3x3<T>, &Scalar::multiply4x4<T>, &Scalar::rotate3<T>,
+                                     &Scalar::crossPadded<T>, &Scalar::multiply3x3Padded<T>, &Scalar::rotate3Padded<T>};
+    return table;
+}
+
+//! Kernel table for T on one instruction set (scalar unless specialized below)
+template<class T>
+const Kernels<T> &kernelsFor(Isa)
+{
+    return scalarKernels<T>();
+}
+
+#if defined(MTL_SIMD_X86)
+
+template<>
+inline const Kernels<float> &kernelsFor<float>(Isa isa)
+{
+    static const Kernels<float> sse2 = {&Sse2::add, &Sse2::subtract, &Sse2::multiply, &Sse2::scale, &Sse2::sqrt,
+                                        &Sse2::dot, &Sse2::cross, &Sse2::quaternionMultiply,
+                                        &Sse2::multiply3x3, &Sse2::multiply4x4, &Sse2::rotate3,
+                                        &Sse2::crossPadded, &Sse2::multiply3x3Padded, &Sse2::rotate3Padded};
+    static const Kernels<float> avx2 = {&Avx2::add, &Avx2::subtract, &Avx2::multiply, &Avx2::scale, &Avx2::sqrt,
+                                        &Avx2::dot, &Sse2::cross, &Sse2::quaternionMultiply,
+                                        &Sse2::multiply3x3, &Sse2::multiply4x4, &Sse2::rotate3,
+                                        &Sse2::crossPadded, &Sse2::multiply3x3Padded, &Sse2::rotate3Padded};
+    static const Kernels<float> avx512 = {&Avx512::add, &Avx512::subtract, &Avx512::multiply, &Avx512::scale, &Avx512::sqrt,
+                                          &Avx512::dot, &Sse2::cross, &Sse2::quaternionMultiply,
+                                          &Sse2::multiply3x3, &Sse2::multiply4x4, &Sse2::rotate3,
+                                          &Sse2::crossPadded, &Sse2::multiply3x3Padded, &Sse2::rotate3Padded};
+    switch(isa)
+    {
+        case Isa::SSE2: return sse2;
+        case Isa::AVX2: return avx2;
+        case Isa::AVX512: return avx512;
+        default: return scalarKernels<float>();
+    }
+}
+
+template<>
+inline const Kernels<double> &kernelsFor<double>(Isa isa)
+{
+    static const Kernels<double> sse2 = {&Sse2::add, &Sse2::subtract, &Sse2::multiply, &Sse2::scale, &Sse2::sqrt,
+                                         &Sse2::dot, &Scalar::cross<double>, &Scalar::quaternionMultiply<double>,
+                                         &Scalar::multiply3x3<double>, &Scalar::multiply4x4<double>, &Scalar::rotate3<double>,
+                                         &Scalar::crossPadded<double>, &Scalar::multiply3x3Padded<double>, &Scalar::rotate3Padded<double>};
+    static const Kernels<double> avx2 = {&Avx2::add, &Avx2::subtract, &Avx2::multiply, &Avx2::scale, &Avx2::sqrt,
+                                         &Avx2::dot, &Avx2::cross, &Avx2::quaternionMultiply,
+                                         &Avx2::multiply3x3, &Avx2::multiply4x4, &Avx2::rotate3,
+                                         &Avx2::crossPadded, &Avx2::multiply3x3Padded, &Avx2::rotate3Padded};
+    static const Kernels<double> avx512 = {&Avx512::add, &Avx512::subtract, &Avx512::multiply, &Avx512::scale, &Avx512::sqrt,
+                                           &Avx512::dot, &Avx2::cross, &Avx2::quaternionMultiply,
+                                           &Avx2::multiply3x3, &Avx2::multiply4x4, &Avx2::rotate3,
+                                           &Avx2::crossPadded, &Avx2::multiply3x3Padded, &Avx2::rotate3Padded};
+    switch(isa)
+    {
+        case Isa::SSE2: return sse2;
+        case Isa::AVX2: return avx2;
+        case Isa::AVX512: return avx512;
+        default: return scalarKernels<double>();
+    }
+}
+
+#endif // MTL_SIMD_X86
+
+} // namespace detail
+
+//! Kernel table for T on the given instruction set (the caller checks isSupported)
+template<class T>
+const Kernels<T> &kernels(Isa isa)
+{
+    return detail::kernelsFor<T>(isa);
+}
+
+//! Kernel table for T on the widest instruction set of the host
+template<class T>
+const Kernels<T> &kernels()
+{
+    static const Kernels<T> &active = detail::kernelsFor<T>(detectIsa());
+    return active;
+}
+
+//! True when a fixed-size operation on T should call the runtime kernels
+template<class T>
+constexpr bool useRuntimeKernels()
+{
+#if defined(MTL_ENABLE_SIMD)
+    return IsSimdType<T>::value && !__builtin_is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
+} // namespace simd
+
+} // namespace matrix
+
+#endif // _SIMD_KERNEL_HPP__
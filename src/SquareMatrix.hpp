@@ -9,50 +9,81 @@
 #ifndef _SQUAREMATRIX_HPP__
 #define _SQUAREMATRIX_HPP__
 
+#include <algorithm>
+#include <cassert>
 #include <cmath>
+#include <cstdio>
 #include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 #include "Matrix.hpp"
 
 namespace matrix
 {
 
-template<class T, size_t M, size_t N>
-class Matrix;
+namespace detail
+{
+
+//! Report a matrix that is singular relative to its own scale
+[[noreturn]] inline void throwSingular(double det)
+{
+    char message[100];
+    snprintf(message, 100, "ERROR: Matrix is singular to working precision. Matrix is not invertible. Det = %e\n", det);
+    throw std::runtime_error(message);
+}
+
+} // namespace detail
 
 template<class T, size_t M>
 class Vector;
 
-template<class T, size_t M>
-class SquareMatrix : public Matrix<T, M, M>
+template<class T, size_t M, class Layout = RowMajor>
+class SquareMatrix : public Matrix<T, M, M, DefaultBounds, Layout>
 {
 public:
     //! Default constructor
-    SquareMatrix();
+    constexpr SquareMatrix();
 
     //! Construct with 2d array
-    explicit SquareMatrix(const T values[M][M]);
+    explicit constexpr SquareMatrix(const T values[M][M]);
 
     //! Construct with a flat array
-    explicit SquareMatrix(const T values[M*M]);
+    explicit constexpr SquareMatrix(const T values[M*M]);
 
     //! Construct using initializer list
-    SquareMatrix(std::initializer_list<std::initializer_list<T>> list);
+    constexpr SquareMatrix(std::initializer_list<std::initializer_list<T>> list);
 
     //! Construct with Matrix type
-    SquareMatrix(const Matrix<T, M, M> &other);
+    constexpr SquareMatrix(const Matrix<T, M, M, DefaultBounds, Layout> &other);
+
+    //! Construct by taking the elements of a Matrix
+    constexpr SquareMatrix(Matrix<T, M, M, DefaultBounds, Layout> &&other);
+
+    //! Construct by evaluating a matrix expression
+    template<class E, typename = std::enable_if_t<detail::IsExpressionOfShape<E, T, M, M>::value>>
+    constexpr SquareMatrix(const MatrixExpression<E> &expr);
 
     //! Assignment operator of Base Type
-    SquareMatrix<T, M> &operator=(const Matrix<T, M, M> &other);
+    constexpr SquareMatrix<T, M, Layout> &operator=(const Matrix<T, M, M, DefaultBounds, Layout> &other);
+
+    //! Move assignment from Base Type
+    constexpr SquareMatrix<T, M, Layout> &operator=(Matrix<T, M, M, DefaultBounds, Layout> &&other);
+
+    //! Assign by evaluating a matrix expression
+    template<class E, typename = std::enable_if_t<detail::IsExpressionOfShape<E, T, M, M>::value>>
+    constexpr SquareMatrix<T, M, Layout> &operator=(const MatrixExpression<E> &expr);
 
     //! Make this matrix an identity matrix
-    void identity();
+    constexpr void identity();
 
     //! Obtain the trace of the matrix
-    T trace() const;
+    constexpr T trace() const;
 
     //! Generate the minor matrix given a column index
-    SquareMatrix<T, M-1> minor(const size_t row, const size_t col) const;
+    SquareMatrix<T, M-1, Layout> minor(const size_t row, const size_t col) const;
 
     //! Test if matrix is upper triangular (nonzeros on diagonal and above)
     bool isUpperTriangular(const double eps = 1.0e-6) const;
@@ -66,58 +97,93 @@ public:
     //! Make Lower Triangular matrix (filled with 1s)
     void makeLowerTriangular();
 
-    //! LU Decomposition
-    void LU_decomposition(SquareMatrix<T, M> &L, SquareMatrix<T, M> &U);
+    //! LU Decomposition (no pivoting; see LUFactorization for a pivoted solver)
+    void LU_decomposition(SquareMatrix<T, M, Layout> &L, SquareMatrix<T, M, Layout> &U);
 };
 
+static_assert(sizeof(SquareMatrix<double, 6>) == 36*sizeof(double), "SquareMatrix must not carry anything beyond its elements");
+static_assert(std::is_standard_layout<SquareMatrix<double, 6>>::value, "SquareMatrix must be standard-layout");
+static_assert(std::is_trivially_copyable<SquareMatrix<double, 6>>::value, "SquareMatrix must be trivially copyable");
+
 //! Default constructor
-template<class T, size_t M>
-SquareMatrix<T,M>::SquareMatrix():
-    Matrix<T, M, M>()
+template<class T, size_t M, class Layout>
+constexpr SquareMatrix<T,M,Layout>::SquareMatrix():
+    Matrix<T, M, M, DefaultBounds, Layout>()
 {
 }
 
 //! Construct with 2d array
-template<class T, size_t M>
-SquareMatrix<T,M>::SquareMatrix(const T values[M][M]):
-    Matrix<T, M, M>(values)
+template<class T, size_t M, class Layout>
+constexpr SquareMatrix<T,M,Layout>::SquareMatrix(const T values[M][M]):
+    Matrix<T, M, M, DefaultBounds, Layout>(values)
 {
 }
 
 //! Construct with a flat array
-template<class T, size_t M>
-SquareMatrix<T,M>::SquareMatrix(const T values[M*M]):
-    Matrix<T, M, M>(values)
+template<class T, size_t M, class Layout>
+constexpr SquareMatrix<T,M,Layout>::SquareMatrix(const T values[M*M]):
+    Matrix<T, M, M, DefaultBounds, Layout>(values)
 {
 }
 
 //! Construct using initializer list
-template<class T, size_t M>
-SquareMatrix<T,M>::SquareMatrix(std::initializer_list<std::initializer_list<T>> list):
-    Matrix<T, M, M>(list)
+template<class T, size_t M, class Layout>
+constexpr SquareMatrix<T,M,Layout>::SquareMatrix(std::initializer_list<std::initializer_list<T>> list):
+    Matrix<T, M, M, DefaultBounds, Layout>(list)
 {
 }
 
 //! Construct with Matrix type
-template<class T, size_t M>
-SquareMatrix<T,M>::SquareMatrix(const Matrix<T, M, M> &other):
-    Matrix<T, M, M>(other)
+template<class T, size_t M, class Layout>
+constexpr SquareMatrix<T,M,Layout>::SquareMatrix(const Matrix<T, M, M, DefaultBounds, Layout> &other):
+    Matrix<T, M, M, DefaultBounds, Layout>(other)
+{
+}
+
+//! Construct by taking the elements of a Matrix
+template<class T, size_t M, class Layout>
+constexpr SquareMatrix<T,M,Layout>::SquareMatrix(Matrix<T, M, M, DefaultBounds, Layout> &&other):
+    Matrix<T, M, M, DefaultBounds, Layout>(std::move(other))
+{
+}
+
+//! Construct by evaluating a matrix expression
+template<class T, size_t M, class Layout>
+template<class E, typename>
+constexpr SquareMatrix<T,M,Layout>::SquareMatrix(const MatrixExpression<E> &expr):
+    Matrix<T, M, M, DefaultBounds, Layout>(expr)
 {
 }
 
 //! Assignment operator from base type
-template<class T, size_t M>
-SquareMatrix<T, M> &SquareMatrix<T,M>::operator=(const Matrix<T, M, M> &other)
+template<class T, size_t M, class Layout>
+constexpr SquareMatrix<T, M, Layout> &SquareMatrix<T,M,Layout>::operator=(const Matrix<T, M, M, DefaultBounds, Layout> &other)
+{
+    Matrix<T, M, M, DefaultBounds, Layout>::operator=(other);
+    return *this;
+}
+
+//! Move assignment from base type
+template<class T, size_t M, class Layout>
+constexpr SquareMatrix<T, M, Layout> &SquareMatrix<T,M,Layout>::operator=(Matrix<T, M, M, DefaultBounds, Layout> &&other)
+{
+    Matrix<T, M, M, DefaultBounds, Layout>::operator=(std::move(other));
+    return *this;
+}
+
+//! Assign by evaluating a matrix expression
+template<class T, size_t M, class Layout>
+template<class E, typename>
+constexpr SquareMatrix<T, M, Layout> &SquareMatrix<T,M,Layout>::operator=(const MatrixExpression<E> &expr)
 {
-    Matrix<T, M, M>::operator=(other);
+    Matrix<T, M, M, DefaultBounds, Layout>::operator=(expr);
     return *this;
 }
 
 //! Make this matrix an identity matrix
-template<class T, size_t M>
-void SquareMatrix<T,M>::identity()
+template<class T, size_t M, class Layout>
+constexpr void SquareMatrix<T,M,Layout>::identity()
 {
-    SquareMatrix<T, M> &self = *this;
     for(size_t i = 0; i < M*M; ++i)
     {
         this->data[i] = (T)0;
@@ -129,17 +195,17 @@ void SquareMatrix<T,M>::identity()
 }
 
 //! Return an identity matrix
-template<class T, size_t M>
-SquareMatrix<T, M> identity()
+template<class T, size_t M, class Layout = RowMajor>
+constexpr SquareMatrix<T, M, Layout> identity()
 {
-    SquareMatrix<T, M> result;
+    SquareMatrix<T, M, Layout> result;
     result.identity();
     return result;
 }
 
 //! Obtain the trace of the matrix
-template<class T, size_t M>
-T SquareMatrix<T, M>::trace() const
+template<class T, size_t M, class Layout>
+constexpr T SquareMatrix<T,M,Layout>::trace() const
 {
     T tr = 0;
     for(size_t i = 0; i < M; ++i)
@@ -150,8 +216,8 @@ T SquareMatrix<T, M>::trace() const
 }
 
 //! Generate the minor matrix given a column index
-template<class T, size_t M>
-SquareMatrix<T, M-1> SquareMatrix<T, M>::minor(const size_t row, const size_t col) const
+template<class T, size_t M, class Layout>
+SquareMatrix<T, M-1, Layout> SquareMatrix<T,M,Layout>::minor(const size_t row, const size_t col) const
 {
     // This method assumes a couple of things:
     // 1. That the matrix is 2x2 or bigger
@@ -159,33 +225,36 @@ SquareMatrix<T, M-1> SquareMatrix<T, M>::minor(const size_t row, const size_t co
     assert(M >= 2); // TODO raise an exception?
 
     T minordata[(M-1)*(M-1)];
-    size_t datactr = 0;
-    for(size_t i = 0; i < M; ++i)
+    for(size_t i = 0, mi = 0; i < M; ++i)
     {
-        for(size_t j = 0; j < M; ++j)
+        if(i == row)
+        {
+            continue;
+        }
+        for(size_t j = 0, mj = 0; j < M; ++j)
         {
-            if(row != i && col != j)
+            if(j != col)
             {
-                // minordata[datactr] = self(i,j);
-                minordata[datactr] = this->data[i*M+j];
-                ++datactr;
+                minordata[Layout::index(mi,mj,M-1,M-1)] = this->data[Layout::index(i,j,M,M)];
+                ++mj;
             }
         }
+        ++mi;
     }
 
-    SquareMatrix<T, M-1> minor(minordata);
+    SquareMatrix<T, M-1, Layout> minor(minordata);
     return minor;
 }
 
 //! Test if matrix is upper triangular (nonzeros on diagonal and above)
-template<class T, size_t M>
-bool SquareMatrix<T, M>::isUpperTriangular(const double eps) const
+template<class T, size_t M, class Layout>
+bool SquareMatrix<T,M,Layout>::isUpperTriangular(const double eps) const
 {
     for(size_t i = 0; i < M; ++i)
     {
         for(size_t j = 0; j < M; ++j)
         {
-            if(i > j && std::fabs(static_cast<double>(this->data[i*M+j])) >= eps)
+            if(i > j && std::fabs(static_cast<double>(this->data[Layout::index(i,j,M,M)])) >= eps)
             {
                 return false;
             }
@@ -195,14 +264,14 @@ bool SquareMatrix<T, M>::isUpperTriangular(const double eps) const
 }
 
 //! Test if matrix is lower triangular (nonzeros on diagonal and below)
-template<class T, size_t M>
-bool SquareMatrix<T, M>::isLowerTriangular(const double eps) const
+template<class T, size_t M, class Layout>
+bool SquareMatrix<T,M,Layout>::isLowerTriangular(const double eps) const
 {
     for(size_t i = 0; i < M; ++i)
     {
         for(size_t j = 0; j < M; ++j)
         {
-            if(i < j && std::fabs(static_cast<double>(this->data[i*M+j])) >= eps)
+            if(i < j && std::fabs(static_cast<double>(this->data[Layout::index(i,j,M,M)])) >= eps)
             {
                 return false;
             }
@@ -212,8 +281,8 @@ bool SquareMatrix<T, M>::isLowerTriangular(const double eps) const
 }
 
 //! Make Upper Triangular matrix (filled with 1s)
-template<class T, size_t M>
-void SquareMatrix<T, M>::makeUpperTriangular()
+template<class T, size_t M, class Layout>
+void SquareMatrix<T,M,Layout>::makeUpperTriangular()
 {
     for(size_t i = 0; i < M; ++i)
     {
@@ -221,15 +290,15 @@ void SquareMatrix<T, M>::makeUpperTriangular()
         {
             if(i <= j)
             {
-                this->data[i*M+j] = static_cast<T>(1);
+                this->data[Layout::index(i,j,M,M)] = static_cast<T>(1);
             }
         }
     }
 }
 
 //! Make Lower Triangular matrix (filled with 1s)
-template<class T, size_t M>
-void SquareMatrix<T, M>::makeLowerTriangular()
+template<class T, size_t M, class Layout>
+void SquareMatrix<T,M,Layout>::makeLowerTriangular()
 {
     for(size_t i = 0; i < M; ++i)
     {
@@ -237,19 +306,19 @@ void SquareMatrix<T, M>::makeLowerTriangular()
         {
             if(i >= j)
             {
-                this->data[i*M+j] = static_cast<T>(1);
+                this->data[Layout::index(i,j,M,M)] = static_cast<T>(1);
             }
         }
     }
 }
 
 //! LU decomposition
-template<class T, size_t M>
-void SquareMatrix<T, M>::LU_decomposition(SquareMatrix<T, M> &L, SquareMatrix<T, M> &U)
+template<class T, size_t M, class Layout>
+void SquareMatrix<T,M,Layout>::LU_decomposition(SquareMatrix<T, M, Layout> &L, SquareMatrix<T, M, Layout> &U)
 {
     // TODO: figure out why self is getting modified (see Introduction to Algorithms, 3rd 28.1)
-    // SquareMatrix<T, M> &self = *this;
-    SquareMatrix<T, M> A = *this;
+    // SquareMatrix<T, M, Layout> &self = *this;
+    SquareMatrix<T, M, Layout> A = *this;
     size_t n = M;
     L.identity();
     // U.identity();
@@ -273,92 +342,201 @@ void SquareMatrix<T, M>::LU_decomposition(SquareMatrix<T, M> &L, SquareMatrix<T,
 }
 
 //! Return the determinant of a trivial 1x1 matrix
-template<class T>
-T determinant(const SquareMatrix<T, 1> &A)
+template<class T, class Layout>
+T determinant(const SquareMatrix<T, 1, Layout> &A)
 {
     return A(0,0);
 }
 
 //! Return the determinant of a 2x2 matrix
-template<class T>
-T determinant(const SquareMatrix<T, 2> &A)
+template<class T, class Layout>
+T determinant(const SquareMatrix<T, 2, Layout> &A)
 {
     return (A(0,0)*A(1,1) - A(0,1)*A(1,0));
 }
 
 //! Return the determinant of a 3x3 matrix
-template<class T>
-T determinant(const SquareMatrix<T, 3> &A)
+template<class T, class Layout>
+T determinant(const SquareMatrix<T, 3, Layout> &A)
 {
     return ((A(0,0)*(A(1,1)*A(2,2) - A(1,2)*A(2,1)))
            -(A(0,1)*(A(1,0)*A(2,2) - A(1,2)*A(2,0)))
            +(A(0,2)*(A(1,0)*A(2,1) - A(1,1)*A(2,0))));
 }
 
-//! Return the determinant of a MxM matrix
-template<class T, size_t M>
-T determinant(const SquareMatrix<T, M> &A)
+//! Return the determinant of a 4x4 matrix
+template<class T, class Layout>
+T determinant(const SquareMatrix<T, 4, Layout> &A)
 {
-    T det = 0;
-    for(size_t i = 0; i < M; ++i)
-    {
-        SquareMatrix<T, M-1> minor = A.minor(0,i);
-        det += std::pow(-1.0, i)*A(0, i)*matrix::determinant<T>(minor);
-    }
-    return det;
+    // Laplace expansion by the 2x2 minors of the top two rows and their complements
+    const T s0 = A(0,0)*A(1,1) - A(1,0)*A(0,1);
+    const T s1 = A(0,0)*A(1,2) - A(1,0)*A(0,2);
+    const T s2 = A(0,0)*A(1,3) - A(1,0)*A(0,3);
+    const T s3 = A(0,1)*A(1,2) - A(1,1)*A(0,2);
+    const T s4 = A(0,1)*A(1,3) - A(1,1)*A(0,3);
+    const T s5 = A(0,2)*A(1,3) - A(1,2)*A(0,3);
+    const T c5 = A(2,2)*A(3,3) - A(3,2)*A(2,3);
+    const T c4 = A(2,1)*A(3,3) - A(3,1)*A(2,3);
+    const T c3 = A(2,1)*A(3,2) - A(3,1)*A(2,2);
+    const T c2 = A(2,0)*A(3,3) - A(3,0)*A(2,3);
+    const T c1 = A(2,0)*A(3,2) - A(3,0)*A(2,2);
+    const T c0 = A(2,0)*A(3,1) - A(3,0)*A(2,1);
+    return s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
 }
 
-//! Compute the inverse of a 2x2 matrix
-template<class T>
-SquareMatrix<T, 2> inverse(const SquareMatrix<T, 2> &A)
+//! Return the determinant of a MxM matrix
+template<class T, size_t M, class Layout>
+T determinant(const SquareMatrix<T, M, Layout> &A)
 {
-    T det = determinant<T>(A);
-    if(std::fabs(det) < 1.0e-9)
+    // Eliminate on a copy of the storage in O(M^3). For ColumnMajor the copy holds the
+    // transpose, which has the same determinant.
+    SquareMatrix<T, M, Layout> work = A;
+    T *a = &work(0,0);
+    T sign = 1;
+    if constexpr(std::is_integral<T>::value)
     {
-        char message[100];
-        snprintf(message, 100, "ERROR: Determinant is < 1.0e-9. Matrix is not invertible. Det = %f\n", (double)det);
-        throw std::runtime_error(message);
+        // Fraction-free (Bareiss) elimination: every division is exact, so integer
+        // determinants stay exact
+        T previous = 1;
+        for(size_t k = 0; k+1 < M; ++k)
+        {
+            if(a[k*M+k] == T(0))
+            {
+                size_t p = k+1;
+                while(p < M && a[p*M+k] == T(0))
+                {
+                    ++p;
+                }
+                if(p == M)
+                {
+                    return T(0);
+                }
+                for(size_t j = k; j < M; ++j)
+                {
+                    std::swap(a[k*M+j], a[p*M+j]);
+                }
+                sign = -sign;
+            }
+            for(size_t i = k+1; i < M; ++i)
+            {
+                for(size_t j = k+1; j < M; ++j)
+                {
+                    a[i*M+j] = (a[i*M+j]*a[k*M+k] - a[i*M+k]*a[k*M+j]) / previous;
+                }
+            }
+            previous = a[k*M+k];
+        }
+        return sign*a[(M-1)*M+(M-1)];
+    }
+    else
+    {
+        // Gaussian elimination with partial pivoting; the determinant is the product of the pivots
+        T det = 1;
+        for(size_t k = 0; k < M; ++k)
+        {
+            size_t p = k;
+            for(size_t i = k+1; i < M; ++i)
+            {
+                if(std::fabs(a[i*M+k]) > std::fabs(a[p*M+k]))
+                {
+                    p = i;
+                }
+            }
+            if(a[p*M+k] == T(0))
+            {
+                return T(0);
+            }
+            if(p != k)
+            {
+                for(size_t j = k; j < M; ++j)
+                {
+                    std::swap(a[k*M+j], a[p*M+j]);
+                }
+                sign = -sign;
+            }
+            const T pivot = a[k*M+k];
+            det *= pivot;
+            for(size_t i = k+1; i < M; ++i)
+            {
+                const T l = a[i*M+k] / pivot;
+                for(size_t j = k+1; j < M; ++j)
+                {
+                    a[i*M+j] -= l*a[k*M+j];
+                }
+            }
+        }
+        return sign*det;
     }
-
-    SquareMatrix<T, 2> Ainv;
-    Ainv(0,0) = A(1,1);
-    Ainv(0,1) = -A(0,1);
-    Ainv(1,0) = -A(1,0);
-    Ainv(1,1) = A(0,0);
-    Ainv /= det;
-    return Ainv;
 }
 
 //! Create and return Upper Triangular matrix
-template<class T, size_t M>
-SquareMatrix<T, M> upperTriangular()
+template<class T, size_t M, class Layout = RowMajor>
+SquareMatrix<T, M, Layout> upperTriangular()
 {
-    SquareMatrix<T, M> m;
+    SquareMatrix<T, M, Layout> m;
     m.makeUpperTriangular();
     return m;
 }
 
 //! Create and return Lower Triangular matrix
-template<class T, size_t M>
-SquareMatrix<T, M> lowerTriangular()
+template<class T, size_t M, class Layout = RowMajor>
+SquareMatrix<T, M, Layout> lowerTriangular()
 {
-    SquareMatrix<T, M> m;
+    SquareMatrix<T, M, Layout> m;
     m.makeLowerTriangular();
     return m;
 }
 
-//! Compute the inverse of a 3x3 matrix
-template<class T>
-SquareMatrix<T, 3> inverse(const SquareMatrix<T, 3> &A)
+namespace detail
+{
+
+//! True when |det| is at most M*eps times the product of the row lengths of A
+//! (Hadamard's bound on |det|). The ratio does not change when A is scaled,
+//! unlike an absolute threshold on det.
+template<class T, size_t M, class Layout>
+bool negligibleDeterminant(T det, const SquareMatrix<T, M, Layout> &A)
 {
-    T det = determinant<T>(A);
-    if(std::fabs(det) < 1.0e-9)
+    T bound = 1;
+    for(size_t i = 0; i < M; ++i)
     {
-        char message[100];
-        snprintf(message, 100, "ERROR: Determinant is < 1.0e-9. Matrix is not invertible. Det = %f\n", (double)det);
-        throw std::runtime_error(message);
+        T lengthSquared = 0;
+        for(size_t j = 0; j < M; ++j)
+        {
+            lengthSquared += A(i,j)*A(i,j);
+        }
+        bound *= std::sqrt(lengthSquared);
+    }
+    return !(std::fabs(det) > M*std::numeric_limits<T>::epsilon()*bound);
+}
+
+//! Compute the inverse of a 2x2 matrix into Ainv and its determinant into det.
+//! Returns false, without writing Ainv, when det is negligible.
+template<class T, class Layout>
+bool invertInto(const SquareMatrix<T, 2, Layout> &A, SquareMatrix<T, 2, Layout> &Ainv, T &det)
+{
+    det = determinant<T>(A);
+    if(negligibleDeterminant(det, A))
+    {
+        return false;
+    }
+    Ainv(0,0) = A(1,1);
+    Ainv(0,1) = -A(0,1);
+    Ainv(1,0) = -A(1,0);
+    Ainv(1,1) = A(0,0);
+    Ainv /= det;
+    return true;
+}
+
+//! Compute the inverse of a 3x3 matrix into Ainv and its determinant into det.
+//! Returns false, without writing Ainv, when det is negligible.
+template<class T, class Layout>
+bool invertInto(const SquareMatrix<T, 3, Layout> &A, SquareMatrix<T, 3, Layout> &Ainv, T &det)
+{
+    det = determinant<T>(A);
+    if(negligibleDeterminant(det, A))
+    {
+        return false;
     }
-    SquareMatrix<T, 3> Ainv;
     T detinv = 1.0 / det;
     Ainv(0,0) = detinv*(A(1,1)*A(2,2) - A(1,2)*A(2,1));
     Ainv(0,1) = detinv*(A(0,2)*A(2,1) - A(0,1)*A(2,2));
@@ -369,6 +547,180 @@ SquareMatrix<T, 3> inverse(const SquareMatrix<T, 3> &A)
     Ainv(2,0) = detinv*(A(1,0)*A(2,1) - A(1,1)*A(2,0));
     Ainv(2,1) = detinv*(A(0,1)*A(2,0) - A(0,0)*A(2,1));
     Ainv(2,2) = detinv*(A(0,0)*A(1,1) - A(0,1)*A(1,0));
+    return true;
+}
+
+//! Compute the inverse of a 4x4 matrix into Ainv and its determinant into det.
+//! Returns false, without writing Ainv, when det is negligible.
+template<class T, class Layout>
+bool invertInto(const SquareMatrix<T, 4, Layout> &A, SquareMatrix<T, 4, Layout> &Ainv, T &det)
+{
+    // 2x2 minors of the top two rows (s) and of the bottom two rows (c) give the
+    // determinant and every cofactor
+    const T s0 = A(0,0)*A(1,1) - A(1,0)*A(0,1);
+    const T s1 = A(0,0)*A(1,2) - A(1,0)*A(0,2);
+    const T s2 = A(0,0)*A(1,3) - A(1,0)*A(0,3);
+    const T s3 = A(0,1)*A(1,2) - A(1,1)*A(0,2);
+    const T s4 = A(0,1)*A(1,3) - A(1,1)*A(0,3);
+    const T s5 = A(0,2)*A(1,3) - A(1,2)*A(0,3);
+    const T c5 = A(2,2)*A(3,3) - A(3,2)*A(2,3);
+    const T c4 = A(2,1)*A(3,3) - A(3,1)*A(2,3);
+    const T c3 = A(2,1)*A(3,2) - A(3,1)*A(2,2);
+    const T c2 = A(2,0)*A(3,3) - A(3,0)*A(2,3);
+    const T c1 = A(2,0)*A(3,2) - A(3,0)*A(2,2);
+    const T c0 = A(2,0)*A(3,1) - A(3,0)*A(2,1);
+    det = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+    if(negligibleDeterminant(det, A))
+    {
+        return false;
+    }
+
+    const T detinv = T(1) / det;
+    Ainv(0,0) = ( A(1,1)*c5 - A(1,2)*c4 + A(1,3)*c3)*detinv;
+    Ainv(0,1) = (-A(0,1)*c5 + A(0,2)*c4 - A(0,3)*c3)*detinv;
+    Ainv(0,2) = ( A(3,1)*s5 - A(3,2)*s4 + A(3,3)*s3)*detinv;
+    Ainv(0,3) = (-A(2,1)*s5 + A(2,2)*s4 - A(2,3)*s3)*detinv;
+    Ainv(1,0) = (-A(1,0)*c5 + A(1,2)*c2 - A(1,3)*c1)*detinv;
+    Ainv(1,1) = ( A(0,0)*c5 - A(0,2)*c2 + A(0,3)*c1)*detinv;
+    Ainv(1,2) = (-A(3,0)*s5 + A(3,2)*s2 - A(3,3)*s1)*detinv;
+    Ainv(1,3) = ( A(2,0)*s5 - A(2,2)*s2 + A(2,3)*s1)*detinv;
+    Ainv(2,0) = ( A(1,0)*c4 - A(1,1)*c2 + A(1,3)*c0)*detinv;
+    Ainv(2,1) = (-A(0,0)*c4 + A(0,1)*c2 - A(0,3)*c0)*detinv;
+    Ainv(2,2) = ( A(3,0)*s4 - A(3,1)*s2 + A(3,3)*s0)*detinv;
+    Ainv(2,3) = (-A(2,0)*s4 + A(2,1)*s2 - A(2,3)*s0)*detinv;
+    Ainv(3,0) = (-A(1,0)*c3 + A(1,1)*c1 - A(1,2)*c0)*detinv;
+    Ainv(3,1) = ( A(0,0)*c3 - A(0,1)*c1 + A(0,2)*c0)*detinv;
+    Ainv(3,2) = (-A(3,0)*s3 + A(3,1)*s1 - A(3,2)*s0)*detinv;
+    Ainv(3,3) = ( A(2,0)*s3 - A(2,1)*s1 + A(2,2)*s0)*detinv;
+    return true;
+}
+
+//! Compute the inverse of a MxM matrix into Ainv and its determinant into det.
+//! Returns false, without writing Ainv, when a pivot is at most M*eps times
+//! the largest absolute row sum of A, so the test follows the scale of A.
+template<class T, size_t M, class Layout>
+bool invertInto(const SquareMatrix<T, M, Layout> &A, SquareMatrix<T, M, Layout> &Ainv, T &det)
+{
+    // Gauss-Jordan elimination with partial pivoting on copies of the storage. For
+    // ColumnMajor the storage holds the transpose, and inverting it yields the
+    // transpose of the inverse, i.e. the inverse in ColumnMajor storage.
+    SquareMatrix<T, M, Layout> work = A;
+    SquareMatrix<T, M, Layout> X;
+    X.identity();
+    T *a = &work(0,0);
+    T *x = &X(0,0);
+
+    T norm = 0;
+    for(size_t i = 0; i < M; ++i)
+    {
+        T rowSum = 0;
+        for(size_t j = 0; j < M; ++j)
+        {
+            rowSum += std::fabs(a[i*M+j]);
+        }
+        norm = std::max(norm, rowSum);
+    }
+    const T tolerance = M*std::numeric_limits<T>::epsilon()*norm;
+
+    det = 1;
+    for(size_t k = 0; k < M; ++k)
+    {
+        size_t p = k;
+        for(size_t i = k+1; i < M; ++i)
+        {
+            if(std::fabs(a[i*M+k]) > std::fabs(a[p*M+k]))
+            {
+                p = i;
+            }
+        }
+        if(!(std::fabs(a[p*M+k]) > tolerance))
+        {
+            det = 0;
+            return false;
+        }
+        if(p != k)
+        {
+            for(size_t j = 0; j < M; ++j)
+            {
+                std::swap(a[k*M+j], a[p*M+j]);
+                std::swap(x[k*M+j], x[p*M+j]);
+            }
+            det = -det;
+        }
+
+        const T pivot = a[k*M+k];
+        det *= pivot;
+        // Columns left of k are already eliminated in the work matrix, and column k
+        // is never read again, so only columns k+1 onwards need updating there
+        const T pivotinv = T(1) / pivot;
+        for(size_t j = k+1; j < M; ++j)
+        {
+            a[k*M+j] *= pivotinv;
+        }
+        for(size_t j = 0; j < M; ++j)
+        {
+            x[k*M+j] *= pivotinv;
+        }
+        for(size_t i = 0; i < M; ++i)
+        {
+            const T l = a[i*M+k];
+            if(i == k || l == T(0))
+            {
+                continue;
+            }
+            for(size_t j = k+1; j < M; ++j)
+            {
+                a[i*M+j] -= l*a[k*M+j];
+            }
+            for(size_t j = 0; j < M; ++j)
+            {
+                x[i*M+j] -= l*x[k*M+j];
+            }
+        }
+    }
+    Ainv = X;
+    return true;
+}
+
+} // namespace detail
+
+//! Compute the inverse of a square matrix (throws std::runtime_error if it is not invertible)
+template<class T, size_t M, class Layout>
+SquareMatrix<T, M, Layout> inverse(const SquareMatrix<T, M, Layout> &A)
+{
+    SquareMatrix<T, M, Layout> Ainv;
+    T det;
+    if(!detail::invertInto(A, Ainv, det))
+    {
+        detail::throwSingular((double)det);
+    }
+    return Ainv;
+}
+
+//! Compute the inverse of a square matrix without throwing. Returns false, and
+//! leaves Ainv unchanged, if the matrix is not invertible. Ainv must not be A.
+template<class T, size_t M, class Layout>
+bool tryInverse(const SquareMatrix<T, M, Layout> &A, SquareMatrix<T, M, Layout> &Ainv)
+{
+    T det;
+    return detail::invertInto(A, Ainv, det);
+}
+
+//! Invert a 4x4 rigid (homogeneous) transform [R p; 0 1] as [R^T -R^T p; 0 1].
+//! R must be a rotation and the bottom row must be 0 0 0 1; neither is checked.
+template<class T, class Layout>
+SquareMatrix<T, 4, Layout> rigidInverse(const SquareMatrix<T, 4, Layout> &A)
+{
+    SquareMatrix<T, 4, Layout> Ainv;
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < 3; ++j)
+        {
+            Ainv(i,j) = A(j,i);
+        }
+        Ainv(i,3) = -(A(0,i)*A(0,3) + A(1,i)*A(1,3) + A(2,i)*A(2,3));
+    }
+    Ainv(3,3) = T(1);
     return Ainv;
 }
 
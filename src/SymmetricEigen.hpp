@@ -0,0 +1,519 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file SymmetricEigen.hpp
+//!
+//! Eigen-decomposition A = V diag(d) V^T of a symmetric matrix, kept as solver
+//! objects like LUFactorization:
+//!
+//!   SymmetricEigen<T, M>  cyclic Jacobi rotations, any size
+//!   SymmetricEigen3<T>    3x3 only (inertia tensors, covariance blocks),
+//!                         closed-form by default or cyclic Jacobi on request,
+//!                         with the eigenvectors returned as a DCM
+//!
+//! Only the upper triangle of A is read. Eigenvalues are sorted in ascending
+//! order and column i of the eigenvector matrix belongs to eigenvalue i.
+//!
+//! The closed form costs a fixed handful of flops and one acos, cos and sqrt,
+//! but like any method working from the characteristic polynomial it loses
+//! about half the digits of two nearly equal eigenvalues and their vectors.
+//! Jacobi iterates to working precision regardless of spacing.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _SYMMETRICEIGEN_HPP__
+#define _SYMMETRICEIGEN_HPP__
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "Matrix.hpp"
+#include "SquareMatrix.hpp"
+#include "Vector.hpp"
+#include "Vector3.hpp"
+#include "DCM.hpp"
+
+namespace matrix
+{
+
+template<class T>
+class DCM;
+
+namespace detail
+{
+
+//! Diagonalize the symmetric M x M matrix a (row-major, upper triangle read) by
+//! cyclic Jacobi rotations. The eigenvalues are written to d and the
+//! eigenvectors to the columns of v, both sorted by ascending eigenvalue.
+//! a is destroyed. Returns false if maxSweeps sweeps did not converge.
+template<class T, size_t M>
+bool jacobiEigen(T *a, T *v, T *d, size_t maxSweeps)
+{
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < M; ++j)
+        {
+            v[i*M+j] = i == j ? T(1) : T(0);
+        }
+        d[i] = a[i*M+i];
+    }
+
+    const T eps = std::numeric_limits<T>::epsilon();
+    bool converged = false;
+    for(size_t sweep = 0; sweep < maxSweeps; ++sweep)
+    {
+        T offDiagonal = 0;
+        T diagonal = 0;
+        for(size_t p = 0; p < M; ++p)
+        {
+            diagonal += d[p]*d[p];
+            for(size_t q = p + 1; q < M; ++q)
+            {
+                offDiagonal += a[p*M+q]*a[p*M+q];
+            }
+        }
+        if(offDiagonal <= eps*eps*diagonal || offDiagonal == T(0))
+        {
+            converged = true;
+            break;
+        }
+
+        for(size_t p = 0; p < M; ++p)
+        {
+            for(size_t q = p + 1; q < M; ++q)
+            {
+                // An element below the rounding error of the diagonal is already zero
+                const T apq = a[p*M+q];
+                if(std::fabs(apq) <= eps*(std::fabs(d[p]) + std::fabs(d[q]))/2)
+                {
+                    a[p*M+q] = 0;
+                    continue;
+                }
+
+                // Rotation angle that zeroes a_pq, through the smaller root t = tan(angle)
+                const T theta = (d[q] - d[p]) / (2*apq);
+                T t = T(1) / (std::fabs(theta) + std::sqrt(theta*theta + 1));
+                if(theta < 0)
+                {
+                    t = -t;
+                }
+                const T c = T(1) / std::sqrt(t*t + 1);
+                const T s = t*c;
+
+                d[p] -= t*apq;
+                d[q] += t*apq;
+                a[p*M+q] = 0;
+
+                // Only the strict upper triangle is kept up to date
+                for(size_t r = 0; r < p; ++r)
+                {
+                    const T arp = a[r*M+p];
+                    const T arq = a[r*M+q];
+                    a[r*M+p] = c*arp - s*arq;
+                    a[r*M+q] = s*arp + c*arq;
+                }
+                for(size_t r = p + 1; r < q; ++r)
+                {
+                    const T apr = a[p*M+r];
+                    const T arq = a[r*M+q];
+                    a[p*M+r] = c*apr - s*arq;
+                    a[r*M+q] = s*apr + c*arq;
+                }
+                for(size_t r = q + 1; r < M; ++r)
+                {
+                    const T apr = a[p*M+r];
+                    const T aqr = a[q*M+r];
+                    a[p*M+r] = c*apr - s*aqr;
+                    a[q*M+r] = s*apr + c*aqr;
+                }
+                for(size_t r = 0; r < M; ++r)
+                {
+                    const T vrp = v[r*M+p];
+                    const T vrq = v[r*M+q];
+                    v[r*M+p] = c*vrp - s*vrq;
+                    v[r*M+q] = s*vrp + c*vrq;
+                }
+            }
+        }
+    }
+
+    // Selection sort, swapping eigenvector columns along with the eigenvalues
+    for(size_t i = 0; i + 1 < M; ++i)
+    {
+        size_t smallest = i;
+        for(size_t j = i + 1; j < M; ++j)
+        {
+            if(d[j] < d[smallest])
+            {
+                smallest = j;
+            }
+        }
+        if(smallest != i)
+        {
+            std::swap(d[i], d[smallest]);
+            for(size_t r = 0; r < M; ++r)
+            {
+                std::swap(v[r*M+i], v[r*M+smallest]);
+            }
+        }
+    }
+    return converged;
+}
+
+} // namespace detail
+
+template<class T, size_t M>
+class SymmetricEigen
+{
+public:
+    //! Sweep limit; random matrices converge in well under 10
+    static constexpr size_t maxSweeps = 50;
+
+    //! Default constructor (identity eigenvectors, zero eigenvalues)
+    SymmetricEigen();
+
+    //! Decompose A (only the upper triangle is read)
+    explicit SymmetricEigen(const Matrix<T, M, M> &A);
+
+    //! Decompose A, replacing the current decomposition
+    void compute(const Matrix<T, M, M> &A);
+
+    //! False if the rotations had not converged after maxSweeps sweeps
+    inline bool hasConverged() const { return converged; }
+
+    //! Eigenvalues in ascending order
+    inline const Vector<T, M> &eigenvalues() const { return d; }
+
+    //! Orthonormal eigenvectors, column i belonging to eigenvalue i
+    inline const SquareMatrix<T, M> &eigenvectors() const { return V; }
+
+private:
+    SquareMatrix<T, M> V;
+    Vector<T, M> d;
+    bool converged;
+};
+
+template<class T>
+class SymmetricEigen3
+{
+public:
+    //! Default constructor (identity eigenvectors, zero eigenvalues)
+    SymmetricEigen3();
+
+    //! Decompose A in closed form (only the upper triangle is read)
+    explicit SymmetricEigen3(const Matrix<T, 3, 3> &A);
+
+    //! Decompose A in closed form, replacing the current decomposition
+    void compute(const Matrix<T, 3, 3> &A);
+
+    //! Decompose A by cyclic Jacobi rotations, replacing the current decomposition
+    void computeJacobi(const Matrix<T, 3, 3> &A);
+
+    //! Eigenvalues in ascending order
+    inline const Vector3<T> &eigenvalues() const { return d; }
+
+    //! Eigenvectors as a proper rotation from the principal axes to the frame
+    //! of A, column i belonging to eigenvalue i
+    inline const DCM<T> &eigenvectors() const { return V; }
+
+private:
+    //! Unit vector spanning the null space of the rank-2 matrix with rows r0, r1, r2.
+    //! Falls back to an arbitrary unit vector if the rank is lower.
+    static void nullVector(const T r0[3], const T r1[3], const T r2[3], T out[3]);
+
+    //! Unit vector orthogonal to w spanning the null space of S restricted to the
+    //! plane orthogonal to w
+    static void nullVectorInPlane(const T S[9], const T w[3], T out[3]);
+
+    DCM<T> V;
+    Vector3<T> d;
+};
+
+//! Default constructor (identity eigenvectors, zero eigenvalues)
+template<class T, size_t M>
+SymmetricEigen<T,M>::SymmetricEigen():
+    converged(true)
+{
+    V.identity();
+}
+
+//! Decompose A (only the upper triangle is read)
+template<class T, size_t M>
+SymmetricEigen<T,M>::SymmetricEigen(const Matrix<T, M, M> &A)
+{
+    compute(A);
+}
+
+//! Decompose A, replacing the current decomposition
+template<class T, size_t M>
+void SymmetricEigen<T,M>::compute(const Matrix<T, M, M> &A)
+{
+    SquareMatrix<T, M> a = A;
+    converged = detail::jacobiEigen<T, M>(&a(0,0), &V(0,0), &d(0), maxSweeps);
+}
+
+//! Default constructor (identity eigenvectors, zero eigenvalues)
+template<class T>
+SymmetricEigen3<T>::SymmetricEigen3()
+{
+}
+
+//! Decompose A in closed form (only the upper triangle is read)
+template<class T>
+SymmetricEigen3<T>::SymmetricEigen3(const Matrix<T, 3, 3> &A)
+{
+    compute(A);
+}
+
+//! Decompose A in closed form, replacing the current decomposition
+template<class T>
+void SymmetricEigen3<T>::compute(const Matrix<T, 3, 3> &A)
+{
+    const T a00 = A(0,0), a01 = A(0,1), a02 = A(0,2);
+    const T a11 = A(1,1), a12 = A(1,2), a22 = A(2,2);
+
+    // Scale to unit largest element so the squares below cannot overflow
+    T scale = std::fabs(a00);
+    scale = std::max(scale, std::fabs(a01));
+    scale = std::max(scale, std::fabs(a02));
+    scale = std::max(scale, std::fabs(a11));
+    scale = std::max(scale, std::fabs(a12));
+    scale = std::max(scale, std::fabs(a22));
+
+    // Shift by the mean eigenvalue q and normalize B = (A - q I) / p
+    T S[9] = {0};
+    T q = 0;
+    T p = 0;
+    if(scale > 0)
+    {
+        S[0] = a00/scale; S[1] = a01/scale; S[2] = a02/scale;
+        S[4] = a11/scale; S[5] = a12/scale; S[8] = a22/scale;
+        q = (S[0] + S[4] + S[8]) / 3;
+        S[0] -= q;
+        S[4] -= q;
+        S[8] -= q;
+        p = std::sqrt((S[0]*S[0] + S[4]*S[4] + S[8]*S[8] + 2*(S[1]*S[1] + S[2]*S[2] + S[5]*S[5])) / 6);
+    }
+    if(p == 0)
+    {
+        // A is a multiple of the identity, any basis will do
+        V.identity();
+        d(0) = d(1) = d(2) = q*scale;
+        return;
+    }
+    S[3] = S[1];
+    S[6] = S[2];
+    S[7] = S[5];
+
+    // The eigenvalues of B are 2 cos(phi + 2 pi k / 3) with cos(3 phi) = det(B) / 2
+    const T b00 = S[0]/p, b01 = S[1]/p, b02 = S[2]/p, b11 = S[4]/p, b12 = S[5]/p, b22 = S[8]/p;
+    T halfDet = (b00*(b11*b22 - b12*b12) - b01*(b01*b22 - b12*b02) + b02*(b01*b12 - b11*b02)) / 2;
+    halfDet = std::min(std::max(halfDet, T(-1)), T(1));
+    const T phi = std::acos(halfDet) / 3;
+    const T twoThirdsPi = T(2.09439510239319549230842892218633526);
+    const T beta2 = 2*std::cos(phi);
+    const T beta0 = 2*std::cos(phi + twoThirdsPi);
+    const T beta1 = -(beta0 + beta2);
+    const T lambda[3] = {p*beta0, p*beta1, p*beta2};
+
+    // Solve for the eigenvector of the eigenvalue furthest from the other two
+    // first; it is the best conditioned. The second comes from the plane
+    // orthogonal to it and the third completes a right-handed basis.
+    const size_t first = halfDet >= 0 ? 2 : 0;
+    T r[9];
+    for(size_t k = 0; k < 9; ++k)
+    {
+        r[k] = S[k];
+    }
+    r[0] -= lambda[first];
+    r[4] -= lambda[first];
+    r[8] -= lambda[first];
+    T v0[3];
+    nullVector(r, r + 3, r + 6, v0);
+
+    for(size_t k = 0; k < 9; ++k)
+    {
+        r[k] = S[k];
+    }
+    r[0] -= lambda[1];
+    r[4] -= lambda[1];
+    r[8] -= lambda[1];
+    T v1[3];
+    nullVectorInPlane(r, v0, v1);
+
+    for(size_t i = 0; i < 3; ++i)
+    {
+        d(i) = (lambda[i] + q)*scale;
+    }
+
+    // Columns (v0, v1, v0 x v1) when the first is the smallest eigenvalue,
+    // (v1 x v0, v1, v0) when it is the largest; both have determinant +1
+    T v2[3] = {v0[1]*v1[2] - v0[2]*v1[1], v0[2]*v1[0] - v0[0]*v1[2], v0[0]*v1[1] - v0[1]*v1[0]};
+    for(size_t i = 0; i < 3; ++i)
+    {
+        V(i,1) = v1[i];
+        if(first == 0)
+        {
+            V(i,0) = v0[i];
+            V(i,2) = v2[i];
+        }
+        else
+        {
+            V(i,0) = -v2[i];
+            V(i,2) = v0[i];
+        }
+    }
+}
+
+//! Decompose A by cyclic Jacobi rotations, replacing the current decomposition
+template<class T>
+void SymmetricEigen3<T>::computeJacobi(const Matrix<T, 3, 3> &A)
+{
+    SquareMatrix<T, 3> a = A;
+    detail::jacobiEigen<T, 3>(&a(0,0), &V(0,0), &d(0), SymmetricEigen<T, 3>::maxSweeps);
+
+    // Sorting may have left a reflection; flipping one eigenvector makes it a rotation
+    const T det = V(0,0)*(V(1,1)*V(2,2) - V(1,2)*V(2,1))
+                - V(0,1)*(V(1,0)*V(2,2) - V(1,2)*V(2,0))
+                + V(0,2)*(V(1,0)*V(2,1) - V(1,1)*V(2,0));
+    if(det < 0)
+    {
+        for(size_t i = 0; i < 3; ++i)
+        {
+            V(i,2) = -V(i,2);
+        }
+    }
+}
+
+//! Unit vector spanning the null space of the rank-2 matrix with rows r0, r1, r2.
+//! Falls back to an arbitrary unit vector if the rank is lower.
+template<class T>
+void SymmetricEigen3<T>::nullVector(const T r0[3], const T r1[3], const T r2[3], T out[3])
+{
+    // Any two independent rows are orthogonal to the null vector; take the
+    // cross product with the largest magnitude
+    const T c01[3] = {r0[1]*r1[2] - r0[2]*r1[1], r0[2]*r1[0] - r0[0]*r1[2], r0[0]*r1[1] - r0[1]*r1[0]};
+    const T c02[3] = {r0[1]*r2[2] - r0[2]*r2[1], r0[2]*r2[0] - r0[0]*r2[2], r0[0]*r2[1] - r0[1]*r2[0]};
+    const T c12[3] = {r1[1]*r2[2] - r1[2]*r2[1], r1[2]*r2[0] - r1[0]*r2[2], r1[0]*r2[1] - r1[1]*r2[0]};
+    const T n01 = c01[0]*c01[0] + c01[1]*c01[1] + c01[2]*c01[2];
+    const T n02 = c02[0]*c02[0] + c02[1]*c02[1] + c02[2]*c02[2];
+    const T n12 = c12[0]*c12[0] + c12[1]*c12[1] + c12[2]*c12[2];
+
+    const T *best = c01;
+    T largest = n01;
+    if(n02 > largest)
+    {
+        best = c02;
+        largest = n02;
+    }
+    if(n12 > largest)
+    {
+        best = c12;
+        largest = n12;
+    }
+    if(largest == 0)
+    {
+        out[0] = 1;
+        out[1] = 0;
+        out[2] = 0;
+        return;
+    }
+    const T inv = 1 / std::sqrt(largest);
+    for(size_t i = 0; i < 3; ++i)
+    {
+        out[i] = best[i]*inv;
+    }
+}
+
+//! Unit vector orthogonal to w spanning the null space of S restricted to the
+//! plane orthogonal to w
+template<class T>
+void SymmetricEigen3<T>::nullVectorInPlane(const T S[9], const T w[3], T out[3])
+{
+    // Orthonormal basis u, v of the plane, starting from the axis least aligned with w
+    T u[3];
+    if(std::fabs(w[0]) > std::fabs(w[1]))
+    {
+        const T inv = 1 / std::sqrt(w[0]*w[0] + w[2]*w[2]);
+        u[0] = -w[2]*inv;
+        u[1] = 0;
+        u[2] = w[0]*inv;
+    }
+    else
+    {
+        const T inv = 1 / std::sqrt(w[1]*w[1] + w[2]*w[2]);
+        u[0] = 0;
+        u[1] = w[2]*inv;
+        u[2] = -w[1]*inv;
+    }
+    const T v[3] = {w[1]*u[2] - w[2]*u[1], w[2]*u[0] - w[0]*u[2], w[0]*u[1] - w[1]*u[0]};
+
+    // 2x2 projection [m00 m01; m01 m11] of S onto the plane; its null vector (x, y)
+    // gives out = x u + y v
+    T Su[3];
+    T Sv[3];
+    for(size_t i = 0; i < 3; ++i)
+    {
+        Su[i] = S[i*3]*u[0] + S[i*3+1]*u[1] + S[i*3+2]*u[2];
+        Sv[i] = S[i*3]*v[0] + S[i*3+1]*v[1] + S[i*3+2]*v[2];
+    }
+    T m00 = u[0]*Su[0] + u[1]*Su[1] + u[2]*Su[2];
+    T m01 = u[0]*Sv[0] + u[1]*Sv[1] + u[2]*Sv[2];
+    T m11 = v[0]*Sv[0] + v[1]*Sv[1] + v[2]*Sv[2];
+
+    // Use the row with the larger entry; a zero projection means the whole
+    // plane is an eigenspace and u will do
+    T x = 1;
+    T y = 0;
+    const T abs00 = std::fabs(m00);
+    const T abs01 = std::fabs(m01);
+    const T abs11 = std::fabs(m11);
+    if(abs00 >= abs11)
+    {
+        const T largest = std::max(abs00, abs01);
+        if(largest > 0)
+        {
+            if(abs00 >= abs01)
+            {
+                m01 /= m00;
+                x = -m01;
+                y = 1;
+            }
+            else
+            {
+                m00 /= m01;
+                x = 1;
+                y = -m00;
+            }
+        }
+    }
+    else
+    {
+        const T largest = std::max(abs11, abs01);
+        if(largest > 0)
+        {
+            if(abs11 >= abs01)
+            {
+                m01 /= m11;
+                x = 1;
+                y = -m01;
+            }
+            else
+            {
+                m11 /= m01;
+                x = -m11;
+                y = 1;
+            }
+        }
+    }
+    const T inv = 1 / std::sqrt(x*x + y*y);
+    for(size_t i = 0; i < 3; ++i)
+    {
+        out[i] = (x*u[i] + y*v[i])*inv;
+    }
+}
+
+} // namespace matrix
+
+#endif // _SYMMETRICEIGEN_HPP__
@@ -0,0 +1,327 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file SymmetricMatrix.hpp
+//!
+//! Symmetric matrix in packed storage: only the M(M+1)/2 elements on and
+//! above the diagonal are kept, row after row (the UpperTriangular layout).
+//! Element (i,j) and element (j,i) are the same stored value, so the matrix
+//! is symmetric by construction and never needs re-symmetrizing.
+//!
+//! The covariance kernels compute only the unique half of their result:
+//!
+//!   congruence(F, P)   F P F^T, e.g. the covariance propagation F P F^T + Q
+//!   P.rankUpdate(A, a) P + a A A^T (SYRK), e.g. P - K S K^T with a = -1
+//!
+//! The half products run on 2x2 register tiles of row-against-row sums. A
+//! rank update does half the work of the dense A A^T. A congruence still
+//! needs all of F P, so it does three quarters of the dense F P F^T.
+//! Convert from and to SquareMatrix at the boundary; the conversions are
+//! a single pass over the elements.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _SYMMETRIC_MATRIX_HPP__
+#define _SYMMETRIC_MATRIX_HPP__
+
+#include <type_traits>
+
+#include "BoundsPolicy.hpp"
+#include "Matrix.hpp"
+#include "SquareMatrix.hpp"
+#include "TriangularMatrix.hpp"
+#include "Vector.hpp"
+
+namespace matrix
+{
+
+namespace detail
+{
+
+//! Add alpha G F^T to the packed upper triangle c of an N x N matrix, where
+//! G and F are N x K and row-major; elements below the diagonal are skipped
+template<class T>
+void addUpperProduct(const T *g, const T *f, size_t N, size_t K, T alpha, T *c)
+{
+    for(size_t i = 0; i < N; i += 2)
+    {
+        const bool twoRows = i + 1 < N;
+        const T *g0 = g + i*K;
+        const T *g1 = twoRows ? g0 + K : g0;
+        for(size_t j = i; j < N; j += 2)
+        {
+            const bool twoCols = j + 1 < N;
+            const T *f0 = f + j*K;
+            const T *f1 = twoCols ? f0 + K : f0;
+
+            // Four independent sums share each load of the two rows
+            T s00 = 0;
+            T s01 = 0;
+            T s10 = 0;
+            T s11 = 0;
+            for(size_t k = 0; k < K; ++k)
+            {
+                const T a0 = g0[k];
+                const T a1 = g1[k];
+                const T b0 = f0[k];
+                const T b1 = f1[k];
+                s00 += a0*b0;
+                s01 += a0*b1;
+                s10 += a1*b0;
+                s11 += a1*b1;
+            }
+
+            c[UpperTriangle::index(i, j, N)] += alpha*s00;
+            if(twoCols)
+            {
+                c[UpperTriangle::index(i, j + 1, N)] += alpha*s01;
+            }
+            if(twoRows && j > i)
+            {
+                c[UpperTriangle::index(i + 1, j, N)] += alpha*s10;
+            }
+            if(twoRows && twoCols)
+            {
+                c[UpperTriangle::index(i + 1, j + 1, N)] += alpha*s11;
+            }
+        }
+    }
+}
+
+} // namespace detail
+
+template<class T, size_t M>
+class SymmetricMatrix
+{
+public:
+    //! Number of stored elements
+    static constexpr size_t size = M*(M+1)/2;
+
+    //! Default constructor (zero matrix)
+    constexpr SymmetricMatrix();
+
+    //! Construct from the upper triangle of a square matrix (the lower half is not read)
+    explicit constexpr SymmetricMatrix(const Matrix<T, M, M> &other);
+
+    //! Copy into a square matrix, both halves filled
+    constexpr SquareMatrix<T, M> toSquareMatrix() const;
+
+    //! Element access operator ((i,j) and (j,i) are the same element)
+    constexpr const T &operator()(size_t i, size_t j) const;
+
+    //! Element assignment operator (assigns (i,j) and (j,i) together)
+    constexpr T &operator()(size_t i, size_t j);
+
+    //! Pointer to the packed upper triangle, row after row
+    constexpr const T *data() const { return values; }
+
+    //! Pointer to the packed upper triangle, row after row
+    constexpr T *data() { return values; }
+
+    //! Set to the identity matrix
+    constexpr void identity();
+
+    //! Matrix addition
+    constexpr SymmetricMatrix operator+(const SymmetricMatrix &other) const;
+
+    //! Matrix subtraction
+    constexpr SymmetricMatrix operator-(const SymmetricMatrix &other) const;
+
+    //! Scalar multiplication
+    constexpr SymmetricMatrix operator*(T value) const;
+
+    //! Compound matrix addition
+    constexpr void operator+=(const SymmetricMatrix &other);
+
+    //! Compound matrix subtraction
+    constexpr void operator-=(const SymmetricMatrix &other);
+
+    //! Product with a dense matrix
+    template<size_t P>
+    Matrix<T, M, P> operator*(const Matrix<T, M, P> &B) const;
+
+    //! Product with a vector
+    Vector<T, M> operator*(const Vector<T, M> &v) const;
+
+    //! Add alpha A A^T (a symmetric rank-K update), computing only the upper half
+    template<size_t K>
+    void rankUpdate(const Matrix<T, M, K> &A, T alpha = T(1));
+
+private:
+    T values[size];
+};
+
+static_assert(sizeof(SymmetricMatrix<double, 6>) == 21*sizeof(double), "SymmetricMatrix must hold only its upper triangle");
+static_assert(std::is_trivially_copyable<SymmetricMatrix<double, 6>>::value, "SymmetricMatrix must be trivially copyable");
+
+//! Congruence transform F P F^T, computing only the upper half of the result
+template<class T, size_t N, size_t M>
+SymmetricMatrix<T, N> congruence(const Matrix<T, N, M> &F, const SymmetricMatrix<T, M> &P)
+{
+    // F P through the dense kernels, then the half product (F P) F^T
+    const Matrix<T, N, M> FP = F*P.toSquareMatrix();
+    SymmetricMatrix<T, N> result;
+    detail::addUpperProduct(&FP(0,0), &F(0,0), N, M, T(1), result.data());
+    return result;
+}
+
+//! Default constructor (zero matrix)
+template<class T, size_t M>
+constexpr SymmetricMatrix<T,M>::SymmetricMatrix():
+    values{}
+{
+}
+
+//! Construct from the upper triangle of a square matrix (the lower half is not read)
+template<class T, size_t M>
+constexpr SymmetricMatrix<T,M>::SymmetricMatrix(const Matrix<T, M, M> &other):
+    values{}
+{
+    const T *o = &other(0,0);
+    T *packed = values;
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = i; j < M; ++j)
+        {
+            *packed++ = o[i*M+j];
+        }
+    }
+}
+
+//! Copy into a square matrix, both halves filled
+template<class T, size_t M>
+constexpr SquareMatrix<T, M> SymmetricMatrix<T,M>::toSquareMatrix() const
+{
+    SquareMatrix<T, M> result;
+    T *r = &result(0,0);
+    const T *packed = values;
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = i; j < M; ++j)
+        {
+            r[i*M+j] = r[j*M+i] = *packed++;
+        }
+    }
+    return result;
+}
+
+//! Element access operator ((i,j) and (j,i) are the same element)
+template<class T, size_t M>
+constexpr const T &SymmetricMatrix<T,M>::operator()(size_t i, size_t j) const
+{
+    DefaultBounds::check(i, j, M, M);
+    return i <= j ? values[UpperTriangle::index(i, j, M)] : values[UpperTriangle::index(j, i, M)];
+}
+
+//! Element assignment operator (assigns (i,j) and (j,i) together)
+template<class T, size_t M>
+constexpr T &SymmetricMatrix<T,M>::operator()(size_t i, size_t j)
+{
+    DefaultBounds::check(i, j, M, M);
+    return i <= j ? values[UpperTriangle::index(i, j, M)] : values[UpperTriangle::index(j, i, M)];
+}
+
+//! Set to the identity matrix
+template<class T, size_t M>
+constexpr void SymmetricMatrix<T,M>::identity()
+{
+    for(size_t e = 0; e < size; ++e)
+    {
+        values[e] = T(0);
+    }
+    for(size_t i = 0; i < M; ++i)
+    {
+        values[UpperTriangle::index(i, i, M)] = T(1);
+    }
+}
+
+//! Matrix addition
+template<class T, size_t M>
+constexpr SymmetricMatrix<T, M> SymmetricMatrix<T,M>::operator+(const SymmetricMatrix &other) const
+{
+    SymmetricMatrix result(*this);
+    result += other;
+    return result;
+}
+
+//! Matrix subtraction
+template<class T, size_t M>
+constexpr SymmetricMatrix<T, M> SymmetricMatrix<T,M>::operator-(const SymmetricMatrix &other) const
+{
+    SymmetricMatrix result(*this);
+    result -= other;
+    return result;
+}
+
+//! Scalar multiplication
+template<class T, size_t M>
+constexpr SymmetricMatrix<T, M> SymmetricMatrix<T,M>::operator*(T value) const
+{
+    SymmetricMatrix result;
+    for(size_t e = 0; e < size; ++e)
+    {
+        result.values[e] = values[e]*value;
+    }
+    return result;
+}
+
+//! Compound matrix addition
+template<class T, size_t M>
+constexpr void SymmetricMatrix<T,M>::operator+=(const SymmetricMatrix &other)
+{
+    for(size_t e = 0; e < size; ++e)
+    {
+        values[e] += other.values[e];
+    }
+}
+
+//! Compound matrix subtraction
+template<class T, size_t M>
+constexpr void SymmetricMatrix<T,M>::operator-=(const SymmetricMatrix &other)
+{
+    for(size_t e = 0; e < size; ++e)
+    {
+        values[e] -= other.values[e];
+    }
+}
+
+//! Product with a dense matrix
+template<class T, size_t M>
+template<size_t P>
+Matrix<T, M, P> SymmetricMatrix<T,M>::operator*(const Matrix<T, M, P> &B) const
+{
+    // Every element of the product needs a full row, so expand and use the dense kernels
+    return toSquareMatrix()*B;
+}
+
+//! Product with a vector
+template<class T, size_t M>
+Vector<T, M> SymmetricMatrix<T,M>::operator*(const Vector<T, M> &v) const
+{
+    // Each stored element (i,j), i < j, contributes to both y(i) and y(j)
+    Vector<T, M> result;
+    const T *packed = values;
+    for(size_t i = 0; i < M; ++i)
+    {
+        T sum = *packed++ * v(i);
+        for(size_t j = i + 1; j < M; ++j)
+        {
+            const T a = *packed++;
+            sum += a*v(j);
+            result(j) += a*v(i);
+        }
+        result(i) += sum;
+    }
+    return result;
+}
+
+//! Add alpha A A^T (a symmetric rank-K update), computing only the upper half
+template<class T, size_t M>
+template<size_t K>
+void SymmetricMatrix<T,M>::rankUpdate(const Matrix<T, M, K> &A, T alpha)
+{
+    detail::addUpperProduct(&A(0,0), &A(0,0), M, K, alpha, values);
+}
+
+} // namespace matrix
+
+#endif // _SYMMETRIC_MATRIX_HPP__
@@ -0,0 +1,199 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file ThreadPool.hpp
+//!
+//! Fixed-size pool of worker threads for splitting one large operation into
+//! independent pieces (e.g. the row panels of a large matrix product). The
+//! calling thread works alongside the pool and parallelFor returns only once
+//! every piece is done. If a piece throws, the pieces not yet started are
+//! skipped and the first exception is rethrown on the calling thread after
+//! every thread has stopped working on the job.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _THREAD_POOL_HPP__
+#define _THREAD_POOL_HPP__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace matrix
+{
+
+class ThreadPool
+{
+public:
+    //! Construct a pool of threads workers (0 runs everything on the calling thread)
+    explicit ThreadPool(size_t threads);
+
+    //! Stop and join every worker
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    //! Number of threads that run a parallelFor, including the caller
+    inline size_t concurrency() const { return workers.size() + 1; }
+
+    //! Call fn(i) for every i in [0, count) and wait for all of them (must not be called from fn).
+    //! Rethrows the first exception thrown by fn, after skipping the remaining indices.
+    void parallelFor(size_t count, const std::function<void(size_t)> &fn);
+
+private:
+    //! Take indices from the current job until none are left, keeping the first exception
+    void runJob();
+
+    //! Worker thread loop
+    void workerLoop();
+
+    std::vector<std::thread> workers;
+    std::mutex callMutex;
+    std::mutex mutex;
+    std::condition_variable startCondition;
+    std::condition_variable doneCondition;
+    const std::function<void(size_t)> *job;
+    size_t jobCount;
+    std::atomic<size_t> nextIndex;
+    size_t busy;
+    size_t generation;
+    bool stopping;
+    std::exception_ptr error;
+};
+
+//! Pool shared by the library, sized to the hardware (created on first use)
+inline ThreadPool &defaultThreadPool()
+{
+    static ThreadPool pool(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0);
+    return pool;
+}
+
+//! Construct a pool of threads workers (0 runs everything on the calling thread)
+inline ThreadPool::ThreadPool(size_t threads):
+    job(nullptr),
+    jobCount(0),
+    nextIndex(0),
+    busy(0),
+    generation(0),
+    stopping(false)
+{
+    workers.reserve(threads);
+    for(size_t t = 0; t < threads; ++t)
+    {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+//! Stop and join every worker
+inline ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    startCondition.notify_all();
+    for(std::thread &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+//! Call fn(i) for every i in [0, count) and wait for all of them (must not be called from fn).
+//! Rethrows the first exception thrown by fn, after skipping the remaining indices.
+inline void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)> &fn)
+{
+    if(workers.empty() || count < 2)
+    {
+        for(size_t i = 0; i < count; ++i)
+        {
+            fn(i);
+        }
+        return;
+    }
+
+    // One job at a time; concurrent callers queue up here
+    std::lock_guard<std::mutex> call(callMutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        jobCount = count;
+        nextIndex = 0;
+        busy = workers.size();
+        ++generation;
+    }
+    startCondition.notify_all();
+
+    runJob();
+
+    // Workers may still be running fn even if the caller's share threw
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [this]() { return busy == 0; });
+    job = nullptr;
+    if(error)
+    {
+        std::exception_ptr thrown = error;
+        error = nullptr;
+        lock.unlock();
+        std::rethrow_exception(thrown);
+    }
+}
+
+//! Take indices from the current job until none are left, keeping the first exception
+inline void ThreadPool::runJob()
+{
+    try
+    {
+        for(size_t i = nextIndex++; i < jobCount; i = nextIndex++)
+        {
+            (*job)(i);
+        }
+    }
+    catch(...)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!error)
+        {
+            error = std::current_exception();
+        }
+        nextIndex = jobCount;
+    }
+}
+
+//! Worker thread loop
+inline void ThreadPool::workerLoop()
+{
+    size_t seen = 0;
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            startCondition.wait(lock, [this, seen]() { return stopping || generation != seen; });
+            if(stopping)
+            {
+                return;
+            }
+            seen = generation;
+        }
+
+        runJob();
+
+        bool last;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            last = --busy == 0;
+        }
+        if(last)
+        {
+            doneCondition.notify_one();
+        }
+    }
+}
+
+} // namespace matrix
+
+#endif // _THREAD_POOL_HPP__
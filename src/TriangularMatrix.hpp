@@ -0,0 +1,448 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TriangularMatrix.hpp
+//!
+//! Square triangular matrices in packed storage: only the M(M+1)/2 elements
+//! of the triangle are kept, row after row, so a triangular factor takes
+//! about half the memory of a SquareMatrix.
+//!
+//!   LowerTriangular<T, M>  nonzeros on and below the diagonal
+//!   UpperTriangular<T, M>  nonzeros on and above the diagonal
+//!
+//! Products with dense matrices (on either side) and solves by forward or
+//! back substitution only visit the stored triangle, about half the work of
+//! the dense operations. Convert from and to SquareMatrix at the boundary;
+//! results match the dense operations up to rounding.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _TRIANGULAR_MATRIX_HPP__
+#define _TRIANGULAR_MATRIX_HPP__
+
+#include <cstdio>
+#include <stdexcept>
+#include <type_traits>
+
+#include "BoundsPolicy.hpp"
+#include "Matrix.hpp"
+#include "SquareMatrix.hpp"
+#include "Vector.hpp"
+
+namespace matrix
+{
+
+struct UpperTriangle;
+
+//! Elements on and below the diagonal; row i holds columns 0 to i
+struct LowerTriangle
+{
+    using Transposed = UpperTriangle;
+    static constexpr bool contains(size_t i, size_t j) { return j <= i; }
+    static constexpr size_t rowBegin(size_t, size_t) { return 0; }
+    static constexpr size_t rowEnd(size_t i, size_t) { return i + 1; }
+    static constexpr size_t index(size_t i, size_t j, size_t) { return i*(i+1)/2 + j; }
+};
+
+//! Elements on and above the diagonal; row i holds columns i to M-1
+struct UpperTriangle
+{
+    using Transposed = LowerTriangle;
+    static constexpr bool contains(size_t i, size_t j) { return j >= i; }
+    static constexpr size_t rowBegin(size_t i, size_t) { return i; }
+    static constexpr size_t rowEnd(size_t, size_t M) { return M; }
+    static constexpr size_t index(size_t i, size_t j, size_t M) { return i*(2*M - i - 1)/2 + j; }
+};
+
+namespace detail
+{
+
+//! Report a write outside the stored triangle
+[[noreturn]] inline void throwOutsideTriangle(size_t i, size_t j)
+{
+    char message[100];
+    snprintf(message, 100, "ERROR: Element [%ld, %ld] is outside the stored triangle.\n", i, j);
+    throw std::domain_error(message);
+}
+
+//! Report a triangular matrix with a zero on its diagonal
+[[noreturn]] inline void throwSingularTriangle(size_t i)
+{
+    char message[100];
+    snprintf(message, 100, "ERROR: Triangular matrix is singular, diagonal element %ld is zero. Cannot solve.\n", i);
+    throw std::runtime_error(message);
+}
+
+} // namespace detail
+
+template<class T, size_t M, class Triangle>
+class TriangularMatrix
+{
+public:
+    //! Number of stored elements
+    static constexpr size_t size = M*(M+1)/2;
+
+    //! Default constructor (zero matrix)
+    constexpr TriangularMatrix();
+
+    //! Construct from the triangle of a square matrix (the other half is not read)
+    explicit constexpr TriangularMatrix(const Matrix<T, M, M> &other);
+
+    //! Copy into a square matrix, zeros outside the triangle
+    constexpr SquareMatrix<T, M> toSquareMatrix() const;
+
+    //! Element access operator (zero outside the triangle)
+    constexpr T operator()(size_t i, size_t j) const;
+
+    //! Stored element for assignment; throws std::domain_error outside the
+    //! triangle (reads through operator() never throw for a valid index)
+    constexpr T &element(size_t i, size_t j);
+
+    //! Pointer to the packed elements, row after row
+    constexpr const T *data() const { return values; }
+
+    //! Pointer to the packed elements, row after row
+    constexpr T *data() { return values; }
+
+    //! Set to the identity matrix
+    constexpr void identity();
+
+    //! Matrix transpose (lower becomes upper and upper becomes lower)
+    constexpr TriangularMatrix<T, M, typename Triangle::Transposed> transpose() const;
+
+    //! Product with a dense matrix, skipping the zero triangle
+    template<size_t P>
+    Matrix<T, M, P> operator*(const Matrix<T, M, P> &B) const;
+
+    //! Product with a vector, skipping the zero triangle
+    Vector<T, M> operator*(const Vector<T, M> &v) const;
+
+    //! Solve this x = b by forward (lower) or back (upper) substitution
+    Vector<T, M> solve(const Matrix<T, M, 1> &b) const;
+
+    //! Solve this X = B for every column of B
+    template<size_t P>
+    Matrix<T, M, P> solve(const Matrix<T, M, P> &B) const;
+
+    //! Product of the diagonal
+    T determinant() const;
+
+private:
+    //! Overwrite the rows of X (P columns) with the solution of this X = X
+    void substitute(T *x, size_t P) const;
+
+    T values[size];
+};
+
+//! Lower triangular matrix in packed storage
+template<class T, size_t M>
+using LowerTriangular = TriangularMatrix<T, M, LowerTriangle>;
+
+//! Upper triangular matrix in packed storage
+template<class T, size_t M>
+using UpperTriangular = TriangularMatrix<T, M, UpperTriangle>;
+
+static_assert(sizeof(LowerTriangular<double, 6>) == 21*sizeof(double), "LowerTriangular must hold only its triangle");
+static_assert(std::is_trivially_copyable<UpperTriangular<double, 6>>::value, "UpperTriangular must be trivially copyable");
+
+//! Default constructor (zero matrix)
+template<class T, size_t M, class Triangle>
+constexpr TriangularMatrix<T,M,Triangle>::TriangularMatrix():
+    values{}
+{
+}
+
+//! Construct from the triangle of a square matrix (the other half is not read)
+template<class T, size_t M, class Triangle>
+constexpr TriangularMatrix<T,M,Triangle>::TriangularMatrix(const Matrix<T, M, M> &other):
+    values{}
+{
+    T *packed = values;
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = Triangle::rowBegin(i, M); j < Triangle::rowEnd(i, M); ++j)
+        {
+            *packed++ = other(i,j);
+        }
+    }
+}
+
+//! Copy into a square matrix, zeros outside the triangle
+template<class T, size_t M, class Triangle>
+constexpr SquareMatrix<T, M> TriangularMatrix<T,M,Triangle>::toSquareMatrix() const
+{
+    SquareMatrix<T, M> result;
+    const T *packed = values;
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = Triangle::rowBegin(i, M); j < Triangle::rowEnd(i, M); ++j)
+        {
+            result(i,j) = *packed++;
+        }
+    }
+    return result;
+}
+
+//! Element access operator (zero outside the triangle)
+template<class T, size_t M, class Triangle>
+constexpr T TriangularMatrix<T,M,Triangle>::operator()(size_t i, size_t j) const
+{
+    DefaultBounds::check(i, j, M, M);
+    return Triangle::contains(i, j) ? values[Triangle::index(i, j, M)] : T(0);
+}
+
+//! Stored element for assignment; throws std::domain_error outside the
+//! triangle (reads through operator() never throw for a valid index)
+template<class T, size_t M, class Triangle>
+constexpr T &TriangularMatrix<T,M,Triangle>::element(size_t i, size_t j)
+{
+    DefaultBounds::check(i, j, M, M);
+    if(!Triangle::contains(i, j))
+    {
+        detail::throwOutsideTriangle(i, j);
+    }
+    return values[Triangle::index(i, j, M)];
+}
+
+//! Set to the identity matrix
+template<class T, size_t M, class Triangle>
+constexpr void TriangularMatrix<T,M,Triangle>::identity()
+{
+    for(size_t e = 0; e < size; ++e)
+    {
+        values[e] = T(0);
+    }
+    for(size_t i = 0; i < M; ++i)
+    {
+        values[Triangle::index(i, i, M)] = T(1);
+    }
+}
+
+//! Matrix transpose (lower becomes upper and upper becomes lower)
+template<class T, size_t M, class Triangle>
+constexpr TriangularMatrix<T, M, typename Triangle::Transposed> TriangularMatrix<T,M,Triangle>::transpose() const
+{
+    using Transposed = typename Triangle::Transposed;
+    TriangularMatrix<T, M, Transposed> result;
+    T *out = result.data();
+    const T *packed = values;
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = Triangle::rowBegin(i, M); j < Triangle::rowEnd(i, M); ++j)
+        {
+            out[Transposed::index(j, i, M)] = *packed++;
+        }
+    }
+    return result;
+}
+
+//! Product with a dense matrix, skipping the zero triangle
+template<class T, size_t M, class Triangle>
+template<size_t P>
+Matrix<T, M, P> TriangularMatrix<T,M,Triangle>::operator*(const Matrix<T, M, P> &B) const
+{
+    // Row i of the result is a combination of the rows of B that row i of
+    // the triangle reaches. Rows are taken in pairs, which reach the same
+    // rows of B but one, so each row of B is loaded once per pair.
+    constexpr bool lower = std::is_same<Triangle, LowerTriangle>::value;
+    Matrix<T, M, P> C;
+    const T *b = &B(0,0);
+    T *c = &C(0,0);
+    size_t i = 0;
+    for(; i + 1 < M; i += 2)
+    {
+        T *c0 = c + i*P;
+        T *c1 = c0 + P;
+        const T *a0 = values + Triangle::index(i, 0, M);
+        const T *a1 = values + Triangle::index(i + 1, 0, M);
+        const size_t begin = Triangle::rowBegin(i + 1, M);
+        const size_t end = Triangle::rowEnd(i, M);
+        for(size_t k = begin; k < end; ++k)
+        {
+            const T x0 = a0[k];
+            const T x1 = a1[k];
+            const T *bk = b + k*P;
+            for(size_t j = 0; j < P; ++j)
+            {
+                c0[j] += x0*bk[j];
+                c1[j] += x1*bk[j];
+            }
+        }
+
+        // The one row of B that only row i+1 (lower) or row i (upper) reaches
+        const size_t k = lower ? i + 1 : i;
+        T *ck = lower ? c1 : c0;
+        const T x = lower ? a1[i + 1] : a0[i];
+        const T *bk = b + k*P;
+        for(size_t j = 0; j < P; ++j)
+        {
+            ck[j] += x*bk[j];
+        }
+    }
+    if(i < M)
+    {
+        T *ci = c + i*P;
+        const T *ai = values + Triangle::index(i, 0, M);
+        for(size_t k = Triangle::rowBegin(i, M); k < Triangle::rowEnd(i, M); ++k)
+        {
+            const T x = ai[k];
+            const T *bk = b + k*P;
+            for(size_t j = 0; j < P; ++j)
+            {
+                ci[j] += x*bk[j];
+            }
+        }
+    }
+    return C;
+}
+
+//! Product with a vector, skipping the zero triangle
+template<class T, size_t M, class Triangle>
+Vector<T, M> TriangularMatrix<T,M,Triangle>::operator*(const Vector<T, M> &v) const
+{
+    Vector<T, M> result;
+    const T *packed = values;
+    for(size_t i = 0; i < M; ++i)
+    {
+        T sum = 0;
+        for(size_t k = Triangle::rowBegin(i, M); k < Triangle::rowEnd(i, M); ++k)
+        {
+            sum += *packed++ * v(k);
+        }
+        result(i) = sum;
+    }
+    return result;
+}
+
+//! Product of a dense matrix with a triangular one, skipping the zero triangle
+template<class T, size_t P, size_t M, class Triangle>
+Matrix<T, P, M> operator*(const Matrix<T, P, M> &B, const TriangularMatrix<T, M, Triangle> &A)
+{
+    // Built transposed, C^T = A^T B^T, so that like the product above the
+    // inner loop runs along a full row of length P: row j of C^T combines
+    // the rows k of B^T that column j of A reaches (rows j to M-1 of a
+    // lower triangle, rows 0 to j of an upper one), again two rows at a time
+    constexpr bool lower = std::is_same<Triangle, LowerTriangle>::value;
+    const Matrix<T, M, P> Bt = B.transpose();
+    Matrix<T, M, P> Ct;
+    const T *b = &Bt(0,0);
+    T *c = &Ct(0,0);
+    const T *a = A.data();
+    size_t j = 0;
+    for(; j + 1 < M; j += 2)
+    {
+        T *c0 = c + j*P;
+        T *c1 = c0 + P;
+        const size_t begin = lower ? j + 1 : 0;
+        const size_t end = lower ? M : j + 1;
+        for(size_t k = begin; k < end; ++k)
+        {
+            const T x0 = a[Triangle::index(k, j, M)];
+            const T x1 = a[Triangle::index(k, j + 1, M)];
+            const T *bk = b + k*P;
+            for(size_t r = 0; r < P; ++r)
+            {
+                c0[r] += x0*bk[r];
+                c1[r] += x1*bk[r];
+            }
+        }
+
+        // The one row of B^T that only column j (lower) or column j+1 (upper) reaches
+        const size_t k = lower ? j : j + 1;
+        T *ck = lower ? c0 : c1;
+        const T x = a[Triangle::index(k, k, M)];
+        const T *bk = b + k*P;
+        for(size_t r = 0; r < P; ++r)
+        {
+            ck[r] += x*bk[r];
+        }
+    }
+    if(j < M)
+    {
+        T *cj = c + j*P;
+        for(size_t k = lower ? j : 0; k < (lower ? M : j + 1); ++k)
+        {
+            const T x = a[Triangle::index(k, j, M)];
+            const T *bk = b + k*P;
+            for(size_t r = 0; r < P; ++r)
+            {
+                cj[r] += x*bk[r];
+            }
+        }
+    }
+    const Matrix<T, P, M> C = Ct.transpose();
+    return C;
+}
+
+//! Solve this x = b by forward (lower) or back (upper) substitution
+template<class T, size_t M, class Triangle>
+Vector<T, M> TriangularMatrix<T,M,Triangle>::solve(const Matrix<T, M, 1> &b) const
+{
+    Vector<T, M> x(b);
+    substitute(&x(0), 1);
+    return x;
+}
+
+//! Solve this X = B for every column of B
+template<class T, size_t M, class Triangle>
+template<size_t P>
+Matrix<T, M, P> TriangularMatrix<T,M,Triangle>::solve(const Matrix<T, M, P> &B) const
+{
+    Matrix<T, M, P> X(B);
+    substitute(&X(0,0), P);
+    return X;
+}
+
+//! Product of the diagonal
+template<class T, size_t M, class Triangle>
+T TriangularMatrix<T,M,Triangle>::determinant() const
+{
+    T det = 1;
+    for(size_t i = 0; i < M; ++i)
+    {
+        det *= values[Triangle::index(i, i, M)];
+    }
+    return det;
+}
+
+//! Overwrite the rows of X (P columns) with the solution of this X = X
+template<class T, size_t M, class Triangle>
+void TriangularMatrix<T,M,Triangle>::substitute(T *x, size_t P) const
+{
+    for(size_t i = 0; i < M; ++i)
+    {
+        if(values[Triangle::index(i, i, M)] == T(0))
+        {
+            detail::throwSingularTriangle(i);
+        }
+    }
+
+    // Lower: rows top to bottom, each using the rows already solved before
+    // it. Upper: bottom to top, each using the rows solved after it.
+    constexpr bool lower = std::is_same<Triangle, LowerTriangle>::value;
+    for(size_t step = 0; step < M; ++step)
+    {
+        const size_t i = lower ? step : M - 1 - step;
+        const size_t begin = lower ? 0 : i + 1;
+        const size_t end = lower ? i : M;
+        const T *row = values + Triangle::index(i, 0, M);
+        T *xi = x + i*P;
+        for(size_t k = begin; k < end; ++k)
+        {
+            const T a = row[k];
+            const T *xk = x + k*P;
+            for(size_t j = 0; j < P; ++j)
+            {
+                xi[j] -= a*xk[j];
+            }
+        }
+        const T d = row[i];
+        for(size_t j = 0; j < P; ++j)
+        {
+            xi[j] /= d;
+        }
+    }
+}
+
+} // namespace matrix
+
+#endif // _TRIANGULAR_MATRIX_HPP__
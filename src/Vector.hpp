@@ -21,37 +21,57 @@ class Vector : public Matrix<T, M, 1>
 {
 public:
     //! Default constructor
-    Vector();
+    constexpr Vector();
 
     //! Constructor with array of initial values
-    explicit Vector(const T values[M]);
+    explicit constexpr Vector(const T values[M]);
 
     //! Constructor with initializer list
-    Vector(std::initializer_list<T> list);
+    constexpr Vector(std::initializer_list<T> list);
 
     //! Construct with other vector/matrix
-    Vector(const Vector<T, M> &other);
+    Vector(const Vector<T, M> &other) = default;
+
+    //! Move constructor
+    Vector(Vector<T, M> &&other) = default;
+
+    //! Copy assignment
+    Vector<T, M> &operator=(const Vector<T, M> &other) = default;
+
+    //! Move assignment
+    Vector<T, M> &operator=(Vector<T, M> &&other) = default;
 
     //! Construct with matrix
-    Vector(const Matrix<T, M, 1> &other);
+    constexpr Vector(const Matrix<T, M, 1> &other);
+
+    //! Construct by taking the elements of a matrix
+    constexpr Vector(Matrix<T, M, 1> &&other);
+
+    //! Construct by evaluating a matrix expression
+    template<class E, typename = std::enable_if_t<detail::IsExpressionOfShape<E, T, M, 1>::value>>
+    constexpr Vector(const MatrixExpression<E> &expr);
+
+    //! Assign by evaluating a matrix expression
+    template<class E, typename = std::enable_if_t<detail::IsExpressionOfShape<E, T, M, 1>::value>>
+    constexpr Vector<T, M> &operator=(const MatrixExpression<E> &expr);
 
     //! Access vector elements
-    const T &operator()(size_t i) const;
+    constexpr const T &operator()(size_t i) const;
 
     //! Assign vector elements
-    T &operator()(size_t i);
+    constexpr T &operator()(size_t i);
 
     //! Get size of vector
     inline const size_t size(){ return M; }
 
     //! Dot product of this vector with b
-    T dot(const Vector<T, M> &b) const;
+    constexpr T dot(const Vector<T, M> &b) const;
 
     //! Dot product with operator*
-    T operator*(const Vector<T, M> &b);
+    constexpr T operator*(const Vector<T, M> &b);
 
     //! Multiply with scalar
-    Vector<T, M> operator*(T value) const;
+    constexpr Vector<T, M> operator*(T value) const;
 
     //! Compute the norm of a vector
     T norm() const;
@@ -66,30 +86,33 @@ public:
     Vector<T, M> unit() const;
 };
 
+static_assert(sizeof(Vector<float, 6>) == 6*sizeof(float), "Vector must not carry anything beyond its elements");
+static_assert(std::is_standard_layout<Vector<float, 6>>::value, "Vector must be standard-layout");
+static_assert(std::is_trivially_copyable<Vector<float, 6>>::value, "Vector must be trivially copyable");
+
 //! Default constructor
 template<class T, size_t M>
-Vector<T,M>::Vector():
+constexpr Vector<T,M>::Vector():
     Matrix<T, M, 1>()
 {
 }
 
 //! Constructor with array of initial values
 template<class T, size_t M>
-Vector<T,M>::Vector(const T values[M]):
+constexpr Vector<T,M>::Vector(const T values[M]):
     Matrix<T, M, 1>(values)
 {
 }
 
 //! Constructor with initializer list
 template<class T, size_t M>
-Vector<T,M>::Vector(std::initializer_list<T> list)
+constexpr Vector<T,M>::Vector(std::initializer_list<T> list):
+    Matrix<T, M, 1>()
 {
     size_t listsize = static_cast<size_t>(list.size());
     if(listsize != M)
     {
-        char message[120];
-        snprintf(message, 120, "ERROR: Invalid number of arguments supplied. Expected [%lu], Received [%lu]\n", M, listsize);
-        throw std::invalid_argument(message);
+        detail::throwInvalidArgumentCount(M, listsize);
     }
 
     auto iter = list.begin();
@@ -99,52 +122,73 @@ Vector<T,M>::Vector(std::initializer_list<T> list)
     }
 }
 
-//! Construct with other vector/matrix
+//! Construct with matrix
 template<class T, size_t M>
-Vector<T,M>::Vector(const Vector<T, M> &other):
+constexpr Vector<T,M>::Vector(const Matrix<T, M, 1> &other):
     Matrix<T, M, 1>(other)
 {
 }
 
-//! Construct with matrix
+//! Construct by taking the elements of a matrix
 template<class T, size_t M>
-Vector<T,M>::Vector(const Matrix<T, M, 1> &other):
-    Matrix<T, M, 1>(other)
+constexpr Vector<T,M>::Vector(Matrix<T, M, 1> &&other):
+    Matrix<T, M, 1>(std::move(other))
 {
 }
 
+//! Construct by evaluating a matrix expression
+template<class T, size_t M>
+template<class E, typename>
+constexpr Vector<T,M>::Vector(const MatrixExpression<E> &expr):
+    Matrix<T, M, 1>(expr)
+{
+}
+
+//! Assign by evaluating a matrix expression
+template<class T, size_t M>
+template<class E, typename>
+constexpr Vector<T, M> &Vector<T,M>::operator=(const MatrixExpression<E> &expr)
+{
+    Matrix<T, M, 1>::operator=(expr);
+    return *this;
+}
+
 //! Access vector elements
 template<class T, size_t M>
-const T &Vector<T,M>::operator()(size_t i) const
+constexpr const T &Vector<T,M>::operator()(size_t i) const
 {
-    const Matrix<T, M, 1> &self = *this;
-    return self(i, 0);
+    Matrix<T, M, 1>::bounds_policy::check(i, 0, M, 1);
+    return this->data[i];
 }
 
 //! Assign vector elements
 template<class T, size_t M>
-T &Vector<T,M>::operator()(size_t i)
+constexpr T &Vector<T,M>::operator()(size_t i)
 {
-    Matrix<T, M, 1> &self = *this;
-    return self(i, 0);
+    Matrix<T, M, 1>::bounds_policy::check(i, 0, M, 1);
+    return this->data[i];
 }
 
 //! Dot product of this vector with b
 template<class T, size_t M>
-T Vector<T,M>::dot(const Vector<T, M> &b) const
+constexpr T Vector<T,M>::dot(const Vector<T, M> &b) const
 {
-    const Vector<T, M> &a = *this;
+    // Shorter vectors are faster inline than through the kernel table
+    if(M >= 16 && simd::useRuntimeKernels<T>())
+    {
+        return simd::kernels<T>().dot(this->data, b.data, M);
+    }
     T value = 0;
     for(size_t i = 0; i < M; ++i)
     {
-        value += a(i) * b(i);
+        value += this->data[i] * b.data[i];
     }
     return value;
 }
 
 //! Dot product with operator*
 template<class T, size_t M>
-T Vector<T,M>::operator*(const Vector<T, M> &b)
+constexpr T Vector<T,M>::operator*(const Vector<T, M> &b)
 {
     const Vector<T, M> &self = *this;
     return self.dot(b);
@@ -152,9 +196,10 @@ T Vector<T,M>::operator*(const Vector<T, M> &b)
 
 //! Multiply with scalar
 template<class T, size_t M>
-Vector<T, M> Vector<T,M>::operator*(T value) const
+constexpr Vector<T, M> Vector<T,M>::operator*(T value) const
 {
-    return Vector(Matrix<T, M, 1>::operator*(value));
+    const Matrix<T, M, 1> &self = *this;
+    return Vector(self * value);
 }
 
 //! Compute the norm of a vector
@@ -21,160 +21,181 @@ class Vector3 : public Vector<T, 3>
 {
 public:
     //! Default constructor
-    Vector3();
+    constexpr Vector3();
 
     //! Copy constructor from Vector3 type
-    Vector3(const Vector3<T> &other);
+    Vector3(const Vector3<T> &other) = default;
 
     //! Copy constructor from Vector type
-    Vector3(const Vector<T, 3> &other);
+    constexpr Vector3(const Vector<T, 3> &other);
 
     //! Copy constructor from Matrix type
-    Vector3(const Matrix<T, 3, 1> &other);
+    constexpr Vector3(const Matrix<T, 3, 1> &other);
+
+    //! Construct by evaluating a matrix expression
+    template<class E, typename = std::enable_if_t<detail::IsExpressionOfShape<E, T, 3, 1>::value>>
+    constexpr Vector3(const MatrixExpression<E> &expr);
+
+    //! Assign by evaluating a matrix expression
+    template<class E, typename = std::enable_if_t<detail::IsExpressionOfShape<E, T, 3, 1>::value>>
+    constexpr Vector3<T> &operator=(const MatrixExpression<E> &expr);
 
     //! Create 3-vector from individual elements
-    Vector3(T x, T y, T z);
+    constexpr Vector3(T x, T y, T z);
 
     //! Create 3-vector from an array
-    explicit Vector3(const T values[3]);
+    explicit constexpr Vector3(const T values[3]);
 
     // Override basic operations to return correct type and skip unnecessary casting operations
     //! Vector addition
-    Vector3<T> operator+(Vector3<T> &other) const;
+    constexpr Vector3<T> operator+(Vector3<T> &other) const;
 
     //! Vector subtraction
-    Vector3<T> operator-(Vector3<T> &other) const;
+    constexpr Vector3<T> operator-(Vector3<T> &other) const;
 
     //! Vector multiplication (dot product)
-    T operator*(const Vector3<T> &other) const;
+    constexpr T operator*(const Vector3<T> &other) const;
 
     //! Scalar addition
-    Vector3<T> operator+(T value) const;
+    constexpr Vector3<T> operator+(T value) const;
 
     //! Scalar subtraction
-    Vector3<T> operator-(T value) const;
+    constexpr Vector3<T> operator-(T value) const;
 
     //! Unary minus
-    Vector3<T> operator-() const;
+    constexpr Vector3<T> operator-() const;
 
     //! Scalar multiplication
-    Vector3<T> operator*(T value) const;
+    constexpr Vector3<T> operator*(T value) const;
 
     //! Cross product
-    Vector3 cross(const Vector3 &other) const;
+    constexpr Vector3 cross(const Vector3 &other) const;
 
     //! Tilde matrix (cross prod matrix)
-    SquareMatrix<T, 3> tilde() const;
+    constexpr SquareMatrix<T, 3> tilde() const;
 };
 
+static_assert(sizeof(Vector3<float>) == 3*sizeof(float), "Vector3 must not carry anything beyond its elements");
+static_assert(std::is_standard_layout<Vector3<float>>::value, "Vector3 must be standard-layout");
+static_assert(std::is_trivially_copyable<Vector3<float>>::value, "Vector3 must be trivially copyable");
+
 //! Default constructor
 template<class T>
-Vector3<T>::Vector3():
+constexpr Vector3<T>::Vector3():
     Vector<T, 3>()
 {
 }
 
-//! Copy construcctor from Vector3 type
+//! Copy constructor form Vector type
 template<class T>
-Vector3<T>::Vector3(const Vector3<T> &other):
+constexpr Vector3<T>::Vector3(const Vector<T, 3> &other):
     Vector<T, 3>(other)
 {
 }
 
-//! Copy constructor form Vector type
+//! Copy constructor from Matrix type
 template<class T>
-Vector3<T>::Vector3(const Vector<T, 3> &other):
+constexpr Vector3<T>::Vector3(const Matrix<T, 3, 1> &other):
     Vector<T, 3>(other)
 {
 }
 
-//! Copy constructor from Matrix type
+//! Construct by evaluating a matrix expression
 template<class T>
-Vector3<T>::Vector3(const Matrix<T, 3, 1> &other):
-    Vector<T, 3>(other)
+template<class E, typename>
+constexpr Vector3<T>::Vector3(const MatrixExpression<E> &expr):
+    Vector<T, 3>(expr)
+{
+}
+
+//! Assign by evaluating a matrix expression
+template<class T>
+template<class E, typename>
+constexpr Vector3<T> &Vector3<T>::operator=(const MatrixExpression<E> &expr)
 {
+    Matrix<T, 3, 1>::operator=(expr);
+    return *this;
 }
 
 //! Create a 3-vector from individual elements
 template<class T>
-Vector3<T>::Vector3(T x, T y, T z)
+constexpr Vector3<T>::Vector3(T x, T y, T z)
 {
-    Vector3<T> &self = *this;
-    self(0) = x;
-    self(1) = y;
-    self(2) = z;
+    this->data[0] = x;
+    this->data[1] = y;
+    this->data[2] = z;
 }
 
 //! Create 3-vector from an array
 template<class T>
-Vector3<T>::Vector3(const T values[3]):
+constexpr Vector3<T>::Vector3(const T values[3]):
     Vector<T, 3>(values)
 {
 }
 
 //! Vector addition
 template<class T>
-Vector3<T> Vector3<T>::operator+(Vector3<T> &other) const
+constexpr Vector3<T> Vector3<T>::operator+(Vector3<T> &other) const
 {
     return Vector3<T>(this->data[0]+other.data[0], this->data[1]+other.data[1], this->data[2]+other.data[2]);
 }
 
 //! Vector subtraction
 template<class T>
-Vector3<T> Vector3<T>::operator-(Vector3<T> &other) const
+constexpr Vector3<T> Vector3<T>::operator-(Vector3<T> &other) const
 {
     return Vector3<T>(this->data[0]-other.data[0], this->data[1]-other.data[1], this->data[2]-other.data[2]);
 }
 
 //! Vector multiplication (dot product)
 template<class T>
-T Vector3<T>::operator*(const Vector3<T> &other) const
+constexpr T Vector3<T>::operator*(const Vector3<T> &other) const
 {
     return this->data[0]*other.data[0] + this->data[1]*other.data[1] + this->data[2]*other.data[2];
 }
 
 //! Scalar addition
 template<class T>
-Vector3<T> Vector3<T>::operator+(T value) const
+constexpr Vector3<T> Vector3<T>::operator+(T value) const
 {
     return Vector3<T>(this->data[0]+value, this->data[1]+value, this->data[2]+value);
 }
 
 //! Scalar subtraction
 template<class T>
-Vector3<T> Vector3<T>::operator-(T value) const
+constexpr Vector3<T> Vector3<T>::operator-(T value) const
 {
     return Vector3<T>(this->data[0]-value, this->data[1]-value, this->data[2]-value);
 }
 
 //! Unary minus
 template<class T>
-Vector3<T> Vector3<T>::operator-() const
+constexpr Vector3<T> Vector3<T>::operator-() const
 {
     return Vector3<T>(-(this->data[0]), -(this->data[1]), -(this->data[2]));
 }
 
 //! Scalar multiplication
 template<class T>
-Vector3<T> Vector3<T>::operator*(T value) const
+constexpr Vector3<T> Vector3<T>::operator*(T value) const
 {
     return Vector3<T>(this->data[0]*value, this->data[1]*value, this->data[2]*value);
 }
 
 //! Cross product
 template<class T>
-Vector3<T> Vector3<T>::cross(const Vector3<T> &other) const
+constexpr Vector3<T> Vector3<T>::cross(const Vector3<T> &other) const
 {
-    const Vector3<T> &self = *this;
-    Vector3<T> result(self(1)*other(2)-self(2)*other(1), -(self(0)*other(2)-self(2)*other(0)), self(0)*other(1)-self(1)*other(0));
+    const T *a = this->data;
+    const T *b = other.data;
+    Vector3<T> result(a[1]*b[2]-a[2]*b[1], -(a[0]*b[2]-a[2]*b[0]), a[0]*b[1]-a[1]*b[0]);
     return result;
 }
 
 //! Tilde matrix (cross prod matrix)
 template<class T>
-SquareMatrix<T, 3> Vector3<T>::tilde() const
+constexpr SquareMatrix<T, 3> Vector3<T>::tilde() const
 {
-    const Vector3<T> &self = *this;
     SquareMatrix<T, 3> ret;
     ret(0,1) = -1.0*this->data[2];
     ret(0,2) = this->data[1];
@@ -0,0 +1,223 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file Vector3Batch.hpp
+//!
+//! Structure-of-arrays batch of 3-vectors (x, y and z each in their own array)
+//! for operating on many vehicles at once. Results match Vector3 element for
+//! element.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _VECTOR3_BATCH_HPP__
+#define _VECTOR3_BATCH_HPP__
+
+#include "BatchStorage.hpp"
+#include "SimdKernel.hpp"
+#include "Vector3.hpp"
+
+namespace matrix
+{
+
+template<class T>
+class Vector3Batch : public BatchStorage<T, 3>
+{
+public:
+    //! Default constructor (empty batch)
+    Vector3Batch();
+
+    //! Construct a batch of n zero vectors
+    explicit Vector3Batch(size_t n);
+
+    //! Construct from an array of n vectors
+    Vector3Batch(const Vector3<T> *vectors, size_t n);
+
+    //! Replace the contents with an array of n vectors
+    void load(const Vector3<T> *vectors, size_t n);
+
+    //! Copy every vector out to an array of size() vectors
+    void store(Vector3<T> *vectors) const;
+
+    //! Get vector i
+    Vector3<T> operator()(size_t i) const;
+
+    //! Set vector i
+    void set(size_t i, const Vector3<T> &v);
+
+    //! Component arrays
+    inline T *x() { return this->component(0); }
+    inline T *y() { return this->component(1); }
+    inline T *z() { return this->component(2); }
+    inline const T *x() const { return this->component(0); }
+    inline const T *y() const { return this->component(1); }
+    inline const T *z() const { return this->component(2); }
+
+    //! Dot product of every vector with the matching vector of other (out holds size() values)
+    void dot(const Vector3Batch<T> &other, T *out) const;
+
+    //! Cross product of every vector with the matching vector of other (out may be this or other)
+    void cross(const Vector3Batch<T> &other, Vector3Batch<T> &out) const;
+
+    //! Normalize every vector
+    void normalize();
+};
+
+//! Default constructor (empty batch)
+template<class T>
+Vector3Batch<T>::Vector3Batch():
+    BatchStorage<T, 3>()
+{
+}
+
+//! Construct a batch of n zero vectors
+template<class T>
+Vector3Batch<T>::Vector3Batch(size_t n):
+    BatchStorage<T, 3>(n)
+{
+}
+
+//! Construct from an array of n vectors
+template<class T>
+Vector3Batch<T>::Vector3Batch(const Vector3<T> *vectors, size_t n):
+    BatchStorage<T, 3>(n)
+{
+    load(vectors, n);
+}
+
+//! Replace the contents with an array of n vectors
+template<class T>
+void Vector3Batch<T>::load(const Vector3<T> *vectors, size_t n)
+{
+    this->resize(n);
+    T *px = x();
+    T *py = y();
+    T *pz = z();
+    for(size_t i = 0; i < n; ++i)
+    {
+        px[i] = vectors[i].coeff(0);
+        py[i] = vectors[i].coeff(1);
+        pz[i] = vectors[i].coeff(2);
+    }
+}
+
+//! Copy every vector out to an array of size() vectors
+template<class T>
+void Vector3Batch<T>::store(Vector3<T> *vectors) const
+{
+    const T *px = x();
+    const T *py = y();
+    const T *pz = z();
+    for(size_t i = 0; i < this->count; ++i)
+    {
+        vectors[i] = Vector3<T>(px[i], py[i], pz[i]);
+    }
+}
+
+//! Get vector i
+template<class T>
+Vector3<T> Vector3Batch<T>::operator()(size_t i) const
+{
+    this->checkIndex(i);
+    return Vector3<T>(x()[i], y()[i], z()[i]);
+}
+
+//! Set vector i
+template<class T>
+void Vector3Batch<T>::set(size_t i, const Vector3<T> &v)
+{
+    this->checkIndex(i);
+    x()[i] = v.coeff(0);
+    y()[i] = v.coeff(1);
+    z()[i] = v.coeff(2);
+}
+
+//! Dot product of every vector with the matching vector of other (out holds size() values)
+template<class T>
+void Vector3Batch<T>::dot(const Vector3Batch<T> &other, T *out) const
+{
+    this->checkSize("dot", other.size());
+    const T *ax = x(), *ay = y(), *az = z();
+    const T *bx = other.x(), *by = other.y(), *bz = other.z();
+    const size_t n = this->count;
+    const size_t blocks = n / this->block;
+    for(size_t k = 0; k < blocks*this->block; k += this->block)
+    {
+        MTL_BATCH_IVDEP
+        for(size_t l = 0; l < this->block; ++l)
+        {
+            const size_t i = k + l;
+            out[i] = T(0) + ax[i]*bx[i] + ay[i]*by[i] + az[i]*bz[i];
+        }
+    }
+    // out only has room for size() values, so the last partial block is done separately
+    for(size_t i = blocks*this->block; i < n; ++i)
+    {
+        out[i] = T(0) + ax[i]*bx[i] + ay[i]*by[i] + az[i]*bz[i];
+    }
+}
+
+//! Cross product of every vector with the matching vector of other (out may be this or other)
+template<class T>
+void Vector3Batch<T>::cross(const Vector3Batch<T> &other, Vector3Batch<T> &out) const
+{
+    this->checkSize("cross", other.size());
+    out.resize(this->count);
+    const T *ax = x(), *ay = y(), *az = z();
+    const T *bx = other.x(), *by = other.y(), *bz = other.z();
+    T *ox = out.x(), *oy = out.y(), *oz = out.z();
+    const size_t n = this->padded;
+    for(size_t k = 0; k < n; k += this->block)
+    {
+        MTL_BATCH_IVDEP
+        for(size_t l = 0; l < this->block; ++l)
+        {
+            const size_t i = k + l;
+            const T cx = ay[i]*bz[i] - az[i]*by[i];
+            const T cy = az[i]*bx[i] - ax[i]*bz[i];
+            const T cz = ax[i]*by[i] - ay[i]*bx[i];
+            ox[i] = cx;
+            oy[i] = cy;
+            oz[i] = cz;
+        }
+    }
+}
+
+//! Normalize every vector
+template<class T>
+void Vector3Batch<T>::normalize()
+{
+    // Norms are computed a chunk at a time so the square roots can use the SIMD kernels
+    constexpr size_t chunk = 16*Vector3Batch<T>::block;
+    T norm[chunk];
+    T *px = x(), *py = y(), *pz = z();
+    const size_t n = this->padded;
+    for(size_t c = 0; c < n; c += chunk)
+    {
+        const size_t m = n - c < chunk ? n - c : chunk;
+        for(size_t k = 0; k < m; k += this->block)
+        {
+            MTL_BATCH_IVDEP
+            for(size_t l = 0; l < this->block; ++l)
+            {
+                const size_t i = c + k + l;
+                norm[k+l] = T(0) + px[i]*px[i] + py[i]*py[i] + pz[i]*pz[i];
+            }
+        }
+        simd::kernels<T>().sqrt(norm, norm, m);
+        this->unitPaddingNorms(norm, c, m);
+        for(size_t k = 0; k < m; k += this->block)
+        {
+            MTL_BATCH_IVDEP
+            for(size_t l = 0; l < this->block; ++l)
+            {
+                const size_t i = c + k + l;
+                px[i] /= norm[k+l];
+                py[i] /= norm[k+l];
+                pz[i] /= norm[k+l];
+            }
+        }
+    }
+}
+
+} // namespace matrix
+
+#endif // _VECTOR3_BATCH_HPP__
@@ -0,0 +1,65 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file Vector3Map.hpp
+//!
+//! Map that presents three elements of a caller-owned buffer as a Vector3
+//! without copying them (see MatrixMap.hpp). Results that are new vectors are
+//! returned as Vector3; everything else reads and writes the buffer in place.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _VECTOR3_MAP_HPP__
+#define _VECTOR3_MAP_HPP__
+
+#include "MatrixMap.hpp"
+#include "SquareMatrix.hpp"
+#include "Vector3.hpp"
+
+namespace matrix
+{
+
+template<class T>
+class Vector3Map : public VectorMap<T, 3>
+{
+public:
+    using value_type = typename VectorMap<T, 3>::value_type;
+
+    //! Map three elements stride apart (stride 1 for contiguous elements)
+    explicit constexpr Vector3Map(T *values, size_t stride = 1);
+
+    //! Assign the mapped elements
+    using VectorMap<T, 3>::operator=;
+
+    //! Cross product with a 3-vector or 3-vector expression
+    template<class E, typename = std::enable_if_t<detail::IsExpressionOfShape<E, value_type, 3, 1>::value>>
+    constexpr Vector3<value_type> cross(const MatrixExpression<E> &other) const;
+
+    //! Skew-symmetric cross product matrix
+    constexpr SquareMatrix<value_type, 3> tilde() const;
+};
+
+//! Map three elements stride apart (stride 1 for contiguous elements)
+template<class T>
+constexpr Vector3Map<T>::Vector3Map(T *values, size_t stride):
+    VectorMap<T, 3>(values, stride)
+{
+}
+
+//! Cross product with a 3-vector or 3-vector expression
+template<class T>
+template<class E, typename>
+constexpr Vector3<typename Vector3Map<T>::value_type> Vector3Map<T>::cross(const MatrixExpression<E> &other) const
+{
+    return Vector3<value_type>(*this).cross(Vector3<value_type>(other));
+}
+
+//! Skew-symmetric cross product matrix
+template<class T>
+constexpr SquareMatrix<typename Vector3Map<T>::value_type, 3> Vector3Map<T>::tilde() const
+{
+    return Vector3<value_type>(*this).tilde();
+}
+
+} // namespace matrix
+
+#endif // _VECTOR3_MAP_HPP__
@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TestCholesky.cpp
+//!
+//! Unit test for Cholesky.hpp
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <iostream>
+#include <gtest/gtest.h>
+#include "../src/Cholesky.hpp"
+#include "TestHelpers.hpp"
+
+namespace
+{
+
+//! Random symmetric positive definite matrix B B^T + I
+template<size_t M>
+matrix::SquareMatrix<double, M> spd(test::Random &random)
+{
+    matrix::SquareMatrix<double, M> B;
+    test::fill(B, random);
+    matrix::SquareMatrix<double, M> A = B*B.transpose();
+    for(size_t i = 0; i < M; ++i)
+    {
+        A(i,i) += 1.0;
+    }
+    return A;
+}
+
+} // namespace
+
+TEST(CholeskyTestSuite, TestLLT)
+{
+    matrix::SquareMatrix<double, 3> A = {{4.0, 12.0, -16.0}, {12.0, 37.0, -43.0}, {-16.0, -43.0, 98.0}};
+    matrix::LLT<double, 3> llt(A);
+    EXPECT_TRUE(llt.isPositiveDefinite());
+
+    matrix::SquareMatrix<double, 3> L = {{2.0, 0.0, 0.0}, {6.0, 1.0, 0.0}, {-8.0, 5.0, 3.0}};
+    EXPECT_LT(test::maxDifference(L, llt.matrixL()), 1.0e-14);
+    EXPECT_NEAR(36.0, llt.determinant(), 1.0e-12);
+
+    test::Random random(18);
+    matrix::SquareMatrix<double, 9> P = spd<9>(random);
+    matrix::LLT<double, 9> llt9(P);
+    matrix::SquareMatrix<double, 9> L9 = llt9.matrixL();
+    EXPECT_LT(test::maxDifference(L9*L9.transpose(), P), 1.0e-12);
+
+    matrix::Vector<double, 9> b;
+    test::fill(b, random);
+    EXPECT_LT(test::maxDifference(P*llt9.solve(b), b), 1.0e-12);
+
+    matrix::Matrix<double, 9, 4> B;
+    test::fill(B, random);
+    EXPECT_LT(test::maxDifference(P*llt9.solve(B), B), 1.0e-12);
+}
+
+TEST(CholeskyTestSuite, TestLDLT)
+{
+    matrix::SquareMatrix<double, 3> A = {{4.0, 12.0, -16.0}, {12.0, 37.0, -43.0}, {-16.0, -43.0, 98.0}};
+    matrix::LDLT<double, 3> ldlt(A);
+    EXPECT_FALSE(ldlt.isSingular());
+    EXPECT_TRUE(ldlt.isPositiveDefinite());
+
+    matrix::SquareMatrix<double, 3> L = {{1.0, 0.0, 0.0}, {3.0, 1.0, 0.0}, {-4.0, 5.0, 1.0}};
+    matrix::Vector<double, 3> D = {4.0, 1.0, 9.0};
+    EXPECT_LT(test::maxDifference(L, ldlt.matrixL()), 1.0e-14);
+    EXPECT_LT(test::maxDifference(D, ldlt.vectorD()), 1.0e-14);
+    EXPECT_NEAR(36.0, ldlt.determinant(), 1.0e-12);
+
+    test::Random random(19);
+    matrix::SquareMatrix<double, 9> P = spd<9>(random);
+    matrix::LDLT<double, 9> ldlt9(P);
+    matrix::Vector<double, 9> b;
+    test::fill(b, random);
+    EXPECT_LT(test::maxDifference(P*ldlt9.solve(b), b), 1.0e-12);
+
+    matrix::Matrix<double, 9, 4> B;
+    test::fill(B, random);
+    EXPECT_LT(test::maxDifference(P*ldlt9.solve(B), B), 1.0e-12);
+
+    // Symmetric indefinite matrices that need no pivoting still factor
+    matrix::SquareMatrix<double, 2> indefinite = {{1.0, 2.0}, {2.0, 1.0}};
+    matrix::LDLT<double, 2> ldltIndefinite(indefinite);
+    EXPECT_FALSE(ldltIndefinite.isSingular());
+    EXPECT_FALSE(ldltIndefinite.isPositiveDefinite());
+    EXPECT_NEAR(-3.0, ldltIndefinite.determinant(), 1.0e-14);
+}
+
+TEST(CholeskyTestSuite, TestUpdateDowndate)
+{
+    test::Random random(20);
+    matrix::SquareMatrix<double, 8> P = spd<8>(random);
+    matrix::Vector<double, 8> v;
+    test::fill(v, random);
+    matrix::SquareMatrix<double, 8> updated = P;
+    for(size_t i = 0; i < 8; ++i)
+    {
+        for(size_t j = 0; j < 8; ++j)
+        {
+            updated(i,j) += v(i)*v(j);
+        }
+    }
+
+    matrix::LLT<double, 8> llt(P);
+    llt.update(v);
+    EXPECT_LT(test::maxDifference((matrix::LLT<double, 8>(updated).matrixL()), llt.matrixL()), 1.0e-12);
+    EXPECT_TRUE(llt.downdate(v));
+    EXPECT_LT(test::maxDifference((matrix::LLT<double, 8>(P).matrixL()), llt.matrixL()), 1.0e-12);
+
+    matrix::LDLT<double, 8> ldlt(P);
+    ldlt.update(v);
+    matrix::LDLT<double, 8> ldltUpdated(updated);
+    EXPECT_LT(test::maxDifference(ldltUpdated.matrixL(), ldlt.matrixL()), 1.0e-12);
+    EXPECT_LT(test::maxDifference(ldltUpdated.vectorD(), ldlt.vectorD()), 1.0e-12);
+    EXPECT_TRUE(ldlt.downdate(v));
+    EXPECT_LT(test::maxDifference((matrix::LDLT<double, 8>(P).vectorD()), ldlt.vectorD()), 1.0e-12);
+}
+
+TEST(CholeskyTestSuite, TestNotPositiveDefinite)
+{
+    matrix::SquareMatrix<double, 2> A = {{1.0, 2.0}, {2.0, 1.0}};
+    matrix::LLT<double, 2> llt(A);
+    EXPECT_FALSE(llt.isPositiveDefinite());
+    matrix::Vector<double, 2> b = {1.0, 1.0};
+    EXPECT_THROW(llt.solve(b), std::runtime_error);
+
+    // Removing more than the matrix holds fails the downdate
+    matrix::SquareMatrix<double, 2> I;
+    I.identity();
+    matrix::Vector<double, 2> v = {2.0, 0.0};
+    matrix::LLT<double, 2> lltI(I);
+    EXPECT_FALSE(lltI.downdate(v));
+    EXPECT_FALSE(lltI.isPositiveDefinite());
+    matrix::LDLT<double, 2> ldltI(I);
+    EXPECT_FALSE(ldltI.downdate(v));
+
+    matrix::SquareMatrix<double, 2> zero;
+    matrix::LDLT<double, 2> ldlt(zero);
+    EXPECT_TRUE(ldlt.isSingular());
+    EXPECT_THROW(ldlt.solve(b), std::runtime_error);
+    EXPECT_FALSE((matrix::LLT<double, 2>().isPositiveDefinite()));
+}
@@ -216,4 +216,74 @@ TEST(DCMTestSuite, TestQuaternionConversionConstructor)
     EXPECT_DOUBLE_EQ(0.70738846419427182, d12(2,0));
     EXPECT_DOUBLE_EQ(0.50360837656663437, d12(2,1));
     EXPECT_DOUBLE_EQ(0.4959638734593364, d12(2,2));
-}
\ No newline at end of file
+}
+
+TEST(DCMTestSuite, TestCompileTimeNedToEnu)
+{
+    // NED to ENU swaps the first two axes and flips the third
+    constexpr matrix::DCM<double> nedToEnu = {{0.0, 1.0, 0.0},
+                                              {1.0, 0.0, 0.0},
+                                              {0.0, 0.0, -1.0}};
+    static_assert(nedToEnu.transpose() == nedToEnu, "NED to ENU is its own inverse");
+    static_assert(nedToEnu*nedToEnu == matrix::identity<double, 3>(), "NED to ENU is orthonormal");
+    static_assert(nedToEnu.trace() == -1.0, "trace");
+
+    constexpr matrix::Vector3<double> ned(10.0, 20.0, -5.0);
+    constexpr matrix::Vector3<double> enu = nedToEnu*ned;
+    static_assert(enu(0) == 20.0 && enu(1) == 10.0 && enu(2) == 5.0, "vector rotation");
+    EXPECT_DOUBLE_EQ(5.0, enu(2));
+
+    constexpr matrix::DCM<double> I;
+    static_assert(I == matrix::identity<double, 3>(), "default DCM is identity");
+}
+
+TEST(DCMTestSuite, TestOrthonormalize)
+{
+    matrix::DCM<double> exact(matrix::Quaternion<double>(0.7, 0.1, -0.5, 0.3));
+    matrix::SquareMatrix<double, 3> I;
+    I.identity();
+
+    const matrix::Orthonormalization methods[3] = {matrix::Orthonormalization::Polar,
+                                                   matrix::Orthonormalization::FirstOrder,
+                                                   matrix::Orthonormalization::GramSchmidt};
+    for(size_t m = 0; m < 3; ++m)
+    {
+        // Small drift, as left by integrating the DCM kinematics
+        matrix::DCM<double> drifted = exact;
+        drifted(0,1) += 1.0e-5;
+        drifted(1,2) -= 2.0e-5;
+        drifted(2,2) += 1.5e-5;
+        drifted.orthonormalize(methods[m]);
+
+        // First order leaves the square of the drift
+        matrix::SquareMatrix<double, 3> error = drifted.transpose()*drifted - I;
+        for(size_t i = 0; i < 3; ++i)
+        {
+            for(size_t j = 0; j < 3; ++j)
+            {
+                EXPECT_NEAR(0.0, error(i,j), 1.0e-8);
+                EXPECT_NEAR(exact(i,j), drifted(i,j), 1.0e-4);
+            }
+        }
+    }
+
+    // Polar and Gram-Schmidt are exact after one call, first order after a few
+    matrix::DCM<double> polar = exact*1.01;
+    polar.orthonormalize();
+    matrix::DCM<double> gramSchmidt = exact*1.01;
+    gramSchmidt.orthonormalize(matrix::Orthonormalization::GramSchmidt);
+    matrix::DCM<double> firstOrder = exact*1.01;
+    for(size_t k = 0; k < 4; ++k)
+    {
+        firstOrder.orthonormalize(matrix::Orthonormalization::FirstOrder);
+    }
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < 3; ++j)
+        {
+            EXPECT_NEAR(exact(i,j), polar(i,j), 1.0e-15);
+            EXPECT_NEAR(exact(i,j), gramSchmidt(i,j), 1.0e-15);
+            EXPECT_NEAR(exact(i,j), firstOrder(i,j), 1.0e-15);
+        }
+    }
+}
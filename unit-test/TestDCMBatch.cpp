@@ -0,0 +1,119 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TestDCMBatch.cpp
+//!
+//! Unit test for DCMBatch.hpp
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/DCMBatch.hpp"
+
+namespace
+{
+
+//! Deterministic, non-unit quaternions (37 is not a whole number of blocks)
+std::vector<matrix::Quaternion<double>> quaternions(size_t n)
+{
+    std::vector<matrix::Quaternion<double>> q(n);
+    for(size_t i = 0; i < n; ++i)
+    {
+        const double s = 0.37*static_cast<double>((i*7) % 23) - 2.1;
+        q[i] = matrix::Quaternion<double>(1.0 + 0.1*s, s, 0.5 - s, 0.2*s*s);
+    }
+    return q;
+}
+
+} // namespace
+
+TEST(DCMBatchTestSuite, TestLoadAndStore)
+{
+    std::vector<matrix::DCM<double>> dcms;
+    for(const matrix::Quaternion<double> &q : quaternions(37))
+    {
+        dcms.push_back(matrix::DCM<double>(q));
+    }
+    matrix::DCMBatch<double> batch(dcms.data(), dcms.size());
+    EXPECT_EQ(37u, batch.size());
+
+    std::vector<matrix::DCM<double>> out(dcms.size());
+    batch.store(out.data());
+    for(size_t i = 0; i < dcms.size(); ++i)
+    {
+        EXPECT_EQ(dcms[i], out[i]);
+        EXPECT_EQ(dcms[i], batch(i));
+        EXPECT_EQ(dcms[i](1, 2), batch.element(1, 2)[i]);
+    }
+
+    batch.set(0, matrix::DCM<double>());
+    EXPECT_EQ(matrix::DCM<double>(), batch(0));
+}
+
+TEST(DCMBatchTestSuite, TestFromQuaternions)
+{
+    const std::vector<matrix::Quaternion<double>> q = quaternions(37);
+    const matrix::QuaternionBatch<double> batchQ(q.data(), q.size());
+    const matrix::DCMBatch<double> batch(batchQ);
+    ASSERT_EQ(q.size(), batch.size());
+    for(size_t i = 0; i < q.size(); ++i)
+    {
+        const matrix::DCM<double> expected(q[i]);
+        for(size_t j = 0; j < 3; ++j)
+        {
+            for(size_t k = 0; k < 3; ++k)
+            {
+                EXPECT_NEAR(expected(j, k), batch(i)(j, k), 1e-12);
+            }
+        }
+    }
+
+    // The padding lanes of the converted DCMs stay zero instead of becoming 0/0
+    for(size_t i = batch.size(); i < batch.paddedSize(); ++i)
+    {
+        EXPECT_EQ(0.0, batch.element(0, 0)[i]);
+    }
+}
+
+TEST(DCMBatchTestSuite, TestRotate)
+{
+    const std::vector<matrix::Quaternion<double>> q = quaternions(37);
+    std::vector<matrix::Vector3<double>> v(q.size());
+    for(size_t i = 0; i < v.size(); ++i)
+    {
+        v[i] = matrix::Vector3<double>(1.0 + static_cast<double>(i), -0.5, 0.25*static_cast<double>(i % 5));
+    }
+    const matrix::DCMBatch<double> batch(matrix::QuaternionBatch<double>(q.data(), q.size()));
+    matrix::Vector3Batch<double> batchV(v.data(), v.size());
+
+    matrix::Vector3Batch<double> rotated;
+    batch.rotate(batchV, rotated);
+    ASSERT_EQ(v.size(), rotated.size());
+    for(size_t i = 0; i < v.size(); ++i)
+    {
+        const matrix::Matrix<double, 3, 1> expected = batch(i)*v[i];
+        for(size_t j = 0; j < 3; ++j)
+        {
+            EXPECT_NEAR(expected(j, 0), rotated(i)(j), 1e-12);
+        }
+    }
+
+    // The result may overwrite the input vectors
+    batch.rotate(batchV, batchV);
+    for(size_t i = 0; i < v.size(); ++i)
+    {
+        EXPECT_EQ(rotated(i), batchV(i));
+    }
+}
+
+TEST(DCMBatchTestSuite, TestSizeMismatchThrows)
+{
+    const std::vector<matrix::Quaternion<double>> q = quaternions(37);
+    const matrix::DCMBatch<double> batch(matrix::QuaternionBatch<double>(q.data(), q.size()));
+    const matrix::Vector3Batch<double> batchV(20);
+
+    matrix::Vector3Batch<double> rotated;
+    EXPECT_THROW(batch.rotate(batchV, rotated), std::domain_error);
+}
@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TestDiscretization.cpp
+//!
+//! Unit test for Discretization.hpp
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <iostream>
+#include <gtest/gtest.h>
+#include "../src/Discretization.hpp"
+#include "TestHelpers.hpp"
+
+TEST(DiscretizationTestSuite, TestScalar)
+{
+    const double a = -0.7;
+    const double b = 1.3;
+    const double q = 0.4;
+    const double dt = 0.25;
+    matrix::Matrix<double, 1, 1> A = {{a}};
+    matrix::Matrix<double, 1, 1> B = {{b}};
+    matrix::Matrix<double, 1, 1> Q = {{q}};
+    const matrix::Discretization<double, 1, 1> d = matrix::c2d(A, B, Q, dt);
+    EXPECT_NEAR(std::exp(a*dt), d.phi()(0,0), 1.0e-15);
+    EXPECT_NEAR(b*(std::exp(a*dt) - 1.0) / a, d.gamma()(0,0), 1.0e-15);
+    EXPECT_NEAR(q*(std::exp(2.0*a*dt) - 1.0) / (2.0*a), d.processNoise()(0,0), 1.0e-15);
+}
+
+TEST(DiscretizationTestSuite, TestDoubleIntegrator)
+{
+    const double q = 2.5;
+    const double dt = 0.1;
+    matrix::Matrix<double, 2, 2> A = {{0.0, 1.0}, {0.0, 0.0}};
+    matrix::Matrix<double, 2, 1> B = {{0.0}, {1.0}};
+    matrix::Matrix<double, 2, 2> Q = {{0.0, 0.0}, {0.0, q}};
+    const matrix::Discretization<double, 2, 1> d = matrix::c2d(A, B, Q, dt);
+
+    matrix::Matrix<double, 2, 2> phi = {{1.0, dt}, {0.0, 1.0}};
+    matrix::Matrix<double, 2, 1> gamma = {{dt*dt/2.0}, {dt}};
+    matrix::Matrix<double, 2, 2> Qd = {{q*dt*dt*dt/3.0, q*dt*dt/2.0}, {q*dt*dt/2.0, q*dt}};
+    EXPECT_LT(test::maxDifference(d.phi(), phi), 1.0e-16);
+    EXPECT_LT(test::maxDifference(d.gamma(), gamma), 1.0e-16);
+    EXPECT_LT(test::maxDifference(d.processNoise(), Qd), 1.0e-16);
+}
+
+TEST(DiscretizationTestSuite, TestSeparateExponentials)
+{
+    test::Random random(51);
+    for(size_t trial = 0; trial < 20; ++trial)
+    {
+        const double dt = 0.05 + 0.1*trial;
+        matrix::SquareMatrix<double, 5> A;
+        matrix::Matrix<double, 5, 2> B;
+        matrix::SquareMatrix<double, 5> G;
+        test::fill(A, random, 2.0);
+        test::fill(B, random);
+        test::fill(G, random);
+        const matrix::SquareMatrix<double, 5> Q = G*G.transpose();
+        const matrix::Discretization<double, 5, 2> d = matrix::c2d(A, B, Q, dt);
+
+        // Phi and Gamma from e^([A B; 0 0] dt)
+        matrix::SquareMatrix<double, 7> F;
+        for(size_t i = 0; i < 5; ++i)
+        {
+            for(size_t j = 0; j < 5; ++j)
+            {
+                F(i,j) = A(i,j)*dt;
+            }
+            F(i,5) = B(i,0)*dt;
+            F(i,6) = B(i,1)*dt;
+        }
+        const matrix::SquareMatrix<double, 7> EF = matrix::expm(F);
+
+        // Van Loan: Qd = Phi E12 from e^([-A Q; 0 A^T] dt)
+        matrix::SquareMatrix<double, 10> C;
+        for(size_t i = 0; i < 5; ++i)
+        {
+            for(size_t j = 0; j < 5; ++j)
+            {
+                C(i,j) = -A(i,j)*dt;
+                C(i,j+5) = Q(i,j)*dt;
+                C(i+5,j+5) = A(j,i)*dt;
+            }
+        }
+        const matrix::SquareMatrix<double, 10> EC = matrix::expm(C);
+
+        matrix::SquareMatrix<double, 5> phi;
+        matrix::Matrix<double, 5, 2> gamma;
+        matrix::SquareMatrix<double, 5> E12;
+        for(size_t i = 0; i < 5; ++i)
+        {
+            for(size_t j = 0; j < 5; ++j)
+            {
+                phi(i,j) = EF(i,j);
+                E12(i,j) = EC(i,j+5);
+            }
+            gamma(i,0) = EF(i,5);
+            gamma(i,1) = EF(i,6);
+        }
+        const matrix::SquareMatrix<double, 5> Qd = phi*E12;
+
+        // Relative to the size of each result
+        const matrix::SquareMatrix<double, 5> zero;
+        const double size = std::max(1.0, test::maxDifference(Qd, zero));
+        EXPECT_LT(test::maxDifference(d.phi(), phi), 1.0e-13*std::max(1.0, test::maxDifference(phi, zero)));
+        EXPECT_LT(test::maxDifference(d.gamma(), gamma), 1.0e-13*std::max(1.0, test::maxDifference(phi, zero)));
+        EXPECT_LT(test::maxDifference(d.processNoise(), Qd), 1.0e-13*size);
+        EXPECT_LT(test::maxDifference(d.processNoise(), d.processNoise().transpose()), 1.0e-300);
+    }
+}
+
+TEST(DiscretizationTestSuite, TestReuse)
+{
+    matrix::Matrix<double, 2, 2> A = {{0.0, 1.0}, {-4.0, -0.4}};
+    matrix::Matrix<double, 2, 1> B = {{0.0}, {1.0}};
+    matrix::Matrix<double, 2, 2> Q = {{0.01, 0.0}, {0.0, 0.2}};
+
+    matrix::Discretization<double, 2, 1> d;
+    matrix::SquareMatrix<double, 2> I;
+    I.identity();
+    EXPECT_LT(test::maxDifference(d.phi(), I), 1.0e-300);
+
+    d.compute(A, B, Q, 0.01);
+    const matrix::SquareMatrix<double, 2> first = d.phi();
+    d.compute(A, B, Q, 0.01);
+    EXPECT_LT(test::maxDifference(d.phi(), first), 1.0e-300);
+
+    // A new step or a changed system is discretized again
+    d.compute(A, B, Q, 0.02);
+    EXPECT_LT(test::maxDifference(d.phi(), first*first), 1.0e-15);
+    A(1,0) = -5.0;
+    d.compute(A, B, Q, 0.02);
+    EXPECT_LT(test::maxDifference(d.phi(), matrix::c2d(A, B, Q, 0.02).phi()), 1.0e-300);
+    EXPECT_GT(test::maxDifference(d.phi(), first*first), 1.0e-5);
+}
@@ -0,0 +1,193 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TestDynamicMatrix.cpp
+//!
+//! Unit test for DynamicMatrix.hpp
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <iostream>
+#include <gtest/gtest.h>
+#include "../src/DynamicMatrix.hpp"
+#include "../src/SquareMatrix.hpp"
+#include "TestHelpers.hpp"
+
+namespace
+{
+
+//! Fill a matrix through operator() with deterministic values
+template<class Mat>
+void fill(Mat &m, size_t rows, size_t cols, double offset)
+{
+    for(size_t i = 0; i < rows; ++i)
+    {
+        for(size_t j = 0; j < cols; ++j)
+        {
+            m(i,j) = 0.25*static_cast<double>((i*7 + j*3) % 11) + offset;
+        }
+    }
+}
+
+} // namespace
+
+TEST(DynamicMatrixTestSuite, TestConstruction)
+{
+    matrix::DynamicMatrix<double> empty;
+    EXPECT_EQ(0u, empty.rows());
+    EXPECT_EQ(0u, empty.cols());
+
+    matrix::DynamicMatrix<double> zeros(4, 7);
+    EXPECT_EQ(4u, zeros.rows());
+    EXPECT_EQ(7u, zeros.cols());
+    EXPECT_EQ(28u, zeros.size());
+    EXPECT_EQ(0.0, zeros(3,6));
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(zeros.data()) % MTL_HEAP_STORAGE_ALIGNMENT);
+
+    const double vals[6] = {1, 2, 3, 4, 5, 6};
+    matrix::DynamicMatrix<double> flat(2, 3, vals);
+    EXPECT_EQ(6.0, flat(1,2));
+
+    matrix::DynamicMatrix<int> list = {{1, 2, 3}, {4, 5, 6}};
+    EXPECT_EQ(2u, list.rows());
+    EXPECT_EQ(3u, list.cols());
+    EXPECT_EQ(4, list(1,0));
+    EXPECT_THROW((matrix::DynamicMatrix<int>{{1, 2}, {3}}), std::invalid_argument);
+
+    if(matrix::DefaultBounds::enabled)
+    {
+        EXPECT_THROW(zeros(4,0), std::domain_error);
+        EXPECT_THROW(zeros(0,7), std::domain_error);
+    }
+
+    zeros.resize(2, 2);
+    EXPECT_EQ(4u, zeros.size());
+}
+
+TEST(DynamicMatrixTestSuite, TestArithmetic)
+{
+    matrix::DynamicMatrix<int> a = {{1, 2}, {3, 4}};
+    matrix::DynamicMatrix<int> b = {{5, 6}, {7, 8}};
+
+    EXPECT_TRUE((a + b == matrix::DynamicMatrix<int>{{6, 8}, {10, 12}}));
+    EXPECT_TRUE((b - a == matrix::DynamicMatrix<int>{{4, 4}, {4, 4}}));
+    EXPECT_TRUE((-a == matrix::DynamicMatrix<int>{{-1, -2}, {-3, -4}}));
+    EXPECT_TRUE((a * b == matrix::DynamicMatrix<int>{{19, 22}, {43, 50}}));
+    EXPECT_TRUE((a * 2 == matrix::DynamicMatrix<int>{{2, 4}, {6, 8}}));
+    EXPECT_TRUE((2 * a == matrix::DynamicMatrix<int>{{2, 4}, {6, 8}}));
+    EXPECT_TRUE((b / 2 == matrix::DynamicMatrix<int>{{2, 3}, {3, 4}}));
+    EXPECT_TRUE((a + 1 == matrix::DynamicMatrix<int>{{2, 3}, {4, 5}}));
+    EXPECT_TRUE((a - 1 == matrix::DynamicMatrix<int>{{0, 1}, {2, 3}}));
+
+    a *= b;
+    EXPECT_TRUE((a == matrix::DynamicMatrix<int>{{19, 22}, {43, 50}}));
+    EXPECT_TRUE(a != b);
+
+    matrix::DynamicMatrix<int> c(2, 3);
+    EXPECT_THROW(a + c, std::domain_error);
+    EXPECT_THROW(c * a, std::domain_error);
+    EXPECT_EQ(2u, (a * c).rows());
+    EXPECT_EQ(3u, (a * c).cols());
+}
+
+TEST(DynamicMatrixTestSuite, TestTransposeSwapAndAbs)
+{
+    matrix::DynamicMatrix<double> m = {{1, -2, 3}, {-4, 5, -6}};
+    matrix::DynamicMatrix<double> t = m.transpose();
+    EXPECT_EQ(3u, t.rows());
+    EXPECT_EQ(2u, t.cols());
+    EXPECT_EQ(-6.0, t(2,1));
+
+    EXPECT_TRUE((m.abs() == matrix::DynamicMatrix<double>{{1, 2, 3}, {4, 5, 6}}));
+
+    m.swapRows(0, 1);
+    EXPECT_EQ(-4.0, m(0,0));
+    m.swapCols(0, 2);
+    EXPECT_EQ(-6.0, m(0,0));
+    EXPECT_THROW(m.swapRows(0, 2), std::domain_error);
+    EXPECT_THROW(m.swapCols(3, 0), std::domain_error);
+
+    m.setValue(1.5);
+    EXPECT_EQ(1.5, m(1,2));
+}
+
+TEST(DynamicMatrixTestSuite, TestFixedSizeInterop)
+{
+    matrix::SquareMatrix<double, 3> fixed;
+    fill(fixed, 3, 3, 0.5);
+    matrix::Matrix<double, 3, 2> column;
+    fill(column, 3, 2, -1.0);
+
+    // Construct from and convert back to fixed-size matrices and expressions
+    matrix::DynamicMatrix<double> dyn(fixed);
+    EXPECT_EQ(3u, dyn.rows());
+    EXPECT_TRUE((dyn.toMatrix<3, 3>() == fixed));
+    EXPECT_THROW((dyn.toMatrix<3, 2>()), std::domain_error);
+
+    matrix::DynamicMatrix<double> sum = fixed + fixed;
+    EXPECT_TRUE((sum.toMatrix<3, 3>() == fixed*2.0));
+    sum = fixed*3.0;
+    EXPECT_TRUE((sum.toMatrix<3, 3>() == fixed*3.0));
+
+    // Mixed operations read the fixed-size operand in place
+    EXPECT_TRUE(((dyn * column).toMatrix<3, 2>() == fixed * column));
+    EXPECT_TRUE(((fixed * dyn).toMatrix<3, 3>() == fixed * fixed));
+    EXPECT_TRUE(((dyn + fixed).toMatrix<3, 3>() == fixed + fixed));
+    EXPECT_TRUE(((fixed - dyn).toMatrix<3, 3>() == fixed - fixed));
+    dyn += fixed;
+    dyn -= fixed*2.0;
+    EXPECT_EQ(0.0, dyn(1,1));
+    EXPECT_THROW(dyn += column, std::domain_error);
+}
+
+TEST(DynamicMatrixTestSuite, TestProductsMatchFixedSizeKernels)
+{
+    // Shapes with a fixed-size kernel, the blocked kernel and the generic loop.
+    // Both sides sum in the same order but may be contracted into FMAs differently.
+    matrix::SquareMatrix<double, 6> a6;
+    matrix::SquareMatrix<double, 6> b6;
+    fill(a6, 6, 6, 0.1);
+    fill(b6, 6, 6, -0.3);
+    const matrix::DynamicMatrix<double> d6 = matrix::DynamicMatrix<double>(a6) * matrix::DynamicMatrix<double>(b6);
+    EXPECT_LT(test::maxDifference(d6.toMatrix<6, 6>(), a6 * b6), 1.0e-12);
+
+    matrix::Matrix<double, 40, 33> a40;
+    matrix::Matrix<double, 33, 50> b40;
+    fill(a40, 40, 33, 0.2);
+    fill(b40, 33, 50, -0.7);
+    const matrix::DynamicMatrix<double> d40 = matrix::DynamicMatrix<double>(a40) * matrix::DynamicMatrix<double>(b40);
+    EXPECT_LT(test::maxDifference(d40.toMatrix<40, 50>(), a40 * b40), 1.0e-10);
+
+    matrix::Matrix<double, 5, 7> a5;
+    matrix::Matrix<double, 7, 2> b5;
+    fill(a5, 5, 7, 0.0);
+    fill(b5, 7, 2, 1.0);
+    const matrix::DynamicMatrix<double> d5 = matrix::DynamicMatrix<double>(a5) * matrix::DynamicMatrix<double>(b5);
+    EXPECT_LT(test::maxDifference(d5.toMatrix<5, 2>(), a5 * b5), 1.0e-12);
+}
+
+TEST(DynamicMatrixTestSuite, TestBlockView)
+{
+    matrix::DynamicMatrix<double> P(6, 6);
+    matrix::SquareMatrix<double, 3> F;
+    fill(F, 3, 3, 0.5);
+
+    P.block<3, 3>(3, 3) += F * F;
+    EXPECT_TRUE((matrix::Matrix<double, 3, 3>(P.block<3, 3>(3, 3)) == F * F));
+    EXPECT_EQ(0.0, P(2,2));
+    EXPECT_TRUE((P.block<3, 3>(3, 3) * F == (F * F) * F));
+    if(matrix::DefaultBounds::enabled)
+    {
+        EXPECT_THROW((P.block<3, 3>(4, 0)), std::domain_error);
+    }
+}
+
+TEST(DynamicMatrixTestSuite, TestAllocator)
+{
+    std::allocator<float> allocator;
+    matrix::DynamicMatrix<float, std::allocator<float>> m(3, 4, allocator);
+    m(2,3) = 1.0f;
+    matrix::DynamicMatrix<float, std::allocator<float>> t = m.transpose();
+    EXPECT_EQ(1.0f, t(3,2));
+}
@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TestDynamicVector.cpp
+//!
+//! Unit test for DynamicVector.hpp
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <gtest/gtest.h>
+#include "../src/DynamicVector.hpp"
+
+TEST(DynamicVectorTestSuite, TestConstruction)
+{
+    matrix::DynamicVector<double> empty;
+    EXPECT_EQ(0u, empty.size());
+    EXPECT_EQ(1u, empty.cols());
+
+    matrix::DynamicVector<double> zeros(5);
+    EXPECT_EQ(5u, zeros.size());
+    EXPECT_EQ(0.0, zeros(4));
+    if(matrix::DefaultBounds::enabled)
+    {
+        EXPECT_THROW(zeros(5), std::domain_error);
+    }
+
+    matrix::DynamicVector<double> v = {1.0, 2.0, 2.0};
+    EXPECT_EQ(3u, v.size());
+    EXPECT_EQ(2.0, v(2));
+
+    const double vals[4] = {4.0, 3.0, 2.0, 1.0};
+    matrix::DynamicVector<double> fromArray(4, vals);
+    EXPECT_EQ(1.0, fromArray(3));
+
+    zeros.resize(8);
+    EXPECT_EQ(8u, zeros.size());
+
+    matrix::DynamicMatrix<double> notColumn(2, 2);
+    EXPECT_THROW(matrix::DynamicVector<double> bad(notColumn), std::domain_error);
+}
+
+TEST(DynamicVectorTestSuite, TestVectorOperations)
+{
+    matrix::DynamicVector<double> a = {1.0, 2.0, 2.0};
+    matrix::DynamicVector<double> b = {3.0, -1.0, 0.5};
+
+    EXPECT_DOUBLE_EQ(2.0, a.dot(b));
+    EXPECT_DOUBLE_EQ(2.0, a*b);
+    EXPECT_DOUBLE_EQ(3.0, a.norm());
+    EXPECT_DOUBLE_EQ(3.0, a.length());
+
+    matrix::DynamicVector<double> scaled = a*2.0;
+    EXPECT_EQ(4.0, scaled(2));
+
+    matrix::DynamicVector<double> unit = a.unit();
+    EXPECT_DOUBLE_EQ(1.0, unit.norm());
+    a.normalize();
+    EXPECT_TRUE(a == unit);
+
+    matrix::DynamicVector<double> sum = a + b;
+    EXPECT_DOUBLE_EQ(unit(0) + 3.0, sum(0));
+
+    matrix::DynamicVector<double> shorter(2);
+    EXPECT_THROW(a.dot(shorter), std::domain_error);
+}
+
+TEST(DynamicVectorTestSuite, TestFixedSizeInterop)
+{
+    matrix::Vector<double, 3> fixed = {1.0, -2.0, 0.5};
+    matrix::DynamicVector<double> v(fixed);
+    EXPECT_EQ(3u, v.size());
+    EXPECT_TRUE((v.toVector<3>() == fixed));
+    EXPECT_THROW(v.toVector<4>(), std::domain_error);
+
+    // Matrix-vector products run the fixed-size 3x3 kernel on the dynamic storage
+    matrix::Matrix<double, 3, 3> rotation = {{0.0, -1.0, 0.0}, {1.0, 0.0, 0.0}, {0.0, 0.0, 1.0}};
+    matrix::DynamicMatrix<double> dynRotation(rotation);
+    matrix::DynamicVector<double> rotated = dynRotation * v;
+    EXPECT_TRUE((rotated.toVector<3>() == matrix::Vector<double, 3>(rotation * fixed)));
+    matrix::DynamicVector<double> mixed = rotation * v;
+    EXPECT_TRUE(mixed == rotated);
+}
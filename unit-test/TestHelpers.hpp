@@ -0,0 +1,65 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TestHelpers.hpp
+//!
+//! Random matrices and matrix comparisons shared by the unit tests. Every
+//! test seeds its own generator, so its inputs do not depend on which tests
+//! ran before it in the TestMatrix binary. std::mt19937 gives the same
+//! sequence on every platform; values are scaled by hand because the output
+//! of std::uniform_real_distribution is implementation defined.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _TEST_HELPERS_HPP__
+#define _TEST_HELPERS_HPP__
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+
+#include "../src/Matrix.hpp"
+
+namespace test
+{
+
+//! Deterministic generator (construct one per test with its own seed)
+using Random = std::mt19937;
+
+//! Next value in [-0.5, 0.5]
+inline double uniform(Random &random)
+{
+    return static_cast<double>(random()) / static_cast<double>(Random::max()) - 0.5;
+}
+
+//! Fill a matrix with values in [-scale/2, scale/2]
+template<size_t M, size_t N>
+void fill(matrix::Matrix<double, M, N> &m, Random &random, double scale = 1.0)
+{
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < N; ++j)
+        {
+            m(i,j) = scale*uniform(random);
+        }
+    }
+}
+
+//! Largest absolute difference between two matrices
+template<size_t M, size_t N>
+double maxDifference(const matrix::Matrix<double, M, N> &a, const matrix::Matrix<double, M, N> &b)
+{
+    double largest = 0.0;
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < N; ++j)
+        {
+            largest = std::max(largest, std::fabs(a(i,j) - b(i,j)));
+        }
+    }
+    return largest;
+}
+
+} // namespace test
+
+#endif // _TEST_HELPERS_HPP__
@@ -0,0 +1,192 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TestHouseholderQR.cpp
+//!
+//! Unit test for HouseholderQR.hpp
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <iostream>
+#include <gtest/gtest.h>
+#include "../src/HouseholderQR.hpp"
+#include "TestHelpers.hpp"
+
+TEST(HouseholderQRTestSuite, TestFactors)
+{
+    test::Random random(21);
+    matrix::Matrix<double, 12, 5> A;
+    test::fill(A, random);
+    matrix::HouseholderQR<double, 12, 5> qr(A);
+    EXPECT_FALSE(qr.isRankDeficient());
+
+    matrix::Matrix<double, 12, 5> Q = qr.thinQ();
+    matrix::SquareMatrix<double, 5> R = qr.matrixR();
+    EXPECT_LT(test::maxDifference(Q*R, A), 1.0e-14);
+
+    matrix::SquareMatrix<double, 5> I;
+    I.identity();
+    EXPECT_LT(test::maxDifference(Q.transpose()*Q, I), 1.0e-14);
+    for(size_t i = 1; i < 5; ++i)
+    {
+        for(size_t j = 0; j < i; ++j)
+        {
+            EXPECT_DOUBLE_EQ(0.0, R(i,j));
+        }
+    }
+}
+
+TEST(HouseholderQRTestSuite, TestLeastSquares)
+{
+    // Fit y = c0 + c1 t + c2 t^2 to exact samples, then to noisy samples
+    matrix::Matrix<double, 8, 3> A;
+    matrix::Vector<double, 8> b;
+    for(size_t i = 0; i < 8; ++i)
+    {
+        const double t = 0.5*i;
+        A(i,0) = 1.0;
+        A(i,1) = t;
+        A(i,2) = t*t;
+        b(i) = 2.0 - 3.0*t + 0.5*t*t;
+    }
+    matrix::HouseholderQR<double, 8, 3> qr(A);
+    matrix::Vector<double, 3> x = qr.solve(b);
+    EXPECT_NEAR(2.0, x(0), 1.0e-13);
+    EXPECT_NEAR(-3.0, x(1), 1.0e-13);
+    EXPECT_NEAR(0.5, x(2), 1.0e-13);
+
+    // The residual of the least-squares solution is orthogonal to the columns of A
+    test::Random random(22);
+    matrix::Vector<double, 8> noise;
+    test::fill(noise, random);
+    matrix::Vector<double, 8> noisy = b + noise;
+    matrix::Vector<double, 3> xn = qr.solve(noisy);
+    matrix::Matrix<double, 8, 1> residual = A*xn - noisy;
+    matrix::Matrix<double, 3, 1> normal = A.transpose()*residual;
+    for(size_t j = 0; j < 3; ++j)
+    {
+        EXPECT_NEAR(0.0, normal(j,0), 1.0e-12);
+    }
+
+    // Columns of B are solved independently
+    matrix::Matrix<double, 8, 2> B;
+    for(size_t i = 0; i < 8; ++i)
+    {
+        B(i,0) = b(i);
+        B(i,1) = noisy(i);
+    }
+    matrix::Matrix<double, 3, 2> X = qr.solve(B);
+    for(size_t j = 0; j < 3; ++j)
+    {
+        EXPECT_NEAR(x(j), X(j,0), 1.0e-13);
+        EXPECT_NEAR(xn(j), X(j,1), 1.0e-13);
+    }
+}
+
+TEST(HouseholderQRTestSuite, TestBlocked)
+{
+    test::Random random(23);
+    matrix::Matrix<double, 60, 20> A;
+    test::fill(A, random);
+    matrix::HouseholderQR<double, 60, 20> qr(A);
+    matrix::HouseholderQR<double, 60, 20> blocked;
+    blocked.computeBlocked(A);
+    EXPECT_LT(test::maxDifference(qr.matrixR(), blocked.matrixR()), 1.0e-13);
+    EXPECT_LT(test::maxDifference(blocked.thinQ()*blocked.matrixR(), A), 1.0e-13);
+
+    matrix::Vector<double, 60> b;
+    test::fill(b, random);
+    EXPECT_LT(test::maxDifference(qr.solve(b), blocked.solve(b)), 1.0e-12);
+}
+
+TEST(HouseholderQRTestSuite, TestAppendRow)
+{
+    test::Random random(24);
+    matrix::Matrix<double, 20, 4> A;
+    matrix::Vector<double, 20> b;
+    test::fill(A, random);
+    test::fill(b, random);
+    matrix::HouseholderQR<double, 20, 4> batch(A);
+    matrix::Vector<double, 4> expected = batch.solve(b);
+    matrix::Matrix<double, 20, 1> residual = A*expected - b;
+
+    // Factor the first 6 rows, then stream in the rest
+    matrix::Matrix<double, 6, 4> head;
+    matrix::Vector<double, 6> headB;
+    for(size_t i = 0; i < 6; ++i)
+    {
+        for(size_t j = 0; j < 4; ++j)
+        {
+            head(i,j) = A(i,j);
+        }
+        headB(i) = b(i);
+    }
+    matrix::HouseholderQR<double, 6, 4> stream;
+    stream.compute(head, headB);
+    for(size_t i = 6; i < 20; ++i)
+    {
+        matrix::Matrix<double, 1, 4> row;
+        for(size_t j = 0; j < 4; ++j)
+        {
+            row(0,j) = A(i,j);
+        }
+        stream.appendRow(row, b(i));
+    }
+    EXPECT_LT(test::maxDifference(expected, stream.solve()), 1.0e-12);
+    EXPECT_NEAR(std::sqrt((residual.transpose()*residual)(0,0)), stream.residualNorm(), 1.0e-12);
+    EXPECT_THROW(stream.solve(headB), std::runtime_error);
+
+    // A stream can also start from nothing
+    matrix::HouseholderQR<double, 4, 4> empty;
+    EXPECT_TRUE(empty.isRankDeficient());
+    for(size_t i = 0; i < 20; ++i)
+    {
+        matrix::Matrix<double, 1, 4> row;
+        for(size_t j = 0; j < 4; ++j)
+        {
+            row(0,j) = A(i,j);
+        }
+        empty.appendRow(row, b(i));
+    }
+    EXPECT_LT(test::maxDifference(expected, empty.solve()), 1.0e-12);
+}
+
+TEST(HouseholderQRTestSuite, TestAppendRowNeedsRightHandSide)
+{
+    matrix::Matrix<double, 5, 2> A = {{1.0, 0.5}, {2.0, -1.0}, {0.5, 3.0}, {-1.5, 1.0}, {2.5, 2.0}};
+    matrix::Vector<double, 5> b = {1.0, -2.0, 0.5, 3.0, 1.5};
+    matrix::Matrix<double, 1, 2> row = {{1.0, 1.0}};
+
+    // compute(A) and computeBlocked(A) do not keep Q^T b, so the accumulated
+    // problem is unknown and must not be solved as if b were zero
+    matrix::HouseholderQR<double, 5, 2> qr(A);
+    EXPECT_THROW(qr.appendRow(row, 2.0), std::runtime_error);
+    EXPECT_THROW(qr.solve(), std::runtime_error);
+    EXPECT_THROW(qr.residualNorm(), std::runtime_error);
+    EXPECT_NO_THROW(qr.solve(b));
+
+    qr.computeBlocked(A);
+    EXPECT_THROW(qr.appendRow(row, 2.0), std::runtime_error);
+    EXPECT_THROW(qr.solve(), std::runtime_error);
+
+    // Refactoring with b makes the stream usable again, and compute(A) clears it
+    qr.compute(A, b);
+    EXPECT_NO_THROW(qr.appendRow(row, 2.0));
+    EXPECT_NO_THROW(qr.solve());
+    qr.compute(A);
+    EXPECT_THROW(qr.solve(), std::runtime_error);
+}
+
+TEST(HouseholderQRTestSuite, TestRankDeficient)
+{
+    matrix::Matrix<double, 4, 2> A = {{1.0, 2.0}, {2.0, 4.0}, {3.0, 6.0}, {4.0, 8.0}};
+    matrix::HouseholderQR<double, 4, 2> qr(A);
+    EXPECT_TRUE(qr.isRankDeficient() || std::fabs(qr.matrixR()(1,1)) < 1.0e-14);
+
+    matrix::Matrix<double, 4, 2> zeroColumn = {{1.0, 0.0}, {2.0, 0.0}, {3.0, 0.0}, {4.0, 0.0}};
+    matrix::HouseholderQR<double, 4, 2> qrZero(zeroColumn);
+    EXPECT_TRUE(qrZero.isRankDeficient());
+    matrix::Vector<double, 4> b = {1.0, 2.0, 3.0, 4.0};
+    EXPECT_THROW(qrZero.solve(b), std::runtime_error);
+}
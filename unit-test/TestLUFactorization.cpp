@@ -0,0 +1,140 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TestLUFactorization.cpp
+//!
+//! Unit test for LUFactorization.hpp
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <iostream>
+#include <gtest/gtest.h>
+#include "../src/LUFactorization.hpp"
+#include "TestHelpers.hpp"
+
+TEST(LUFactorizationTestSuite, TestFactors)
+{
+    matrix::SquareMatrix<double, 3> A = {{2.0, 1.0, 1.0}, {4.0, -6.0, 0.0}, {-2.0, 7.0, 2.0}};
+    matrix::LUFactorization<double, 3> lu(A);
+    EXPECT_FALSE(lu.isSingular());
+
+    // The largest element of the first column is pivoted to the top
+    EXPECT_EQ(1u, lu.permutation(0));
+    EXPECT_DOUBLE_EQ(4.0, lu.upper()(0,0));
+
+    matrix::SquareMatrix<double, 3> PA;
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < 3; ++j)
+        {
+            PA(i,j) = A(lu.permutation(i), j);
+        }
+    }
+    matrix::SquareMatrix<double, 3> L = lu.lower();
+    matrix::SquareMatrix<double, 3> U = lu.upper();
+    EXPECT_LT(test::maxDifference(L*U, PA), 1.0e-12);
+    for(size_t i = 0; i < 3; ++i)
+    {
+        EXPECT_DOUBLE_EQ(1.0, L(i,i));
+        for(size_t j = i+1; j < 3; ++j)
+        {
+            EXPECT_DOUBLE_EQ(0.0, L(i,j));
+            EXPECT_DOUBLE_EQ(0.0, U(j,i));
+        }
+        EXPECT_LE(std::fabs(L(2,i)), 1.0);
+    }
+}
+
+TEST(LUFactorizationTestSuite, TestZeroPivot)
+{
+    // Invertible, but the unpivoted decomposition divides by A(0,0) = 0
+    matrix::SquareMatrix<double, 3> A = {{0.0, 1.0, 2.0}, {1.0, 0.0, 3.0}, {4.0, -3.0, 8.0}};
+    matrix::LUFactorization<double, 3> lu(A);
+    EXPECT_FALSE(lu.isSingular());
+    EXPECT_DOUBLE_EQ(matrix::determinant<double>(A), lu.determinant());
+
+    matrix::Vector<double, 3> b = {1.0, 2.0, 3.0};
+    matrix::Vector<double, 3> x = lu.solve(b);
+    EXPECT_LT(test::maxDifference(A*x, b), 1.0e-12);
+}
+
+TEST(LUFactorizationTestSuite, TestSolve)
+{
+    test::Random random(15);
+    matrix::SquareMatrix<double, 8> A;
+    test::fill(A, random);
+    matrix::LUFactorization<double, 8> lu(A);
+
+    // One factorization serves many right-hand sides
+    for(size_t n = 0; n < 5; ++n)
+    {
+        matrix::Vector<double, 8> b;
+        test::fill(b, random);
+        matrix::Vector<double, 8> x = lu.solve(b);
+        EXPECT_LT(test::maxDifference(A*x, b), 1.0e-10);
+    }
+
+    matrix::Matrix<double, 8, 3> B;
+    test::fill(B, random);
+    matrix::Matrix<double, 8, 3> X = lu.solve(B);
+    EXPECT_LT(test::maxDifference(A*X, B), 1.0e-10);
+
+    // Each column matches the single right-hand side solve
+    for(size_t j = 0; j < 3; ++j)
+    {
+        matrix::Vector<double, 8> b;
+        for(size_t i = 0; i < 8; ++i)
+        {
+            b(i) = B(i,j);
+        }
+        matrix::Vector<double, 8> x = lu.solve(b);
+        for(size_t i = 0; i < 8; ++i)
+        {
+            EXPECT_DOUBLE_EQ(x(i), X(i,j));
+        }
+    }
+
+    // compute() refactors the same object
+    matrix::SquareMatrix<double, 8> A2;
+    test::fill(A2, random);
+    lu.compute(A2);
+    matrix::Vector<double, 8> b;
+    test::fill(b, random);
+    EXPECT_LT(test::maxDifference(A2*lu.solve(b), b), 1.0e-10);
+}
+
+TEST(LUFactorizationTestSuite, TestDeterminantAndInverse)
+{
+    matrix::SquareMatrix<double, 3> A = {{1.0, 2.0, 3.0}, {0.0, 1.0, 4.0}, {5.0, 6.0, 0.0}};
+    matrix::LUFactorization<double, 3> lu(A);
+    EXPECT_NEAR(matrix::determinant<double>(A), lu.determinant(), 1.0e-12);
+    EXPECT_LT(test::maxDifference(matrix::inverse<double>(A), lu.inverse()), 1.0e-12);
+
+    test::Random random(16);
+    matrix::SquareMatrix<double, 5> B;
+    test::fill(B, random);
+    matrix::LUFactorization<double, 5> luB(B);
+    EXPECT_NEAR(matrix::determinant<double>(B), luB.determinant(), 1.0e-12);
+
+    matrix::SquareMatrix<double, 32> C;
+    test::fill(C, random);
+    matrix::LUFactorization<double, 32> luC(C);
+    matrix::SquareMatrix<double, 32> I;
+    I.identity();
+    EXPECT_LT(test::maxDifference(C*luC.inverse(), I), 1.0e-9);
+}
+
+TEST(LUFactorizationTestSuite, TestSingular)
+{
+    matrix::SquareMatrix<double, 3> A = {{1.0, 2.0, 3.0}, {2.0, 4.0, 6.0}, {1.0, 0.0, 1.0}};
+    matrix::LUFactorization<double, 3> lu(A);
+    EXPECT_TRUE(lu.isSingular());
+    EXPECT_DOUBLE_EQ(0.0, lu.determinant());
+    matrix::Vector<double, 3> b = {1.0, 2.0, 3.0};
+    EXPECT_THROW(lu.solve(b), std::runtime_error);
+    EXPECT_THROW(lu.inverse(), std::runtime_error);
+
+    matrix::LUFactorization<double, 3> empty;
+    EXPECT_TRUE(empty.isSingular());
+}
@@ -8,6 +8,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <iostream>
+#include <limits>
+#include <sstream>
 #include <gtest/gtest.h>
 #include "../src/Matrix.hpp"
 
@@ -147,6 +149,59 @@ TEST(MatrixTestSuite, TestElementAccessOperator)
     EXPECT_EQ(-3, m(0,1));
 }
 
+TEST(MatrixTestSuite, TestCheckedElementAccessThrows)
+{
+    // Named explicitly, since a build may change the default policy
+    matrix::Matrix<int, 2, 3, matrix::CheckedBounds> m;
+    const matrix::Matrix<int, 2, 3, matrix::CheckedBounds> &cm = m;
+    EXPECT_THROW(m(2,0), std::domain_error);
+    EXPECT_THROW(m(0,3), std::domain_error);
+    EXPECT_THROW(cm(2,3), std::domain_error);
+    EXPECT_NO_THROW(m(1,2));
+
+    // Debug policy checks whenever NDEBUG is not defined
+    matrix::Matrix<int, 2, 3, matrix::DebugBounds> d;
+#ifndef NDEBUG
+    EXPECT_TRUE(matrix::DebugBounds::enabled);
+    EXPECT_THROW(d(2,0), std::domain_error);
+#else
+    EXPECT_FALSE(matrix::DebugBounds::enabled);
+#endif
+    EXPECT_NO_THROW(d(1,2));
+    EXPECT_TRUE(matrix::CheckedBounds::enabled);
+    EXPECT_FALSE(matrix::UncheckedBounds::enabled);
+}
+
+TEST(MatrixTestSuite, TestUncheckedBoundsPolicy)
+{
+    double vals1[4] = {1.5, -2.0, 3.25, 4.0};
+    double vals2[4] = {0.5, 6.0, -1.0, 2.0};
+    matrix::Matrix<double, 2, 2, matrix::UncheckedBounds> u1(vals1);
+    matrix::Matrix<double, 2, 2, matrix::UncheckedBounds> u2(vals2);
+    matrix::Matrix<double, 2, 2> c1(vals1);
+    matrix::Matrix<double, 2, 2> c2(vals2);
+
+    matrix::Matrix<double, 2, 2, matrix::UncheckedBounds> uprod = u1 * u2;
+    matrix::Matrix<double, 2, 2> cprod = c1 * c2;
+    matrix::Matrix<double, 2, 2, matrix::UncheckedBounds> usum = u1 + u2*2.0;
+    matrix::Matrix<double, 2, 2> csum = c1 + c2*2.0;
+    for(size_t i = 0; i < 2; ++i)
+    {
+        for(size_t j = 0; j < 2; ++j)
+        {
+            EXPECT_DOUBLE_EQ(cprod(i,j), uprod(i,j));
+            EXPECT_DOUBLE_EQ(csum(i,j), usum(i,j));
+        }
+    }
+
+    // Policies can be mixed within an expression
+    matrix::Matrix<double, 2, 2> mixed = c1 - u2;
+    EXPECT_DOUBLE_EQ(1.0, mixed(0,0));
+    EXPECT_DOUBLE_EQ(-8.0, mixed(0,1));
+    EXPECT_DOUBLE_EQ(4.25, mixed(1,0));
+    EXPECT_DOUBLE_EQ(2.0, mixed(1,1));
+}
+
 TEST(MatrixTestSuite, TestMatrixAddition)
 {
     int vals1[4] = {1,2,3,4};
@@ -544,6 +599,193 @@ TEST(MatrixTestSuite, TestScalarMatrixMultiplication)
     EXPECT_EQ(16, result(1,1));
 }
 
+TEST(MatrixTestSuite, TestFusedExpressionMatchesEagerEvaluation)
+{
+    double a[9] = {0.1, 1.0/3.0, 2.7, -4.1, 5.3, 0.7, 1.0e-3, 8.9, -9.2};
+    double b[9] = {3.3, -0.2, 1.0/7.0, 4.4, 2.5, -6.6, 0.31, 7.7, 1.9};
+    double c[9] = {-1.5, 2.25, 0.6, 1.0/9.0, -3.1, 4.0, 5.5, -0.05, 2.2};
+    matrix::Matrix<double, 3, 3> A(a);
+    matrix::Matrix<double, 3, 3> B(b);
+    matrix::Matrix<double, 3, 3> C(c);
+    const double s = 0.37;
+
+    // Evaluate one operator at a time, materializing every intermediate
+    matrix::Matrix<double, 3, 3> t1 = B * s;
+    matrix::Matrix<double, 3, 3> t2 = A + t1;
+    matrix::Matrix<double, 3, 3> t3 = t2 - C;
+    matrix::Matrix<double, 3, 3> t4 = -t3;
+    matrix::Matrix<double, 3, 3> eager = t4 / 3.0;
+
+    matrix::Matrix<double, 3, 3> fused = -(A + B*s - C) / 3.0;
+    EXPECT_TRUE(fused == eager);
+
+    matrix::Matrix<double, 3, 3> assigned;
+    assigned = -(A + B*s - C) / 3.0;
+    EXPECT_TRUE(assigned == eager);
+
+    matrix::Matrix<double, 3, 3> compound = A;
+    compound += B*s - C;
+    matrix::Matrix<double, 3, 3> t5 = t1 - C;
+    matrix::Matrix<double, 3, 3> expected = A;
+    expected += t5;
+    EXPECT_TRUE(compound == expected);
+}
+
+TEST(MatrixTestSuite, TestExpressionMatrixMultiply)
+{
+    int vals1[4] = {1, 2, 3, 4};
+    int vals2[4] = {4, 3, 2, 1};
+    matrix::Matrix<int, 2, 2> m1(vals1);
+    matrix::Matrix<int, 2, 2> m2(vals2);
+
+    matrix::Matrix<int, 2, 2> sum = m1 + m2;
+    matrix::Matrix<int, 2, 2> expected = sum * m1;
+    matrix::Matrix<int, 2, 2> result = (m1 + m2) * m1;
+    EXPECT_TRUE(result == expected);
+
+    expected = m1 * sum;
+    result = m1 * (m1 + m2);
+    EXPECT_TRUE(result == expected);
+}
+
+TEST(MatrixTestSuite, TestExpressionsSupportMatrixMethods)
+{
+    int vals1[6] = {1, -2, 3, 4, -5, 6};
+    int vals2[6] = {6, 5, -4, 3, 2, -1};
+    matrix::Matrix<int, 2, 3> m1(vals1);
+    matrix::Matrix<int, 2, 3> m2(vals2);
+    const matrix::Matrix<int, 2, 3> sum = m1 + m2;
+    const matrix::Matrix<int, 2, 3> twice = m1 * 2;
+
+    // Call forms that compiled when the operators returned a Matrix
+    EXPECT_TRUE((m1 + m2).eval() == sum);
+    EXPECT_TRUE((m1 + m2).transpose() == sum.transpose());
+    EXPECT_TRUE((m1 * 2).abs() == twice.abs());
+    EXPECT_TRUE(((m1 - m2).submatrix<1, 2>(0, 0, 1, 2) == (m1 - m2).eval().submatrix<1, 2>(0, 0, 1, 2)));
+    EXPECT_TRUE((m1 + m2) == sum);
+    EXPECT_TRUE(sum == (m1 + m2));
+    EXPECT_TRUE((m1 * 2) == (m1 + m1));
+    EXPECT_TRUE((m1 + m2) != twice);
+    EXPECT_FALSE((m1 + m2) != sum);
+
+    std::ostringstream expression;
+    std::ostringstream evaluated;
+    expression << (m1 + m2);
+    evaluated << sum;
+    EXPECT_EQ(evaluated.str(), expression.str());
+}
+
+TEST(MatrixTestSuite, TestStoredExpressionHoldsTemporaries)
+{
+    int vals1[4] = {1, 2, 3, 4};
+    int vals2[4] = {4, 3, 2, 1};
+    matrix::Matrix<int, 2, 2> m1(vals1);
+    matrix::Matrix<int, 2, 2> m2(vals2);
+    const matrix::Matrix<int, 2, 2> product = m1 * m2;
+
+    // The products are temporaries; the expressions keep them alive
+    auto e1 = m1*m2 + m1;
+    auto e2 = m2 - m1*m2;
+    auto e3 = -(m1*m2) * 3;
+    auto e4 = (m1*m2 + m1) - m2*m1;
+    matrix::Matrix<int, 2, 2> r1 = e1;
+    matrix::Matrix<int, 2, 2> r2 = e2;
+    matrix::Matrix<int, 2, 2> r3 = e3;
+    matrix::Matrix<int, 2, 2> r4 = e4;
+    EXPECT_TRUE(r1 == product + m1);
+    EXPECT_TRUE(r2 == m2 - product);
+    EXPECT_TRUE(r3 == product * -3);
+    matrix::Matrix<int, 2, 2> reversed = m2 * m1;
+    EXPECT_TRUE(r4 == product + m1 - reversed);
+
+    // Heap-stored temporaries are moved into the expression
+    matrix::Matrix<double, 50, 50> a;
+    for(size_t i = 0; i < 50; ++i)
+    {
+        a(i,i) = 2.0;
+        a(i,(i+1)%50) = 1.0;
+    }
+    auto e5 = a*a + a;
+    const matrix::Matrix<double, 50, 50> square = a*a;
+    matrix::Matrix<double, 50, 50> r5 = e5;
+    EXPECT_TRUE(r5 == square + a);
+}
+
+// Kernels sum in the generic loop's order, but FMA contraction (e.g. -march=native)
+// may round each one differently: allow the error bound of an N-term dot product,
+// n*eps*sum|a_ik*b_kj|, with the sums of magnitudes taken from |A|*|B|
+template<class T, size_t M, size_t N, size_t P>
+void expectProductWithinRounding(const matrix::Matrix<T, M, N> &a, const matrix::Matrix<T, N, P> &b, const T *expected, const T *result)
+{
+    const matrix::Matrix<T, M, N> absA = a.abs();
+    const matrix::Matrix<T, N, P> absB = b.abs();
+    T magnitude[M*P];
+    matrix::detail::GenericMultiplyKernel<T, M, N, P>::apply(&absA(0,0), &absB(0,0), magnitude);
+    for(size_t i = 0; i < M*P; ++i)
+    {
+        EXPECT_NEAR(expected[i], result[i], 2*N*std::numeric_limits<T>::epsilon()*magnitude[i]);
+    }
+}
+
+template<size_t M, size_t N, size_t P>
+void expectKernelMatchesGenericLoop()
+{
+    matrix::Matrix<double, M, N> a;
+    matrix::Matrix<double, N, P> b;
+    for(size_t i = 0; i < M*N; ++i)
+    {
+        a(i/N, i%N) = 0.37*static_cast<double>(i) - 1.5;
+    }
+    for(size_t i = 0; i < N*P; ++i)
+    {
+        b(i/P, i%P) = 2.0 - 0.21*static_cast<double>(i);
+    }
+
+    double expected[M*P];
+    matrix::detail::GenericMultiplyKernel<double, M, N, P>::apply(&a(0,0), &b(0,0), expected);
+    matrix::Matrix<double, M, P> result = a * b;
+    expectProductWithinRounding(a, b, expected, &result(0,0));
+}
+
+TEST(MatrixTestSuite, TestSpecializedMultiplyKernels)
+{
+    expectKernelMatchesGenericLoop<3, 3, 3>();
+    expectKernelMatchesGenericLoop<3, 3, 1>();
+    expectKernelMatchesGenericLoop<4, 4, 1>();
+    expectKernelMatchesGenericLoop<6, 6, 6>();
+    expectKernelMatchesGenericLoop<6, 6, 1>();
+
+    matrix::Matrix<int, 3, 3> m = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+    matrix::Matrix<int, 3, 3> squared = m * m;
+    matrix::Matrix<int, 3, 3> expected = {{30, 36, 42}, {66, 81, 96}, {102, 126, 150}};
+    EXPECT_TRUE(squared == expected);
+}
+
+TEST(MatrixTestSuite, TestBlockedMultiplyKernel)
+{
+    // Shapes that leave partial register tiles, packed tiles and row panels
+    expectKernelMatchesGenericLoop<16, 16, 16>();
+    expectKernelMatchesGenericLoop<60, 60, 60>();
+    expectKernelMatchesGenericLoop<37, 150, 45>();
+
+    matrix::Matrix<float, 70, 33> a;
+    matrix::Matrix<float, 33, 41> b;
+    for(size_t i = 0; i < 70*33; ++i)
+    {
+        a(i/33, i%33) = 0.5f - 0.01f*static_cast<float>(i % 97);
+    }
+    for(size_t i = 0; i < 33*41; ++i)
+    {
+        b(i/41, i%41) = 0.03f*static_cast<float>(i % 61) - 0.7f;
+    }
+    float expected[70*41];
+    float threaded[70*41];
+    matrix::detail::GenericMultiplyKernel<float, 70, 33, 41>::apply(&a(0,0), &b(0,0), expected);
+    matrix::ThreadPool pool(3);
+    matrix::detail::BlockedMultiplyKernel<float, 70, 33, 41>::apply(&a(0,0), &b(0,0), threaded, pool);
+    expectProductWithinRounding(a, b, expected, threaded);
+}
+
 TEST(MatrixTestSuite, TestOStreamOutputSquareInts)
 {
     int vals[9] = {1,2,3,4,5,6,7,8,9};
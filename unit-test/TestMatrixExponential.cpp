@@ -0,0 +1,187 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TestMatrixExponential.cpp
+//!
+//! Unit test for MatrixExponential.hpp
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <iostream>
+#include <gtest/gtest.h>
+#include "../src/MatrixExponential.hpp"
+#include "../src/DCM.hpp"
+#include "TestHelpers.hpp"
+
+namespace
+{
+
+//! e^A as a Taylor series, summed in long double after scaling A by 2^-10
+template<size_t M>
+matrix::SquareMatrix<double, M> taylor(const matrix::SquareMatrix<double, M> &A)
+{
+    matrix::SquareMatrix<long double, M> As;
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < M; ++j)
+        {
+            As(i,j) = static_cast<long double>(A(i,j)) / 1024.0L;
+        }
+    }
+    matrix::SquareMatrix<long double, M> E;
+    E.identity();
+    matrix::SquareMatrix<long double, M> term = E;
+    for(size_t k = 1; k < 30; ++k)
+    {
+        term = term*As;
+        term /= static_cast<long double>(k);
+        E += term;
+    }
+    for(size_t k = 0; k < 10; ++k)
+    {
+        E = E*E;
+    }
+    matrix::SquareMatrix<double, M> result;
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < M; ++j)
+        {
+            result(i,j) = static_cast<double>(E(i,j));
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(MatrixExponentialTestSuite, TestPadeDegrees)
+{
+    // Norms that select each Pade degree, and one that needs squaring
+    test::Random random(51);
+    const double scales[6] = {0.001, 0.05, 0.3, 0.8, 2.0, 8.0};
+    for(size_t k = 0; k < 6; ++k)
+    {
+        matrix::SquareMatrix<double, 6> A;
+        test::fill(A, random, scales[k]);
+        matrix::SquareMatrix<double, 6> expected = taylor(A);
+        double size = 0.0;
+        for(size_t i = 0; i < 6; ++i)
+        {
+            for(size_t j = 0; j < 6; ++j)
+            {
+                size = std::max(size, std::fabs(expected(i,j)));
+            }
+        }
+        EXPECT_LT(test::maxDifference(matrix::expm(A), expected), 1.0e-14*size);
+    }
+
+    // Diagonal and nilpotent matrices have exact exponentials
+    matrix::SquareMatrix<double, 2> D = {{1.0, 0.0}, {0.0, -2.0}};
+    matrix::SquareMatrix<double, 2> eD = matrix::expm(D);
+    EXPECT_NEAR(std::exp(1.0), eD(0,0), 1.0e-15);
+    EXPECT_NEAR(std::exp(-2.0), eD(1,1), 1.0e-15);
+    EXPECT_DOUBLE_EQ(0.0, eD(0,1));
+
+    matrix::SquareMatrix<double, 3> N = {{0.0, 1.0, 2.0}, {0.0, 0.0, 3.0}, {0.0, 0.0, 0.0}};
+    matrix::SquareMatrix<double, 3> eN = matrix::expm(N);
+    EXPECT_NEAR(1.0, eN(0,1), 1.0e-15);
+    EXPECT_NEAR(2.0 + 0.5*3.0, eN(0,2), 1.0e-15);
+    EXPECT_NEAR(3.0, eN(1,2), 1.0e-15);
+}
+
+TEST(MatrixExponentialTestSuite, TestRodrigues)
+{
+    // e^(w~) rotates by |w| about w, matching the quaternion of the same rotation
+    matrix::Vector3<double> w(0.3, -1.2, 0.8);
+    matrix::SquareMatrix<double, 3> R = matrix::expm(w.tilde());
+    const double angle = w.norm();
+    matrix::Vector3<double> axis = w / angle;
+    matrix::Quaternion<double> q(std::cos(angle/2), std::sin(angle/2)*axis(0), std::sin(angle/2)*axis(1), std::sin(angle/2)*axis(2));
+    matrix::DCM<double> expected(q);
+    EXPECT_LT(test::maxDifference(R, expected), 1.0e-15);
+    EXPECT_LT(test::maxDifference(R, taylor(w.tilde())), 1.0e-14);
+
+    matrix::SquareMatrix<double, 3> zero;
+    matrix::SquareMatrix<double, 3> I;
+    I.identity();
+    EXPECT_LT(test::maxDifference(matrix::expm(zero), I), 1.0e-15);
+
+    // A tiny rotation keeps full precision
+    matrix::Vector3<double> small(1.0e-9, 2.0e-9, -1.0e-9);
+    matrix::SquareMatrix<double, 3> Rs = matrix::expm(small.tilde());
+    matrix::SquareMatrix<double, 3> W = small.tilde();
+    matrix::SquareMatrix<double, 3> secondOrder = I + W + W*W*0.5;
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < 3; ++j)
+        {
+            EXPECT_NEAR(secondOrder(i,j), Rs(i,j), i == j ? 1.0e-16 : 1.0e-24);
+        }
+    }
+}
+
+TEST(MatrixExponentialTestSuite, TestQuaternionRate)
+{
+    // Integrating qdot = 0.5 q * (0, w) over dt in one step: e^(0.5 Omega dt) q
+    matrix::Vector3<double> w(0.4, -0.1, 0.7);
+    const double dt = 0.5;
+    matrix::SquareMatrix<double, 4> Omega = {{0.0, -w(0), -w(1), -w(2)},
+                                            {w(0), 0.0, w(2), -w(1)},
+                                            {w(1), -w(2), 0.0, w(0)},
+                                            {w(2), w(1), -w(0), 0.0}};
+    matrix::SquareMatrix<double, 4> A = Omega*(0.5*dt);
+    matrix::SquareMatrix<double, 4> Phi = matrix::expm(A);
+    EXPECT_LT(test::maxDifference(Phi, taylor(A)), 1.0e-15);
+
+    matrix::Quaternion<double> q(0.9, 0.1, -0.3, 0.2);
+    q.normalize();
+    matrix::Vector<double, 4> next = Phi*q;
+
+    // Constant rate: the same as composing with the rotation by w dt in the body frame
+    const double angle = w.norm()*dt;
+    matrix::Vector3<double> axis = w / w.norm();
+    matrix::Quaternion<double> step(std::cos(angle/2), std::sin(angle/2)*axis(0), std::sin(angle/2)*axis(1), std::sin(angle/2)*axis(2));
+    matrix::Quaternion<double> expected = q*step;
+    for(size_t i = 0; i < 4; ++i)
+    {
+        EXPECT_NEAR(expected(i), next(i), 1.0e-15);
+    }
+
+    // The left-multiplication form is recognized too
+    matrix::SquareMatrix<double, 4> left = Omega.transpose();
+    for(size_t i = 1; i < 4; ++i)
+    {
+        left(i,0) = Omega(i,0);
+        left(0,i) = Omega(0,i);
+    }
+    EXPECT_LT(test::maxDifference(matrix::expm(left), taylor(left)), 1.0e-14);
+}
+
+TEST(MatrixExponentialTestSuite, TestExpmv)
+{
+    test::Random random(52);
+    const double scales[3] = {0.1, 1.0, 10.0};
+    for(size_t k = 0; k < 3; ++k)
+    {
+        matrix::SquareMatrix<double, 8> A;
+        matrix::Vector<double, 8> v;
+        test::fill(A, random, scales[k]);
+        test::fill(v, random);
+        for(size_t i = 0; i < 8; ++i)
+        {
+            A(i,i) -= scales[k];
+        }
+        matrix::Vector<double, 8> expected = matrix::expm(A)*v;
+        double size = 0.0;
+        for(size_t i = 0; i < 8; ++i)
+        {
+            size = std::max(size, std::fabs(expected(i)));
+        }
+        EXPECT_LT(test::maxDifference(matrix::expmv(A, v), expected), 1.0e-13*size);
+    }
+
+    matrix::SquareMatrix<double, 2> zero;
+    matrix::Vector<double, 2> v = {1.0, -2.0};
+    EXPECT_LT(test::maxDifference(matrix::expmv(zero, v), v), 1.0e-16);
+}
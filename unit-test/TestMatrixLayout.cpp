@@ -0,0 +1,249 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TestMatrixLayout.cpp
+//!
+//! Unit test for the RowMajor and ColumnMajor matrix layouts
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <gtest/gtest.h>
+#include "../src/SquareMatrix.hpp"
+#include "../src/Vector.hpp"
+
+namespace
+{
+
+template<class T, size_t M, size_t N>
+using ColMatrix = matrix::Matrix<T, M, N, matrix::DefaultBounds, matrix::ColumnMajor>;
+
+//! Fill a matrix through operator() with deterministic values
+template<class Mat>
+void fill(Mat &m, size_t rows, size_t cols, double offset)
+{
+    for(size_t i = 0; i < rows; ++i)
+    {
+        for(size_t j = 0; j < cols; ++j)
+        {
+            m(i,j) = 0.25*static_cast<double>((i*7 + j*3) % 11) + offset;
+        }
+    }
+}
+
+//! True when every element of a equals the same element of b
+template<class A, class B>
+bool sameElements(const A &a, const B &b)
+{
+    for(size_t i = 0; i < A::rows; ++i)
+    {
+        for(size_t j = 0; j < A::cols; ++j)
+        {
+            if(a(i,j) != b(i,j))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//! Every combination of layouts gives exactly the row-major product
+template<size_t M, size_t N, size_t P>
+void checkProducts()
+{
+    matrix::Matrix<double, M, N> a;
+    matrix::Matrix<double, N, P> b;
+    fill(a, M, N, 0.5);
+    fill(b, N, P, -1.0);
+    ColMatrix<double, M, N> ca(a);
+    ColMatrix<double, N, P> cb(b);
+    const matrix::Matrix<double, M, P> expected = a*b;
+
+    EXPECT_TRUE(sameElements(expected, ca*cb));
+    EXPECT_TRUE(sameElements(expected, ca*b));
+    EXPECT_TRUE(sameElements(expected, a*cb));
+
+    ColMatrix<double, M, P> c = ca*cb;
+    EXPECT_TRUE(sameElements(expected, c));
+}
+
+} // namespace
+
+TEST(MatrixLayoutTestSuite, TestStorageOrder)
+{
+    ColMatrix<int, 2, 3> m = {{1, 2, 3}, {4, 5, 6}};
+    const int *storage = &m(0,0);
+    const int columns[6] = {1, 4, 2, 5, 3, 6};
+    for(size_t k = 0; k < 6; ++k)
+    {
+        EXPECT_EQ(columns[k], storage[k]);
+    }
+    EXPECT_EQ(6, m(1,2));
+    matrix::Matrix<int, 2, 3, matrix::CheckedBounds, matrix::ColumnMajor> checked(m);
+    EXPECT_THROW(checked(2,0), std::domain_error);
+
+    // Flat arrays are read in storage order
+    ColMatrix<int, 2, 3> flat(columns);
+    EXPECT_TRUE(flat == m);
+
+    const int rows[2][3] = {{1, 2, 3}, {4, 5, 6}};
+    ColMatrix<int, 2, 3> fromArray(rows);
+    EXPECT_TRUE(fromArray == m);
+
+    EXPECT_EQ(1u, matrix::ColumnMajor::rowStride(2, 3));
+    EXPECT_EQ(2u, matrix::ColumnMajor::colStride(2, 3));
+    EXPECT_EQ(5u, matrix::ColumnMajor::index(1, 2, 2, 3));
+}
+
+TEST(MatrixLayoutTestSuite, TestConversion)
+{
+    matrix::Matrix<double, 3, 4> rowMajor;
+    fill(rowMajor, 3, 4, 1.0);
+
+    ColMatrix<double, 3, 4> colMajor(rowMajor);
+    EXPECT_TRUE(sameElements(rowMajor, colMajor));
+    EXPECT_EQ(rowMajor(2,1), (&colMajor(0,0))[1*3 + 2]);
+
+    matrix::Matrix<double, 3, 4> back(colMajor);
+    EXPECT_TRUE(back == rowMajor);
+
+    rowMajor = colMajor*2.0;
+    EXPECT_DOUBLE_EQ(2.0*colMajor(1,3), rowMajor(1,3));
+}
+
+TEST(MatrixLayoutTestSuite, TestElementWise)
+{
+    matrix::Matrix<double, 4, 5> a;
+    matrix::Matrix<double, 4, 5> b;
+    fill(a, 4, 5, 0.0);
+    fill(b, 4, 5, 2.5);
+    ColMatrix<double, 4, 5> ca(a);
+    ColMatrix<double, 4, 5> cb(b);
+
+    const matrix::Matrix<double, 4, 5> expected = a + b*2.0 - a;
+
+    // Same layouts evaluate in storage order, mixed layouts element by element
+    ColMatrix<double, 4, 5> same = ca + cb*2.0 - ca;
+    ColMatrix<double, 4, 5> mixed = ca + b*2.0 - a;
+    matrix::Matrix<double, 4, 5> mixedRow = a + cb*2.0 - ca;
+    EXPECT_TRUE(sameElements(expected, same));
+    EXPECT_TRUE(sameElements(expected, mixed));
+    EXPECT_TRUE(mixedRow == expected);
+
+    ColMatrix<double, 4, 5> accumulate(ca);
+    accumulate += b;
+    accumulate -= cb*0.5;
+    matrix::Matrix<double, 4, 5> reference(a);
+    reference += b;
+    reference -= b*0.5;
+    EXPECT_TRUE(sameElements(reference, accumulate));
+
+    EXPECT_TRUE((ca == ColMatrix<double, 4, 5>(a)));
+    EXPECT_TRUE(ca != cb);
+}
+
+TEST(MatrixLayoutTestSuite, TestMultiply)
+{
+    checkProducts<3, 3, 3>();
+    checkProducts<6, 6, 6>();
+    checkProducts<3, 7, 2>();
+    checkProducts<20, 20, 20>();
+    checkProducts<40, 40, 40>();
+    checkProducts<64, 48, 80>();
+
+    matrix::Matrix<double, 4, 4> a;
+    fill(a, 4, 4, 0.75);
+    ColMatrix<double, 4, 4> ca(a);
+    matrix::Matrix<double, 4, 4> expected = a*a;
+    ca *= ColMatrix<double, 4, 4>(a);
+    EXPECT_TRUE(sameElements(expected, ca));
+
+    // Products inside expressions
+    ColMatrix<double, 4, 4> cb(a);
+    ColMatrix<double, 4, 4> sum = cb*cb + cb;
+    EXPECT_TRUE(sameElements(a*a + a, sum));
+
+    // Matrix-vector products
+    matrix::Vector<double, 4> v = {1.0, -2.0, 0.5, 3.0};
+    auto cv = cb*v;
+    auto rv = a*v;
+    for(size_t i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(rv(i,0), cv(i,0));
+    }
+}
+
+TEST(MatrixLayoutTestSuite, TestTransposeAndSwaps)
+{
+    matrix::Matrix<double, 3, 5> a;
+    fill(a, 3, 5, 0.0);
+    ColMatrix<double, 3, 5> ca(a);
+
+    EXPECT_TRUE(sameElements(a.transpose(), ca.transpose()));
+
+    a.swapRows(0, 2);
+    ca.swapRows(0, 2);
+    EXPECT_TRUE(sameElements(a, ca));
+
+    a.swapCols(1, 4);
+    ca.swapCols(1, 4);
+    EXPECT_TRUE(sameElements(a, ca));
+}
+
+TEST(MatrixLayoutTestSuite, TestViews)
+{
+    matrix::Matrix<double, 5, 6> a;
+    fill(a, 5, 6, 1.0);
+    ColMatrix<double, 5, 6> ca(a);
+
+    EXPECT_TRUE(sameElements(a.block<2, 3>(1, 2), ca.block<2, 3>(1, 2)));
+    EXPECT_TRUE(sameElements(a.row(3), ca.row(3)));
+    EXPECT_TRUE(sameElements(a.col(4), ca.col(4)));
+    EXPECT_TRUE(sameElements(a.diagonal(), ca.diagonal()));
+    EXPECT_TRUE(sameElements(a.transposed(), ca.transposed()));
+
+    // Columns of a column-major matrix are contiguous
+    EXPECT_EQ(1u, ca.col(2).rowStride());
+    EXPECT_EQ(&ca(0,2) + 1, &ca.col(2)(1,0));
+
+    ca.block<2, 2>(0, 0) = a.block<2, 2>(3, 4);
+    EXPECT_EQ(a(4,5), ca(1,1));
+
+    matrix::Matrix<double, 6, 6> expected = a.transposed()*a;
+    EXPECT_TRUE(sameElements(expected, ca.transposed()*ca));
+}
+
+TEST(MatrixLayoutTestSuite, TestSquareMatrix)
+{
+    using ColSquare = matrix::SquareMatrix<double, 4, matrix::ColumnMajor>;
+
+    ColSquare eye = matrix::identity<double, 4, matrix::ColumnMajor>();
+    EXPECT_TRUE(sameElements(matrix::identity<double, 4>(), eye));
+
+    matrix::SquareMatrix<double, 4> a = {{4.0, 1.0, 2.0, 0.5}, {1.0, 5.0, 0.0, 1.0}, {2.0, 0.0, 6.0, 1.5}, {0.5, 1.0, 1.5, 3.0}};
+    ColSquare ca(a);
+
+    EXPECT_DOUBLE_EQ(a.trace(), ca.trace());
+    EXPECT_TRUE(sameElements(a.minor(1, 2), ca.minor(1, 2)));
+    EXPECT_DOUBLE_EQ(matrix::determinant<double>(a), matrix::determinant<double>(ca));
+
+    matrix::SquareMatrix<double, 4> L, U;
+    ColSquare cL, cU;
+    a.LU_decomposition(L, U);
+    ca.LU_decomposition(cL, cU);
+    EXPECT_TRUE(sameElements(L, cL));
+    EXPECT_TRUE(sameElements(U, cU));
+
+    ColSquare upper = matrix::upperTriangular<double, 4, matrix::ColumnMajor>();
+    EXPECT_TRUE(upper.isUpperTriangular());
+    EXPECT_FALSE(upper.isLowerTriangular());
+    EXPECT_EQ(1.0, upper(0,3));
+    EXPECT_EQ(0.0, upper(3,0));
+
+    matrix::SquareMatrix<double, 3, matrix::ColumnMajor> three = {{2.0, 0.0, 1.0}, {1.0, 3.0, 0.0}, {0.0, 1.0, 4.0}};
+    matrix::SquareMatrix<double, 3, matrix::ColumnMajor> product = three*matrix::inverse(three);
+    EXPECT_TRUE(product.isUpperTriangular(1.0e-12));
+    EXPECT_TRUE(product.isLowerTriangular(1.0e-12));
+    EXPECT_NEAR(3.0, product.trace(), 1.0e-12);
+}
@@ -0,0 +1,157 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TestMatrixMap.cpp
+//!
+//! Unit test for MatrixMap.hpp, Vector3Map.hpp and QuaternionMap.hpp
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <iostream>
+#include <gtest/gtest.h>
+#include "../src/MatrixMap.hpp"
+#include "../src/QuaternionMap.hpp"
+#include "../src/Vector3Map.hpp"
+
+TEST(MatrixMapTestSuite, TestLayouts)
+{
+    double buffer[6] = {1, 2, 3, 4, 5, 6};
+
+    matrix::MatrixMap<double, 2, 3> rowMajor(buffer);
+    EXPECT_EQ(6.0, rowMajor(1,2));
+    EXPECT_EQ(buffer, &rowMajor(0,0));
+
+    matrix::MatrixMap<double, 2, 3> columnMajor(buffer, matrix::ColumnMajor());
+    EXPECT_EQ(2.0, columnMajor(1,0));
+    EXPECT_EQ(3.0, columnMajor(0,1));
+    matrix::Matrix<double, 2, 3> evaluated = columnMajor;
+    EXPECT_TRUE((evaluated == matrix::Matrix<double, 2, 3>{{1, 3, 5}, {2, 4, 6}}));
+
+    // Every other element of the buffer
+    matrix::MatrixMap<double, 3, 1, matrix::CheckedBounds> strided(buffer + 1, 2, 1);
+    EXPECT_EQ(6.0, strided(2,0));
+    EXPECT_THROW(strided(3,0), std::domain_error);
+
+    const double constBuffer[4] = {1, 0, 0, 1};
+    matrix::MatrixMap<const double, 2, 2> readOnly(constBuffer);
+    EXPECT_TRUE((matrix::Matrix<double, 2, 2>(readOnly) == matrix::Matrix<double, 2, 2>{{1, 0}, {0, 1}}));
+}
+
+TEST(MatrixMapTestSuite, TestOperatorsInPlace)
+{
+    double buffer[4] = {1, 2, 3, 4};
+    matrix::MatrixMap<double, 2, 2> m(buffer);
+    matrix::Matrix<double, 2, 2> other = {{1, 1}, {1, 1}};
+
+    m += other;
+    EXPECT_EQ(5.0, buffer[3]);
+    m *= 2.0;
+    EXPECT_EQ(4.0, buffer[0]);
+    m -= other*2.0;
+    m /= 2.0;
+    EXPECT_EQ(1.0, buffer[0]);
+    EXPECT_EQ(4.0, buffer[3]);
+
+    // Products read the buffer in place
+    matrix::Matrix<double, 2, 2> product = m * other;
+    EXPECT_TRUE((product == matrix::Matrix<double, 2, 2>{{3, 3}, {7, 7}}));
+    product = other * m;
+    EXPECT_TRUE((product == matrix::Matrix<double, 2, 2>{{4, 6}, {4, 6}}));
+
+    // Assignment writes through to the buffer
+    double out[4] = {0, 0, 0, 0};
+    matrix::MatrixMap<double, 2, 2> outMap(out, matrix::ColumnMajor());
+    outMap = m + other;
+    EXPECT_EQ(2.0, out[0]);
+    EXPECT_EQ(4.0, out[1]);
+    EXPECT_EQ(3.0, out[2]);
+    EXPECT_EQ(5.0, out[3]);
+    outMap = m;
+    EXPECT_EQ(3.0, out[1]);
+}
+
+TEST(MatrixMapTestSuite, TestVectorMap)
+{
+    // Interleaved samples: x0 y0 x1 y1 ...
+    float samples[8] = {3, 0, 4, 0, 0, 1, 0, 2};
+    matrix::VectorMap<float, 4> x(samples, 2);
+    EXPECT_EQ(4u, x.size());
+    EXPECT_EQ(4.0f, x(1));
+    EXPECT_FLOAT_EQ(5.0f, x.norm());
+    EXPECT_FLOAT_EQ(5.0f, x.length());
+    EXPECT_FLOAT_EQ(25.0f, x*x);
+
+    matrix::Vector<float, 4> unit = x.unit();
+    EXPECT_FLOAT_EQ(0.6f, unit(0));
+    x.normalize();
+    EXPECT_FLOAT_EQ(0.8f, samples[2]);
+    EXPECT_EQ(1.0f, samples[5]);
+}
+
+TEST(MatrixMapTestSuite, TestVector3Map)
+{
+    // Two IMU records of [gyro, accel]
+    double imu[12] = {1, 0, 0, 0, 0, 9.8, 0, 1, 0, 0, 0, 9.7};
+    matrix::Vector3Map<double> gyro(imu + 6);
+    matrix::Vector3Map<double> accel(imu + 9);
+    matrix::Vector3<double> x(1, 0, 0);
+
+    matrix::Vector3<double> c = gyro.cross(x);
+    EXPECT_TRUE((c == matrix::Vector3<double>(0, 0, -1)));
+    EXPECT_TRUE((gyro.tilde() == matrix::Vector3<double>(0, 1, 0).tilde()));
+    EXPECT_EQ(0.0, gyro*x);
+
+    accel -= matrix::Vector3<double>(0, 0, 9.7);
+    EXPECT_EQ(0.0, imu[11]);
+    gyro = gyro * 2.0 + x;
+    EXPECT_EQ(1.0, imu[6]);
+    EXPECT_EQ(2.0, imu[7]);
+
+    matrix::SquareMatrix<double, 3> R = {{0, -1, 0}, {1, 0, 0}, {0, 0, 1}};
+    matrix::Vector3<double> rotated = R * gyro;
+    EXPECT_TRUE((rotated == matrix::Vector3<double>(-2, 1, 0)));
+    gyro = R * gyro;
+    EXPECT_EQ(-2.0, imu[6]);
+}
+
+TEST(MatrixMapTestSuite, TestQuaternionMap)
+{
+    const double angle = 0.3;
+    double buffer[8] = {std::cos(angle/2), 0, 0, std::sin(angle/2), 1, 0, 0, 0};
+    matrix::QuaternionMap<double> qm(buffer);
+    matrix::Quaternion<double> q(buffer);
+    matrix::Quaternion<double> p(0.5, 0.5, 0.5, 0.5);
+
+    EXPECT_TRUE((qm * p == q * p));
+    EXPECT_TRUE((qm.conjugate() == q.conjugate()));
+    EXPECT_TRUE((qm.inverse() == q.inverse()));
+    EXPECT_EQ(q.norm(), qm.norm());
+    EXPECT_EQ(q.z(), qm.z());
+    EXPECT_TRUE((qm.vector() == q.vector()));
+    EXPECT_TRUE((qm + 1.0 == q + 1.0));
+    EXPECT_TRUE((p * qm == p * q));
+
+    // Scalar operators follow Quaternion (scalar part only for + and -)
+    qm += 1.0;
+    EXPECT_EQ(q.w() + 1.0, buffer[0]);
+    EXPECT_EQ(0.0, buffer[1]);
+    qm -= 1.0;
+    q += 1.0;
+    q -= 1.0;
+
+    qm *= p;
+    q *= p;
+    EXPECT_TRUE((matrix::Quaternion<double>(qm) == q));
+
+    qm.invert();
+    q.invert();
+    EXPECT_TRUE((matrix::Quaternion<double>(qm) == q));
+
+    // A second quaternion stored in the same buffer
+    matrix::QuaternionMap<double> identity(buffer + 4);
+    identity *= qm;
+    EXPECT_TRUE((matrix::Quaternion<double>(identity) == matrix::Quaternion<double>(qm)));
+    identity.w() = 2.0;
+    EXPECT_EQ(2.0, buffer[4]);
+}
@@ -0,0 +1,178 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TestMatrixStorage.cpp
+//!
+//! Unit test for MatrixStorage.hpp
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <gtest/gtest.h>
+#include "../src/SquareMatrix.hpp"
+#include "../src/Vector.hpp"
+
+namespace
+{
+
+template<class T, size_t M, size_t N>
+void fill(matrix::Matrix<T, M, N> &m, T offset)
+{
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < N; ++j)
+        {
+            m(i,j) = static_cast<T>((i*7 + j*3) % 11) + offset;
+        }
+    }
+}
+
+} // namespace
+
+TEST(MatrixStorageTestSuite, TestStorageSelection)
+{
+    EXPECT_FALSE((matrix::detail::MatrixStorage<double, 9>::onHeap));
+    EXPECT_FALSE((matrix::detail::MatrixStorage<double, MTL_HEAP_STORAGE_THRESHOLD/sizeof(double)>::onHeap));
+    EXPECT_TRUE((matrix::detail::MatrixStorage<double, MTL_HEAP_STORAGE_THRESHOLD/sizeof(double) + 1>::onHeap));
+
+    EXPECT_EQ(36*sizeof(double), sizeof(matrix::SquareMatrix<double, 6>));
+    EXPECT_EQ(sizeof(double *), sizeof(matrix::SquareMatrix<double, 200>));
+    EXPECT_EQ(sizeof(float *), sizeof(matrix::Vector<float, 5000>));
+}
+
+TEST(MatrixStorageTestSuite, TestHeapStorageIsZeroedAndAligned)
+{
+    matrix::SquareMatrix<double, 200> m;
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(&m(0,0)) % MTL_HEAP_STORAGE_ALIGNMENT);
+    for(size_t i = 0; i < 200; ++i)
+    {
+        for(size_t j = 0; j < 200; ++j)
+        {
+            EXPECT_EQ(0.0, m(i,j));
+        }
+    }
+}
+
+TEST(MatrixStorageTestSuite, TestCopyIsDeep)
+{
+    matrix::Matrix<double, 120, 80> a;
+    fill(a, 1.0);
+    matrix::Matrix<double, 120, 80> b(a);
+    EXPECT_TRUE(a == b);
+    EXPECT_NE(&a(0,0), &b(0,0));
+
+    b(3,4) = -1.0;
+    EXPECT_FALSE(a == b);
+
+    b = a;
+    EXPECT_TRUE(a == b);
+}
+
+TEST(MatrixStorageTestSuite, TestMoveTakesBuffer)
+{
+    matrix::Matrix<double, 120, 80> a;
+    fill(a, 2.0);
+    const matrix::Matrix<double, 120, 80> expected(a);
+    const double *buffer = &a(0,0);
+
+    matrix::Matrix<double, 120, 80> b(std::move(a));
+    EXPECT_EQ(buffer, &b(0,0));
+    EXPECT_TRUE(b == expected);
+
+    // A moved-from matrix keeps its size and holds zeros
+    const matrix::Matrix<double, 120, 80> zero;
+    EXPECT_TRUE(a == zero);
+
+    // and can be assigned to again
+    a = expected;
+    EXPECT_TRUE(a == expected);
+
+    matrix::Matrix<double, 120, 80> c;
+    c = std::move(b);
+    EXPECT_EQ(buffer, &c(0,0));
+    EXPECT_TRUE(c == expected);
+}
+
+TEST(MatrixStorageTestSuite, TestMovedFromStaysReadable)
+{
+    matrix::Matrix<double, 64, 64> a;
+    fill(a, 3.0);
+    const matrix::Matrix<double, 64, 64> expected(a);
+
+    matrix::Matrix<double, 64, 64> b;
+    b = std::move(a);
+    matrix::Matrix<double, 64, 64> c(std::move(b));
+    EXPECT_TRUE(c == expected);
+
+    // Both moved-from matrices can be read, copied and written
+    EXPECT_EQ(0.0, b(63,63));
+    matrix::Matrix<double, 64, 64> d(b);
+    EXPECT_EQ(0.0, d(10,20));
+    matrix::Matrix<double, 64, 64> e(a);
+    e(0,0) = 1.0;
+    EXPECT_EQ(1.0, e(0,0));
+
+    // Move-assigning from a moved-from matrix hands over a valid buffer
+    matrix::Matrix<double, 64, 64> f;
+    matrix::Matrix<double, 64, 64> g(std::move(f));
+    g = std::move(f);
+    EXPECT_EQ(0.0, g(5,5));
+    EXPECT_EQ(0.0, f(5,5));
+}
+
+TEST(MatrixStorageTestSuite, TestMoveDoesNotAllocate)
+{
+    using Storage = matrix::detail::HeapStorage<double, 4096>;
+    Storage a;
+    const double *buffer = a;
+
+    // Moving hands over the buffer and leaves the source without one
+    Storage b(std::move(a));
+    EXPECT_EQ(buffer, static_cast<const double *>(b));
+    EXPECT_FALSE(a.allocated());
+
+    Storage c;
+    c = std::move(b);
+    EXPECT_EQ(buffer, static_cast<const double *>(c));
+
+    // The moved-from source allocates zeroed elements only when accessed
+    const double *fresh = a;
+    EXPECT_TRUE(a.allocated());
+    EXPECT_NE(buffer, fresh);
+    EXPECT_EQ(0.0, fresh[4095]);
+
+    // Copy assignment into a moved-from object allocates its buffer again
+    Storage d(std::move(c));
+    static_cast<double *>(d)[7] = 5.0;
+    c = d;
+    EXPECT_TRUE(c.allocated());
+    EXPECT_EQ(5.0, static_cast<const double *>(c)[7]);
+}
+
+TEST(MatrixStorageTestSuite, TestResultsMoveIntoDerivedTypes)
+{
+    matrix::SquareMatrix<double, 64> a;
+    matrix::SquareMatrix<double, 64> b;
+    fill(a, 0.5);
+    fill(b, -0.25);
+
+    matrix::Matrix<double, 64, 64> product = a * b;
+    const matrix::Matrix<double, 64, 64> expected(product);
+    const double *buffer = &product(0,0);
+    matrix::SquareMatrix<double, 64> square(std::move(product));
+    EXPECT_EQ(buffer, &square(0,0));
+    EXPECT_TRUE(square == expected);
+
+    matrix::SquareMatrix<double, 64> sum = a + b;
+    sum = a * b;
+    EXPECT_TRUE(sum == expected);
+
+    matrix::Matrix<float, 5000, 1> column;
+    column(4999, 0) = 3.0f;
+    const float *columnBuffer = &column(0,0);
+    matrix::Vector<float, 5000> v(std::move(column));
+    EXPECT_EQ(columnBuffer, &v(0));
+    EXPECT_EQ(3.0f, v(4999));
+}
@@ -0,0 +1,206 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TestMatrixView.cpp
+//!
+//! Unit test for MatrixView.hpp
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <gtest/gtest.h>
+#include "../src/SquareMatrix.hpp"
+#include "../src/Vector.hpp"
+#include "TestHelpers.hpp"
+
+namespace
+{
+
+//! Fill a matrix through operator() with deterministic values
+template<class Mat>
+void fill(Mat &m, size_t rows, size_t cols, double offset)
+{
+    for(size_t i = 0; i < rows; ++i)
+    {
+        for(size_t j = 0; j < cols; ++j)
+        {
+            m(i,j) = 0.25*static_cast<double>((i*7 + j*3) % 11) + offset;
+        }
+    }
+}
+
+} // namespace
+
+TEST(MatrixViewTestSuite, TestBlockReadWrite)
+{
+    matrix::Matrix<int, 3, 4> m = {{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}};
+
+    auto b = m.block<2, 2>(1, 2);
+    EXPECT_EQ(7, b(0,0));
+    EXPECT_EQ(12, b(1,1));
+    EXPECT_EQ(&m(1,2), &b(0,0));
+
+    // Views check with their parent's policy, named explicitly since a build may change the default
+    matrix::Matrix<int, 3, 4, matrix::CheckedBounds> checked(m);
+    EXPECT_THROW((checked.block<2, 2>(1, 2)(2,0)), std::domain_error);
+    EXPECT_THROW((checked.block<2, 2>(2, 0)), std::domain_error);
+    EXPECT_THROW((checked.block<2, 2>(0, 3)), std::domain_error);
+
+    b(1,0) = 100;
+    EXPECT_EQ(100, m(2,2));
+
+    // Assignment copies elements into the parent instead of rebinding the view
+    m.block<1, 2>(0, 0) = m.block<1, 2>(2, 0);
+    EXPECT_EQ(9, m(0,0));
+    EXPECT_EQ(10, m(0,1));
+
+    matrix::Matrix<int, 2, 2> copy = m.block<2, 2>(0, 0);
+    EXPECT_TRUE((copy == matrix::Matrix<int, 2, 2>{{9, 10}, {5, 6}}));
+
+    const matrix::Matrix<int, 3, 4> &constRef = m;
+    matrix::MatrixView<const int, 2, 2> readOnly = constRef.block<2, 2>(1, 1);
+    EXPECT_EQ(6, readOnly(0,0));
+    matrix::MatrixView<const int, 2, 2> converted = b;
+    EXPECT_EQ(100, converted(1,0));
+}
+
+TEST(MatrixViewTestSuite, TestRowColDiagonalTranspose)
+{
+    matrix::Matrix<int, 3, 4> m = {{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}};
+
+    matrix::Matrix<int, 1, 4> row = m.row(1);
+    EXPECT_TRUE((row == matrix::Matrix<int, 1, 4>{{5, 6, 7, 8}}));
+    matrix::Matrix<int, 3, 1> col = m.col(3);
+    EXPECT_TRUE((col == matrix::Matrix<int, 3, 1>{{4}, {8}, {12}}));
+    matrix::Matrix<int, 3, 1> diag = m.diagonal();
+    EXPECT_TRUE((diag == matrix::Matrix<int, 3, 1>{{1}, {6}, {11}}));
+    matrix::Matrix<int, 3, 4, matrix::CheckedBounds> checked(m);
+    EXPECT_THROW(checked.row(3), std::domain_error);
+    EXPECT_THROW(checked.col(4), std::domain_error);
+
+    matrix::Matrix<int, 4, 3> t = m.transposed();
+    EXPECT_TRUE((t == m.transpose()));
+    EXPECT_EQ(&m(2,1), &m.transposed()(1,2));
+    matrix::Matrix<int, 3, 4> back = m.transposed().transposed();
+    EXPECT_TRUE((back == m));
+
+    m.row(0) *= 2;
+    m.col(0) += 1;
+    m.diagonal().setValue(0);
+    EXPECT_TRUE((m == matrix::Matrix<int, 3, 4>{{0, 4, 6, 8}, {6, 0, 7, 8}, {10, 10, 0, 12}}));
+
+    m.row(2) -= m.row(1);
+    EXPECT_TRUE((matrix::Matrix<int, 1, 4>(m.row(2)) == matrix::Matrix<int, 1, 4>{{4, 10, -7, 4}}));
+}
+
+TEST(MatrixViewTestSuite, TestBlockUpdateInPlace)
+{
+    matrix::SquareMatrix<double, 6> P;
+    fill(P, 6, 6, 1.0);
+    matrix::SquareMatrix<double, 3> F;
+    fill(F, 3, 3, -0.5);
+    matrix::SquareMatrix<double, 3> Q;
+    fill(Q, 3, 3, 0.25);
+
+    // Expected result computed with copies
+    matrix::SquareMatrix<double, 6> expected = P;
+    const matrix::SquareMatrix<double, 3> product = F * Q;
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < 3; ++j)
+        {
+            expected(3+i, 3+j) += product(i,j);
+        }
+    }
+
+    P.block<3, 3>(3, 3) += F * Q;
+    EXPECT_TRUE(P == expected);
+
+    // Expressions of views are evaluated in one pass straight into the parent
+    P.block<3, 3>(0, 0) = P.block<3, 3>(3, 3) * 2.0 - F;
+    EXPECT_EQ(expected(3,3)*2.0 - F(0,0), P(0,0));
+}
+
+TEST(MatrixViewTestSuite, TestViewProducts)
+{
+    matrix::Matrix<double, 4, 3> A;
+    fill(A, 4, 3, 0.5);
+    matrix::Matrix<double, 4, 2> B;
+    fill(B, 4, 2, -1.5);
+
+    // Strided and contiguous kernels may round differently once FMAs are contracted
+    const double tolerance = 1.0e-12;
+
+    // A^T * B without materializing the transpose
+    const matrix::Matrix<double, 3, 2> atb = A.transposed() * B;
+    EXPECT_LT(test::maxDifference(atb, A.transpose() * B), tolerance);
+
+    // Blocks on either side and on both sides
+    matrix::SquareMatrix<double, 6> big;
+    fill(big, 6, 6, 0.1);
+    matrix::SquareMatrix<double, 3> F;
+    fill(F, 3, 3, 2.0);
+    matrix::Matrix<double, 3, 3> block;
+    matrix::Matrix<double, 3, 3> topLeft;
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < 3; ++j)
+        {
+            block(i,j) = big(3+i, 3+j);
+            topLeft(i,j) = big(i,j);
+        }
+    }
+    EXPECT_LT(test::maxDifference(big.block<3, 3>(3, 3) * F, block * F), tolerance);
+    EXPECT_LT(test::maxDifference(F * big.block<3, 3>(3, 3), F * block), tolerance);
+    EXPECT_LT(test::maxDifference(big.block<3, 3>(3, 3) * big.block<3, 3>(3, 3).transposed(), block * block.transpose()), tolerance);
+
+    // Row times column is a 1x1 product
+    const matrix::Matrix<double, 1, 1> dot = big.row(2) * big.col(4);
+    double expected = 0;
+    for(size_t k = 0; k < 6; ++k)
+    {
+        expected += big(2,k) * big(k,4);
+    }
+    EXPECT_NEAR(expected, dot(0,0), tolerance);
+
+    // Views mixed with unevaluated expressions
+    EXPECT_LT(test::maxDifference(big.block<3, 3>(0, 0) * (F + F), topLeft * (F + F)), tolerance);
+    EXPECT_LT(test::maxDifference((F - F) * big.block<3, 3>(0, 0).transposed(), (F - F) * topLeft.transpose()), tolerance);
+}
+
+TEST(MatrixViewTestSuite, TestLargeBlockProducts)
+{
+    // Blocks large enough for the blocked kernel must match the generic loop (up to
+    // rounding, since either may be contracted into FMAs)
+    const double tolerance = 1.0e-12;
+    matrix::Matrix<double, 50, 60> big;
+    fill(big, 50, 60, 0.3);
+    matrix::Matrix<double, 40, 45> other;
+    fill(other, 40, 45, -0.2);
+
+    const matrix::Matrix<double, 40, 40> aBlock = big.submatrix<40, 40>(5, 10, 45, 50);
+    const matrix::Matrix<double, 40, 45> product = big.block<40, 40>(5, 10) * other;
+    matrix::Matrix<double, 40, 45> expected;
+    matrix::detail::GenericMultiplyKernel<double, 40, 40, 45>::apply(&aBlock(0,0), &other(0,0), &expected(0,0));
+    EXPECT_LT(test::maxDifference(product, expected), tolerance);
+
+    const matrix::Matrix<double, 60, 60> gram = big.transposed() * big;
+    EXPECT_LT(test::maxDifference(gram, big.transpose() * big), tolerance);
+
+    // Too large to pack on the stack but too thin for the blocked kernel
+    const matrix::Matrix<double, 60, 8> thin = big.transposed() * big.block<50, 8>(0, 3);
+    EXPECT_LT(test::maxDifference(thin, big.transpose() * matrix::Matrix<double, 50, 8>(big.block<50, 8>(0, 3))), tolerance);
+}
+
+TEST(MatrixViewTestSuite, TestVectorViews)
+{
+    matrix::SquareMatrix<double, 3> m = {{1, 2, 3}, {4, 5, 6}, {7, 8, 10}};
+    matrix::Vector<double, 3> v = {1, 0, -1};
+
+    matrix::Vector<double, 3> column = m.col(2);
+    EXPECT_EQ(10.0, column(2));
+    m.col(1) = v;
+    EXPECT_EQ(-1.0, m(2,1));
+    const matrix::Matrix<double, 1, 1> rowTimesV = m.row(0) * v;
+    EXPECT_EQ(1.0 - 3.0, rowTimesV(0,0));
+}
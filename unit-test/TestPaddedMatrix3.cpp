@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TestPaddedMatrix3.cpp
+//!
+//! Unit test for PaddedMatrix3.hpp
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/DCM.hpp"
+#include "../src/PaddedMatrix3.hpp"
+
+namespace
+{
+
+//! True when every element matches the packed matrix exactly
+template<class T>
+bool sameElements(const matrix::Matrix<T, 3, 3> &expected, const matrix::PaddedMatrix3<T> &m)
+{
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < 3; ++j)
+        {
+            if(expected(i,j) != m(i,j))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//! True when every element matches the packed matrix up to rounding (products may be contracted into FMAs)
+template<class T>
+bool closeElements(const matrix::Matrix<T, 3, 3> &expected, const matrix::PaddedMatrix3<T> &m)
+{
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < 3; ++j)
+        {
+            if(std::abs(expected(i,j) - m(i,j)) > T(1e-12))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//! True when every padding lane is zero
+template<class T>
+bool zeroPadding(const matrix::PaddedMatrix3<T> &m)
+{
+    return m.data()[3] == T(0) && m.data()[7] == T(0) && m.data()[11] == T(0);
+}
+
+} // namespace
+
+TEST(PaddedMatrix3TestSuite, TestStorage)
+{
+    EXPECT_EQ(48u, sizeof(matrix::PaddedMatrix3<float>));
+    EXPECT_EQ(96u, sizeof(matrix::PaddedMatrix3<double>));
+    EXPECT_EQ(32u, alignof(matrix::PaddedMatrix3<double>));
+
+    matrix::SquareMatrix<double, 3> packed = {{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}, {7.0, 8.0, 9.0}};
+    matrix::PaddedMatrix3<double> m(packed);
+    EXPECT_TRUE(sameElements<double>(packed, m));
+    EXPECT_TRUE(zeroPadding(m));
+    EXPECT_DOUBLE_EQ(4.0, m.data()[4]);
+    if(matrix::DefaultBounds::enabled)
+    {
+        EXPECT_THROW(m(0,3), std::domain_error);
+    }
+    EXPECT_TRUE(m.toSquareMatrix() == packed);
+
+    matrix::PaddedVector3<double> row = m.row(2);
+    EXPECT_DOUBLE_EQ(8.0, row(1));
+
+    m(1,2) = -1.0;
+    EXPECT_DOUBLE_EQ(-1.0, m.data()[6]);
+
+    matrix::PaddedMatrix3<double> eye;
+    eye.identity();
+    EXPECT_TRUE(sameElements<double>(matrix::identity<double, 3>(), eye));
+    EXPECT_TRUE(zeroPadding(eye));
+}
+
+TEST(PaddedMatrix3TestSuite, TestArithmeticMatchesSquareMatrix)
+{
+    matrix::SquareMatrix<double, 3> a = {{0.3, -1.2, 2.5}, {1.1, 0.7, -0.4}, {-2.2, 0.9, 1.6}};
+    matrix::SquareMatrix<double, 3> b = {{1.5, 0.25, -0.75}, {-0.6, 2.2, 0.1}, {0.8, -1.3, 0.45}};
+    matrix::PaddedMatrix3<double> pa(a);
+    matrix::PaddedMatrix3<double> pb(b);
+
+    EXPECT_TRUE(closeElements<double>(a*b, pa*pb));
+    EXPECT_TRUE(sameElements<double>(a + b, pa + pb));
+    EXPECT_TRUE(sameElements<double>(a - b, pa - pb));
+    EXPECT_TRUE(sameElements<double>(a*2.5, pa*2.5));
+    EXPECT_TRUE(sameElements<double>(a.transpose(), pa.transpose()));
+    EXPECT_TRUE(zeroPadding(pa*pb));
+    EXPECT_TRUE(zeroPadding(pa.transpose()));
+
+    matrix::PaddedMatrix3<double> product(pa);
+    product *= pb;
+    EXPECT_TRUE(closeElements<double>(a*b, product));
+    EXPECT_TRUE(zeroPadding(product));
+    EXPECT_TRUE(product != pa);
+
+    matrix::Vector3<double> v(0.5, -1.5, 2.0);
+    matrix::Vector3<double> expected = a*v;
+    matrix::PaddedVector3<double> rotated = pa*matrix::PaddedVector3<double>(v);
+    EXPECT_NEAR(expected(0), rotated(0), 1e-12);
+    EXPECT_NEAR(expected(1), rotated(1), 1e-12);
+    EXPECT_NEAR(expected(2), rotated(2), 1e-12);
+    EXPECT_EQ(0.0, rotated.data()[3]);
+}
+
+TEST(PaddedMatrix3TestSuite, TestRotateBatch)
+{
+    const matrix::DCM<float> dcm(matrix::Quaternion<float>(0.9f, 0.1f, -0.3f, 0.2f).unit());
+    const matrix::PaddedMatrix3<float> padded(dcm);
+
+    std::vector<matrix::PaddedVector3<float>> in, out(7);
+    for(size_t n = 0; n < 7; ++n)
+    {
+        in.emplace_back(0.5f*n, 1.0f - n, 0.25f*n*n);
+    }
+    padded.rotate(in.data(), out.data(), in.size());
+    for(size_t n = 0; n < 7; ++n)
+    {
+        const matrix::Vector3<float> expected = dcm*in[n].toVector3();
+        EXPECT_EQ(expected(0), out[n](0));
+        EXPECT_EQ(expected(1), out[n](1));
+        EXPECT_EQ(expected(2), out[n](2));
+        EXPECT_EQ(0.0f, out[n].data()[3]);
+    }
+
+    // In place
+    padded.rotate(in.data(), in.data(), in.size());
+    EXPECT_TRUE(in[6] == out[6]);
+}
@@ -0,0 +1,119 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TestPaddedVector3.cpp
+//!
+//! Unit test for PaddedVector3.hpp
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/PaddedVector3.hpp"
+
+namespace
+{
+
+//! True when every element matches the packed vector exactly
+template<class T>
+bool sameElements(const matrix::Vector3<T> &expected, const matrix::PaddedVector3<T> &v)
+{
+    return expected(0) == v(0) && expected(1) == v(1) && expected(2) == v(2);
+}
+
+} // namespace
+
+TEST(PaddedVector3TestSuite, TestStorage)
+{
+    EXPECT_EQ(16u, sizeof(matrix::PaddedVector3<float>));
+    EXPECT_EQ(32u, sizeof(matrix::PaddedVector3<double>));
+    EXPECT_EQ(16u, alignof(matrix::PaddedVector3<float>));
+    EXPECT_EQ(32u, alignof(matrix::PaddedVector3<double>));
+
+    // Elements of an array stay aligned
+    std::vector<matrix::PaddedVector3<double>> vectors(5);
+    for(const matrix::PaddedVector3<double> &v : vectors)
+    {
+        EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(v.data()) % 32);
+    }
+
+    matrix::PaddedVector3<double> v(1.0, 2.0, 3.0);
+    EXPECT_DOUBLE_EQ(1.0, v(0));
+    EXPECT_DOUBLE_EQ(3.0, v(2));
+    EXPECT_DOUBLE_EQ(0.0, v.data()[3]);
+    if(matrix::DefaultBounds::enabled)
+    {
+        EXPECT_THROW(v(3), std::domain_error);
+    }
+
+    v(1) = -4.0;
+    EXPECT_DOUBLE_EQ(-4.0, v.data()[1]);
+}
+
+TEST(PaddedVector3TestSuite, TestConversion)
+{
+    matrix::Vector3<double> packed(1.5, -2.25, 0.125);
+    matrix::PaddedVector3<double> padded(packed);
+    EXPECT_TRUE(sameElements(packed, padded));
+    EXPECT_DOUBLE_EQ(0.0, padded.data()[3]);
+    EXPECT_TRUE(padded.toVector3() == packed);
+
+    matrix::PaddedVector3<float> zero;
+    for(size_t i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(0.0f, zero.data()[i]);
+    }
+}
+
+TEST(PaddedVector3TestSuite, TestArithmeticMatchesVector3)
+{
+    const matrix::Vector3<double> a(0.3, -1.7, 2.9);
+    const matrix::Vector3<double> b(-0.45, 0.8, 1.1);
+    const matrix::PaddedVector3<double> pa(a);
+    const matrix::PaddedVector3<double> pb(b);
+
+    EXPECT_TRUE(sameElements<double>(a + b, pa + pb));
+    EXPECT_TRUE(sameElements<double>(a - b, pa - pb));
+    EXPECT_TRUE(sameElements<double>(-a, -pa));
+    EXPECT_TRUE(sameElements<double>(a*1.5, pa*1.5));
+    EXPECT_TRUE(sameElements<double>(a.cross(b), pa.cross(pb)));
+
+    // Vector::dot may sum across SIMD lanes in a different order
+    EXPECT_DOUBLE_EQ(a*b, pa*pb);
+    EXPECT_DOUBLE_EQ(a.dot(b), pa.dot(pb));
+    EXPECT_DOUBLE_EQ(a.norm(), pa.norm());
+    const matrix::Vector3<double> unit = a.unit();
+    for(size_t i = 0; i < 3; ++i)
+    {
+        EXPECT_DOUBLE_EQ(unit(i), pa.unit()(i));
+    }
+
+    matrix::PaddedVector3<double> sum(pa);
+    sum += pb;
+    sum -= pa;
+    sum *= 2.0;
+    EXPECT_TRUE(sameElements<double>((a + b - a)*2.0, sum));
+    EXPECT_TRUE(sum == pb*2.0);
+    EXPECT_TRUE(sum != pb);
+
+    matrix::PaddedVector3<double> n(pa);
+    n.normalize();
+    EXPECT_NEAR(1.0, n.norm(), 1.0e-15);
+}
+
+TEST(PaddedVector3TestSuite, TestPaddingStaysZero)
+{
+    matrix::PaddedVector3<double> v(1.0, 2.0, 3.0);
+    const double inf = std::numeric_limits<double>::infinity();
+
+    EXPECT_EQ(0.0, (v*inf).data()[3]);
+    EXPECT_EQ(0.0, (v/0.0).data()[3]);
+    EXPECT_EQ(0.0, (-v).data()[3]);
+    EXPECT_EQ(0.0, v.cross(matrix::PaddedVector3<double>(-2.0, 0.5, 4.0)).data()[3]);
+
+    v *= inf;
+    EXPECT_EQ(0.0, v.data()[3]);
+}
@@ -7,6 +7,7 @@
 //! @author David Wallace <jdavidwallace1@gmail.com>
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <cstring>
 #include <iostream>
 #include <gtest/gtest.h>
 #include "../src/Quaternion.hpp"
@@ -776,6 +777,21 @@ TEST(QuaternionTestSuite, TestQuaternionScalarMultiplication)
     EXPECT_DOUBLE_EQ(2.15, result2(3));
 }
 
+TEST(QuaternionTestSuite, TestCompileTimeProductAndConjugate)
+{
+    constexpr matrix::Quaternion<int> p(1, 2, 3, 4);
+    constexpr matrix::Quaternion<int> q(5, 6, 7, 8);
+    constexpr matrix::Quaternion<int> r = p*q;
+    static_assert(r.w() == -60 && r.x() == 12 && r.y() == 30 && r.z() == 24, "quaternion product");
+
+    constexpr matrix::Quaternion<int> pc = p.conjugate();
+    static_assert(pc.w() == 1 && pc.x() == -2 && pc.y() == -3 && pc.z() == -4, "conjugate");
+
+    constexpr matrix::Quaternion<int> n = p*pc;
+    static_assert(n.w() == 30 && n.x() == 0 && n.y() == 0 && n.z() == 0, "product with conjugate is the squared norm");
+    EXPECT_EQ(30, n.scalar());
+}
+
 TEST(QuaternionTestSuite, TestQuaternionWXYZ)
 {
     matrix::Quaternion<double> q = {3.4, -2.3, 1.1, 0.5};
@@ -819,4 +835,25 @@ TEST(QuaternionTestSuite, TestAsMatrixRepresentation)
     EXPECT_DOUBLE_EQ(-23.61, m(3,1));
     EXPECT_DOUBLE_EQ(-6.37, m(3,2));
     EXPECT_DOUBLE_EQ(-39.5, m(3,3));
-}
\ No newline at end of file
+}
+TEST(QuaternionTestSuite, TestBulkMemcpyOfQuaternionArray)
+{
+    matrix::Quaternion<float> src[3] = {{1.0f, 0.0f, 0.0f, 0.0f},
+                                        {0.5f, 0.5f, 0.5f, 0.5f},
+                                        {0.0f, -1.0f, 0.0f, 0.0f}};
+    float raw[12];
+    std::memcpy(raw, src, sizeof(src));
+    EXPECT_EQ(sizeof(raw), sizeof(src));
+    EXPECT_FLOAT_EQ(0.5f, raw[4]);
+    EXPECT_FLOAT_EQ(-1.0f, raw[9]);
+
+    matrix::Quaternion<float> dst[3];
+    std::memcpy(dst, raw, sizeof(raw));
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < 4; ++j)
+        {
+            EXPECT_FLOAT_EQ(src[i](j), dst[i](j));
+        }
+    }
+}
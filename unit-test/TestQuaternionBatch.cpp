@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TestQuaternionBatch.cpp
+//!
+//! Unit test for QuaternionBatch.hpp
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/QuaternionBatch.hpp"
+
+namespace
+{
+
+//! Deterministic, non-trivial quaternions (37 is not a whole number of blocks)
+std::vector<matrix::Quaternion<double>> quaternions(size_t n, double offset)
+{
+    std::vector<matrix::Quaternion<double>> q(n);
+    for(size_t i = 0; i < n; ++i)
+    {
+        const double s = 0.37*static_cast<double>((i*7) % 23) - 2.1 + offset;
+        q[i] = matrix::Quaternion<double>(1.0 + 0.1*s, s, 0.5 - s, 0.2*s*s);
+    }
+    return q;
+}
+
+} // namespace
+
+TEST(QuaternionBatchTestSuite, TestLoadAndStore)
+{
+    const std::vector<matrix::Quaternion<double>> q = quaternions(37, 0.0);
+    matrix::QuaternionBatch<double> batch(q.data(), q.size());
+    EXPECT_EQ(37u, batch.size());
+
+    std::vector<matrix::Quaternion<double>> out(q.size());
+    batch.store(out.data());
+    for(size_t i = 0; i < q.size(); ++i)
+    {
+        EXPECT_EQ(q[i], out[i]);
+        EXPECT_EQ(q[i], batch(i));
+        EXPECT_EQ(q[i](0), batch.w()[i]);
+        EXPECT_EQ(q[i](3), batch.z()[i]);
+    }
+
+    batch.set(36, matrix::Quaternion<double>(1.0, 0.0, 0.0, 0.0));
+    EXPECT_EQ(matrix::Quaternion<double>(1.0, 0.0, 0.0, 0.0), batch(36));
+}
+
+TEST(QuaternionBatchTestSuite, TestMultiply)
+{
+    const std::vector<matrix::Quaternion<double>> p = quaternions(37, 0.0);
+    const std::vector<matrix::Quaternion<double>> q = quaternions(37, -0.4);
+    matrix::QuaternionBatch<double> batchP(p.data(), p.size());
+    const matrix::QuaternionBatch<double> batchQ(q.data(), q.size());
+
+    matrix::QuaternionBatch<double> products;
+    batchP.multiply(batchQ, products);
+    ASSERT_EQ(p.size(), products.size());
+    for(size_t i = 0; i < p.size(); ++i)
+    {
+        const matrix::Quaternion<double> expected = p[i]*q[i];
+        for(size_t j = 0; j < 4; ++j)
+        {
+            EXPECT_NEAR(expected(j), products(i)(j), 1e-12);
+        }
+    }
+
+    // The result may overwrite one of the inputs
+    batchP.multiply(batchQ, batchP);
+    for(size_t i = 0; i < p.size(); ++i)
+    {
+        EXPECT_EQ(products(i), batchP(i));
+    }
+}
+
+TEST(QuaternionBatchTestSuite, TestNormalize)
+{
+    const std::vector<matrix::Quaternion<double>> q = quaternions(37, 0.3);
+    matrix::QuaternionBatch<double> batch(q.data(), q.size());
+    batch.normalize();
+    for(size_t i = 0; i < q.size(); ++i)
+    {
+        matrix::Quaternion<double> expected = q[i];
+        expected.normalize();
+        for(size_t j = 0; j < 4; ++j)
+        {
+            EXPECT_NEAR(expected(j), batch(i)(j), 1e-12);
+        }
+    }
+
+    // The padding lanes stay zero instead of becoming 0/0
+    for(size_t i = batch.size(); i < batch.paddedSize(); ++i)
+    {
+        EXPECT_EQ(0.0, batch.w()[i]);
+        EXPECT_EQ(0.0, batch.z()[i]);
+    }
+}
+
+TEST(QuaternionBatchTestSuite, TestSizeMismatchThrows)
+{
+    const std::vector<matrix::Quaternion<double>> q = quaternions(37, 0.0);
+    const matrix::QuaternionBatch<double> batchP(q.data(), q.size());
+    const matrix::QuaternionBatch<double> batchQ(q.data(), 20);
+
+    matrix::QuaternionBatch<double> products;
+    EXPECT_THROW(batchP.multiply(batchQ, products), std::domain_error);
+    EXPECT_THROW(batchQ.multiply(batchP, products), std::domain_error);
+}
@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TestSVD3.cpp
+//!
+//! Unit test for SVD3.hpp
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <iostream>
+#include <gtest/gtest.h>
+#include "../src/DCM.hpp"
+#include "TestHelpers.hpp"
+
+TEST(SVD3TestSuite, TestDecomposition)
+{
+    test::Random random(41);
+    matrix::SquareMatrix<double, 3> I;
+    I.identity();
+    for(size_t trial = 0; trial < 100; ++trial)
+    {
+        matrix::SquareMatrix<double, 3> A;
+        test::fill(A, random);
+        matrix::SVD3<double> svd(A);
+        const matrix::SquareMatrix<double, 3> &U = svd.matrixU();
+        const matrix::SquareMatrix<double, 3> &V = svd.matrixV();
+        const matrix::Vector<double, 3> &s = svd.singularValues();
+
+        matrix::SquareMatrix<double, 3> US = U;
+        for(size_t i = 0; i < 3; ++i)
+        {
+            for(size_t j = 0; j < 3; ++j)
+            {
+                US(i,j) *= s(j);
+            }
+        }
+        EXPECT_LT(test::maxDifference(US*V.transpose(), A), 1.0e-14);
+        EXPECT_LT(test::maxDifference(U.transpose()*U, I), 1.0e-14);
+        EXPECT_LT(test::maxDifference(V.transpose()*V, I), 1.0e-14);
+        EXPECT_NEAR(1.0, matrix::determinant<double>(U), 1.0e-14);
+        EXPECT_NEAR(1.0, matrix::determinant<double>(V), 1.0e-14);
+
+        // Signed: the last singular value takes the sign of det(A)
+        EXPECT_GE(s(0), s(1));
+        EXPECT_GE(s(1), std::fabs(s(2)));
+        EXPECT_NEAR(matrix::determinant<double>(A), s(0)*s(1)*s(2), 1.0e-14);
+    }
+}
+
+TEST(SVD3TestSuite, TestPolar)
+{
+    test::Random random(42);
+    matrix::SquareMatrix<double, 3> I;
+    I.identity();
+    for(size_t trial = 0; trial < 100; ++trial)
+    {
+        matrix::SquareMatrix<double, 3> A;
+        test::fill(A, random);
+        matrix::PolarDecomposition3<double> polar(A);
+        const matrix::SquareMatrix<double, 3> &R = polar.rotation();
+        const matrix::SquareMatrix<double, 3> &S = polar.stretch();
+        EXPECT_LT(test::maxDifference(R*S, A), 1.0e-14);
+        EXPECT_LT(test::maxDifference(R.transpose()*R, I), 1.0e-14);
+        EXPECT_LT(test::maxDifference(S, S.transpose()), 1.0e-14);
+        EXPECT_NEAR(1.0, matrix::determinant<double>(R), 1.0e-14);
+    }
+
+    // A rotation times a symmetric positive definite stretch is recovered exactly
+    matrix::DCM<double> rotation(matrix::Quaternion<double>(0.9, -0.3, 0.2, 0.25));
+    matrix::SquareMatrix<double, 3> stretch = {{2.0, 0.3, -0.1}, {0.3, 1.5, 0.2}, {-0.1, 0.2, 1.0}};
+    matrix::PolarDecomposition3<double> polar(rotation*stretch);
+    EXPECT_LT(test::maxDifference(polar.rotation(), rotation), 1.0e-14);
+    EXPECT_LT(test::maxDifference(polar.stretch(), stretch), 1.0e-14);
+
+    // Rank-deficient input still gives a rotation
+    matrix::SquareMatrix<double, 3> singular = {{1.0, 2.0, 3.0}, {2.0, 4.0, 6.0}, {1.0, 0.0, 1.0}};
+    matrix::PolarDecomposition3<double> flat(singular);
+    EXPECT_LT(test::maxDifference(flat.rotation().transpose()*flat.rotation(), I), 1.0e-14);
+    EXPECT_LT(test::maxDifference(flat.rotation()*flat.stretch(), singular), 1.0e-13);
+}
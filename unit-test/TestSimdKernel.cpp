@@ -0,0 +1,198 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TestSimdKernel.cpp
+//!
+//! Unit test for SimdKernel.hpp. Every instruction set supported by the build
+//! host is compared against the scalar reference kernels.
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <limits>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/MatrixStorage.hpp"
+#include "../src/SimdKernel.hpp"
+
+namespace
+{
+
+const matrix::simd::Isa allIsas[] = {matrix::simd::Isa::SSE2, matrix::simd::Isa::AVX2, matrix::simd::Isa::AVX512};
+
+//! Deterministic, non-trivial test data
+template<class T>
+std::vector<T> sequence(size_t n, T offset)
+{
+    std::vector<T> v(n);
+    for(size_t i = 0; i < n; ++i)
+    {
+        v[i] = static_cast<T>(0.37*static_cast<double>((i*7) % 23) - 2.1) + offset;
+    }
+    return v;
+}
+
+//! Compare arrays up to rounding (the scalar code may be contracted into FMAs)
+template<class T, class A>
+void expectClose(const std::vector<T, A> &expected, const std::vector<T, A> &result)
+{
+    ASSERT_EQ(expected.size(), result.size());
+    const T tolerance = T(1024)*std::numeric_limits<T>::epsilon();
+    for(size_t i = 0; i < expected.size(); ++i)
+    {
+        EXPECT_NEAR(expected[i], result[i], tolerance) << "element " << i;
+    }
+}
+
+//! Compare every kernel of one instruction set against the scalar kernels
+template<class T>
+void expectMatchesScalar(matrix::simd::Isa isa)
+{
+    SCOPED_TRACE(matrix::simd::isaName(isa));
+    const matrix::simd::Kernels<T> &ref = matrix::simd::kernels<T>(matrix::simd::Isa::Scalar);
+    const matrix::simd::Kernels<T> &k = matrix::simd::kernels<T>(isa);
+
+    // Odd lengths exercise the remainder handling of every vector width
+    for(size_t n : {size_t(1), size_t(3), size_t(7), size_t(16), size_t(37)})
+    {
+        const std::vector<T> a = sequence<T>(n, T(0.5));
+        const std::vector<T> b = sequence<T>(n, T(-0.25));
+        std::vector<T> expected(n), result(n);
+
+        ref.add(a.data(), b.data(), expected.data(), n);
+        k.add(a.data(), b.data(), result.data(), n);
+        EXPECT_EQ(expected, result);
+
+        ref.subtract(a.data(), b.data(), expected.data(), n);
+        k.subtract(a.data(), b.data(), result.data(), n);
+        EXPECT_EQ(expected, result);
+
+        ref.multiply(a.data(), b.data(), expected.data(), n);
+        k.multiply(a.data(), b.data(), result.data(), n);
+        EXPECT_EQ(expected, result);
+
+        ref.scale(a.data(), T(1.75), expected.data(), n);
+        k.scale(a.data(), T(1.75), result.data(), n);
+        EXPECT_EQ(expected, result);
+
+        ref.multiply(a.data(), a.data(), expected.data(), n);
+        ref.sqrt(expected.data(), expected.data(), n);
+        k.multiply(a.data(), a.data(), result.data(), n);
+        k.sqrt(result.data(), result.data(), n);
+        EXPECT_EQ(expected, result);
+
+        // The vector kernels sum across lanes in a different order
+        const T dot = ref.dot(a.data(), b.data(), n);
+        EXPECT_NEAR(dot, k.dot(a.data(), b.data(), n), 1.0e-4);
+    }
+
+    // The per-object kernels agree with the scalar code up to rounding
+    const size_t count = 5;
+    const std::vector<T> a = sequence<T>(16*count, T(0.5));
+    const std::vector<T> b = sequence<T>(16*count, T(-0.25));
+    std::vector<T> expected(16*count), result(16*count);
+
+    ref.cross(a.data(), b.data(), expected.data(), count);
+    k.cross(a.data(), b.data(), result.data(), count);
+    expectClose(expected, result);
+
+    ref.quaternionMultiply(a.data(), b.data(), expected.data(), count);
+    k.quaternionMultiply(a.data(), b.data(), result.data(), count);
+    expectClose(expected, result);
+
+    ref.multiply3x3(a.data(), b.data(), expected.data(), count);
+    k.multiply3x3(a.data(), b.data(), result.data(), count);
+    expectClose(expected, result);
+
+    ref.multiply4x4(a.data(), b.data(), expected.data(), count);
+    k.multiply4x4(a.data(), b.data(), result.data(), count);
+    expectClose(expected, result);
+
+    ref.rotate3(a.data(), b.data(), expected.data(), count);
+    k.rotate3(a.data(), b.data(), result.data(), count);
+    expectClose(expected, result);
+
+    // Padded kernels need aligned arrays with zero padding lanes
+    using AlignedArray = std::vector<T, matrix::AlignedAllocator<T>>;
+    AlignedArray pa(a.begin(), a.begin() + 12*count), pb(b.begin(), b.begin() + 12*count);
+    for(size_t i = 3; i < 12*count; i += 4)
+    {
+        pa[i] = T(0);
+        pb[i] = T(0);
+    }
+    AlignedArray paddedExpected(12*count), paddedResult(12*count);
+
+    ref.crossPadded(pa.data(), pb.data(), paddedExpected.data(), 3*count);
+    k.crossPadded(pa.data(), pb.data(), paddedResult.data(), 3*count);
+    expectClose(paddedExpected, paddedResult);
+
+    ref.multiply3x3Padded(pa.data(), pb.data(), paddedExpected.data(), count);
+    k.multiply3x3Padded(pa.data(), pb.data(), paddedResult.data(), count);
+    expectClose(paddedExpected, paddedResult);
+
+    ref.rotate3Padded(pa.data(), pb.data(), paddedExpected.data(), 3*count);
+    k.rotate3Padded(pa.data(), pb.data(), paddedResult.data(), 3*count);
+    expectClose(paddedExpected, paddedResult);
+    for(size_t i = 3; i < 12*count; i += 4)
+    {
+        EXPECT_EQ(T(0), paddedResult[i]);
+    }
+}
+
+} // namespace
+
+TEST(SimdKernelTestSuite, TestScalarReference)
+{
+    const float a[3] = {3.0f, 6.0f, -2.0f};
+    const float b[3] = {7.0f, 1.0f, 0.0f};
+    float c[3];
+    matrix::simd::Scalar::cross(a, b, c, 1);
+    EXPECT_FLOAT_EQ(2.0f, c[0]);
+    EXPECT_FLOAT_EQ(-14.0f, c[1]);
+    EXPECT_FLOAT_EQ(-39.0f, c[2]);
+    EXPECT_FLOAT_EQ(27.0f, matrix::simd::Scalar::dot(a, b, 3));
+
+    const double p[4] = {1.0, 2.0, 3.0, 4.0};
+    const double q[4] = {5.0, 6.0, 7.0, 8.0};
+    double r[4];
+    matrix::simd::Scalar::quaternionMultiply(p, q, r, 1);
+    EXPECT_DOUBLE_EQ(-60.0, r[0]);
+    EXPECT_DOUBLE_EQ(12.0, r[1]);
+    EXPECT_DOUBLE_EQ(30.0, r[2]);
+    EXPECT_DOUBLE_EQ(24.0, r[3]);
+}
+
+TEST(SimdKernelTestSuite, TestFloatKernelsMatchScalar)
+{
+    for(matrix::simd::Isa isa : allIsas)
+    {
+        if(matrix::simd::isSupported(isa))
+        {
+            expectMatchesScalar<float>(isa);
+        }
+        else
+        {
+            std::cout << matrix::simd::isaName(isa) << " not supported by this host, skipped" << std::endl;
+        }
+    }
+}
+
+TEST(SimdKernelTestSuite, TestDoubleKernelsMatchScalar)
+{
+    for(matrix::simd::Isa isa : allIsas)
+    {
+        if(matrix::simd::isSupported(isa))
+        {
+            expectMatchesScalar<double>(isa);
+        }
+    }
+}
+
+TEST(SimdKernelTestSuite, TestRuntimeDispatch)
+{
+    const matrix::simd::Isa isa = matrix::simd::detectIsa();
+    EXPECT_TRUE(matrix::simd::isSupported(isa));
+    std::cout << "Dispatching to " << matrix::simd::isaName(isa) << std::endl;
+    EXPECT_EQ(&matrix::simd::kernels<double>(isa), &matrix::simd::kernels<double>());
+    EXPECT_EQ(&matrix::simd::kernels<float>(isa), &matrix::simd::kernels<float>());
+}
@@ -404,6 +404,23 @@ TEST(SquareMatrixTestSuite, TestTrace)
     EXPECT_EQ(5, m.trace());
 }
 
+TEST(SquareMatrixTestSuite, TestCompileTimeEvaluation)
+{
+    constexpr matrix::SquareMatrix<int, 3> I = matrix::identity<int, 3>();
+    static_assert(I(0,0) == 1 && I(1,1) == 1 && I(2,2) == 1, "identity diagonal");
+    static_assert(I(0,1) == 0 && I(1,2) == 0 && I(2,0) == 0, "identity off-diagonal");
+    static_assert(I.trace() == 3, "identity trace");
+
+    constexpr matrix::SquareMatrix<int, 3> m = {{2, -5, 3}, {3, -3, 0}, {4, 1, 6}};
+    static_assert(m.trace() == 5, "trace");
+    static_assert(m.transpose()(0,2) == 4 && m.transpose()(2,0) == 3, "transpose");
+    static_assert(m*I == m, "product with identity");
+
+    constexpr matrix::SquareMatrix<int, 3> sum = m + I*2 - m;
+    static_assert(sum == I*2, "fused expression");
+    EXPECT_EQ(2, sum(1,1));
+}
+
 TEST(SquareMatrixTestSuite, TestMinor)
 {
     matrix::SquareMatrix<int, 3> m = {{1, 2, 3}, {4, 5, 6}, {7, 8 ,9}};
@@ -642,6 +659,54 @@ TEST(SquareMatrixTestSuite, Test5x5Determinant)
     EXPECT_EQ(3523, matrix::determinant<int>(m));
 }
 
+TEST(SquareMatrixTestSuite, TestZeroPivotDeterminant)
+{
+    // Leading zeros force row swaps in both the integer and floating-point eliminations
+    matrix::SquareMatrix<int, 5> m = {{0, 2, 1, 0, 3}, {0, 0, 4, 1, 2}, {1, 3, 0, 2, 0}, {2, 1, 1, 0, 1}, {0, 1, 0, 3, 1}};
+    matrix::SquareMatrix<double, 5> d;
+    for(size_t i = 0; i < 5; ++i)
+    {
+        for(size_t j = 0; j < 5; ++j)
+        {
+            d(i,j) = m(i,j);
+        }
+    }
+    EXPECT_EQ(-159, matrix::determinant<int>(m));
+    EXPECT_NEAR(-159.0, matrix::determinant<double>(d), 1.0e-12);
+
+    matrix::SquareMatrix<int, 5> singular = m;
+    for(size_t j = 0; j < 5; ++j)
+    {
+        singular(4,j) = m(0,j) + m(2,j);
+    }
+    EXPECT_EQ(0, matrix::determinant<int>(singular));
+}
+
+TEST(SquareMatrixTestSuite, TestLargeDeterminant)
+{
+    // Tridiagonal (-1, 2, -1) has determinant M+1
+    matrix::SquareMatrix<double, 12> A;
+    matrix::SquareMatrix<double, 12, matrix::ColumnMajor> B;
+    for(size_t i = 0; i < 12; ++i)
+    {
+        A(i,i) = B(i,i) = 2.0;
+        if(i+1 < 12)
+        {
+            A(i,i+1) = A(i+1,i) = B(i,i+1) = B(i+1,i) = -1.0;
+        }
+    }
+    EXPECT_NEAR(13.0, matrix::determinant<double>(A), 1.0e-10);
+    EXPECT_NEAR(13.0, matrix::determinant<double>(B), 1.0e-10);
+
+    matrix::SquareMatrix<long, 10> I;
+    I.identity();
+    I(9,9) = 7;
+    EXPECT_EQ(7, matrix::determinant<long>(I));
+
+    matrix::SquareMatrix<double, 4> m = {{2.0, 2.0, 6.0, 8.0}, {5.0, 3.0, -4.0, 5.0}, {3.0, -7.0, 2.0, 0.0}, {3.0, 5.0, 7.0, 2.0}};
+    EXPECT_NEAR(3508.0, matrix::determinant<double>(m), 1.0e-9);
+}
+
 TEST(SquareMatrixTestSuite, Test2x2InverseSuccess)
 {
     double vals[2][2] = {{3, -4}, {2, 1}};
@@ -674,4 +739,199 @@ TEST(SquareMatrixTestSuite, Test3x3InverseSuccess)
     EXPECT_DOUBLE_EQ(-0.20867208672086721, minv(2,0));
     EXPECT_DOUBLE_EQ(-0.043360433604336043, minv(2,1));
     EXPECT_DOUBLE_EQ(0.056910569105691054, minv(2,2));
-}
\ No newline at end of file
+}
+
+TEST(SquareMatrixTestSuite, Test4x4Inverse)
+{
+    matrix::SquareMatrix<double, 4> m = {{2.0, 2.0, 6.0, 8.0}, {5.0, 3.0, -4.0, 5.0}, {3.0, -7.0, 2.0, 0.0}, {3.0, 5.0, 7.0, 2.0}};
+    matrix::SquareMatrix<double, 4> minv = matrix::inverse<double>(m);
+    matrix::SquareMatrix<double, 4> product = m*minv;
+    for(size_t i = 0; i < 4; ++i)
+    {
+        for(size_t j = 0; j < 4; ++j)
+        {
+            EXPECT_NEAR(i == j ? 1.0 : 0.0, product(i,j), 1.0e-12);
+        }
+    }
+
+    // Column-major storage gives the same inverse
+    matrix::SquareMatrix<double, 4, matrix::ColumnMajor> c(m);
+    matrix::SquareMatrix<double, 4, matrix::ColumnMajor> cinv = matrix::inverse<double>(c);
+    for(size_t i = 0; i < 4; ++i)
+    {
+        for(size_t j = 0; j < 4; ++j)
+        {
+            EXPECT_NEAR(minv(i,j), cinv(i,j), 1.0e-15);
+        }
+    }
+
+    matrix::SquareMatrix<double, 4> singular = {{1.0, 2.0, 3.0, 4.0}, {2.0, 4.0, 6.0, 8.0}, {0.0, 1.0, 0.0, 1.0}, {1.0, 0.0, 1.0, 0.0}};
+    EXPECT_THROW(matrix::inverse<double>(singular), std::runtime_error);
+}
+
+TEST(SquareMatrixTestSuite, TestLargeInverse)
+{
+    // Invertible with a zero leading pivot
+    matrix::SquareMatrix<double, 6> m = {{0.0, 2.0, 1.0, 0.0, 3.0, 1.0}, {0.0, 0.0, 4.0, 1.0, 2.0, 0.0}, {1.0, 3.0, 0.0, 2.0, 0.0, 5.0},
+                                         {2.0, 1.0, 1.0, 0.0, 1.0, 2.0}, {0.0, 1.0, 0.0, 3.0, 1.0, 1.0}, {4.0, 0.0, 2.0, 1.0, 0.0, 3.0}};
+    matrix::SquareMatrix<double, 6> minv = matrix::inverse<double>(m);
+    matrix::SquareMatrix<double, 6> product = minv*m;
+    for(size_t i = 0; i < 6; ++i)
+    {
+        for(size_t j = 0; j < 6; ++j)
+        {
+            EXPECT_NEAR(i == j ? 1.0 : 0.0, product(i,j), 1.0e-12);
+        }
+    }
+
+    matrix::SquareMatrix<double, 5, matrix::ColumnMajor> c;
+    for(size_t i = 0; i < 5; ++i)
+    {
+        for(size_t j = 0; j < 5; ++j)
+        {
+            c(i,j) = 1.0 / (1.0 + i + 2.0*j);
+        }
+        c(i,i) += 1.0;
+    }
+    matrix::SquareMatrix<double, 5, matrix::ColumnMajor> cproduct = c*matrix::inverse<double>(c);
+    for(size_t i = 0; i < 5; ++i)
+    {
+        for(size_t j = 0; j < 5; ++j)
+        {
+            EXPECT_NEAR(i == j ? 1.0 : 0.0, cproduct(i,j), 1.0e-12);
+        }
+    }
+
+    matrix::SquareMatrix<double, 6> singular = m;
+    for(size_t j = 0; j < 6; ++j)
+    {
+        singular(5,j) = m(0,j) - m(3,j);
+    }
+    EXPECT_THROW(matrix::inverse<double>(singular), std::runtime_error);
+}
+
+TEST(SquareMatrixTestSuite, TestScaledInverse)
+{
+    // Well conditioned, but the determinants are 1e-18 and 1e-12 times those
+    // of the unscaled matrices
+    matrix::SquareMatrix<double, 6> m;
+    for(size_t i = 0; i < 6; ++i)
+    {
+        for(size_t j = 0; j < 6; ++j)
+        {
+            m(i,j) = 1.0e-3 / (1.0 + i + j);
+        }
+        m(i,i) += 1.0e-3;
+    }
+    matrix::SquareMatrix<double, 6> minv = matrix::inverse<double>(m);
+    matrix::SquareMatrix<double, 6> product = m*minv;
+    for(size_t i = 0; i < 6; ++i)
+    {
+        for(size_t j = 0; j < 6; ++j)
+        {
+            EXPECT_NEAR(i == j ? 1.0 : 0.0, product(i,j), 1.0e-12);
+        }
+    }
+    matrix::SquareMatrix<double, 6> tinv;
+    EXPECT_TRUE(matrix::tryInverse(m, tinv));
+    EXPECT_TRUE(tinv == minv);
+
+    matrix::SquareMatrix<double, 4> f = {{2.0, 2.0, 6.0, 8.0}, {5.0, 3.0, -4.0, 5.0}, {3.0, -7.0, 2.0, 0.0}, {3.0, 5.0, 7.0, 2.0}};
+    matrix::SquareMatrix<double, 4> scaled = f*1.0e-3;
+    matrix::SquareMatrix<double, 4> sinv;
+    EXPECT_TRUE(matrix::tryInverse(scaled, sinv));
+    matrix::SquareMatrix<double, 4> finv = matrix::inverse<double>(f);
+    for(size_t i = 0; i < 4; ++i)
+    {
+        for(size_t j = 0; j < 4; ++j)
+        {
+            EXPECT_NEAR(1.0e3*finv(i,j), sinv(i,j), 1.0e-9);
+        }
+    }
+
+    // Singularity is judged relative to the scale, so a large singular matrix
+    // whose rounded determinant is not zero is still rejected
+    matrix::SquareMatrix<double, 6> singular = m*1.0e9;
+    for(size_t j = 0; j < 6; ++j)
+    {
+        singular(5,j) = 0.1*singular(0,j) + 0.3*singular(3,j);
+    }
+    EXPECT_THROW(matrix::inverse<double>(singular), std::runtime_error);
+    EXPECT_FALSE(matrix::tryInverse(singular, tinv));
+
+    matrix::SquareMatrix<double, 4> singular4 = f*1.0e9;
+    for(size_t j = 0; j < 4; ++j)
+    {
+        singular4(3,j) = 0.1*singular4(0,j) + 0.3*singular4(2,j);
+    }
+    EXPECT_THROW(matrix::inverse<double>(singular4), std::runtime_error);
+
+    // The closed forms for 2x2 and 3x3 use the same scale-relative test
+    matrix::SquareMatrix<double, 3> small3;
+    small3.identity();
+    small3 *= 1.0e-4;
+    matrix::SquareMatrix<double, 3> small3inv;
+    EXPECT_TRUE(matrix::tryInverse(small3, small3inv));
+    EXPECT_DOUBLE_EQ(1.0e4, small3inv(1,1));
+    EXPECT_DOUBLE_EQ(0.0, small3inv(0,2));
+    matrix::SquareMatrix<double, 3> r = {{3.0, 2.0, -4.0}, {0.0, -7.0, 8.0}, {11.0, 2.0, 9.0}};
+    matrix::SquareMatrix<double, 3> rinv = matrix::inverse<double>(r);
+    matrix::SquareMatrix<double, 3> scaled3 = r*1.0e-5;
+    matrix::SquareMatrix<double, 3> scaledInv = matrix::inverse<double>(scaled3);
+    for(size_t i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < 3; ++j)
+        {
+            EXPECT_NEAR(1.0e5*rinv(i,j), scaledInv(i,j), 1.0e-9);
+        }
+    }
+
+    matrix::SquareMatrix<double, 2> small2 = {{2.0e-5, 1.0e-5}, {-1.0e-5, 3.0e-5}};
+    matrix::SquareMatrix<double, 2> small2inv = matrix::inverse<double>(small2);
+    EXPECT_NEAR(3.0e5/7.0, small2inv(0,0), 1.0e-9);
+
+    matrix::SquareMatrix<double, 3> singular3 = r*1.0e9;
+    for(size_t j = 0; j < 3; ++j)
+    {
+        singular3(2,j) = 0.1*singular3(0,j) + 0.3*singular3(1,j);
+    }
+    EXPECT_THROW(matrix::inverse<double>(singular3), std::runtime_error);
+}
+
+TEST(SquareMatrixTestSuite, TestTryInverse)
+{
+    matrix::SquareMatrix<double, 3> m = {{3.0, 2.0, -4.0}, {0.0, -7.0, 8.0}, {11.0, 2.0, 9.0}};
+    matrix::SquareMatrix<double, 3> minv;
+    EXPECT_TRUE(matrix::tryInverse(m, minv));
+    EXPECT_TRUE(minv == matrix::inverse<double>(m));
+
+    // A failed inversion leaves the output untouched
+    matrix::SquareMatrix<double, 2> singular = {{0.0, 0.0}, {6.0, 5.0}};
+    matrix::SquareMatrix<double, 2> out = {{1.0, 2.0}, {3.0, 4.0}};
+    EXPECT_FALSE(matrix::tryInverse(singular, out));
+    EXPECT_DOUBLE_EQ(1.0, out(0,0));
+    EXPECT_DOUBLE_EQ(4.0, out(1,1));
+
+    matrix::SquareMatrix<double, 7> zero;
+    matrix::SquareMatrix<double, 7> zinv;
+    EXPECT_FALSE(matrix::tryInverse(zero, zinv));
+    EXPECT_DOUBLE_EQ(0.0, zinv(3,3));
+}
+
+TEST(SquareMatrixTestSuite, TestRigidInverse)
+{
+    // Rotation of 30 degrees about z, then a translation
+    const double c = std::cos(M_PI/6.0), s = std::sin(M_PI/6.0);
+    matrix::SquareMatrix<double, 4> T = {{c, -s, 0.0, 1.0}, {s, c, 0.0, -2.0}, {0.0, 0.0, 1.0, 3.0}, {0.0, 0.0, 0.0, 1.0}};
+    matrix::SquareMatrix<double, 4> Tinv = matrix::rigidInverse(T);
+    matrix::SquareMatrix<double, 4> general = matrix::inverse<double>(T);
+    for(size_t i = 0; i < 4; ++i)
+    {
+        for(size_t j = 0; j < 4; ++j)
+        {
+            EXPECT_NEAR(general(i,j), Tinv(i,j), 1.0e-15);
+        }
+    }
+    EXPECT_DOUBLE_EQ(-3.0, Tinv(2,3));
+    EXPECT_DOUBLE_EQ(1.0, Tinv(3,3));
+}
@@ -0,0 +1,149 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TestSymmetricEigen.cpp
+//!
+//! Unit test for SymmetricEigen.hpp
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <iostream>
+#include <gtest/gtest.h>
+#include "../src/SymmetricEigen.hpp"
+#include "TestHelpers.hpp"
+
+namespace
+{
+
+//! Fill a symmetric matrix with values in [-0.5, 0.5]
+template<size_t M>
+void fillSymmetric(matrix::SquareMatrix<double, M> &m, test::Random &random)
+{
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = i; j < M; ++j)
+        {
+            m(i,j) = test::uniform(random);
+            m(j,i) = m(i,j);
+        }
+    }
+}
+
+//! V diag(d) V^T
+template<size_t M>
+matrix::SquareMatrix<double, M> reconstruct(const matrix::SquareMatrix<double, M> &V, const matrix::Vector<double, M> &d)
+{
+    matrix::SquareMatrix<double, M> VD = V;
+    for(size_t i = 0; i < M; ++i)
+    {
+        for(size_t j = 0; j < M; ++j)
+        {
+            VD(i,j) *= d(j);
+        }
+    }
+    return VD*V.transpose();
+}
+
+} // namespace
+
+TEST(SymmetricEigenTestSuite, TestJacobi)
+{
+    test::Random random(31);
+    matrix::SquareMatrix<double, 8> A;
+    fillSymmetric(A, random);
+    matrix::SymmetricEigen<double, 8> eig(A);
+    EXPECT_TRUE(eig.hasConverged());
+
+    const matrix::SquareMatrix<double, 8> &V = eig.eigenvectors();
+    EXPECT_LT(test::maxDifference(reconstruct(V, eig.eigenvalues()), A), 1.0e-14);
+    matrix::SquareMatrix<double, 8> I;
+    I.identity();
+    EXPECT_LT(test::maxDifference(V.transpose()*V, I), 1.0e-14);
+    for(size_t i = 1; i < 8; ++i)
+    {
+        EXPECT_LE(eig.eigenvalues()(i-1), eig.eigenvalues()(i));
+    }
+
+    // A diagonal matrix needs no rotations
+    matrix::SquareMatrix<double, 3> D = {{3.0, 0.0, 0.0}, {0.0, -1.0, 0.0}, {0.0, 0.0, 2.0}};
+    matrix::SymmetricEigen<double, 3> diag(D);
+    EXPECT_DOUBLE_EQ(-1.0, diag.eigenvalues()(0));
+    EXPECT_DOUBLE_EQ(2.0, diag.eigenvalues()(1));
+    EXPECT_DOUBLE_EQ(3.0, diag.eigenvalues()(2));
+    EXPECT_DOUBLE_EQ(1.0, std::fabs(diag.eigenvectors()(1,0)));
+}
+
+TEST(SymmetricEigenTestSuite, TestClosedForm)
+{
+    test::Random random(32);
+    for(size_t trial = 0; trial < 100; ++trial)
+    {
+        matrix::SquareMatrix<double, 3> A;
+        fillSymmetric(A, random);
+        matrix::SymmetricEigen3<double> closed(A);
+        matrix::SymmetricEigen3<double> jacobi;
+        jacobi.computeJacobi(A);
+
+        const matrix::DCM<double> &V = closed.eigenvectors();
+        EXPECT_LT(test::maxDifference(reconstruct<3>(V, closed.eigenvalues()), A), 1.0e-12);
+        EXPECT_LT(test::maxDifference(reconstruct<3>(jacobi.eigenvectors(), jacobi.eigenvalues()), A), 1.0e-14);
+        EXPECT_LT(test::maxDifference(closed.eigenvalues(), jacobi.eigenvalues()), 1.0e-12);
+
+        // Both return proper rotations
+        EXPECT_NEAR(1.0, matrix::determinant<double>(V), 1.0e-12);
+        EXPECT_NEAR(1.0, matrix::determinant<double>(jacobi.eigenvectors()), 1.0e-14);
+    }
+}
+
+TEST(SymmetricEigenTestSuite, TestInertiaTensor)
+{
+    // Principal inertia (1, 2, 4) rotated into the body frame
+    matrix::Quaternion<double> q(0.8, 0.2, -0.4, 0.4);
+    q.normalize();
+    matrix::DCM<double> R(q);
+    matrix::SquareMatrix<double, 3> principal = {{1.0, 0.0, 0.0}, {0.0, 2.0, 0.0}, {0.0, 0.0, 4.0}};
+    matrix::SquareMatrix<double, 3> J = R*principal*R.transpose();
+
+    matrix::SymmetricEigen3<double> eig(J);
+    EXPECT_NEAR(1.0, eig.eigenvalues()(0), 1.0e-14);
+    EXPECT_NEAR(2.0, eig.eigenvalues()(1), 1.0e-14);
+    EXPECT_NEAR(4.0, eig.eigenvalues()(2), 1.0e-14);
+
+    // Each principal axis matches a column of R up to sign
+    for(size_t j = 0; j < 3; ++j)
+    {
+        double dot = 0.0;
+        for(size_t i = 0; i < 3; ++i)
+        {
+            dot += eig.eigenvectors()(i,j)*R(i,j);
+        }
+        EXPECT_NEAR(1.0, std::fabs(dot), 1.0e-14);
+    }
+}
+
+TEST(SymmetricEigenTestSuite, TestRepeatedEigenvalues)
+{
+    matrix::SquareMatrix<double, 3> I;
+    I.identity();
+    matrix::SymmetricEigen3<double> scalar(I*5.0);
+    EXPECT_DOUBLE_EQ(5.0, scalar.eigenvalues()(0));
+    EXPECT_DOUBLE_EQ(5.0, scalar.eigenvalues()(2));
+    EXPECT_LT(test::maxDifference(scalar.eigenvectors(), I), 1.0e-15);
+
+    matrix::SymmetricEigen3<double> zero((matrix::SquareMatrix<double, 3>()));
+    EXPECT_DOUBLE_EQ(0.0, zero.eigenvalues()(1));
+
+    // A symmetric top: a double eigenvalue still gives an orthonormal basis
+    matrix::SquareMatrix<double, 3> top = {{2.0, 1.0, 1.0}, {1.0, 2.0, 1.0}, {1.0, 1.0, 2.0}};
+    matrix::SymmetricEigen3<double> closed(top);
+    EXPECT_NEAR(1.0, closed.eigenvalues()(0), 1.0e-14);
+    EXPECT_NEAR(1.0, closed.eigenvalues()(1), 1.0e-14);
+    EXPECT_NEAR(4.0, closed.eigenvalues()(2), 1.0e-14);
+    EXPECT_LT(test::maxDifference(reconstruct<3>(closed.eigenvectors(), closed.eigenvalues()), top), 1.0e-14);
+    EXPECT_LT(test::maxDifference(closed.eigenvectors().transpose()*closed.eigenvectors(), I), 1.0e-14);
+
+    matrix::SymmetricEigen3<double> jacobi;
+    jacobi.computeJacobi(top);
+    EXPECT_LT(test::maxDifference(reconstruct<3>(jacobi.eigenvectors(), jacobi.eigenvalues()), top), 1.0e-14);
+}
@@ -0,0 +1,113 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TestSymmetricMatrix.cpp
+//!
+//! Unit test for SymmetricMatrix.hpp
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <iostream>
+#include <gtest/gtest.h>
+#include "../src/SymmetricMatrix.hpp"
+#include "TestHelpers.hpp"
+
+namespace
+{
+
+//! A random symmetric matrix
+template<size_t M>
+matrix::SquareMatrix<double, M> symmetric(test::Random &random)
+{
+    matrix::SquareMatrix<double, M> G;
+    test::fill(G, random);
+    return G + G.transpose();
+}
+
+} // namespace
+
+TEST(SymmetricMatrixTestSuite, TestStorage)
+{
+    matrix::SquareMatrix<double, 3> A = {{1.0, 2.0, 3.0}, {2.0, 5.0, 6.0}, {3.0, 6.0, 9.0}};
+    matrix::SymmetricMatrix<double, 3> S(A);
+    const double upper[6] = {1.0, 2.0, 3.0, 5.0, 6.0, 9.0};
+    for(size_t e = 0; e < 6; ++e)
+    {
+        EXPECT_EQ(upper[e], S.data()[e]);
+    }
+    EXPECT_LT(test::maxDifference(S.toSquareMatrix(), A), 1.0e-300);
+
+    // Both halves are one element
+    S(2,0) = -4.0;
+    EXPECT_EQ(-4.0, S(0,2));
+    if(matrix::DefaultBounds::enabled)
+    {
+        EXPECT_THROW(S(3,0), std::domain_error);
+    }
+
+    matrix::SymmetricMatrix<double, 3> I;
+    I.identity();
+    matrix::SquareMatrix<double, 3> dense;
+    dense.identity();
+    EXPECT_LT(test::maxDifference(I.toSquareMatrix(), dense), 1.0e-300);
+
+    const matrix::SymmetricMatrix<double, 3> sum = S + I*2.0 - I;
+    EXPECT_EQ(2.0, sum(0,0));
+    EXPECT_EQ(-4.0, sum(2,0));
+}
+
+TEST(SymmetricMatrixTestSuite, TestMultiply)
+{
+    test::Random random(71);
+    const matrix::SquareMatrix<double, 7> A = symmetric<7>(random);
+    const matrix::SymmetricMatrix<double, 7> S(A);
+    matrix::Matrix<double, 7, 3> B;
+    matrix::Vector<double, 7> v;
+    test::fill(B, random);
+    test::fill(v, random);
+    EXPECT_LT(test::maxDifference(S*B, A*B), 1.0e-15);
+    EXPECT_LT(test::maxDifference(S*v, A*v), 1.0e-15);
+}
+
+TEST(SymmetricMatrixTestSuite, TestCongruence)
+{
+    test::Random random(72);
+    for(size_t trial = 0; trial < 10; ++trial)
+    {
+        const matrix::SquareMatrix<double, 9> P = symmetric<9>(random);
+        matrix::SquareMatrix<double, 9> F;
+        matrix::Matrix<double, 4, 9> H;
+        test::fill(F, random);
+        test::fill(H, random);
+        const matrix::SymmetricMatrix<double, 9> Ps(P);
+
+        const matrix::SymmetricMatrix<double, 9> FPFt = matrix::congruence(F, Ps);
+        EXPECT_LT(test::maxDifference(FPFt.toSquareMatrix(), F*P*F.transpose()), 1.0e-14);
+
+        // A non-square F maps to a smaller symmetric matrix
+        const matrix::SymmetricMatrix<double, 4> HPHt = matrix::congruence(H, Ps);
+        EXPECT_LT(test::maxDifference(HPHt.toSquareMatrix(), H*P*H.transpose()), 1.0e-14);
+    }
+}
+
+TEST(SymmetricMatrixTestSuite, TestRankUpdate)
+{
+    test::Random random(73);
+    const matrix::SquareMatrix<double, 8> P = symmetric<8>(random);
+    matrix::Matrix<double, 8, 3> K;
+    matrix::Matrix<double, 8, 1> v;
+    test::fill(K, random);
+    test::fill(v, random);
+
+    matrix::SymmetricMatrix<double, 8> S(P);
+    S.rankUpdate(K, -0.5);
+    const matrix::SquareMatrix<double, 8> expected = P - K*K.transpose()*0.5;
+    EXPECT_LT(test::maxDifference(S.toSquareMatrix(), expected), 1.0e-15);
+
+    // Rank 1 with the default weight, on an odd size
+    matrix::SymmetricMatrix<double, 8> T(P);
+    T.rankUpdate(v);
+    const matrix::SquareMatrix<double, 8> outer = P + v*v.transpose();
+    EXPECT_LT(test::maxDifference(T.toSquareMatrix(), outer), 1.0e-15);
+}
@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TestThreadPool.cpp
+//!
+//! Unit test for ThreadPool.hpp
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/ThreadPool.hpp"
+
+TEST(ThreadPoolTestSuite, TestConcurrency)
+{
+    matrix::ThreadPool serial(0);
+    EXPECT_EQ(1u, serial.concurrency());
+
+    matrix::ThreadPool pool(3);
+    EXPECT_EQ(4u, pool.concurrency());
+}
+
+TEST(ThreadPoolTestSuite, TestParallelForVisitsEveryIndexOnce)
+{
+    for(size_t threads : {size_t(0), size_t(1), size_t(4)})
+    {
+        matrix::ThreadPool pool(threads);
+        // Repeated jobs reuse the same workers
+        for(size_t count : {size_t(0), size_t(1), size_t(7), size_t(1000)})
+        {
+            std::vector<int> visits(count, 0);
+            pool.parallelFor(count, [&visits](size_t i) { ++visits[i]; });
+            EXPECT_EQ(std::vector<int>(count, 1), visits);
+        }
+    }
+}
+
+TEST(ThreadPoolTestSuite, TestExceptionsReachTheCaller)
+{
+    matrix::ThreadPool pool(1);
+    const std::thread::id caller = std::this_thread::get_id();
+
+    // Two indices, each held until both have started, so the caller and the
+    // worker run one each; the thread chosen by throwOnCaller throws
+    for(bool throwOnCaller : {true, false})
+    {
+        std::atomic<int> started(0);
+        std::atomic<int> finished(0);
+        auto fn = [&](size_t)
+        {
+            ++started;
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while(started < 2 && std::chrono::steady_clock::now() < deadline)
+            {
+                std::this_thread::yield();
+            }
+            if((std::this_thread::get_id() == caller) == throwOnCaller)
+            {
+                throw std::runtime_error("piece failed");
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            ++finished;
+        };
+        EXPECT_THROW(pool.parallelFor(2, fn), std::runtime_error);
+
+        // parallelFor waited for the other piece before rethrowing
+        EXPECT_EQ(1, finished.load());
+    }
+
+    // Every piece throwing reports one exception, and the pool stays usable
+    EXPECT_THROW(pool.parallelFor(100, [](size_t) { throw std::runtime_error("every piece"); }), std::runtime_error);
+    std::vector<int> visits(50, 0);
+    pool.parallelFor(50, [&visits](size_t i) { ++visits[i]; });
+    EXPECT_EQ(std::vector<int>(50, 1), visits);
+}
+
+TEST(ThreadPoolTestSuite, TestDefaultThreadPool)
+{
+    matrix::ThreadPool &pool = matrix::defaultThreadPool();
+    EXPECT_EQ(&pool, &matrix::defaultThreadPool());
+    EXPECT_GE(pool.concurrency(), 1u);
+}
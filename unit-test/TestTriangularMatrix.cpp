@@ -0,0 +1,131 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TestTriangularMatrix.cpp
+//!
+//! Unit test for TriangularMatrix.hpp
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include "../src/TriangularMatrix.hpp"
+#include "TestHelpers.hpp"
+
+namespace
+{
+
+//! A well-conditioned square matrix (diagonal pushed away from zero)
+template<size_t M>
+matrix::SquareMatrix<double, M> wellConditioned(test::Random &random)
+{
+    matrix::SquareMatrix<double, M> A;
+    test::fill(A, random);
+    for(size_t i = 0; i < M; ++i)
+    {
+        A(i,i) += A(i,i) < 0.0 ? -2.0 : 2.0;
+    }
+    return A;
+}
+
+} // namespace
+
+TEST(TriangularMatrixTestSuite, TestStorage)
+{
+    matrix::SquareMatrix<double, 3> A = {{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}, {7.0, 8.0, 9.0}};
+    matrix::LowerTriangular<double, 3> L(A);
+    matrix::UpperTriangular<double, 3> U(A);
+
+    const double lower[6] = {1.0, 4.0, 5.0, 7.0, 8.0, 9.0};
+    const double upper[6] = {1.0, 2.0, 3.0, 5.0, 6.0, 9.0};
+    for(size_t e = 0; e < 6; ++e)
+    {
+        EXPECT_EQ(lower[e], L.data()[e]);
+        EXPECT_EQ(upper[e], U.data()[e]);
+    }
+
+    EXPECT_EQ(8.0, L(2,1));
+    EXPECT_EQ(0.0, L(1,2));
+    EXPECT_EQ(6.0, U(1,2));
+    EXPECT_EQ(0.0, U(2,1));
+    EXPECT_TRUE(L.toSquareMatrix().isLowerTriangular());
+    EXPECT_TRUE(U.toSquareMatrix().isUpperTriangular());
+    EXPECT_EQ(45.0, L.determinant());
+
+    L.element(2,0) = -7.0;
+    EXPECT_EQ(-7.0, L.toSquareMatrix()(2,0));
+    EXPECT_THROW(L.element(0,2) = 1.0, std::domain_error);
+    EXPECT_THROW(U.element(2,0) = 1.0, std::domain_error);
+    if(matrix::DefaultBounds::enabled)
+    {
+        EXPECT_THROW(U(3,3), std::domain_error);
+    }
+
+    // Transpose swaps the triangle
+    matrix::UpperTriangular<double, 3> Lt = L.transpose();
+    EXPECT_LT(test::maxDifference(Lt.toSquareMatrix(), L.toSquareMatrix().transpose()), 1.0e-300);
+
+    matrix::LowerTriangular<double, 3> I;
+    I.identity();
+    matrix::SquareMatrix<double, 3> dense;
+    dense.identity();
+    EXPECT_LT(test::maxDifference(I.toSquareMatrix(), dense), 1.0e-300);
+}
+
+TEST(TriangularMatrixTestSuite, TestMultiply)
+{
+    test::Random random(61);
+    matrix::SquareMatrix<double, 7> A;
+    matrix::Matrix<double, 7, 4> B;
+    matrix::Matrix<double, 5, 7> C;
+    matrix::Vector<double, 7> v;
+    test::fill(A, random);
+    test::fill(B, random);
+    test::fill(C, random);
+    test::fill(v, random);
+
+    matrix::LowerTriangular<double, 7> L(A);
+    matrix::UpperTriangular<double, 7> U(A);
+    const matrix::SquareMatrix<double, 7> Ld = L.toSquareMatrix();
+    const matrix::SquareMatrix<double, 7> Ud = U.toSquareMatrix();
+
+    EXPECT_LT(test::maxDifference(L*B, Ld*B), 1.0e-15);
+    EXPECT_LT(test::maxDifference(U*B, Ud*B), 1.0e-15);
+    EXPECT_LT(test::maxDifference(C*L, C*Ld), 1.0e-15);
+    EXPECT_LT(test::maxDifference(C*U, C*Ud), 1.0e-15);
+    EXPECT_LT(test::maxDifference(L*v, Ld*v), 1.0e-15);
+    EXPECT_LT(test::maxDifference(U*v, Ud*v), 1.0e-15);
+    EXPECT_LT(test::maxDifference(A*L, A*Ld), 1.0e-15);
+}
+
+TEST(TriangularMatrixTestSuite, TestSolve)
+{
+    test::Random random(62);
+    for(size_t trial = 0; trial < 20; ++trial)
+    {
+        const matrix::SquareMatrix<double, 9> A = wellConditioned<9>(random);
+        matrix::LowerTriangular<double, 9> L(A);
+        matrix::UpperTriangular<double, 9> U(A);
+        matrix::Vector<double, 9> b;
+        matrix::Matrix<double, 9, 3> B;
+        test::fill(b, random);
+        test::fill(B, random);
+
+        const matrix::Vector<double, 9> x = L.solve(b);
+        const matrix::Vector<double, 9> y = U.solve(b);
+        EXPECT_LT(test::maxDifference(L.toSquareMatrix()*x, b), 1.0e-14);
+        EXPECT_LT(test::maxDifference(U.toSquareMatrix()*y, b), 1.0e-14);
+
+        const matrix::Matrix<double, 9, 3> X = L.solve(B);
+        const matrix::Matrix<double, 9, 3> Y = U.solve(B);
+        EXPECT_LT(test::maxDifference(L*X, B), 1.0e-14);
+        EXPECT_LT(test::maxDifference(U*Y, B), 1.0e-14);
+    }
+
+    matrix::SquareMatrix<double, 3> singular = {{1.0, 0.0, 0.0}, {2.0, 0.0, 0.0}, {3.0, 4.0, 5.0}};
+    matrix::LowerTriangular<double, 3> L(singular);
+    matrix::Vector<double, 3> b = {1.0, 2.0, 3.0};
+    EXPECT_THROW(L.solve(b), std::runtime_error);
+}
@@ -206,6 +206,23 @@ TEST(Vector3TestSuite, TestScalarCompoundDivision)
     EXPECT_DOUBLE_EQ(-2.1, v(2));
 }
 
+TEST(Vector3TestSuite, TestFusedExpressionAssignment)
+{
+    const matrix::Vector3<double> a(1.5, -2.0, 0.25);
+    const matrix::Vector3<double> b(0.5, 4.0, -1.0);
+    matrix::Vector3<double> c(2.0, 2.0, 2.0);
+
+    matrix::Vector3<double> result = a + b*2.0 - c;
+    EXPECT_DOUBLE_EQ(0.5, result(0));
+    EXPECT_DOUBLE_EQ(4.0, result(1));
+    EXPECT_DOUBLE_EQ(-3.75, result(2));
+
+    result = (a - b) / 2.0;
+    EXPECT_DOUBLE_EQ(0.5, result(0));
+    EXPECT_DOUBLE_EQ(-3.0, result(1));
+    EXPECT_DOUBLE_EQ(0.625, result(2));
+}
+
 TEST(Vector3TestSuite, TestVector3CrossProduct)
 {
     matrix::Vector3<int> v1(3, 6, -2);
@@ -245,6 +262,20 @@ TEST(Vector3TestSuite, TestVector3TildeOperation)
     EXPECT_EQ(0, m(2,2));
 }
 
+TEST(Vector3TestSuite, TestCompileTimeCrossAndTilde)
+{
+    constexpr matrix::Vector3<int> v1(3, 6, -2);
+    constexpr matrix::Vector3<int> v2(7, 1, 0);
+    constexpr matrix::Vector3<int> c = v1.cross(v2);
+    static_assert(c(0) == 2 && c(1) == -14 && c(2) == -39, "cross product");
+    static_assert(v1*v2 == 27, "dot product");
+
+    constexpr matrix::SquareMatrix<int, 3> m = v1.tilde();
+    constexpr matrix::Vector3<int> mc = m*v2;
+    static_assert(mc(0) == c(0) && mc(1) == c(1) && mc(2) == c(2), "tilde matrix matches cross product");
+    EXPECT_EQ(-39, mc(2));
+}
+
 TEST(Vector3TestSuite, TestVector3UnitVector)
 {
     matrix::Vector3<double> v(2.1, 3.3, 5.3);
@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////
+//!
+//! @file TestVector3Batch.cpp
+//!
+//! Unit test for BatchStorage.hpp and Vector3Batch.hpp
+//!
+//! @author David Wallace <jdavidwallace1@gmail.com>
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/Vector3Batch.hpp"
+
+namespace
+{
+
+//! Deterministic, non-trivial vectors (37 is not a whole number of blocks)
+std::vector<matrix::Vector3<double>> vectors(size_t n, double offset)
+{
+    std::vector<matrix::Vector3<double>> v(n);
+    for(size_t i = 0; i < n; ++i)
+    {
+        const double s = 0.37*static_cast<double>((i*7) % 23) - 2.1 + offset;
+        v[i] = matrix::Vector3<double>(s, 1.5 - 0.5*s, 0.25*s*s + 0.1);
+    }
+    return v;
+}
+
+} // namespace
+
+TEST(Vector3BatchTestSuite, TestLoadAndStore)
+{
+    const std::vector<matrix::Vector3<double>> v = vectors(37, 0.0);
+    matrix::Vector3Batch<double> batch(v.data(), v.size());
+    EXPECT_EQ(37u, batch.size());
+    EXPECT_EQ(48u, batch.paddedSize());
+
+    std::vector<matrix::Vector3<double>> out(v.size());
+    batch.store(out.data());
+    for(size_t i = 0; i < v.size(); ++i)
+    {
+        EXPECT_EQ(v[i], out[i]);
+        EXPECT_EQ(v[i], batch(i));
+        EXPECT_EQ(v[i](1), batch.y()[i]);
+    }
+
+    batch.set(5, matrix::Vector3<double>(1.0, 2.0, 3.0));
+    EXPECT_EQ(matrix::Vector3<double>(1.0, 2.0, 3.0), batch(5));
+}
+
+TEST(Vector3BatchTestSuite, TestResize)
+{
+    const std::vector<matrix::Vector3<double>> v = vectors(20, 0.0);
+    matrix::Vector3Batch<double> batch(v.data(), v.size());
+    batch.normalize();
+    const matrix::Vector3<double> kept = batch(3);
+
+    // Growing inside the padding must not expose stale lanes
+    batch.resize(30);
+    EXPECT_EQ(32u, batch.paddedSize());
+    EXPECT_EQ(kept, batch(3));
+    EXPECT_EQ(matrix::Vector3<double>(0.0, 0.0, 0.0), batch(25));
+
+    batch.resize(100);
+    EXPECT_EQ(112u, batch.paddedSize());
+    EXPECT_EQ(kept, batch(3));
+    EXPECT_EQ(matrix::Vector3<double>(0.0, 0.0, 0.0), batch(99));
+
+    batch.resize(2);
+    EXPECT_EQ(2u, batch.size());
+    EXPECT_EQ(16u, batch.paddedSize());
+}
+
+TEST(Vector3BatchTestSuite, TestDotAndCross)
+{
+    const std::vector<matrix::Vector3<double>> a = vectors(37, 0.0);
+    const std::vector<matrix::Vector3<double>> b = vectors(37, 0.7);
+    const matrix::Vector3Batch<double> batchA(a.data(), a.size());
+    matrix::Vector3Batch<double> batchB(b.data(), b.size());
+
+    std::vector<double> dots(a.size());
+    batchA.dot(batchB, dots.data());
+    matrix::Vector3Batch<double> crosses;
+    batchA.cross(batchB, crosses);
+    ASSERT_EQ(a.size(), crosses.size());
+    for(size_t i = 0; i < a.size(); ++i)
+    {
+        EXPECT_NEAR(a[i].dot(b[i]), dots[i], 1e-12);
+        const matrix::Vector3<double> expected = a[i].cross(b[i]);
+        for(size_t j = 0; j < 3; ++j)
+        {
+            EXPECT_NEAR(expected(j), crosses(i)(j), 1e-12);
+        }
+    }
+
+    // The result may overwrite one of the inputs
+    batchA.cross(batchB, batchB);
+    for(size_t i = 0; i < a.size(); ++i)
+    {
+        EXPECT_EQ(crosses(i), batchB(i));
+    }
+}
+
+TEST(Vector3BatchTestSuite, TestNormalize)
+{
+    // Longer than one chunk of the norm buffer
+    std::vector<matrix::Vector3<float>> v(1000);
+    for(size_t i = 0; i < v.size(); ++i)
+    {
+        v[i] = matrix::Vector3<float>(1.0f + static_cast<float>(i % 13), -2.0f, 0.5f*static_cast<float>(i % 7));
+    }
+    matrix::Vector3Batch<float> batch(v.data(), v.size());
+    batch.normalize();
+    for(size_t i = 0; i < v.size(); ++i)
+    {
+        matrix::Vector3<float> expected = v[i];
+        expected.normalize();
+        for(size_t j = 0; j < 3; ++j)
+        {
+            EXPECT_NEAR(expected(j), batch(i)(j), 1e-6f);
+        }
+    }
+
+    // The padding lanes stay zero instead of becoming 0/0
+    for(size_t i = batch.size(); i < batch.paddedSize(); ++i)
+    {
+        EXPECT_EQ(0.0f, batch.x()[i]);
+        EXPECT_EQ(0.0f, batch.y()[i]);
+        EXPECT_EQ(0.0f, batch.z()[i]);
+    }
+}
+
+TEST(Vector3BatchTestSuite, TestSizeMismatchThrows)
+{
+    const std::vector<matrix::Vector3<double>> a = vectors(37, 0.0);
+    const matrix::Vector3Batch<double> batchA(a.data(), a.size());
+    const matrix::Vector3Batch<double> batchB(a.data(), 20);
+
+    std::vector<double> dots(a.size());
+    matrix::Vector3Batch<double> crosses;
+    EXPECT_THROW(batchA.dot(batchB, dots.data()), std::domain_error);
+    EXPECT_THROW(batchA.cross(batchB, crosses), std::domain_error);
+    EXPECT_THROW(batchB.cross(batchA, crosses), std::domain_error);
+}